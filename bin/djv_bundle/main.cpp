@@ -0,0 +1,361 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/IO.h>
+#include <djvAV/Image.h>
+#if defined(PNG_FOUND)
+#include <djvAV/PNG.h>
+#endif // PNG_FOUND
+
+#include <djvCore/Context.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/PicoJSON.h>
+#include <djvCore/ResourceBundle.h>
+#include <djvCore/ResourceSystem.h>
+#include <djvCore/Time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <thread>
+
+using namespace djv;
+
+namespace djv
+{
+    //! This namespace provides functionality for djv_bundle.
+    namespace bundle
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t readMax = 16;
+
+            typedef std::pair<Core::ResourceBundle::Entry, std::vector<uint8_t> > BundleEntry;
+
+        } // namespace
+
+        //! The application only uses the core systems, so it can run as part
+        //! of the build on machines without a display or audio device.
+        class Application : public Core::Context
+        {
+            DJV_NON_COPYABLE(Application);
+
+        protected:
+            void _init(int & argc, char ** argv)
+            {
+                std::vector<std::string> args;
+                for (int i = 0; i < argc; ++i)
+                {
+                    args.push_back(argv[i]);
+                }
+                Core::Context::_init(args);
+
+                if (!_parseArgs())
+                {
+                    return;
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                std::vector<BundleEntry> entries;
+                _addFiles("Fonts", "\\.(ttf|otf)$", entries);
+                _addFiles("Shaders", "\\.glsl$", entries);
+                _addText(entries);
+                _addIcons(entries);
+                std::sort(
+                    entries.begin(),
+                    entries.end(),
+                    [](const BundleEntry& a, const BundleEntry& b)
+                    {
+                        return a.first.name < b.first.name;
+                    });
+                Core::ResourceBundle::write(_output, entries);
+
+                size_t size = 0;
+                for (const auto& i : entries)
+                {
+                    size += i.second.size();
+                }
+                const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - start;
+                std::cout << _output << ": " << entries.size() << " " << DJV_TEXT("entries") << ", " <<
+                    (size / Core::Memory::megabyte) << "MB, " << diff.count() << " " << DJV_TEXT("seconds") << std::endl;
+            }
+
+            Application()
+            {}
+
+        public:
+            static std::shared_ptr<Application> create(int & argc, char ** argv)
+            {
+                auto out = std::shared_ptr<Application>(new Application);
+                out->_init(argc, argv);
+                return out;
+            }
+
+        private:
+            bool _parseArgs()
+            {
+                bool out = true;
+                auto args = getArgs();
+                auto i = args.begin();
+                while (i != args.end())
+                {
+                    if ("-h" == *i || "-help" == *i)
+                    {
+                        out = false;
+                        _printUsage();
+                        break;
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (out)
+                {
+                    if (args.size() != 3)
+                    {
+                        throw std::invalid_argument(DJV_TEXT("Cannot parse the command line"));
+                    }
+                    _input = Core::FileSystem::Path(args[1]);
+                    _output = args[2];
+                }
+                return out;
+            }
+
+            void _printUsage()
+            {
+                std::cout << std::endl;
+                std::cout << DJV_TEXT(" Usage:") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   djv_bundle (resource directory) (output)") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   Pack the fonts, icons, shaders, and text in a resource directory (etc) into a bundle.") << std::endl;
+                std::cout << std::endl;
+            }
+
+            std::vector<Core::FileSystem::FileInfo> _list(const Core::FileSystem::Path& path, const std::string& filter)
+            {
+                Core::FileSystem::DirectoryListOptions options;
+                options.filter = filter;
+                return Core::FileSystem::FileInfo::directoryList(path, options);
+            }
+
+            void _addFiles(const std::string& dir, const std::string& filter, std::vector<BundleEntry>& out)
+            {
+                for (const auto& i : _list(Core::FileSystem::Path(_input, dir), filter))
+                {
+                    Core::FileSystem::FileIO io;
+                    io.open(i.getFileName(), Core::FileSystem::FileIO::Mode::Read);
+                    BundleEntry entry;
+                    entry.first.type = Core::ResourceBundle::EntryType::File;
+                    entry.first.name = dir + "/" + i.getFileName(Core::Frame::invalid, false);
+                    entry.second.resize(io.getSize());
+                    io.read(entry.second.data(), entry.second.size());
+                    out.push_back(std::move(entry));
+                }
+            }
+
+            void _addText(std::vector<BundleEntry>& out)
+            {
+                for (const auto& i : _list(Core::FileSystem::Path(_input, "Text"), "\\.text$"))
+                {
+                    Core::FileSystem::FileIO io;
+                    io.open(i.getFileName(), Core::FileSystem::FileIO::Mode::Read);
+                    const std::string contents = Core::FileSystem::FileIO::readContents(io);
+                    picojson::value v;
+                    const std::string error = picojson::parse(v, contents);
+                    if (!error.empty())
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("Error reading the text file") << " '" << i.getPath() << "'. " << error;
+                        throw Core::FileSystem::Error(ss.str());
+                    }
+                    Core::ResourceBundle::TextList text;
+                    if (v.is<picojson::array>())
+                    {
+                        for (const auto& item : v.get<picojson::array>())
+                        {
+                            if (item.is<picojson::object>())
+                            {
+                                const auto& obj = item.get<picojson::object>();
+                                const auto id = obj.find("id");
+                                const auto value = obj.find("text");
+                                if (id != obj.end() && value != obj.end() && !id->second.to_str().empty())
+                                {
+                                    text.push_back(std::make_pair(id->second.to_str(), value->second.to_str()));
+                                }
+                            }
+                        }
+                    }
+                    BundleEntry entry;
+                    entry.first.type = Core::ResourceBundle::EntryType::Text;
+                    entry.first.name = "Text/" + i.getFileName(Core::Frame::invalid, false);
+                    entry.second = Core::ResourceBundle::packText(text);
+                    out.push_back(std::move(entry));
+                }
+            }
+
+            void _addIcons(std::vector<BundleEntry>& out)
+            {
+#if defined(PNG_FOUND)
+                // Decode the icons with the PNG reader that the icon system uses,
+                // without the rest of the I/O system.
+                auto resourceSystem = getSystemT<Core::ResourceSystem>();
+                auto logSystem = getSystemT<Core::LogSystem>();
+                _logStartupTime();
+                const Core::FileSystem::Path iconsPath(_input, "Icons");
+                std::list<std::pair<std::string, Core::FileSystem::Path> > files;
+                for (const auto& i : _list(iconsPath, "DPI$"))
+                {
+                    if (Core::FileSystem::FileType::Directory == i.getType())
+                    {
+                        const std::string dpi = i.getFileName(Core::Frame::invalid, false);
+                        for (const auto& j : _list(i.getPath(), "\\.png$"))
+                        {
+                            files.push_back(std::make_pair(
+                                "Icons/" + dpi + "/" + j.getFileName(Core::Frame::invalid, false),
+                                j.getPath()));
+                        }
+                    }
+                }
+
+                std::list<std::pair<std::string, std::shared_ptr<AV::IO::IRead> > > reads;
+                while (files.size() || reads.size())
+                {
+                    while (files.size() && reads.size() < readMax)
+                    {
+                        reads.push_back(std::make_pair(
+                            files.front().first,
+                            AV::IO::PNG::Read::create(
+                                Core::FileSystem::FileInfo(files.front().second),
+                                AV::IO::ReadOptions(),
+                                resourceSystem,
+                                logSystem)));
+                        files.pop_front();
+                    }
+                    auto i = reads.begin();
+                    while (i != reads.end())
+                    {
+                        std::shared_ptr<AV::Image::Image> image;
+                        bool finished = false;
+                        {
+                            std::lock_guard<std::mutex> lock(i->second->getMutex());
+                            auto& queue = i->second->getVideoQueue();
+                            if (!queue.isEmpty())
+                            {
+                                image = queue.getFrame().image;
+                            }
+                            else if (queue.isFinished())
+                            {
+                                finished = true;
+                            }
+                        }
+                        if (image)
+                        {
+                            _addImage(i->first, image, out);
+                            i = reads.erase(i);
+                        }
+                        else if (finished)
+                        {
+                            std::cout << DJV_TEXT("Error loading image") << " '" << i->first << "'." << std::endl;
+                            i = reads.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+#else // PNG_FOUND
+                // Without the PNG reader the icons are left for the icon system
+                // to load from the loose files.
+                std::cout << DJV_TEXT("Skipping the icons, PNG support is not available.") << std::endl;
+#endif // PNG_FOUND
+            }
+
+            void _addImage(
+                const std::string& name,
+                const std::shared_ptr<AV::Image::Image>& image,
+                std::vector<BundleEntry>& out)
+            {
+                // Only 8-bit RGBA images are packed, anything else is left
+                // for the icon system to load from the loose file.
+                if (image->getType() != AV::Image::Type::RGBA_U8)
+                {
+                    std::cout << DJV_TEXT("Skipping image") << " '" << name << "': " << image->getType() << std::endl;
+                    return;
+                }
+                const uint16_t w = image->getWidth();
+                const uint16_t h = image->getHeight();
+                const size_t scanlineByteCount = static_cast<size_t>(w) * 4;
+                const bool mirrorY = image->getLayout().mirror.y;
+                BundleEntry entry;
+                entry.first.type = Core::ResourceBundle::EntryType::Image;
+                entry.first.name = name;
+                entry.first.width = w;
+                entry.first.height = h;
+                entry.second.resize(scanlineByteCount * h);
+                for (uint16_t y = 0; y < h; ++y)
+                {
+                    memcpy(
+                        entry.second.data() + scanlineByteCount * y,
+                        image->getData(mirrorY ? (h - 1 - y) : y),
+                        scanlineByteCount);
+                }
+                out.push_back(std::move(entry));
+            }
+
+            Core::FileSystem::Path _input;
+            std::string _output;
+        };
+
+    } // namespace bundle
+} // namespace djv
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        bundle::Application::create(argc, argv);
+        r = 0;
+    }
+    catch (const std::exception & error)
+    {
+        std::cout << Core::Error::format(error) << std::endl;
+    }
+    return r;
+}
@@ -38,6 +38,9 @@
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
 
+#include <chrono>
+#include <iomanip>
+
 using namespace djv;
 
 namespace djv
@@ -66,6 +69,7 @@ namespace djv
                 }
 
                 auto io = getSystemT<AV::IO::System>();
+                _logStartupTime();
                 Core::FileSystem::FileInfo readFileInfo(argv[1]);
                 if (_readSeq)
                 {
@@ -92,10 +96,24 @@ namespace djv
                 {
                     writeFileInfo.evalSequence();
                 }
+                if (_ffmpegOptions.size())
+                {
+                    auto options = io->getOptions("FFmpeg");
+                    if (options.is<picojson::object>())
+                    {
+                        for (const auto& i : _ffmpegOptions)
+                        {
+                            options.get<picojson::object>()[i.first] = picojson::value(i.second);
+                        }
+                        io->setOptions("FFmpeg", options);
+                    }
+                }
                 AV::IO::WriteOptions writeOptions;
                 writeOptions.videoQueueSize = _writeQueueSize;
+                writeOptions.colorSpaceConvert = _colorSpace;
                 _write = io->write(writeFileInfo, info, writeOptions);
                 _write->setThreadCount(_writeThreadCount);
+                _startTime = std::chrono::steady_clock::now();
                 
                 _statsTimer = Core::Time::Timer::create(shared_from_this());
                 _statsTimer->setRepeating(true);
@@ -114,7 +132,8 @@ namespace djv
                     }
                     if (frame && size)
                     {
-                        std::cout << static_cast<size_t>(frame / static_cast<float>(size - 1) * 100.F) << "%" << std::endl;
+                        std::cout << static_cast<size_t>(frame / static_cast<float>(size - 1) * 100.F) << "% " <<
+                            std::fixed << std::setprecision(2) << _getFPS() << " " << DJV_TEXT("fps") << std::endl;
                     }
                 });
             }
@@ -145,6 +164,7 @@ namespace djv
                         {
                             auto frame = readQueue.popFrame();
                             writeQueue.addFrame(frame);
+                            ++_frameCount;
                         }
                         else if (readQueue.isFinished())
                         {
@@ -154,11 +174,26 @@ namespace djv
                 }
                 if (_write && !_write->isRunning())
                 {
+                    std::cout << _frameCount << " " << DJV_TEXT("frames") << ", " <<
+                        std::fixed << std::setprecision(2) << _getFPS() << " " << DJV_TEXT("fps") << std::endl;
                     exit(0);
                 }
             }
 
         private:
+            //! Get the average number of frames per second written since the
+            //! conversion started.
+            float _getFPS()
+            {
+                size_t queued = 0;
+                {
+                    std::lock_guard<std::mutex> lock(_write->getMutex());
+                    queued = _write->getVideoQueue().getCount();
+                }
+                const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - _startTime;
+                return elapsed.count() > 0.F ? (_frameCount - queued) / elapsed.count() : 0.F;
+            }
+
             bool _parseArgs()
             {
                 bool out = true;
@@ -181,6 +216,22 @@ namespace djv
                         i = args.erase(i);
                         _resize.reset(new AV::Image::Size(resize));
                     }
+                    else if ("-colorSpace" == *i)
+                    {
+                        i = args.erase(i);
+                        if (i == args.end())
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the color space"));
+                        }
+                        _colorSpace.input = *i;
+                        i = args.erase(i);
+                        if (i == args.end())
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the color space"));
+                        }
+                        _colorSpace.output = *i;
+                        i = args.erase(i);
+                    }
                     else if ("-readSeq" == *i)
                     {
                         i = args.erase(i);
@@ -227,6 +278,27 @@ namespace djv
                         i = args.erase(i);
                         _writeThreadCount = std::max(value, 1);
                     }
+                    else if ("-ffmpegCodec" == *i ||
+                        "-ffmpegBitRate" == *i ||
+                        "-ffmpegGOP" == *i ||
+                        "-ffmpegPixelFormat" == *i)
+                    {
+                        const std::map<std::string, std::string> keys =
+                        {
+                            { "-ffmpegCodec", "Codec" },
+                            { "-ffmpegBitRate", "BitRate" },
+                            { "-ffmpegGOP", "GOPSize" },
+                            { "-ffmpegPixelFormat", "PixelFormat" }
+                        };
+                        const std::string key = keys.at(*i);
+                        i = args.erase(i);
+                        if (i == args.end())
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the FFmpeg option"));
+                        }
+                        _ffmpegOptions[key] = *i;
+                        i = args.erase(i);
+                    }
                     else
                     {
                         ++i;
@@ -257,6 +329,9 @@ namespace djv
                 std::cout << DJV_TEXT("   -resize \"(width) (height)\"") << std::endl;
                 std::cout << DJV_TEXT("   Resize the image.") << std::endl;
                 std::cout << std::endl;
+                std::cout << DJV_TEXT("   -colorSpace (input) (output)") << std::endl;
+                std::cout << DJV_TEXT("   Convert the color space using the current OpenColorIO configuration.") << std::endl;
+                std::cout << std::endl;
                 std::cout << DJV_TEXT("   -readSeq") << std::endl;
                 std::cout << DJV_TEXT("   Interpret the input file name as a sequence.") << std::endl;
                 std::cout << std::endl;
@@ -275,11 +350,24 @@ namespace djv
                 std::cout << DJV_TEXT("   -writeThreads (value)") << std::endl;
                 std::cout << DJV_TEXT("   Set the number of threads for writing.") << std::endl;
                 std::cout << std::endl;
+                std::cout << DJV_TEXT("   -ffmpegCodec (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the FFmpeg encoder, for example mpeg4 or mjpeg.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -ffmpegBitRate (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the FFmpeg encoder bit rate in bits per second.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -ffmpegGOP (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the FFmpeg encoder GOP size in frames.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -ffmpegPixelFormat (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the FFmpeg encoder pixel format, for example yuv420p or yuv444p10le.") << std::endl;
+                std::cout << std::endl;
             }
 
             std::string _input;
             std::string _output;
             std::unique_ptr<AV::Image::Size> _resize;
+            AV::OCIO::Convert _colorSpace;
             bool _readSeq = false;
             bool _writeSeq = false;
             //! \todo What's a good default for this?
@@ -287,9 +375,12 @@ namespace djv
             size_t _writeQueueSize = 10;
             size_t _readThreadCount = 4;
             size_t _writeThreadCount = 4;
+            std::map<std::string, std::string> _ffmpegOptions;
             std::shared_ptr<AV::IO::IRead> _read;
             std::shared_ptr<Core::Time::Timer> _statsTimer;
             std::shared_ptr<AV::IO::IWrite> _write;
+            size_t _frameCount = 0;
+            std::chrono::steady_clock::time_point _startTime;
         };
 
     } // namespace convert
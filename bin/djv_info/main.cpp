@@ -60,6 +60,7 @@ namespace djv
 
                 auto io = getSystemT<AV::IO::System>();
                 auto avSystem = getSystemT<AV::AVSystem>();
+                _logStartupTime();
                 for (int i = 1; i < argc; ++i)
                 {
                     const Core::FileSystem::FileInfo fileInfo(argv[i]);
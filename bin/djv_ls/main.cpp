@@ -57,10 +57,16 @@ namespace djv
                 }
                 CmdLine::Application::_init(args);
 
+                if (!_parseArgs())
+                {
+                    return;
+                }
+
                 auto io = getSystemT<AV::IO::System>();
-                for (int i = 1; i < argc; ++i)
+                _logStartupTime();
+                for (const auto& i : _inputs)
                 {
-                    const Core::FileSystem::FileInfo fileInfo(argv[i]);
+                    const Core::FileSystem::FileInfo fileInfo(i);
                     switch (fileInfo.getType())
                     {
                     case Core::FileSystem::FileType::File:
@@ -72,6 +78,8 @@ namespace djv
                         Core::FileSystem::DirectoryListOptions options;
                         options.fileSequences = true;
                         options.fileSequenceExtensions = io->getSequenceExtensions();
+                        options.sort = _sort;
+                        options.reverseSort = _reverseSort;
                         for (const auto & j : Core::FileSystem::FileInfo::directoryList(fileInfo.getPath(), options))
                         {
                             _print(j.getFileName(Core::Frame::invalid, false));
@@ -95,10 +103,75 @@ namespace djv
             }
 
         private:
+            bool _parseArgs()
+            {
+                bool out = true;
+                auto args = getArgs();
+                auto i = args.begin();
+                while (i != args.end())
+                {
+                    if ("-h" == *i || "-help" == *i)
+                    {
+                        out = false;
+                        _printUsage();
+                        break;
+                    }
+                    else if ("-sort" == *i)
+                    {
+                        i = args.erase(i);
+                        if (i == args.end())
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the sort"));
+                        }
+                        std::stringstream ss(*i);
+                        ss >> _sort;
+                        i = args.erase(i);
+                    }
+                    else if ("-reverse" == *i)
+                    {
+                        i = args.erase(i);
+                        _reverseSort = true;
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (out)
+                {
+                    for (size_t j = 1; j < args.size(); ++j)
+                    {
+                        _inputs.push_back(args[j]);
+                    }
+                }
+                return out;
+            }
+
+            void _printUsage()
+            {
+                std::cout << std::endl;
+                std::cout << DJV_TEXT(" Usage:") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   djv_ls (input) ... [option, ...]") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT(" Options:") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -sort (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the directory listing sort: Name, Size, Time, Permissions, or Natural.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -reverse") << std::endl;
+                std::cout << DJV_TEXT("   Reverse the sort order.") << std::endl;
+                std::cout << std::endl;
+            }
+
             void _print(const std::string & fileName)
             {
                 std::cout << fileName << std::endl;
             }
+
+            std::vector<std::string> _inputs;
+            Core::FileSystem::DirectoryListSort _sort = Core::FileSystem::DirectoryListSort::Name;
+            bool _reverseSort = false;
         };
 
     } // namespace ls
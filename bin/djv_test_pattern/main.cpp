@@ -122,6 +122,7 @@ namespace djv
             _render = getSystemT<AV::Render::Render2D>();
 
             auto io = getSystemT<AV::IO::System>();
+            _logStartupTime();
             Core::FileSystem::FileInfo writeFileInfo(argv[1]);
             writeFileInfo.evalSequence();
             AV::IO::WriteOptions writeOptions;
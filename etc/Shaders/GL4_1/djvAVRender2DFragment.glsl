@@ -65,6 +65,12 @@ uniform vec4        color;
 uniform sampler2D   textureSampler;
 uniform int         colorSpace          = 0;
 uniform sampler3D   colorSpaceSampler;
+uniform bool        yuv                 = false;
+uniform vec4        yuvRect[3];
+uniform vec2        yuvTexelSize;
+uniform mat3        yuvMatrix;
+uniform vec3        yuvScale;
+uniform vec3        yuvOffset;
 
 // djv::AV::Image::Channels
 #define IMAGE_CHANNELS_L    1
@@ -132,6 +138,26 @@ vec4 softClipFunc(vec4 value, float softClip)
     return value;
 }
 
+// The YUV planes are packed into a single texture; yuvRect gives the
+// position and size of each plane in texture coordinates. The coordinates
+// are clamped so that filtering does not bleed between the planes.
+vec2 yuvCoord(vec4 rect, vec2 value)
+{
+    return clamp(
+        rect.xy + value * rect.zw,
+        rect.xy + yuvTexelSize * 0.5,
+        rect.xy + rect.zw - yuvTexelSize * 0.5);
+}
+
+vec4 yuvFunc(vec2 value)
+{
+    vec3 tmp;
+    tmp[0] = texture(textureSampler, yuvCoord(yuvRect[0], value)).r;
+    tmp[1] = texture(textureSampler, yuvCoord(yuvRect[1], value)).r;
+    tmp[2] = texture(textureSampler, yuvCoord(yuvRect[2], value)).r;
+    return vec4(yuvMatrix * (tmp * yuvScale + yuvOffset), 1.0);
+}
+
 float knee(float value, float f)
 {
     return log(value * f + 1.0) / f;
@@ -195,7 +221,15 @@ void main()
     else if (COLOR_MODE_COLOR_AND_TEXTURE == colorMode)
     {
 		// Sample the texture.
-		vec4 t = texture(textureSampler, Texture);
+		vec4 t;
+		if (yuv)
+		{
+			t = yuvFunc(Texture);
+		}
+		else
+		{
+			t = texture(textureSampler, Texture);
+		}
 		
 		// Swizzle the channels for the given image format.
 		if (IMAGE_CHANNELS_L == imageChannels)
@@ -0,0 +1,61 @@
+#------------------------------------------------------------------------------
+# Copyright (c) 2019 Darby Johnston
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# * Redistributions of source code must retain the above copyright notice,
+#   this list of conditions, and the following disclaimer.
+# * Redistributions in binary form must reproduce the above copyright notice,
+#   this list of conditions, and the following disclaimer in the documentation
+#   and/or other materials provided with the distribution.
+# * Neither the names of the copyright holders nor the names of any
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#------------------------------------------------------------------------------
+
+import djvCorePy
+import djvAVPy
+import djvCmdLineAppPy
+
+import sys
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+try:
+    if len(sys.argv) < 2:
+        raise ValueError("Usage: ImageStatsCmdLineExample.py (input)")
+
+    # Create an application.
+    app = djvCmdLineAppPy.Application.create([sys.argv[0]])
+
+    # Read the frames and print statistics.
+    fileInfo = djvCorePy.FileSystem.FileInfo(sys.argv[1])
+    fileInfo.evalSequence()
+    read = djvAVPy.IO.Read(app, fileInfo, prefetch=8)
+    for frame, image in read:
+        stats = djvAVPy.Image.getStats(image)
+        print(frame, "min:", stats.min, "max:", stats.max, "average:", stats.average)
+        if numpy:
+            # The image data is shared with the array, no copy is made.
+            pixels = numpy.asarray(image)
+            print(frame, "shape:", pixels.shape, "dtype:", pixels.dtype)
+
+except Exception as e:
+    print(str(e))
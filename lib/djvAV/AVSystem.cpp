@@ -58,8 +58,6 @@ namespace djv
             std::shared_ptr<ValueSubject<Time::FPS> > defaultSpeed;
             std::shared_ptr<ValueSubject<Render::ImageFilterOptions> > imageFilterOptions;
             std::shared_ptr<ValueSubject<bool> > lcdText;
-            std::shared_ptr<ThumbnailSystem> thumbnailSystem;
-            std::shared_ptr<Render::Render2D> render2D;
         };
 
         void AVSystem::_init(const std::shared_ptr<Core::Context>& context)
@@ -73,21 +71,27 @@ namespace djv
             p.imageFilterOptions = ValueSubject<Render::ImageFilterOptions>::create();
             p.lcdText = ValueSubject<bool>::create(true);
 
-            auto glfwSystem = GLFW::System::create(context);
-            auto ocioSystem = OCIO::System::create(context);
-            auto ioSystem = IO::System::create(context);
-            auto fontSystem = Font::System::create(context);
-            p.thumbnailSystem = ThumbnailSystem::create(context);
-            p.render2D = Render::Render2D::create(context);
-            auto audioSystem = Audio::System::create(context);
-
-            addDependency(glfwSystem);
-            addDependency(ocioSystem);
-            addDependency(ioSystem);
-            addDependency(fontSystem);
-            addDependency(p.thumbnailSystem);
-            addDependency(p.render2D);
-            addDependency(audioSystem);
+            // The systems are created the first time they are requested, so
+            // that command-line tools only pay for what they use (for example
+            // listing files doesn't need an OpenGL context or fonts).
+            context->addSystemFactory<GLFW::System>();
+            context->addSystemFactory<OCIO::System>();
+            context->addSystemFactory<IO::System>();
+            context->addSystemFactory<Font::System>();
+            context->addSystemFactory<ThumbnailSystem>();
+            auto weak = std::weak_ptr<AVSystem>(std::dynamic_pointer_cast<AVSystem>(shared_from_this()));
+            context->addSystemFactory<Render::Render2D>(
+                [weak](const std::shared_ptr<Context>& context)
+                {
+                    auto out = Render::Render2D::create(context);
+                    if (auto system = weak.lock())
+                    {
+                        out->setImageFilterOptions(system->observeImageFilterOptions()->get());
+                        out->setLCDText(system->observeLCDText()->get());
+                    }
+                    return out;
+                });
+            context->addSystemFactory<Audio::System>();
         }
 
         AVSystem::AVSystem() :
@@ -135,7 +139,13 @@ namespace djv
             if (p.defaultSpeed->setIfChanged(value))
             {
                 Time::setDefaultSpeed(value);
-                p.thumbnailSystem->clearCache();
+                if (auto context = getContext().lock())
+                {
+                    for (const auto& i : context->getSystemsT<ThumbnailSystem>())
+                    {
+                        i->clearCache();
+                    }
+                }
             }
         }
 
@@ -149,7 +159,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.imageFilterOptions->setIfChanged(value))
             {
-                p.render2D->setImageFilterOptions(value);
+                if (auto context = getContext().lock())
+                {
+                    for (const auto& i : context->getSystemsT<Render::Render2D>())
+                    {
+                        i->setImageFilterOptions(value);
+                    }
+                }
             }
         }
 
@@ -163,7 +179,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.lcdText->setIfChanged(value))
             {
-                p.render2D->setLCDText(value);
+                if (auto context = getContext().lock())
+                {
+                    for (const auto& i : context->getSystemsT<Render::Render2D>())
+                    {
+                        i->setLCDText(value);
+                    }
+                }
             }
         }
 
@@ -27,29 +27,89 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 
+
 #include <djvAV/AudioData.h>
 
+#include <cmath>
+
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
 #define _CONVERT(a, b) \
+    convertKernel(reinterpret_cast<const a##_T*>(in), reinterpret_cast<b##_T*>(out), size)
+
+#define _CONVERT_VOLUME(a, b) \
+    convertVolumeKernel(reinterpret_cast<const a##_T*>(in), reinterpret_cast<b##_T*>(out), size, volume)
+
+#define _REMAP(a, b) \
+    remapKernel( \
+        reinterpret_cast<const a##_T*>(in), inChannelCount, \
+        reinterpret_cast<b##_T*>(out), outChannelCount, \
+        sampleCount, volume, channelMap)
+
+#define _TYPE_SWITCH(MACRO, inType, outType) \
+    switch (inType) \
     { \
-        const a##_T * inP = reinterpret_cast<const a##_T *>(data->getData()); \
-        b##_T * outP = reinterpret_cast<b##_T *>(out->getData()); \
-        for (size_t i = 0; i < sampleCount * channelCount; ++i, ++inP, ++outP) \
+    case Type::S8: \
+        switch (outType) \
         { \
-            a##To##b(*inP, *outP); \
+        case Type::S8:  MACRO(S8, S8);  break; \
+        case Type::S16: MACRO(S8, S16); break; \
+        case Type::S32: MACRO(S8, S32); break; \
+        case Type::F32: MACRO(S8, F32); break; \
+        case Type::F64: MACRO(S8, F64); break; \
+        default: break; \
         } \
-    }
-
-#define _VOLUME(t) \
-    { \
-        const t##_T* inP = reinterpret_cast<const t##_T*>(in); \
-        t##_T* outP = reinterpret_cast<t##_T*>(out); \
-        t##_T* const endP = outP + sampleCount * channelCount; \
-        for (; outP < endP; ++inP, ++outP) \
+        break; \
+    case Type::S16: \
+        switch (outType) \
         { \
-            *outP = *inP * volume; \
+        case Type::S8:  MACRO(S16, S8);  break; \
+        case Type::S16: MACRO(S16, S16); break; \
+        case Type::S32: MACRO(S16, S32); break; \
+        case Type::F32: MACRO(S16, F32); break; \
+        case Type::F64: MACRO(S16, F64); break; \
+        default: break; \
         } \
+        break; \
+    case Type::S32: \
+        switch (outType) \
+        { \
+        case Type::S8:  MACRO(S32, S8);  break; \
+        case Type::S16: MACRO(S32, S16); break; \
+        case Type::S32: MACRO(S32, S32); break; \
+        case Type::F32: MACRO(S32, F32); break; \
+        case Type::F64: MACRO(S32, F64); break; \
+        default: break; \
+        } \
+        break; \
+    case Type::F32: \
+        switch (outType) \
+        { \
+        case Type::S8:  MACRO(F32, S8);  break; \
+        case Type::S16: MACRO(F32, S16); break; \
+        case Type::S32: MACRO(F32, S32); break; \
+        case Type::F32: MACRO(F32, F32); break; \
+        case Type::F64: MACRO(F32, F64); break; \
+        default: break; \
+        } \
+        break; \
+    case Type::F64: \
+        switch (outType) \
+        { \
+        case Type::S8:  MACRO(F64, S8);  break; \
+        case Type::S16: MACRO(F64, S16); break; \
+        case Type::S32: MACRO(F64, S32); break; \
+        case Type::F32: MACRO(F64, F32); break; \
+        case Type::F64: MACRO(F64, F64); break; \
+        default: break; \
+        } \
+        break; \
+    default: break; \
     }
 
 namespace djv
@@ -90,138 +150,762 @@ namespace djv
                 memset(_data.data(), 0, getByteCount());
             }
 
+            namespace
+            {
+                template<typename T>
+                struct SampleTraits;
+
+                template<>
+                struct SampleTraits<S8_T>
+                {
+                    static constexpr bool  isFloat = false;
+                    static constexpr int   bits    = 8;
+                    static constexpr float min() { return -128.F; }
+                    static constexpr float max() { return 127.F; }
+                };
+
+                template<>
+                struct SampleTraits<S16_T>
+                {
+                    static constexpr bool  isFloat = false;
+                    static constexpr int   bits    = 16;
+                    static constexpr float min() { return -32768.F; }
+                    static constexpr float max() { return 32767.F; }
+                };
+
+                template<>
+                struct SampleTraits<S32_T>
+                {
+                    static constexpr bool  isFloat = false;
+                    static constexpr int   bits    = 32;
+                    static constexpr float min() { return -2147483648.F; }
+                    //! The largest float that is less than 2^31.
+                    static constexpr float max() { return 2147483520.F; }
+                };
+
+                template<>
+                struct SampleTraits<F32_T>
+                {
+                    static constexpr bool  isFloat = true;
+                    static constexpr int   bits    = 32;
+                    static constexpr float min() { return -1.F; }
+                    static constexpr float max() { return 1.F; }
+                };
+
+                template<>
+                struct SampleTraits<F64_T>
+                {
+                    static constexpr bool  isFloat = true;
+                    static constexpr int   bits    = 64;
+                    static constexpr float min() { return -1.F; }
+                    static constexpr float max() { return 1.F; }
+                };
+
+                //! The scale that takes a sample value of type A to type B, matching
+                //! the per-sample conversion functions.
+                template<typename A, typename B>
+                float getScale()
+                {
+                    float out = 1.F;
+                    if (!SampleTraits<A>::isFloat && !SampleTraits<B>::isFloat)
+                    {
+                        out = std::ldexp(1.F, SampleTraits<B>::bits - SampleTraits<A>::bits);
+                    }
+                    else if (!SampleTraits<A>::isFloat)
+                    {
+                        out = 1.F / static_cast<float>(std::numeric_limits<A>::max());
+                    }
+                    else if (!SampleTraits<B>::isFloat)
+                    {
+                        out = static_cast<float>(std::numeric_limits<B>::max());
+                    }
+                    return out;
+                }
+
+                template<typename T>
+                inline T fromFloat(float value)
+                {
+                    return static_cast<T>(Core::Math::clamp(value, SampleTraits<T>::min(), SampleTraits<T>::max()));
+                }
+
+                template<>
+                inline F32_T fromFloat(float value)
+                {
+                    return value;
+                }
+
+                template<>
+                inline F64_T fromFloat(float value)
+                {
+                    return static_cast<F64_T>(value);
+                }
+
+                template<typename A, typename B>
+                inline void convertSample(A value, B& out);
+
+                template<>
+                inline void convertSample(S8_T value, S8_T& out) { out = value; }
+                template<>
+                inline void convertSample(S8_T value, S16_T& out) { S8ToS16(value, out); }
+                template<>
+                inline void convertSample(S8_T value, S32_T& out) { S8ToS32(value, out); }
+                template<>
+                inline void convertSample(S8_T value, F32_T& out) { S8ToF32(value, out); }
+                template<>
+                inline void convertSample(S8_T value, F64_T& out) { S8ToF64(value, out); }
+                template<>
+                inline void convertSample(S16_T value, S8_T& out) { S16ToS8(value, out); }
+                template<>
+                inline void convertSample(S16_T value, S16_T& out) { out = value; }
+                template<>
+                inline void convertSample(S16_T value, S32_T& out) { S16ToS32(value, out); }
+                template<>
+                inline void convertSample(S16_T value, F32_T& out) { S16ToF32(value, out); }
+                template<>
+                inline void convertSample(S16_T value, F64_T& out) { S16ToF64(value, out); }
+                template<>
+                inline void convertSample(S32_T value, S8_T& out) { S32ToS8(value, out); }
+                template<>
+                inline void convertSample(S32_T value, S16_T& out) { S32ToS16(value, out); }
+                template<>
+                inline void convertSample(S32_T value, S32_T& out) { out = value; }
+                template<>
+                inline void convertSample(S32_T value, F32_T& out) { S32ToF32(value, out); }
+                template<>
+                inline void convertSample(S32_T value, F64_T& out) { S32ToF64(value, out); }
+                template<>
+                inline void convertSample(F32_T value, S8_T& out) { F32ToS8(value, out); }
+                template<>
+                inline void convertSample(F32_T value, S16_T& out) { F32ToS16(value, out); }
+                template<>
+                inline void convertSample(F32_T value, S32_T& out) { F32ToS32(value, out); }
+                template<>
+                inline void convertSample(F32_T value, F32_T& out) { out = value; }
+                template<>
+                inline void convertSample(F32_T value, F64_T& out) { F32ToF64(value, out); }
+                template<>
+                inline void convertSample(F64_T value, S8_T& out) { F64ToS8(value, out); }
+                template<>
+                inline void convertSample(F64_T value, S16_T& out) { F64ToS16(value, out); }
+                template<>
+                inline void convertSample(F64_T value, S32_T& out) { F64ToS32(value, out); }
+                template<>
+                inline void convertSample(F64_T value, F32_T& out) { F64ToF32(value, out); }
+                template<>
+                inline void convertSample(F64_T value, F64_T& out) { out = value; }
+
+#if defined(DJV_AUDIO_SSE2)
+                // The SSE2 kernels process four samples at a time. Integer samples
+                // are widened to 32-bit lanes, and floating point samples are
+                // processed as either four floats or two pairs of doubles.
+
+                inline __m128i loadI(const S8_T* value)
+                {
+                    int32_t tmp = 0;
+                    memcpy(&tmp, value, sizeof(int32_t));
+                    __m128i out = _mm_cvtsi32_si128(tmp);
+                    out = _mm_unpacklo_epi8(out, out);
+                    out = _mm_unpacklo_epi16(out, out);
+                    return _mm_srai_epi32(out, 24);
+                }
+
+                inline __m128i loadI(const S16_T* value)
+                {
+                    __m128i out = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(value));
+                    out = _mm_unpacklo_epi16(out, out);
+                    return _mm_srai_epi32(out, 16);
+                }
+
+                inline __m128i loadI(const S32_T* value)
+                {
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(value));
+                }
+
+                inline void storeI(S8_T* out, __m128i value)
+                {
+                    value = _mm_packs_epi32(value, value);
+                    value = _mm_packs_epi16(value, value);
+                    const int32_t tmp = _mm_cvtsi128_si32(value);
+                    memcpy(out, &tmp, sizeof(int32_t));
+                }
+
+                inline void storeI(S16_T* out, __m128i value)
+                {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(value, value));
+                }
+
+                inline void storeI(S32_T* out, __m128i value)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value);
+                }
+
+                inline __m128 loadF(const S8_T* value)
+                {
+                    return _mm_cvtepi32_ps(loadI(value));
+                }
+
+                inline __m128 loadF(const S16_T* value)
+                {
+                    return _mm_cvtepi32_ps(loadI(value));
+                }
+
+                inline __m128 loadF(const S32_T* value)
+                {
+                    return _mm_cvtepi32_ps(loadI(value));
+                }
+
+                inline __m128 loadF(const F32_T* value)
+                {
+                    return _mm_loadu_ps(value);
+                }
+
+                inline __m128 loadF(const F64_T* value)
+                {
+                    return _mm_movelh_ps(
+                        _mm_cvtpd_ps(_mm_loadu_pd(value)),
+                        _mm_cvtpd_ps(_mm_loadu_pd(value + 2)));
+                }
+
+                template<typename T>
+                inline void storeF(T* out, __m128 value)
+                {
+                    value = _mm_max_ps(value, _mm_set1_ps(SampleTraits<T>::min()));
+                    value = _mm_min_ps(value, _mm_set1_ps(SampleTraits<T>::max()));
+                    storeI(out, _mm_cvttps_epi32(value));
+                }
+
+                template<>
+                inline void storeF(F32_T* out, __m128 value)
+                {
+                    _mm_storeu_ps(out, value);
+                }
+
+                template<>
+                inline void storeF(F64_T* out, __m128 value)
+                {
+                    _mm_storeu_pd(out, _mm_cvtps_pd(value));
+                    _mm_storeu_pd(out + 2, _mm_cvtps_pd(_mm_movehl_ps(value, value)));
+                }
+
+                inline void loadD(const F32_T* value, __m128d& out0, __m128d& out1)
+                {
+                    const __m128 tmp = _mm_loadu_ps(value);
+                    out0 = _mm_cvtps_pd(tmp);
+                    out1 = _mm_cvtps_pd(_mm_movehl_ps(tmp, tmp));
+                }
+
+                inline void loadD(const F64_T* value, __m128d& out0, __m128d& out1)
+                {
+                    out0 = _mm_loadu_pd(value);
+                    out1 = _mm_loadu_pd(value + 2);
+                }
+
+                //! Divide by a power of two, rounding towards zero like integer division.
+                template<int N>
+                inline __m128i divPow2(__m128i value)
+                {
+                    const __m128i bias = _mm_srli_epi32(_mm_srai_epi32(value, 31), 32 - N);
+                    return _mm_srai_epi32(_mm_add_epi32(value, bias), N);
+                }
+
+                //! Convert doubles to integers with truncation, clamping to the given range.
+                inline __m128i cvttD(__m128d value0, __m128d value1, double scale, double min, double max)
+                {
+                    const __m128d scaleV = _mm_set1_pd(scale);
+                    const __m128d minV = _mm_set1_pd(min);
+                    const __m128d maxV = _mm_set1_pd(max);
+                    value0 = _mm_min_pd(_mm_max_pd(_mm_mul_pd(value0, scaleV), minV), maxV);
+                    value1 = _mm_min_pd(_mm_max_pd(_mm_mul_pd(value1, scaleV), minV), maxV);
+                    return _mm_unpacklo_epi64(_mm_cvttpd_epi32(value0), _mm_cvttpd_epi32(value1));
+                }
+
+                template<typename A, typename B>
+                inline void convert4(const A* in, B* out)
+                {
+                    memcpy(out, in, 4 * sizeof(A));
+                }
+
+                template<>
+                inline void convert4(const S8_T* in, S16_T* out) { storeI(out, _mm_slli_epi32(loadI(in), 8)); }
+                template<>
+                inline void convert4(const S8_T* in, S32_T* out) { storeI(out, _mm_slli_epi32(loadI(in), 24)); }
+                template<>
+                inline void convert4(const S16_T* in, S8_T* out) { storeI(out, divPow2<8>(loadI(in))); }
+                template<>
+                inline void convert4(const S16_T* in, S32_T* out) { storeI(out, _mm_slli_epi32(loadI(in), 16)); }
+                template<>
+                inline void convert4(const S32_T* in, S8_T* out) { storeI(out, divPow2<24>(loadI(in))); }
+                template<>
+                inline void convert4(const S32_T* in, S16_T* out) { storeI(out, divPow2<16>(loadI(in))); }
+
+                template<typename T>
+                inline void intToF32(const T* in, F32_T* out)
+                {
+                    const __m128 max = _mm_set1_ps(static_cast<float>(std::numeric_limits<T>::max()));
+                    _mm_storeu_ps(out, _mm_div_ps(_mm_cvtepi32_ps(loadI(in)), max));
+                }
+
+                template<>
+                inline void convert4(const S8_T* in, F32_T* out) { intToF32(in, out); }
+                template<>
+                inline void convert4(const S16_T* in, F32_T* out) { intToF32(in, out); }
+                template<>
+                inline void convert4(const S32_T* in, F32_T* out) { intToF32(in, out); }
+
+                template<typename T>
+                inline void intToF64(const T* in, F64_T* out)
+                {
+                    const __m128i value = loadI(in);
+                    const __m128d max = _mm_set1_pd(static_cast<double>(std::numeric_limits<T>::max()));
+                    _mm_storeu_pd(out, _mm_div_pd(_mm_cvtepi32_pd(value), max));
+                    _mm_storeu_pd(out + 2, _mm_div_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(value, value)), max));
+                }
+
+                template<>
+                inline void convert4(const S8_T* in, F64_T* out) { intToF64(in, out); }
+                template<>
+                inline void convert4(const S16_T* in, F64_T* out) { intToF64(in, out); }
+                template<>
+                inline void convert4(const S32_T* in, F64_T* out) { intToF64(in, out); }
+
+                template<typename T>
+                inline void f32ToInt(const F32_T* in, T* out)
+                {
+                    __m128 value = _mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(static_cast<float>(std::numeric_limits<T>::max())));
+                    value = _mm_max_ps(value, _mm_set1_ps(SampleTraits<T>::min()));
+                    value = _mm_min_ps(value, _mm_set1_ps(SampleTraits<T>::max()));
+                    storeI(out, _mm_cvttps_epi32(value));
+                }
+
+                template<>
+                inline void convert4(const F32_T* in, S8_T* out) { f32ToInt(in, out); }
+                template<>
+                inline void convert4(const F32_T* in, S16_T* out) { f32ToInt(in, out); }
+
+                template<typename A, typename B>
+                inline void doubleToInt(const A* in, B* out)
+                {
+                    __m128d value0;
+                    __m128d value1;
+                    loadD(in, value0, value1);
+                    storeI(out, cvttD(
+                        value0,
+                        value1,
+                        static_cast<double>(std::numeric_limits<B>::max()),
+                        static_cast<double>(std::numeric_limits<B>::min()),
+                        static_cast<double>(std::numeric_limits<B>::max())));
+                }
+
+                template<>
+                inline void convert4(const F32_T* in, S32_T* out) { doubleToInt(in, out); }
+                template<>
+                inline void convert4(const F64_T* in, S8_T* out) { doubleToInt(in, out); }
+                template<>
+                inline void convert4(const F64_T* in, S16_T* out) { doubleToInt(in, out); }
+                template<>
+                inline void convert4(const F64_T* in, S32_T* out) { doubleToInt(in, out); }
+
+                template<>
+                inline void convert4(const F32_T* in, F64_T* out)
+                {
+                    __m128d value0;
+                    __m128d value1;
+                    loadD(in, value0, value1);
+                    _mm_storeu_pd(out, value0);
+                    _mm_storeu_pd(out + 2, value1);
+                }
+
+                template<>
+                inline void convert4(const F64_T* in, F32_T* out)
+                {
+                    _mm_storeu_ps(out, loadF(in));
+                }
+#endif // DJV_AUDIO_SSE2
+
+                template<typename A, typename B>
+                void convertKernel(const A* in, B* out, size_t size)
+                {
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        convert4(in + i, out + i);
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convertSample(in[i], out[i]);
+                    }
+                }
+
+                template<typename A, typename B>
+                void convertVolumeKernel(const A* in, B* out, size_t size, float volume)
+                {
+                    const float scale = getScale<A, B>() * volume;
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    const __m128 scaleV = _mm_set1_ps(scale);
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        storeF(out + i, _mm_mul_ps(loadF(in + i), scaleV));
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out[i] = fromFloat<B>(static_cast<float>(in[i]) * scale);
+                    }
+                }
+
+                template<typename A, typename B>
+                inline B scaleSample(A value, float scale)
+                {
+                    return fromFloat<B>(static_cast<float>(value) * scale);
+                }
+
+                template<>
+                inline F64_T scaleSample(F64_T value, float scale)
+                {
+                    return value * scale;
+                }
+
+                template<typename A, typename B>
+                void remapKernel(
+                    const A* in,
+                    uint8_t inChannelCount,
+                    B* out,
+                    uint8_t outChannelCount,
+                    size_t sampleCount,
+                    float volume,
+                    const std::vector<int8_t>& channelMap)
+                {
+                    const float scale = getScale<A, B>() * volume;
+                    const B zero = fromFloat<B>(0.F);
+                    int8_t map[256];
+                    for (size_t c = 0; c < outChannelCount; ++c)
+                    {
+                        const int8_t channel = c < channelMap.size() ? channelMap[c] : static_cast<int8_t>(c);
+                        map[c] = channel < inChannelCount ? channel : -1;
+                    }
+                    const A* inP = in;
+                    B* outP = out;
+                    B* const endP = out + sampleCount * outChannelCount;
+                    for (; outP < endP; inP += inChannelCount, outP += outChannelCount)
+                    {
+                        for (size_t c = 0; c < outChannelCount; ++c)
+                        {
+                            outP[c] = map[c] >= 0 ? scaleSample<A, B>(inP[map[c]], scale) : zero;
+                        }
+                    }
+                }
+
+                template<typename T>
+                void volumeKernel(const T* in, T* out, size_t size, float volume)
+                {
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    const __m128 volumeV = _mm_set1_ps(volume);
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        storeI(out + i, _mm_cvttps_epi32(_mm_mul_ps(loadF(in + i), volumeV)));
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out[i] = static_cast<T>(in[i] * volume);
+                    }
+                }
+
+                template<>
+                void volumeKernel(const F32_T* in, F32_T* out, size_t size, float volume)
+                {
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    const __m128 volumeV = _mm_set1_ps(volume);
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), volumeV));
+                        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_loadu_ps(in + i + 4), volumeV));
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out[i] = in[i] * volume;
+                    }
+                }
+
+                template<>
+                void volumeKernel(const F64_T* in, F64_T* out, size_t size, float volume)
+                {
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    const __m128d volumeV = _mm_set1_pd(volume);
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), volumeV));
+                        _mm_storeu_pd(out + i + 2, _mm_mul_pd(_mm_loadu_pd(in + i + 2), volumeV));
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out[i] = in[i] * volume;
+                    }
+                }
+
+            } // namespace
+
             std::shared_ptr<Data> Data::convert(const std::shared_ptr<Data> & data, Type type)
             {
-                const Type dataType = data->getType();
+                const uint8_t channelCount = data->getChannelCount();
                 const size_t sampleCount = data->getSampleCount();
-                const size_t channelCount = static_cast<size_t>(data->getChannelCount());
                 auto out = Data::create(Info(channelCount, type, data->getSampleRate(), sampleCount));
-                if (dataType == type)
+                convert(data->getData(), data->getType(), channelCount, out->getData(), type, channelCount, sampleCount);
+                return out;
+            }
+
+            void Data::convert(
+                const uint8_t* in,
+                Type           inType,
+                uint8_t        inChannelCount,
+                uint8_t*       out,
+                Type           outType,
+                uint8_t        outChannelCount,
+                size_t         sampleCount,
+                float          volume,
+                const std::vector<int8_t>& channelMap)
+            {
+                bool identity = inChannelCount == outChannelCount;
+                for (size_t c = 0; identity && c < channelMap.size() && c < outChannelCount; ++c)
                 {
-                    memcpy(out->getData(), data->getData(), sampleCount * channelCount * Audio::getByteCount(type));
+                    identity = channelMap[c] == static_cast<int8_t>(c);
                 }
-                else
+                if (identity)
                 {
-                    switch (dataType)
+                    // The channels are contiguous so the whole buffer can be processed
+                    // as a single run of samples.
+                    const size_t size = sampleCount * inChannelCount;
+                    if (1.F == volume)
                     {
-                        case Type::S8:
-                            switch (type)
-                            {
-                            case Type::S16: _CONVERT(S8, S16); break;
-                            case Type::S32: _CONVERT(S8, S32); break;
-                            case Type::F32: _CONVERT(S8, F32); break;
-                            case Type::F64: _CONVERT(S8, F64); break;
-                            default: break;
-                            }
-                            break;
-                        case Type::S16:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(S16, S8);  break;
-                            case Type::S32: _CONVERT(S16, S32); break;
-                            case Type::F32: _CONVERT(S16, F32); break;
-                            case Type::F64: _CONVERT(S16, F64); break;
-                            default: break;
-                            }
-                            break;
-                        case Type::S32:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(S32, S8);  break;
-                            case Type::S16: _CONVERT(S32, S16); break;
-                            case Type::F32: _CONVERT(S32, F32); break;
-                            case Type::F64: _CONVERT(S32, F64); break;
-                            default: break;
-                            }
-                            break;
-                        case Type::F32:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(F32, S8);  break;
-                            case Type::S16: _CONVERT(F32, S16); break;
-                            case Type::S32: _CONVERT(F32, S32); break;
-                            case Type::F64: _CONVERT(F32, F64); break;
-                            default: break;
-                            }
-                            break;
-                        case Type::F64:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(F64, S8);  break;
-                            case Type::S16: _CONVERT(F64, S16); break;
-                            case Type::S32: _CONVERT(F64, S32); break;
-                            case Type::F32: _CONVERT(F64, F32); break;
-                            default: break;
-                            }
-                            break;
-                        default: break;
+                        if (inType == outType)
+                        {
+                            memcpy(out, in, size * Audio::getByteCount(inType));
+                        }
+                        else
+                        {
+                            _TYPE_SWITCH(_CONVERT, inType, outType);
+                        }
+                    }
+                    else if (inType == outType)
+                    {
+                        Data::volume(in, out, volume, sampleCount, inChannelCount, inType);
+                    }
+                    else
+                    {
+                        _TYPE_SWITCH(_CONVERT_VOLUME, inType, outType);
                     }
                 }
-                return out;
+                else
+                {
+                    _TYPE_SWITCH(_REMAP, inType, outType);
+                }
             }
 
             namespace
             {
-                template<typename U>
-                void _planarInterleave(const U * value, U * out, size_t channelCount, size_t size)
+#if defined(DJV_AUDIO_SSE2)
+                template<size_t>
+                struct Shuffle;
+
+                template<>
+                struct Shuffle<1>
                 {
-                    const size_t planeSize = size / channelCount;
-                    for (size_t c = 0; c < channelCount; ++c)
+                    static __m128i interleaveLo(__m128i a, __m128i b) { return _mm_unpacklo_epi8(a, b); }
+                    static __m128i interleaveHi(__m128i a, __m128i b) { return _mm_unpackhi_epi8(a, b); }
+                    static __m128i even(__m128i a, __m128i b)
                     {
-                        const U * inP = value + c * planeSize;
-                        const U * endP = inP + planeSize;
-                        U * outP = out + c;
-                        for (; inP < endP; ++inP, outP += channelCount)
+                        return _mm_packs_epi16(
+                            _mm_srai_epi16(_mm_slli_epi16(a, 8), 8),
+                            _mm_srai_epi16(_mm_slli_epi16(b, 8), 8));
+                    }
+                    static __m128i odd(__m128i a, __m128i b)
+                    {
+                        return _mm_packs_epi16(_mm_srai_epi16(a, 8), _mm_srai_epi16(b, 8));
+                    }
+                };
+
+                template<>
+                struct Shuffle<2>
+                {
+                    static __m128i interleaveLo(__m128i a, __m128i b) { return _mm_unpacklo_epi16(a, b); }
+                    static __m128i interleaveHi(__m128i a, __m128i b) { return _mm_unpackhi_epi16(a, b); }
+                    static __m128i even(__m128i a, __m128i b)
+                    {
+                        return _mm_packs_epi32(
+                            _mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                            _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+                    }
+                    static __m128i odd(__m128i a, __m128i b)
+                    {
+                        return _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+                    }
+                };
+
+                template<>
+                struct Shuffle<4>
+                {
+                    static __m128i interleaveLo(__m128i a, __m128i b) { return _mm_unpacklo_epi32(a, b); }
+                    static __m128i interleaveHi(__m128i a, __m128i b) { return _mm_unpackhi_epi32(a, b); }
+                    static __m128i even(__m128i a, __m128i b)
+                    {
+                        return _mm_castps_si128(_mm_shuffle_ps(
+                            _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+                    }
+                    static __m128i odd(__m128i a, __m128i b)
+                    {
+                        return _mm_castps_si128(_mm_shuffle_ps(
+                            _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+                    }
+                };
+
+                template<>
+                struct Shuffle<8>
+                {
+                    static __m128i interleaveLo(__m128i a, __m128i b) { return _mm_unpacklo_epi64(a, b); }
+                    static __m128i interleaveHi(__m128i a, __m128i b) { return _mm_unpackhi_epi64(a, b); }
+                    static __m128i even(__m128i a, __m128i b) { return _mm_unpacklo_epi64(a, b); }
+                    static __m128i odd(__m128i a, __m128i b) { return _mm_unpackhi_epi64(a, b); }
+                };
+#endif // DJV_AUDIO_SSE2
+
+                template<typename T>
+                void interleave2(const T* in0, const T* in1, T* out, size_t sampleCount)
+                {
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    const size_t step = 16 / sizeof(T);
+                    for (; i + step <= sampleCount; i += step)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + i));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + i));
+                        __m128i* outP = reinterpret_cast<__m128i*>(out + i * 2);
+                        _mm_storeu_si128(outP, Shuffle<sizeof(T)>::interleaveLo(a, b));
+                        _mm_storeu_si128(outP + 1, Shuffle<sizeof(T)>::interleaveHi(a, b));
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < sampleCount; ++i)
+                    {
+                        out[i * 2] = in0[i];
+                        out[i * 2 + 1] = in1[i];
+                    }
+                }
+
+                template<typename T>
+                void deinterleave2(const T* in, T* out0, T* out1, size_t sampleCount)
+                {
+                    size_t i = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    const size_t step = 16 / sizeof(T);
+                    for (; i + step <= sampleCount; i += step)
+                    {
+                        const __m128i* inP = reinterpret_cast<const __m128i*>(in + i * 2);
+                        const __m128i a = _mm_loadu_si128(inP);
+                        const __m128i b = _mm_loadu_si128(inP + 1);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out0 + i), Shuffle<sizeof(T)>::even(a, b));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out1 + i), Shuffle<sizeof(T)>::odd(a, b));
+                    }
+#endif // DJV_AUDIO_SSE2
+                    for (; i < sampleCount; ++i)
+                    {
+                        out0[i] = in[i * 2];
+                        out1[i] = in[i * 2 + 1];
+                    }
+                }
+
+                template<typename T>
+                void planarDeinterleaveKernel(const T* value, T* out, size_t sampleCount, uint8_t channelCount)
+                {
+                    switch (channelCount)
+                    {
+                    case 1:
+                        memcpy(out, value, sampleCount * sizeof(T));
+                        break;
+                    case 2:
+                        deinterleave2(value, out, out + sampleCount, sampleCount);
+                        break;
+                    default:
+                        for (uint8_t c = 0; c < channelCount; ++c)
                         {
-                            *outP = *inP;
+                            const T* inP = value + c;
+                            T* outP = out + c * sampleCount;
+                            for (size_t i = 0; i < sampleCount; ++i, inP += channelCount, ++outP)
+                            {
+                                *outP = *inP;
+                            }
                         }
+                        break;
                     }
                 }
-            }
 
-            std::shared_ptr<Data> Data::planarInterleave(const std::shared_ptr<Data> & data)
-            {
-                auto out = Data::create(data->getInfo());
-                const size_t channelCount = data->getChannelCount();
-                const size_t sampleCount = data->getSampleCount();
-                switch (data->getType())
+                template<typename T>
+                void planarInterleaveData(const Data& data, Data& out)
                 {
-                case Type::S8:
-                    _planarInterleave(reinterpret_cast<const S8_T *> (data->getData()), reinterpret_cast<S8_T *> (out->getData()), channelCount, sampleCount);
-                    break;
-                case Type::S16:
-                    _planarInterleave(reinterpret_cast<const S16_T *>(data->getData()), reinterpret_cast<S16_T *>(out->getData()), channelCount, sampleCount);
-                    break;
-                case Type::S32:
-                    _planarInterleave(reinterpret_cast<const S32_T *>(data->getData()), reinterpret_cast<S32_T *>(out->getData()), channelCount, sampleCount);
-                    break;
-                case Type::F32:
-                    _planarInterleave(reinterpret_cast<const F32_T *>(data->getData()), reinterpret_cast<F32_T *>(out->getData()), channelCount, sampleCount);
-                    break;
-                case Type::F64:
-                    _planarInterleave(reinterpret_cast<const F64_T *>(data->getData()), reinterpret_cast<F64_T *>(out->getData()), channelCount, sampleCount);
-                    break;
-                default: break;
+                    const T* value = reinterpret_cast<const T*>(data.getData());
+                    const size_t sampleCount = data.getSampleCount();
+                    const uint8_t channelCount = data.getChannelCount();
+                    std::vector<const T*> planes(channelCount);
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        planes[c] = value + c * sampleCount;
+                    }
+                    Data::planarInterleave(planes.data(), reinterpret_cast<T*>(out.getData()), sampleCount, channelCount);
                 }
-                return out;
-            }
 
-            namespace
+            } // namespace
+
+            template<typename T>
+            void Data::planarInterleave(const T** value, T* out, size_t sampleCount, uint8_t channelCount)
             {
-                template<typename T>
-                void _planarDeinterleave(const T* value, T* out, uint8_t channelCount, size_t size)
+                switch (channelCount)
                 {
-                    const size_t planeSize = size / channelCount;
+                case 1:
+                    memcpy(out, value[0], sampleCount * sizeof(T));
+                    break;
+                case 2:
+                    interleave2(value[0], value[1], out, sampleCount);
+                    break;
+                default:
                     for (uint8_t c = 0; c < channelCount; ++c)
                     {
-                        const T* inP = value + c;
-                        T* outP = out + c * planeSize;
-                        for (size_t i = 0; i < planeSize; ++i, inP += channelCount, ++outP)
+                        const T* inP = value[c];
+                        const T* endP = inP + sampleCount;
+                        T* outP = out + c;
+                        for (; inP < endP; ++inP, outP += channelCount)
                         {
                             *outP = *inP;
                         }
                     }
+                    break;
+                }
+            }
+
+            template void Data::planarInterleave(const S8_T**, S8_T*, size_t, uint8_t);
+            template void Data::planarInterleave(const S16_T**, S16_T*, size_t, uint8_t);
+            template void Data::planarInterleave(const S32_T**, S32_T*, size_t, uint8_t);
+            template void Data::planarInterleave(const F32_T**, F32_T*, size_t, uint8_t);
+            template void Data::planarInterleave(const F64_T**, F64_T*, size_t, uint8_t);
+
+            std::shared_ptr<Data> Data::planarInterleave(const std::shared_ptr<Data> & data)
+            {
+                auto out = Data::create(data->getInfo());
+                switch (data->getType())
+                {
+                case Type::S8:  planarInterleaveData<S8_T> (*data, *out); break;
+                case Type::S16: planarInterleaveData<S16_T>(*data, *out); break;
+                case Type::S32: planarInterleaveData<S32_T>(*data, *out); break;
+                case Type::F32: planarInterleaveData<F32_T>(*data, *out); break;
+                case Type::F64: planarInterleaveData<F64_T>(*data, *out); break;
+                default: break;
                 }
+                return out;
             }
 
             std::shared_ptr<Data> Data::planarDeinterleave(const std::shared_ptr<Data> & data)
@@ -232,19 +916,19 @@ namespace djv
                 switch (data->getType())
                 {
                 case Type::S8:
-                    _planarDeinterleave(reinterpret_cast<const S8_T *> (data->getData()), reinterpret_cast<S8_T *> (out->getData()), channelCount, sampleCount);
+                    planarDeinterleaveKernel(reinterpret_cast<const S8_T *> (data->getData()), reinterpret_cast<S8_T *> (out->getData()), sampleCount, channelCount);
                     break;
                 case Type::S16:
-                    _planarDeinterleave(reinterpret_cast<const S16_T *>(data->getData()), reinterpret_cast<S16_T *>(out->getData()), channelCount, sampleCount);
+                    planarDeinterleaveKernel(reinterpret_cast<const S16_T *>(data->getData()), reinterpret_cast<S16_T *>(out->getData()), sampleCount, channelCount);
                     break;
                 case Type::S32:
-                    _planarDeinterleave(reinterpret_cast<const S32_T *>(data->getData()), reinterpret_cast<S32_T *>(out->getData()), channelCount, sampleCount);
+                    planarDeinterleaveKernel(reinterpret_cast<const S32_T *>(data->getData()), reinterpret_cast<S32_T *>(out->getData()), sampleCount, channelCount);
                     break;
                 case Type::F32:
-                    _planarDeinterleave(reinterpret_cast<const F32_T *>(data->getData()), reinterpret_cast<F32_T *>(out->getData()), channelCount, sampleCount);
+                    planarDeinterleaveKernel(reinterpret_cast<const F32_T *>(data->getData()), reinterpret_cast<F32_T *>(out->getData()), sampleCount, channelCount);
                     break;
                 case Type::F64:
-                    _planarDeinterleave(reinterpret_cast<const F64_T *>(data->getData()), reinterpret_cast<F64_T *>(out->getData()), channelCount, sampleCount);
+                    planarDeinterleaveKernel(reinterpret_cast<const F64_T *>(data->getData()), reinterpret_cast<F64_T *>(out->getData()), sampleCount, channelCount);
                     break;
                 default: break;
                 }
@@ -253,13 +937,14 @@ namespace djv
 
             void Data::volume(const uint8_t* in, uint8_t* out, float volume, size_t sampleCount, uint8_t channelCount, Type type)
             {
+                const size_t size = sampleCount * channelCount;
                 switch (type)
                 {
-                case Type::S8:  _VOLUME(S8);  break;
-                case Type::S16: _VOLUME(S16); break;
-                case Type::S32: _VOLUME(S32); break;
-                case Type::F32: _VOLUME(F32); break;
-                case Type::F64: _VOLUME(F64); break;
+                case Type::S8:  volumeKernel(reinterpret_cast<const S8_T*> (in), reinterpret_cast<S8_T*> (out), size, volume); break;
+                case Type::S16: volumeKernel(reinterpret_cast<const S16_T*>(in), reinterpret_cast<S16_T*>(out), size, volume); break;
+                case Type::S32: volumeKernel(reinterpret_cast<const S32_T*>(in), reinterpret_cast<S32_T*>(out), size, volume); break;
+                case Type::F32: volumeKernel(reinterpret_cast<const F32_T*>(in), reinterpret_cast<F32_T*>(out), size, volume); break;
+                case Type::F64: volumeKernel(reinterpret_cast<const F64_T*>(in), reinterpret_cast<F64_T*>(out), size, volume); break;
                 default: break;
                 }
             }
@@ -279,4 +964,3 @@ namespace djv
         } // namespace Audio
     } // namespace AV
 } // namespace djv
-
@@ -32,6 +32,7 @@
 #include <djvAV/Audio.h>
 
 #include <memory>
+#include <vector>
 
 namespace djv
 {
@@ -91,6 +92,21 @@ namespace djv
 
                 static std::shared_ptr<Data> convert(const std::shared_ptr<Data>&, Type);
 
+                //! Convert the type, scale the volume, and remap the channels of
+                //! interleaved samples in a single pass. The channel map provides the
+                //! input channel for each output channel, or -1 for silence. An empty
+                //! channel map passes the channels through in order.
+                static void convert(
+                    const uint8_t* in,
+                    Type           inType,
+                    uint8_t        inChannelCount,
+                    uint8_t*       out,
+                    Type           outType,
+                    uint8_t        outChannelCount,
+                    size_t         sampleCount,
+                    float          volume = 1.F,
+                    const std::vector<int8_t>& channelMap = std::vector<int8_t>());
+
                 template<typename T>
                 static void extract(const T*, T*, size_t sampleCount, uint8_t inChannelCount, uint8_t outChannelCount);
 
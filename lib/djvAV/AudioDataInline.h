@@ -105,12 +105,12 @@ namespace djv
 
             inline uint8_t * Data::getData(size_t offset)
             {
-                return _data.data();
+                return _data.data() + offset * static_cast<size_t>(_info.channelCount) * Audio::getByteCount(_info.type);
             }
 
             inline const uint8_t * Data::getData(size_t offset) const
             {
-                return _data.data();
+                return _data.data() + offset * static_cast<size_t>(_info.channelCount) * Audio::getByteCount(_info.type);
             }
 
             template<typename T>
@@ -146,42 +146,6 @@ namespace djv
                 }
             }
 
-            template<typename T>
-            inline void Data::planarInterleave(const T** value, T* out, size_t sampleCount, uint8_t channelCount)
-            {
-                switch (channelCount)
-                {
-                case 1:
-                    memcpy(out, value[0], sampleCount * channelCount * sizeof(T));
-                    break;
-                case 2:
-                {
-                    const T* inP0 = value[0];
-                    const T* inP1 = value[1];
-                    T* outP = out;
-                    T* const endP = out + sampleCount * channelCount;
-                    for (; outP < endP; outP += 2, ++inP0, ++inP1)
-                    {
-                        outP[0] = inP0[0];
-                        outP[1] = inP1[0];
-                    }
-                    break;
-                }
-                default:
-                    for (uint8_t c = 0; c < channelCount; ++c)
-                    {
-                        const T* inP = value[c];
-                        const T* endP = inP + sampleCount;
-                        T* outP = out + c;
-                        for (; inP < endP; ++inP, outP += channelCount)
-                        {
-                            *outP = *inP;
-                        }
-                    }
-                    break;
-                }
-            }
-
         } // namespace Audio
     } // namespace AV
 } // namespace djv
@@ -0,0 +1,350 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/AudioMixer.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/Timer.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t blockSampleCount = 256;
+                const size_t ringSampleCount  = 8192;
+
+                struct Source
+                {
+                    std::shared_ptr<IO::IRead> read;
+                    size_t track = 0;
+                    Info info;
+                    float gain = 1.F;
+                    std::vector<int8_t> channelMap;
+                    std::deque<std::shared_ptr<Data> > pending;
+                    size_t pendingOffset = 0;
+                    size_t pendingCount = 0;
+                    bool finished = false;
+                };
+
+            } // namespace
+
+            struct Mixer::Private
+            {
+                Info info;
+                std::vector<Source> sources;
+                mutable std::mutex mutex;
+                std::vector<F32_T> ring;
+                std::atomic<size_t> ringRead;
+                std::atomic<size_t> ringWrite;
+                std::vector<F32_T> scratch;
+                std::atomic<bool> active;
+                std::atomic<bool> running;
+                std::thread thread;
+            };
+
+            void Mixer::_init(uint8_t channelCount, size_t sampleRate)
+            {
+                DJV_PRIVATE_PTR();
+                p.info = Info(channelCount, Type::F32, sampleRate, 0);
+                p.ring.resize(ringSampleCount * static_cast<size_t>(channelCount));
+                p.scratch.resize(blockSampleCount * static_cast<size_t>(channelCount));
+                p.ringRead = 0;
+                p.ringWrite = 0;
+                p.active = false;
+                p.running = true;
+                p.thread = std::thread(
+                    [this]
+                {
+                    DJV_PRIVATE_PTR();
+                    const auto timeout = Time::getMilliseconds(Time::TimerValue::VeryFast);
+                    while (p.running)
+                    {
+                        if (p.active)
+                        {
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            while (p.running && p.active && _mix())
+                                ;
+                        }
+                        std::this_thread::sleep_for(timeout);
+                    }
+                });
+            }
+
+            Mixer::Mixer() :
+                _p(new Private)
+            {}
+
+            Mixer::~Mixer()
+            {
+                DJV_PRIVATE_PTR();
+                p.running = false;
+                if (p.thread.joinable())
+                {
+                    p.thread.join();
+                }
+            }
+
+            std::shared_ptr<Mixer> Mixer::create(uint8_t channelCount, size_t sampleRate)
+            {
+                auto out = std::shared_ptr<Mixer>(new Mixer);
+                out->_init(channelCount, sampleRate);
+                return out;
+            }
+
+            Info Mixer::getInfo() const
+            {
+                return _p->info;
+            }
+
+            size_t Mixer::getSourceCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.sources.size();
+            }
+
+            size_t Mixer::addSource(const std::shared_ptr<IO::IRead>& read, size_t track, const Info& info)
+            {
+                DJV_PRIVATE_PTR();
+                if (info.sampleRate != p.info.sampleRate)
+                {
+                    throw std::invalid_argument(DJV_TEXT("The audio sample rate does not match the mixer."));
+                }
+                std::lock_guard<std::mutex> lock(p.mutex);
+                Source source;
+                source.read = read;
+                source.track = track;
+                source.info = info;
+                p.sources.push_back(std::move(source));
+                return p.sources.size() - 1;
+            }
+
+            void Mixer::clearSources()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.sources.clear();
+            }
+
+            float Mixer::getGain(size_t index) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return index < p.sources.size() ? p.sources[index].gain : 0.F;
+            }
+
+            void Mixer::setGain(size_t index, float value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (index < p.sources.size())
+                {
+                    p.sources[index].gain = value;
+                }
+            }
+
+            std::vector<int8_t> Mixer::getChannelMap(size_t index) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return index < p.sources.size() ? p.sources[index].channelMap : std::vector<int8_t>();
+            }
+
+            void Mixer::setChannelMap(size_t index, const std::vector<int8_t>& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (index < p.sources.size())
+                {
+                    p.sources[index].channelMap = value;
+                }
+            }
+
+            bool Mixer::isActive() const
+            {
+                return _p->active;
+            }
+
+            void Mixer::setActive(bool value)
+            {
+                _p->active = value;
+            }
+
+            void Mixer::reset()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                for (auto& i : p.sources)
+                {
+                    i.pending.clear();
+                    i.pendingOffset = 0;
+                    i.pendingCount = 0;
+                    i.finished = false;
+                }
+                p.ringRead = 0;
+                p.ringWrite = 0;
+            }
+
+            size_t Mixer::getAvailable() const
+            {
+                DJV_PRIVATE_PTR();
+                return p.ringWrite.load(std::memory_order_acquire) - p.ringRead.load(std::memory_order_acquire);
+            }
+
+            size_t Mixer::read(F32_T* out, size_t sampleCount, float volume)
+            {
+                DJV_PRIVATE_PTR();
+                const size_t read  = p.ringRead.load(std::memory_order_relaxed);
+                const size_t write = p.ringWrite.load(std::memory_order_acquire);
+                const size_t size  = std::min(sampleCount, write - read);
+                const size_t offset = read % ringSampleCount;
+                const size_t size0 = std::min(size, ringSampleCount - offset);
+                const uint8_t channelCount = p.info.channelCount;
+                Data::volume(
+                    reinterpret_cast<const uint8_t*>(p.ring.data() + offset * channelCount),
+                    reinterpret_cast<uint8_t*>(out),
+                    volume,
+                    size0,
+                    channelCount,
+                    Type::F32);
+                if (size > size0)
+                {
+                    Data::volume(
+                        reinterpret_cast<const uint8_t*>(p.ring.data()),
+                        reinterpret_cast<uint8_t*>(out + size0 * channelCount),
+                        volume,
+                        size - size0,
+                        channelCount,
+                        Type::F32);
+                }
+                p.ringRead.store(read + size, std::memory_order_release);
+                return size;
+            }
+
+            bool Mixer::_mix()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.sources.empty())
+                {
+                    return false;
+                }
+                const size_t write = p.ringWrite.load(std::memory_order_relaxed);
+                const size_t read  = p.ringRead.load(std::memory_order_acquire);
+                if (ringSampleCount - (write - read) < blockSampleCount)
+                {
+                    return false;
+                }
+
+                // Pull audio from the queues until every source can fill a block.
+                // Sources that have reached the end of their queue contribute
+                // silence so they don't stall the other sources.
+                bool ready = true;
+                bool finished = true;
+                for (auto& i : p.sources)
+                {
+                    if (i.pendingCount < blockSampleCount)
+                    {
+                        std::lock_guard<std::mutex> lock(i.read->getMutex());
+                        auto& queue = i.read->getAudioTrackQueue(i.track);
+                        while (!queue.isEmpty() && i.pendingCount < blockSampleCount)
+                        {
+                            const auto frame = queue.popFrame();
+                            if (frame.audio && frame.audio->getSampleCount())
+                            {
+                                i.pendingCount += frame.audio->getSampleCount();
+                                i.pending.push_back(frame.audio);
+                            }
+                        }
+                        i.finished = queue.isEmpty() && queue.isFinished();
+                    }
+                    ready &= i.pendingCount >= blockSampleCount || i.finished;
+                    finished &= 0 == i.pendingCount && i.finished;
+                }
+                if (!ready || finished)
+                {
+                    return false;
+                }
+
+                // Convert each source and add it to the output block.
+                const uint8_t channelCount = p.info.channelCount;
+                F32_T* out = p.ring.data() + (write % ringSampleCount) * channelCount;
+                std::fill(out, out + blockSampleCount * channelCount, 0.F);
+                for (auto& i : p.sources)
+                {
+                    size_t offset = 0;
+                    while (offset < blockSampleCount && i.pending.size())
+                    {
+                        const auto& data = i.pending.front();
+                        const size_t size = std::min(blockSampleCount - offset, data->getSampleCount() - i.pendingOffset);
+                        Data::convert(
+                            data->getData(i.pendingOffset),
+                            data->getType(),
+                            data->getChannelCount(),
+                            reinterpret_cast<uint8_t*>(p.scratch.data() + offset * channelCount),
+                            Type::F32,
+                            channelCount,
+                            size,
+                            i.gain,
+                            i.channelMap);
+                        offset += size;
+                        i.pendingOffset += size;
+                        i.pendingCount -= size;
+                        if (i.pendingOffset >= data->getSampleCount())
+                        {
+                            i.pending.pop_front();
+                            i.pendingOffset = 0;
+                        }
+                    }
+                    const size_t size = offset * channelCount;
+                    for (size_t j = 0; j < size; ++j)
+                    {
+                        out[j] += p.scratch[j];
+                    }
+                }
+                p.ringWrite.store(write + blockSampleCount, std::memory_order_release);
+                return true;
+            }
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvAV/AudioData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            class IRead;
+
+        } // namespace IO
+
+        namespace Audio
+        {
+            //! This class provides an audio mixer.
+            //!
+            //! The mixer pulls audio from the queues of one or more readers,
+            //! converts each source to 32-bit float with its own gain and channel
+            //! map, and sums the sources into a ring buffer. The mixing happens on
+            //! a background thread so that read() never blocks and can be called
+            //! from the realtime audio callback.
+            class Mixer : public std::enable_shared_from_this<Mixer>
+            {
+                DJV_NON_COPYABLE(Mixer);
+
+            protected:
+                void _init(uint8_t channelCount, size_t sampleRate);
+                Mixer();
+
+            public:
+                ~Mixer();
+
+                //! Create a new mixer.
+                static std::shared_ptr<Mixer> create(uint8_t channelCount, size_t sampleRate);
+
+                //! Get the output information.
+                Info getInfo() const;
+
+                //! \name Sources
+                ///@{
+
+                size_t getSourceCount() const;
+
+                //! Add a source. The source reads from the queue for the given
+                //! audio track (see IO::IRead::getAudioTrackQueue()), so several
+                //! tracks can be mixed from one reader. The source sample rate must
+                //! match the mixer sample rate. Returns the index of the new source.
+                size_t addSource(const std::shared_ptr<IO::IRead>&, size_t track, const Info&);
+                void clearSources();
+
+                float getGain(size_t) const;
+                void setGain(size_t, float);
+
+                //! Get the channel map for a source. Each entry provides the source
+                //! channel for an output channel, or -1 for silence.
+                std::vector<int8_t> getChannelMap(size_t) const;
+                void setChannelMap(size_t, const std::vector<int8_t>&);
+
+                ///@}
+
+                //! \name Mixing
+                ///@{
+
+                bool isActive() const;
+                void setActive(bool);
+
+                //! Discard all pending and mixed audio. This should only be called
+                //! while the audio stream is stopped.
+                void reset();
+
+                //! Get the number of mixed samples that are ready to be read.
+                size_t getAvailable() const;
+
+                //! Copy mixed samples to the given buffer and return the number of
+                //! samples copied. This function does not block.
+                size_t read(F32_T*, size_t sampleCount, float volume = 1.F);
+
+                ///@}
+
+            private:
+                bool _mix();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
@@ -611,7 +611,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides Cineon image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
@@ -45,6 +45,7 @@ namespace djv
             {
                 static const std::string pluginName = "Cineon";
                 static const std::set<std::string> fileExtensions = { ".cin" };
+                static const std::vector<std::string> magicNumbers = { std::string("\x80\x2a\x5f\xd7", 4), std::string("\xd7\x5f\x2a\x80", 4) };
 
                 //! This enumeration provides the Cineon file color profiles.
                 enum class ColorProfile
@@ -223,7 +224,7 @@ namespace djv
 
                     static std::shared_ptr<Image::Image> readImage(
                         const Info&,
-                        Core::FileSystem::FileIO&);
+                        const std::shared_ptr<Core::FileSystem::FileIO>&);
 
                 protected:
                     Info _readInfo(const std::string &) override;
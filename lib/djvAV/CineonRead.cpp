@@ -68,36 +68,51 @@ namespace djv
                 
                 std::shared_ptr<Image::Image> Read::readImage(
                     const Info& info,
-                    FileSystem::FileIO& io)
+                    const std::shared_ptr<FileSystem::FileIO>& io)
                 {
+                    std::shared_ptr<Image::Image> out;
+                    const size_t fileDataByteCount = io->getSize() - io->getPos();
 #if defined(DJV_MMAP)
-                    auto out = Image::Image::create(info.video[0].info, io);
-#else // DJV_MMAP
-                    auto infoTmp = info;
-                    bool convertEndian = false;
-                    if (infoTmp.video[0].info.layout.endian != Memory::getEndian())
+                    // Use the memory-mapped file data directly when the file
+                    // contains the complete image. The data is left in the file
+                    // endian, the byte swapping is handled when the image is
+                    // uploaded to the GPU.
+                    if (fileDataByteCount >= info.video[0].info.getDataByteCount())
                     {
-                        convertEndian = true;
-                        infoTmp.video[0].info.layout.endian = Memory::getEndian();
+                        out = Image::Image::create(info.video[0].info, io);
                     }
-                    auto out = Image::Image::create(infoTmp.video[0].info);
-                    io.read(out->getData(), io.getSize() - io.getPos());
-                    if (convertEndian)
+#endif // DJV_MMAP
+                    if (!out)
                     {
+                        auto imageInfo = info.video[0].info;
+                        bool convertEndian = false;
+                        if (imageInfo.layout.endian != Memory::getEndian())
+                        {
+                            convertEndian = true;
+                            imageInfo.layout.endian = Memory::getEndian();
+                        }
+                        out = Image::Image::create(imageInfo);
                         const size_t dataByteCount = out->getDataByteCount();
-                        switch (Image::getDataType(infoTmp.video[0].info.type))
+                        if (fileDataByteCount < dataByteCount)
                         {
-                            case Image::DataType::U10:
-                                Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                break;
-                            case Image::DataType::U16:
-                                Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                break;
-                            default: break;                            
+                            out->zero();
+                        }
+                        io->read(out->getData(), std::min(fileDataByteCount, dataByteCount));
+                        if (convertEndian)
+                        {
+                            switch (Image::getDataType(imageInfo.type))
+                            {
+                                case Image::DataType::U10:
+                                    Memory::endian(out->getData(), dataByteCount / 4, 4);
+                                    break;
+                                case Image::DataType::U16:
+                                    Memory::endian(out->getData(), dataByteCount / 2, 2);
+                                    break;
+                                default: break;
+                            }
                         }
                     }
-#endif // DJV_MMAP
-                    out->setTags(infoTmp.tags);
+                    out->setTags(info.tags);
                     return out;
                 }
 
@@ -109,8 +124,8 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
-                    FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
+                    auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                    const auto info = _open(fileName, *io);
                     auto out = readImage(info, io);
                     out->setPluginName(pluginName);
                     return out;
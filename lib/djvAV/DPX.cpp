@@ -875,7 +875,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides DPX image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
@@ -48,6 +48,7 @@ namespace djv
             {
                 static const std::string pluginName = "DPX";
                 static const std::set<std::string> fileExtensions = { ".dpx" };
+                static const std::vector<std::string> magicNumbers = { "SDPX", "XPDS" };
 
                 //! This enumeration provides the DPX file format versions.
                 enum class Version
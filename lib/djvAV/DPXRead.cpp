@@ -77,8 +77,8 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
-                    FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
+                    auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                    const auto info = _open(fileName, *io);
                     auto out = Cineon::Read::readImage(info, io);
                     out->setPluginName(pluginName);
                     return out;
@@ -157,6 +157,12 @@ namespace djv
                     return Read::create(fileInfo, options, p.options, _resourceSystem, _logSystem);
                 }
 
+                std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info& info, const WriteOptions& options) const
+                {
+                    DJV_PRIVATE_PTR();
+                    return Write::create(fileInfo, info, options, p.options, _resourceSystem, _logSystem);
+                }
+
             } // namespace FFmpeg
         } // namespace IO
     } // namespace AV
@@ -166,6 +172,10 @@ namespace djv
         picojson::value out(picojson::object_type, true);
         {
             out.get<picojson::object>()["ThreadCount"] = toJSON(value.threadCount);
+            out.get<picojson::object>()["Codec"] = toJSON(value.codec);
+            out.get<picojson::object>()["BitRate"] = toJSON(value.bitRate);
+            out.get<picojson::object>()["GOPSize"] = toJSON(value.gopSize);
+            out.get<picojson::object>()["PixelFormat"] = toJSON(value.pixelFormat);
         }
         return out;
     }
@@ -180,6 +190,22 @@ namespace djv
                 {
                     fromJSON(i.second, out.threadCount);
                 }
+                else if ("Codec" == i.first)
+                {
+                    fromJSON(i.second, out.codec);
+                }
+                else if ("BitRate" == i.first)
+                {
+                    fromJSON(i.second, out.bitRate);
+                }
+                else if ("GOPSize" == i.first)
+                {
+                    fromJSON(i.second, out.gopSize);
+                }
+                else if ("PixelFormat" == i.first)
+                {
+                    fromJSON(i.second, out.pixelFormat);
+                }
             }
         }
         else
@@ -32,6 +32,7 @@
 #include <djvAV/IO.h>
 
 #include <djvCore/Frame.h>
+#include <djvCore/Timer.h>
 
 #if defined(DJV_PLATFORM_LINUX)
 #define __STDC_CONSTANT_MACROS
@@ -43,6 +44,10 @@ extern "C"
 
 } // extern "C"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+
 namespace djv
 {
     namespace AV
@@ -66,13 +71,60 @@ namespace djv
 
                 std::string getErrorString(int);
 
+                //! This class provides a bounded queue between pipeline threads.
+                template<typename T>
+                class PipelineQueue
+                {
+                public:
+                    explicit PipelineQueue(size_t max);
+
+                    size_t getCount() const;
+                    size_t getMax() const;
+
+                    //! Add a value without waiting for room in the queue.
+                    void add(T&&);
+
+                    //! Wait for room in the queue and add a value. Returns false if
+                    //! the cancel callback returned true before there was room.
+                    bool push(T&&, const std::function<bool(void)>& cancel);
+
+                    //! Wait for a value and remove it from the queue. Returns false if
+                    //! the cancel callback returned true before a value was available.
+                    bool pop(T&, const std::function<bool(void)>& cancel);
+
+                    void clear();
+
+                private:
+                    const size_t _max = 0;
+                    std::deque<T> _values;
+                    mutable std::mutex _mutex;
+                    std::condition_variable _cv;
+                };
+
                 //! This struct provides the FFmpeg file I/O optioms.
                 struct Options
                 {
-                    size_t threadCount = 4;
+                    size_t      threadCount = 4;
+                    std::string codec;                   //!< Encoder name, empty for the file format default
+                    size_t      bitRate     = 20000000;  //!< Encoder bit rate in bits per second
+                    size_t      gopSize     = 24;        //!< Encoder GOP size in frames
+                    std::string pixelFormat = "yuv420p"; //!< Encoder pixel format name
                 };
 
                 //! This class provides the FFmpeg file reader.
+                //!
+                //! Video is read with a pipeline of three threads connected by
+                //! bounded queues: demuxing (which also decodes audio), decoding,
+                //! and conversion. Planar YUV frames are copied as decoded and
+                //! converted to RGB when they are displayed, other formats are
+                //! converted to RGBA by the software scaler on the conversion thread.
+                //! When more than one audio track is decoded the demuxer routes
+                //! the packets to a decoder and queue for each track.
+                //!
+                //! Reverse playback decodes each GOP forward once, stages the decoded
+                //! frames, and passes them on in reverse order. The decoding
+                //! thread works on the previous GOP while the current one is being
+                //! converted.
                 class Read : public IRead
                 {
                     DJV_NON_COPYABLE(Read);
@@ -103,21 +155,80 @@ namespace djv
                     void seek(int64_t, Direction) override;
 
                 private:
-                    struct DecodeVideo
-                    {
-                        AVPacket*           packet       = nullptr;
-                        Core::Frame::Number seek         = -1;
-                        bool                cacheEnabled = false;
-                    };
-                    int _decodeVideo(const DecodeVideo&, Core::Frame::Number&);
+                    bool _demuxReverse();
+                    void _endReverseGOP();
+                    void _decodeVideoThread();
+                    int _decodeVideo(
+                        AVFrame*,
+                        AVPacket*,
+                        Core::Frame::Number seek,
+                        Core::Frame::Number reverseEnd,
+                        size_t epoch);
+                    void _convertVideoThread();
+                    bool _addVideoFrame(const AVFrame*, Core::Frame::Number, size_t epoch);
+                    void _convertVideo(const AVFrame*, const std::shared_ptr<Image::Image>&);
 
                     struct DecodeAudio
                     {
+                        int                 stream = -1;
                         AVPacket*           packet = nullptr;
                         Core::Frame::Number seek   = -1;
                     };
                     int _decodeAudio(const DecodeAudio&, Core::Frame::Number&);
 
+                    //! The mutex must be locked when calling this function.
+                    void _clearAudioQueues(bool finished);
+
+                    DJV_PRIVATE();
+                };
+
+                //! This class provides the FFmpeg file writer.
+                //!
+                //! Video is written with two threads connected by a bounded queue:
+                //! conversion and encoding. Images are converted to the encoder
+                //! pixel format while the previous frames are being encoded. Planar
+                //! YUV formats use a vectorized converter that runs in parallel
+                //! slices, other formats use the software scaler. Encoders that
+                //! support it use frame threading.
+                //!
+                //! Destroying the writer finishes the video queue and waits for
+                //! the queued frames to be encoded and the file to be completed.
+                //!
+                //! \todo Add support for writing audio.
+                class Write : public IWrite
+                {
+                    DJV_NON_COPYABLE(Write);
+
+                protected:
+                    void _init(
+                        const Core::FileSystem::FileInfo&,
+                        const Info&,
+                        const WriteOptions&,
+                        const Options&,
+                        const std::shared_ptr<Core::ResourceSystem>&,
+                        const std::shared_ptr<Core::LogSystem>&);
+                    Write();
+
+                public:
+                    ~Write() override;
+
+                    static std::shared_ptr<Write> create(
+                        const Core::FileSystem::FileInfo&,
+                        const Info&,
+                        const WriteOptions&,
+                        const Options&,
+                        const std::shared_ptr<Core::ResourceSystem>&,
+                        const std::shared_ptr<Core::LogSystem>&);
+
+                    bool isRunning() const override;
+
+                private:
+                    void _convertThread();
+                    void _encodeThread();
+                    std::shared_ptr<AVFrame> _convert(const std::shared_ptr<Image::Image>&, size_t threadCount);
+                    void _encode(const AVFrame*);
+                    void _close();
+
                     DJV_PRIVATE();
                 };
 
@@ -138,6 +249,7 @@ namespace djv
                     void setOptions(const picojson::value&) override;
 
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
+                    std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info&, const WriteOptions&) const override;
 
                 private:
                     DJV_PRIVATE();
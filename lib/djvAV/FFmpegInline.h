@@ -35,6 +35,83 @@ namespace djv
         {
             namespace FFmpeg
             {
+                template<typename T>
+                inline PipelineQueue<T>::PipelineQueue(size_t max) :
+                    _max(max)
+                {}
+
+                template<typename T>
+                inline size_t PipelineQueue<T>::getCount() const
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _values.size();
+                }
+
+                template<typename T>
+                inline size_t PipelineQueue<T>::getMax() const
+                {
+                    return _max;
+                }
+
+                template<typename T>
+                inline void PipelineQueue<T>::add(T&& value)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _values.push_back(std::move(value));
+                    }
+                    _cv.notify_all();
+                }
+
+                template<typename T>
+                inline bool PipelineQueue<T>::push(T&& value, const std::function<bool(void)>& cancel)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        while (_values.size() >= _max)
+                        {
+                            if (cancel())
+                            {
+                                return false;
+                            }
+                            _cv.wait_for(lock, Core::Time::getMilliseconds(Core::Time::TimerValue::Fast));
+                        }
+                        _values.push_back(std::move(value));
+                    }
+                    _cv.notify_all();
+                    return true;
+                }
+
+                template<typename T>
+                inline bool PipelineQueue<T>::pop(T& value, const std::function<bool(void)>& cancel)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        while (_values.empty())
+                        {
+                            if (cancel())
+                            {
+                                return false;
+                            }
+                            _cv.wait_for(lock, Core::Time::getMilliseconds(Core::Time::TimerValue::Fast));
+                        }
+                        value = std::move(_values.front());
+                        _values.pop_front();
+                    }
+                    _cv.notify_all();
+                    return true;
+                }
+
+                template<typename T>
+                inline void PipelineQueue<T>::clear()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _values.clear();
+                    }
+                    _cv.notify_all();
+                }
+
             } // namespace FFmpeg
         } // namespace IO
     } // namespace AV
@@ -31,6 +31,7 @@
 
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
 
@@ -39,10 +40,17 @@ extern "C"
 #include <libavformat/avformat.h>
 #include <libavutil/dict.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 
 } // extern "C"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -53,6 +61,206 @@ namespace djv
         {
             namespace FFmpeg
             {
+                namespace
+                {
+                    //! \todo Should this be configurable?
+                    const size_t packetQueueMax      = 32;
+                    const size_t packetQueueAudioMax = 128;
+                    const size_t frameQueueMax       = 4;
+                    const size_t gopQueueMax         = 1;
+                    const size_t reverseGOPByteMax   = Memory::gigabyte;
+                    const size_t throughputTimeout   = 10;
+
+                    //! Packets are tagged with the seek epoch they were read in so that
+                    //! stale packets can be dropped after a seek.
+                    //!
+                    //! In reverse playback the packets carry the range of frames to
+                    //! decode [seek, reverseEnd], and an empty packet with gopEnd set
+                    //! marks the end of the range.
+                    struct Packet
+                    {
+                        std::shared_ptr<AVPacket> packet;
+                        size_t epoch = 0;
+                        Frame::Number seek = Frame::invalid;
+                        Frame::Number reverseEnd = Frame::invalid;
+                        bool gopEnd = false;
+                        bool eof = false;
+                    };
+
+                    struct DecodedFrame
+                    {
+                        std::shared_ptr<AVFrame> frame;
+                        Frame::Number number = Frame::invalid;
+                        size_t epoch = 0;
+                    };
+
+                    //! This struct provides an audio track that is being decoded.
+                    struct AudioTrack
+                    {
+                        size_t track = 0;
+                        AudioInfo info;
+                    };
+
+                    //! In reverse playback a GOP is decoded forward once and the
+                    //! decoded frames are staged, then handed to the conversion
+                    //! thread in reverse order. Only a GOP whose decoded frames do
+                    //! not fit in reverseGOPByteMax is split into several ranges.
+                    struct DecodedGOP
+                    {
+                        std::vector<DecodedFrame> frames;
+                        size_t epoch = 0;
+                        bool eof = false;
+                    };
+
+                    std::shared_ptr<AVPacket> createPacket()
+                    {
+                        return std::shared_ptr<AVPacket>(
+                            av_packet_alloc(),
+                            [](AVPacket* value)
+                            {
+                                av_packet_free(&value);
+                            });
+                    }
+
+                    std::shared_ptr<AVFrame> createFrame()
+                    {
+                        return std::shared_ptr<AVFrame>(
+                            av_frame_alloc(),
+                            [](AVFrame* value)
+                            {
+                                av_frame_free(&value);
+                            });
+                    }
+
+                    Frame::Number timestampToFrame(int64_t value, const AVRational& timeBase, const Time::Speed& speed)
+                    {
+                        AVRational r;
+                        r.num = speed.getDen();
+                        r.den = speed.getNum();
+                        return av_rescale_q(value, timeBase, r);
+                    }
+
+                    int64_t frameToTimestamp(Frame::Number value, const AVRational& timeBase, const Time::Speed& speed)
+                    {
+                        AVRational r;
+                        r.num = speed.getDen();
+                        r.den = speed.getNum();
+                        return av_rescale_q(value, r, timeBase);
+                    }
+
+                    //! Get the image type for pixel formats that can be stored without
+                    //! conversion.
+                    Image::Type getYUVType(AVPixelFormat value)
+                    {
+                        Image::Type out = Image::Type::None;
+                        switch (value)
+                        {
+                        case AV_PIX_FMT_YUV420P:
+                        case AV_PIX_FMT_YUVJ420P:     out = Image::Type::YUV_420P_U8;  break;
+                        case AV_PIX_FMT_YUV422P:
+                        case AV_PIX_FMT_YUVJ422P:     out = Image::Type::YUV_422P_U8;  break;
+                        case AV_PIX_FMT_YUV444P:
+                        case AV_PIX_FMT_YUVJ444P:     out = Image::Type::YUV_444P_U8;  break;
+                        case AV_PIX_FMT_YUV420P10LE: out = Image::Type::YUV_420P_U10; break;
+                        case AV_PIX_FMT_YUV422P10LE: out = Image::Type::YUV_422P_U10; break;
+                        case AV_PIX_FMT_YUV444P10LE: out = Image::Type::YUV_444P_U10; break;
+                        case AV_PIX_FMT_YUV420P16LE: out = Image::Type::YUV_420P_U16; break;
+                        case AV_PIX_FMT_YUV422P16LE: out = Image::Type::YUV_422P_U16; break;
+                        case AV_PIX_FMT_YUV444P16LE: out = Image::Type::YUV_444P_U16; break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                    Image::YUVCoefficients getYUVCoefficients(AVColorSpace value, int height)
+                    {
+                        Image::YUVCoefficients out = height >= 720 ?
+                            Image::YUVCoefficients::BT709 :
+                            Image::YUVCoefficients::BT601;
+                        switch (value)
+                        {
+                        case AVCOL_SPC_BT709:      out = Image::YUVCoefficients::BT709;  break;
+                        case AVCOL_SPC_BT470BG:
+                        case AVCOL_SPC_SMPTE170M:  out = Image::YUVCoefficients::BT601;  break;
+                        case AVCOL_SPC_BT2020_NCL: out = Image::YUVCoefficients::BT2020; break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                    Image::YUVRange getYUVRange(AVColorRange value, AVPixelFormat format)
+                    {
+                        Image::YUVRange out = Image::YUVRange::Video;
+                        switch (format)
+                        {
+                        case AV_PIX_FMT_YUVJ420P:
+                        case AV_PIX_FMT_YUVJ422P:
+                        case AV_PIX_FMT_YUVJ444P: out = Image::YUVRange::Full; break;
+                        default: break;
+                        }
+                        switch (value)
+                        {
+                        case AVCOL_RANGE_MPEG: out = Image::YUVRange::Video; break;
+                        case AVCOL_RANGE_JPEG: out = Image::YUVRange::Full;  break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                    void copyPlanes(const AVFrame* avFrame, const std::shared_ptr<Image::Image>& image)
+                    {
+                        const auto& info = image->getInfo();
+                        const size_t pixelByteCount = info.getPixelByteCount();
+                        for (uint8_t i = 0; i < info.getPlaneCount(); ++i)
+                        {
+                            const Image::Size size = info.getPlaneSize(i);
+                            const size_t byteCount = size.w * pixelByteCount;
+                            const size_t scanlineByteCount = info.getPlaneScanlineByteCount(i);
+                            const uint8_t* src = avFrame->data[i];
+                            uint8_t* dst = image->getPlaneData(i);
+                            for (uint16_t y = 0; y < size.h; ++y)
+                            {
+                                memcpy(dst, src, byteCount);
+                                src += avFrame->linesize[i];
+                                dst += scanlineByteCount;
+                            }
+                        }
+                    }
+
+                    AudioInfo getAudioInfo(AVFormatContext* avFormatContext, AVStream* avAudioStream)
+                    {
+                        size_t sampleCount = 0;
+                        if (avAudioStream->duration != AV_NOPTS_VALUE)
+                        {
+                            sampleCount = avAudioStream->duration;
+                        }
+                        else if (avFormatContext->duration != AV_NOPTS_VALUE)
+                        {
+                            sampleCount = av_rescale_q(
+                                avFormatContext->duration,
+                                av_get_time_base_q(),
+                                avAudioStream->time_base);
+                        }
+                        uint8_t channelCount = avAudioStream->codecpar->channels;
+                        switch (channelCount)
+                        {
+                        case 1:
+                        case 2:
+                        case 6:
+                        case 7:
+                        case 8: break;
+                        default: channelCount = 2; break;
+                        }
+                        return AudioInfo(
+                            Audio::Info(
+                                channelCount,
+                                FFmpeg::toAudioType(static_cast<AVSampleFormat>(avAudioStream->codecpar->format)),
+                                avAudioStream->codecpar->sample_rate,
+                                sampleCount));
+                    }
+
+                } // namespace
+
                 struct Read::Private
                 {
                     Options options;
@@ -66,14 +274,32 @@ namespace djv
                     std::thread thread;
                     std::atomic<bool> running;
 
+                    std::atomic<size_t> epoch;
+                    PipelineQueue<Packet> packetQueue { packetQueueMax };
+                    PipelineQueue<DecodedFrame> frameQueue { frameQueueMax };
+                    PipelineQueue<DecodedGOP> gopQueue { gopQueueMax };
+                    std::atomic<bool> reverse;
+                    Frame::Number reverseEnd = Frame::invalid;
+                    Frame::Number reverseStart = Frame::invalid;
+                    Frame::Number reverseFrameMax = 1;
+                    bool reverseSeek = false;
+                    std::vector<DecodedFrame> reverseStaging;
+                    std::thread decodeThread;
+                    std::thread convertThread;
+                    std::atomic<size_t> demuxCount;
+                    std::atomic<size_t> decodeCount;
+                    std::atomic<size_t> convertCount;
+
                     AVFormatContext * avFormatContext = nullptr;
                     int avVideoStream = -1;
                     int avAudioStream = -1;
+                    std::map<int, AudioTrack> audioTracks;
+                    bool videoEnabled = true;
                     std::map<int, AVCodecParameters *> avCodecParameters;
                     std::map<int, AVCodecContext *> avCodecContext;
                     AVFrame * avFrame = nullptr;
-                    AVFrame * avFrameRgb = nullptr;
-                    SwsContext * swsContext = nullptr;
+                    bool yuv = false;
+                    SwsContext* swsContext = nullptr;
                 };
 
                 void Read::_init(
@@ -87,6 +313,11 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     p.options = options;
                     p.running = true;
+                    p.epoch = 0;
+                    p.reverse = false;
+                    p.demuxCount = 0;
+                    p.decodeCount = 0;
+                    p.convertCount = 0;
                     p.thread = std::thread(
                         [this]
                     {
@@ -121,18 +352,24 @@ namespace djv
                             }
                             av_dump_format(p.avFormatContext, 0, _fileInfo.getFileName().c_str(), 0);
 
-                            // Find the first video and audio stream.
+                            // Find the first video stream and the audio streams.
+                            std::vector<int> avAudioStreams;
                             for (unsigned int i = 0; i < p.avFormatContext->nb_streams; ++i)
                             {
                                 if (-1 == p.avVideoStream && p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
                                 {
                                     p.avVideoStream = i;
                                 }
-                                if (-1 == p.avAudioStream && p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO)
+                                if (p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO)
                                 {
-                                    p.avAudioStream = i;
+                                    avAudioStreams.push_back(i);
                                 }
                             }
+                            if (_options.audioTrack < avAudioStreams.size())
+                            {
+                                p.avAudioStream = avAudioStreams[_options.audioTrack];
+                            }
+                            p.videoEnabled = _options.videoEnabled && p.avVideoStream != -1;
                             if (-1 == p.avVideoStream && -1 == p.avAudioStream)
                             {
                                 std::stringstream ss;
@@ -173,47 +410,86 @@ namespace djv
                                         DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
                                     throw FileSystem::Error(ss.str());
                                 }
-                                p.avCodecContext[p.avVideoStream] = avcodec_alloc_context3(avVideoCodec);
-                                r = avcodec_parameters_to_context(p.avCodecContext[p.avVideoStream], p.avCodecParameters[p.avVideoStream]);
-                                if (r < 0)
+                                if (p.videoEnabled)
                                 {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
-                                        DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
-                                    throw FileSystem::Error(ss.str());
-                                }
-                                p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
-                                p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
-                                r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
-                                if (r < 0)
-                                {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
-                                        DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
-                                    throw FileSystem::Error(ss.str());
-                                }
+                                    p.avCodecContext[p.avVideoStream] = avcodec_alloc_context3(avVideoCodec);
+                                    r = avcodec_parameters_to_context(p.avCodecContext[p.avVideoStream], p.avCodecParameters[p.avVideoStream]);
+                                    if (r < 0)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                            DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                                        throw FileSystem::Error(ss.str());
+                                    }
+                                    // Use frame threading when the codec supports it, the
+                                    // codec falls back to slice threading otherwise.
+                                    p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
+                                    p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+                                    if (avVideoCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS)
+                                    {
+                                        p.avCodecContext[p.avVideoStream]->thread_type |= FF_THREAD_FRAME;
+                                    }
+                                    r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
+                                    if (r < 0)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                            DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                                        throw FileSystem::Error(ss.str());
+                                    }
 
-                                // Initialize the buffers.
-                                p.avFrameRgb = av_frame_alloc();
-
-                                // Initialize the software scaler.
-                                p.swsContext = sws_getContext(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    AV_PIX_FMT_RGBA,
-                                    SWS_BILINEAR,
-                                    0,
-                                    0,
-                                    0);
+                                    // Planar YUV formats are kept as decoded, otherwise
+                                    // initialize the software scaler. The whole frame is
+                                    // converted with one scaler so the chroma is
+                                    // interpolated across the full height.
+                                    const int width = p.avCodecParameters[p.avVideoStream]->width;
+                                    const int height = p.avCodecParameters[p.avVideoStream]->height;
+                                    const auto format = static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format);
+                                    p.yuv = getYUVType(format) != Image::Type::None;
+
+                                    // The number of decoded frames that can be staged
+                                    // for reverse playback.
+                                    const int frameByteCount = av_image_get_buffer_size(format, width, height, 1);
+                                    p.reverseFrameMax = std::max(
+                                        static_cast<Frame::Number>(frameByteCount > 0 ? (reverseGOPByteMax / frameByteCount) : 0),
+                                        static_cast<Frame::Number>(1));
+
+                                    if (!p.yuv)
+                                    {
+                                        p.swsContext = sws_getContext(
+                                            width,
+                                            height,
+                                            format,
+                                            width,
+                                            height,
+                                            AV_PIX_FMT_RGBA,
+                                            SWS_BILINEAR,
+                                            0,
+                                            0,
+                                            0);
+                                        if (!p.swsContext)
+                                        {
+                                            std::stringstream ss;
+                                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                                DJV_TEXT("cannot be opened") << ".";
+                                            throw FileSystem::Error(ss.str());
+                                        }
+                                    }
+                                }
 
                                 // Get information.
-                                const auto pixelDataInfo = Image::Info(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    Image::Type::RGBA_U8);
+                                const auto avCodecParameters = p.avCodecParameters[p.avVideoStream];
+                                const auto format = static_cast<AVPixelFormat>(avCodecParameters->format);
+                                auto pixelDataInfo = Image::Info(
+                                    avCodecParameters->width,
+                                    avCodecParameters->height,
+                                    p.yuv ? getYUVType(format) : Image::Type::RGBA_U8);
+                                if (p.yuv)
+                                {
+                                    pixelDataInfo.layout.endian = Memory::Endian::LSB;
+                                    pixelDataInfo.yuvCoefficients = getYUVCoefficients(avCodecParameters->color_space, avCodecParameters->height);
+                                    pixelDataInfo.yuvRange = getYUVRange(avCodecParameters->color_range, format);
+                                }
                                 if (avVideoStream->duration != AV_NOPTS_VALUE)
                                 {
                                     AVRational r;
@@ -248,86 +524,95 @@ namespace djv
                                 }*/
                             }
 
-                            if (p.avAudioStream != -1)
+                            // Open the codecs for the audio tracks that are decoded. All
+                            // of the tracks are listed so that the other tracks can be
+                            // decoded with ReadOptions::audioTrack or allAudioTracks.
+                            for (size_t track = 0; track < avAudioStreams.size(); ++track)
                             {
-                                // Find the codec for the audio stream.
-                                auto avAudioStream = p.avFormatContext->streams[p.avAudioStream];
+                                const int stream = avAudioStreams[track];
+                                auto avAudioStream = p.avFormatContext->streams[stream];
                                 auto avAudioCodecParameters = avAudioStream->codecpar;
-                                Audio::Type audioType = FFmpeg::toAudioType(static_cast<AVSampleFormat>(avAudioCodecParameters->format));
-                                if (Audio::Type::None == audioType)
-                                {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The audio format") <<
-                                        " '" << FFmpeg::toString(static_cast<AVSampleFormat>(avAudioCodecParameters->format)) << "' " <<
-                                        DJV_TEXT("is not supported") << ".";
-                                    throw FileSystem::Error(ss.str());
-                                }
                                 auto avAudioCodec = avcodec_find_decoder(avAudioCodecParameters->codec_id);
-                                if (!avAudioCodec)
+                                auto audioInfo = getAudioInfo(p.avFormatContext, avAudioStream);
+                                if (avAudioCodec)
                                 {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
-                                        DJV_TEXT("does not match any audio codecs") << ".";
-                                    throw FileSystem::Error(ss.str());
+                                    audioInfo.codec = std::string(avAudioCodec->long_name);
                                 }
-                                p.avCodecParameters[p.avAudioStream] = avcodec_parameters_alloc();
-                                r = avcodec_parameters_copy(p.avCodecParameters[p.avAudioStream], avAudioCodecParameters);
-                                if (r < 0)
+                                if (stream == p.avAudioStream)
                                 {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
-                                        DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
-                                    throw FileSystem::Error(ss.str());
+                                    p.audioInfo = audioInfo;
                                 }
-                                p.avCodecContext[p.avAudioStream] = avcodec_alloc_context3(avAudioCodec);
-                                r = avcodec_parameters_to_context(p.avCodecContext[p.avAudioStream], p.avCodecParameters[p.avAudioStream]);
-                                if (r < 0)
+                                info.audio.push_back(audioInfo);
+                                if (stream != p.avAudioStream && !_options.allAudioTracks)
                                 {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
-                                        DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
-                                    throw FileSystem::Error(ss.str());
+                                    continue;
                                 }
-                                r = avcodec_open2(p.avCodecContext[p.avAudioStream], avAudioCodec, 0);
-                                if (r < 0)
+                                try
                                 {
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
-                                        DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
-                                    throw FileSystem::Error(ss.str());
-                                }
+                                    Audio::Type audioType = FFmpeg::toAudioType(static_cast<AVSampleFormat>(avAudioCodecParameters->format));
+                                    if (Audio::Type::None == audioType)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The audio format") <<
+                                            " '" << FFmpeg::toString(static_cast<AVSampleFormat>(avAudioCodecParameters->format)) << "' " <<
+                                            DJV_TEXT("is not supported") << ".";
+                                        throw FileSystem::Error(ss.str());
+                                    }
+                                    if (!avAudioCodec)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                            DJV_TEXT("does not match any audio codecs") << ".";
+                                        throw FileSystem::Error(ss.str());
+                                    }
+                                    p.avCodecParameters[stream] = avcodec_parameters_alloc();
+                                    r = avcodec_parameters_copy(p.avCodecParameters[stream], avAudioCodecParameters);
+                                    if (r < 0)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                            DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                                        throw FileSystem::Error(ss.str());
+                                    }
+                                    p.avCodecContext[stream] = avcodec_alloc_context3(avAudioCodec);
+                                    r = avcodec_parameters_to_context(p.avCodecContext[stream], p.avCodecParameters[stream]);
+                                    if (r < 0)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                            DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                                        throw FileSystem::Error(ss.str());
+                                    }
+                                    r = avcodec_open2(p.avCodecContext[stream], avAudioCodec, 0);
+                                    if (r < 0)
+                                    {
+                                        std::stringstream ss;
+                                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                            DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                                        throw FileSystem::Error(ss.str());
+                                    }
 
-                                // Get information.
-                                size_t sampleCount = 0;
-                                if (avAudioStream->duration != AV_NOPTS_VALUE)
-                                {
-                                    sampleCount = avAudioStream->duration;
+                                    AudioTrack audioTrack;
+                                    audioTrack.track = track;
+                                    audioTrack.info = audioInfo;
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    p.audioTracks[stream] = audioTrack;
                                 }
-                                else if (p.avFormatContext->duration != AV_NOPTS_VALUE)
+                                catch (const std::exception& e)
                                 {
-                                    sampleCount = av_rescale_q(
-                                        p.avFormatContext->duration,
-                                        av_get_time_base_q(),
-                                        avAudioStream->time_base);
-                                }
-                                uint8_t channelCount = p.avCodecParameters[p.avAudioStream]->channels;
-                                switch (channelCount)
-                                {
-                                case 1:
-                                case 2:
-                                case 6:
-                                case 7:
-                                case 8: break;
-                                default: channelCount = 2; break;
+                                    if (stream == p.avAudioStream)
+                                    {
+                                        throw;
+                                    }
+
+                                    // The other tracks are optional, finish their queues so
+                                    // they don't stall the tracks that can be decoded.
+                                    std::stringstream ss;
+                                    ss << _fileInfo << ": " << DJV_TEXT("audio track") << " " << track << ": " << e.what();
+                                    _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str(), LogLevel::Error);
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    getAudioTrackQueue(track).setFinished(true);
                                 }
-                                p.audioInfo = AudioInfo(
-                                    Audio::Info(
-                                        channelCount,
-                                        audioType,
-                                        p.avCodecParameters[p.avAudioStream]->sample_rate,
-                                        sampleCount));
-                                p.videoInfo.codec = std::string(avAudioCodec->long_name);
-                                info.audio.push_back(p.audioInfo);
                             }
 
                             AVDictionaryEntry* tag = nullptr;
@@ -338,92 +623,119 @@ namespace djv
 
                             p.infoPromise.set_value(info);
 
-                            while (p.running)
+                            if (p.videoEnabled)
                             {
-                                //! \todo Implement me!
-                                /*bool cacheEnabled = false;
-                                size_t cacheMaxByteCount = 0;
-                                {
-                                    std::lock_guard<std::mutex> lock(_mutex);
-                                    cacheEnabled = _cacheEnabled;
-                                    cacheMaxByteCount = _cacheMaxByteCount;
-                                    _cachedFrames = _getCachedFrames(_cache);
-                                }
-                                if (!cacheEnabled)
-                                {
-                                    _cache.clear();
-                                }
-                                if (info.video.size() && _options.layer < info.video.size())
-                                {
-                                    const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
-                                    _cache.setMax(cacheMaxByteCount / dataByteCount);
-                                }
-                                else
-                                {
-                                    _cache.setMax(0);
-                                }*/
+                                p.decodeThread = std::thread(
+                                    [this]
+                                    {
+                                        _decodeVideoThread();
+                                    });
+                                p.convertThread = std::thread(
+                                    [this]
+                                    {
+                                        _convertVideoThread();
+                                    });
+                            }
 
+                            Frame::Number videoSeek = Frame::invalid;
+                            Frame::Number audioSeek = Frame::invalid;
+                            bool demuxFinished = false;
+                            auto throughputTime = std::chrono::steady_clock::now();
+                            while (p.running)
+                            {
                                 bool read = false;
                                 int64_t seek = Frame::invalid;
                                 {
-                                    //const std::vector<Frame::Number> cachedFrames = _cache.getKeys();
                                     std::unique_lock<std::mutex> lock(_mutex);
                                     if (p.queueCV.wait_for(
                                         lock,
                                         Time::getMilliseconds(Time::TimerValue::Fast),
-                                        [this, sequenceSize]
-                                        //[this, sequenceSize, cacheEnabled, &cachedFrames]
+                                        [this, demuxFinished]
                                     {
                                         DJV_PRIVATE_PTR();
-                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
-                                        const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
-
-                                        /*bool cache = false;
-                                        if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
+                                        // Audio may read past the video packet queue size since
+                                        // the video packets are interleaved with the audio.
+                                        const size_t packetCount = p.packetQueue.getCount();
+                                        const bool video = p.videoEnabled && !demuxFinished && packetCount < p.packetQueue.getMax();
+                                        bool audio = false;
+                                        if (packetCount < packetQueueAudioMax)
                                         {
-                                            const size_t cacheMax = _cache.getMax();
-                                            cache |= _cache.getSize() < cacheMax;
-                                            if (_videoQueue.getFrameCount())
+                                            for (const auto& i : p.audioTracks)
                                             {
-                                                const auto& frame = _videoQueue.getFrame();
-                                                for (const auto& i : cachedFrames)
-                                                {
-                                                    if (i < frame.frame || i > frame.frame + cacheMax)
-                                                    {
-                                                        cache = true;
-                                                        break;
-                                                    }
-                                                }
+                                                auto& queue = getAudioTrackQueue(i.second.track);
+                                                audio |= !queue.isFinished() && queue.getCount() < queue.getMax();
                                             }
-                                        }*/
-                                        
+                                        }
                                         return video || audio || p.seek != Frame::invalid || p.direction != _direction;
-                                        //return video || audio || p.seek != Frame::invalid || p.direction != _direction || cache;
                                     }))
                                     {
                                         read = true;
                                         if (p.direction != _direction)
                                         {
                                             p.direction = _direction;
+                                            demuxFinished = false;
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
-                                            _audioQueue.setFinished(false);
-                                            _audioQueue.clearFrames();
+                                            _clearAudioQueues(false);
                                         }
                                         if (p.seek != Frame::invalid)
                                         {
                                             seek = p.seek;
                                             p.seek = Frame::invalid;
+                                            ++p.epoch;
+                                            p.reverse = p.videoEnabled && Direction::Reverse == p.direction;
+                                            p.packetQueue.clear();
+                                            p.frameQueue.clear();
+                                            p.gopQueue.clear();
+                                            demuxFinished = false;
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
-                                            _audioQueue.setFinished(false);
-                                            _audioQueue.clearFrames();
+                                            _clearAudioQueues(p.reverse);
                                         }
                                     }
                                 }
+
+                                const auto now = std::chrono::steady_clock::now();
+                                const float throughputElapsed = std::chrono::duration<float>(now - throughputTime).count();
+                                if (throughputElapsed >= throughputTimeout)
+                                {
+                                    throughputTime = now;
+                                    const size_t demuxCount = p.demuxCount.exchange(0);
+                                    const size_t decodeCount = p.decodeCount.exchange(0);
+                                    const size_t convertCount = p.convertCount.exchange(0);
+                                    if (demuxCount || decodeCount || convertCount)
+                                    {
+                                        std::stringstream ss;
+                                        ss << _fileInfo << ": ";
+                                        ss << "demux " << demuxCount / throughputElapsed << " packets/s, ";
+                                        ss << "decode " << decodeCount / throughputElapsed << " frames/s, ";
+                                        ss << "convert " << convertCount / throughputElapsed << " frames/s, ";
+                                        ss << "queued " << p.packetQueue.getCount() << " packets, ";
+                                        ss << p.frameQueue.getCount() << " frames";
+                                        _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
+                                    }
+                                }
+
                                 AVPacket packet;
                                 try
                                 {
+                                    if (seek != Frame::invalid && p.reverse)
+                                    {
+                                        // Reverse playback starts with the GOP containing
+                                        // the seek frame.
+                                        p.reverseEnd = seek;
+                                        p.reverseStart = Frame::invalid;
+                                        p.reverseSeek = true;
+                                        seek = Frame::invalid;
+                                    }
+                                    if (p.reverse)
+                                    {
+                                        if (read && !demuxFinished)
+                                        {
+                                            demuxFinished = _demuxReverse();
+                                        }
+                                        continue;
+                                    }
                                     if (seek != Frame::invalid)
                                     {
                                         int64_t t = 0;
@@ -446,14 +758,15 @@ namespace djv
                                             t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
                                             //t = av_rescale_q(seek, r, av_get_time_base_q());
                                         }
-                                        if (p.avVideoStream != -1)
-                                        {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                        }
-                                        if (p.avAudioStream != -1)
+
+                                        // The video codec is flushed by the decode thread when it
+                                        // sees the new epoch, frames before the seek are skipped.
+                                        for (const auto& i : p.audioTracks)
                                         {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                                            avcodec_flush_buffers(p.avCodecContext[i.first]);
                                         }
+                                        videoSeek = seek;
+                                        audioSeek = seek;
                                         if (av_seek_frame(
                                             p.avFormatContext,
                                             stream,
@@ -462,89 +775,41 @@ namespace djv
                                         {
                                             throw std::exception();
                                         }
-                                        Frame::Number videoFrame = Frame::invalid;
-                                        Frame::Number audioFrame = Frame::invalid;
-                                        while (videoFrame < seek - 1 || audioFrame < seek - 1)
-                                        {
-                                            if (av_read_frame(p.avFormatContext, &packet) < 0)
-                                            {
-                                                if (p.avVideoStream != -1)
-                                                {
-                                                    DecodeVideo dv;
-                                                    //dv.cacheEnabled = cacheEnabled;
-                                                    dv.seek         = seek;
-                                                    _decodeVideo(dv, videoFrame);
-                                                    avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                                }
-                                                if (p.avAudioStream != -1)
-                                                {
-                                                    DecodeAudio da;
-                                                    da.seek = seek;
-                                                    _decodeAudio(da, audioFrame);
-                                                    avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                                }
-                                                throw std::exception();
-                                            }
-                                            if (p.avVideoStream == packet.stream_index)
-                                            {
-                                                DecodeVideo dv;
-                                                dv.packet       = &packet;
-                                                dv.seek         = seek;
-                                                //dv.cacheEnabled = cacheEnabled;
-                                                if (_decodeVideo(dv, videoFrame) < 0)
-                                                {
-                                                    throw std::exception();
-                                                }
-                                            }
-                                            else if (p.avAudioStream == packet.stream_index)
-                                            {
-                                                DecodeAudio da;
-                                                da.packet = &packet;
-                                                da.seek   = seek;
-                                                if (_decodeAudio(da, audioFrame) < 0)
-                                                {
-                                                    throw std::exception();
-                                                }
-                                            }
-                                            av_packet_unref(&packet);
-                                        }
                                     }
                                     if (read)
                                     {
-                                        Frame::Number videoFrame = Frame::invalid;
                                         Frame::Number audioFrame = Frame::invalid;
                                         int r = av_read_frame(p.avFormatContext, &packet);
                                         if (r < 0)
                                         {
-                                            if (p.avVideoStream != -1)
-                                            {
-                                                DecodeVideo dv;
-                                                //dv.cacheEnabled = cacheEnabled;
-                                                _decodeVideo(dv, videoFrame);
-                                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                            }
-                                            if (p.avAudioStream != -1)
+                                            for (const auto& i : p.audioTracks)
                                             {
                                                 DecodeAudio da;
+                                                da.stream = i.first;
+                                                da.seek   = audioSeek;
                                                 _decodeAudio(da, audioFrame);
-                                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                                                avcodec_flush_buffers(p.avCodecContext[i.first]);
                                             }
                                             throw std::exception();
                                         }
-                                        if (p.avVideoStream == packet.stream_index)
+                                        ++p.demuxCount;
+                                        if (p.videoEnabled && p.avVideoStream == packet.stream_index)
                                         {
-                                            DecodeVideo dv;
-                                            dv.packet       = &packet;
-                                            //dv.cacheEnabled = cacheEnabled;
-                                            if (_decodeVideo(dv, videoFrame) < 0)
-                                            {
-                                                throw std::exception();
-                                            }
+                                            Packet videoPacket;
+                                            videoPacket.packet = createPacket();
+                                            av_packet_move_ref(videoPacket.packet.get(), &packet);
+                                            videoPacket.epoch = p.epoch;
+                                            videoPacket.seek = videoSeek;
+                                            p.packetQueue.add(std::move(videoPacket));
                                         }
-                                        else if (p.avAudioStream == packet.stream_index)
+                                        else if (p.audioTracks.count(packet.stream_index))
                                         {
+                                            // The audio tracks share the demuxer, the packets
+                                            // are routed to the decoder for their stream.
                                             DecodeAudio da;
+                                            da.stream = packet.stream_index;
                                             da.packet = &packet;
+                                            da.seek   = audioSeek;
                                             if (_decodeAudio(da, audioFrame) < 0)
                                             {
                                                 throw std::exception();
@@ -561,10 +826,28 @@ namespace djv
                                         _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
                                     }*/
                                     av_packet_unref(&packet);
+
+                                    // The video queue is finished by the conversion thread once
+                                    // the frames still in the pipeline have been added.
+                                    demuxFinished = true;
+                                    if (p.videoEnabled)
+                                    {
+                                        Packet eofPacket;
+                                        eofPacket.epoch = p.epoch;
+                                        eofPacket.seek = videoSeek;
+                                        eofPacket.eof = true;
+                                        p.packetQueue.add(std::move(eofPacket));
+                                    }
                                     {
                                         std::lock_guard<std::mutex> lock(_mutex);
-                                        _videoQueue.setFinished(true);
-                                        _audioQueue.setFinished(true);
+                                        if (!p.videoEnabled)
+                                        {
+                                            _videoQueue.setFinished(true);
+                                        }
+                                        for (const auto& i : p.audioTracks)
+                                        {
+                                            getAudioTrackQueue(i.second.track).setFinished(true);
+                                        }
                                     }
                                 }
                             }
@@ -574,13 +857,17 @@ namespace djv
                             p.infoPromise.set_value(Info());
                             _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), LogLevel::Error);
                         }
-                        if (p.swsContext)
+                        if (p.decodeThread.joinable())
                         {
-                            sws_freeContext(p.swsContext);
+                            p.decodeThread.join();
                         }
-                        if (p.avFrameRgb)
+                        if (p.convertThread.joinable())
+                        {
+                            p.convertThread.join();
+                        }
+                        if (p.swsContext)
                         {
-                            av_frame_free(&p.avFrameRgb);
+                            sws_freeContext(p.swsContext);
                         }
                         if (p.avFrame)
                         {
@@ -639,25 +926,195 @@ namespace djv
                     return _p->infoPromise.get_future();
                 }
 
-                void Read::seek(Frame::Number value, Direction)
+                void Read::seek(Frame::Number value, Direction direction)
                 {
                     DJV_PRIVATE_PTR();
                     {
                         std::lock_guard<std::mutex> lock(_mutex);
+                        _direction = direction;
                         _videoQueue.clearFrames();
-                        _audioQueue.clearFrames();
+                        _videoQueue.setFinished(false);
+                        _clearAudioQueues(false);
                         p.seek = value;
                     }
                     p.queueCV.notify_one();
                 }
 
-                int Read::_decodeVideo(const DecodeVideo& dv, Frame::Number& frame)
+                bool Read::_demuxReverse()
+                {
+                    DJV_PRIVATE_PTR();
+                    AVStream* avStream = p.avFormatContext->streams[p.avVideoStream];
+                    if (p.reverseSeek)
+                    {
+                        // Seek to the key frame at or before the end of the next range.
+                        p.reverseSeek = false;
+                        p.reverseStart = Frame::invalid;
+                        if (p.reverseEnd < 0 ||
+                            av_seek_frame(
+                                p.avFormatContext,
+                                p.avVideoStream,
+                                frameToTimestamp(p.reverseEnd, avStream->time_base, p.speed),
+                                AVSEEK_FLAG_BACKWARD) < 0)
+                        {
+                            Packet eofPacket;
+                            eofPacket.epoch = p.epoch;
+                            eofPacket.eof = true;
+                            p.packetQueue.add(std::move(eofPacket));
+                            return true;
+                        }
+                    }
+
+                    AVPacket packet;
+                    if (av_read_frame(p.avFormatContext, &packet) < 0)
+                    {
+                        _endReverseGOP();
+                        return false;
+                    }
+                    ++p.demuxCount;
+                    if (p.avVideoStream == packet.stream_index)
+                    {
+                        const int64_t pts = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+                        const int64_t dts = packet.dts != AV_NOPTS_VALUE ? packet.dts : pts;
+                        if (Frame::invalid == p.reverseStart)
+                        {
+                            // The first packet after the seek is the key frame that
+                            // starts the GOP. The whole GOP is decoded once unless its
+                            // frames do not fit in the staging budget.
+                            const Frame::Number key = timestampToFrame(pts, avStream->time_base, p.speed);
+                            p.reverseStart = std::min(
+                                std::max(key, p.reverseEnd - p.reverseFrameMax + 1),
+                                p.reverseEnd);
+                        }
+                        if (timestampToFrame(dts, avStream->time_base, p.speed) > p.reverseEnd)
+                        {
+                            av_packet_unref(&packet);
+                            _endReverseGOP();
+                            return false;
+                        }
+                        Packet videoPacket;
+                        videoPacket.packet = createPacket();
+                        av_packet_move_ref(videoPacket.packet.get(), &packet);
+                        videoPacket.epoch = p.epoch;
+                        videoPacket.seek = p.reverseStart;
+                        videoPacket.reverseEnd = p.reverseEnd;
+                        p.packetQueue.add(std::move(videoPacket));
+                    }
+                    av_packet_unref(&packet);
+                    return false;
+                }
+
+                void Read::_endReverseGOP()
+                {
+                    DJV_PRIVATE_PTR();
+                    Packet gopPacket;
+                    gopPacket.epoch = p.epoch;
+                    gopPacket.seek = p.reverseStart;
+                    gopPacket.reverseEnd = p.reverseEnd;
+                    gopPacket.gopEnd = true;
+                    p.packetQueue.add(std::move(gopPacket));
+
+                    // Continue with the frames before this range. If no video was
+                    // found there is nothing left to read.
+                    p.reverseEnd = p.reverseStart != Frame::invalid ? (p.reverseStart - 1) : -1;
+                    p.reverseSeek = true;
+                }
+
+                void Read::_decodeVideoThread()
                 {
                     DJV_PRIVATE_PTR();
-                    int r = avcodec_send_packet(p.avCodecContext[p.avVideoStream], dv.packet);
+                    AVFrame* avFrame = av_frame_alloc();
+                    size_t epoch = 0;
+                    while (p.running)
+                    {
+                        Packet packet;
+                        if (!p.packetQueue.pop(
+                            packet,
+                            [this]
+                            {
+                                return !_p->running;
+                            }))
+                        {
+                            continue;
+                        }
+                        if (packet.epoch != p.epoch)
+                        {
+                            continue;
+                        }
+                        if (packet.epoch != epoch)
+                        {
+                            epoch = packet.epoch;
+                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            p.reverseStaging.clear();
+                        }
+                        const int r = _decodeVideo(avFrame, packet.packet.get(), packet.seek, packet.reverseEnd, packet.epoch);
+                        if (packet.gopEnd)
+                        {
+                            // The decoder has been drained, pass the staged frames on
+                            // in reverse order.
+                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            DecodedGOP gop;
+                            gop.frames = std::move(p.reverseStaging);
+                            p.reverseStaging.clear();
+                            std::sort(
+                                gop.frames.begin(),
+                                gop.frames.end(),
+                                [](const DecodedFrame& a, const DecodedFrame& b)
+                                {
+                                    return a.number > b.number;
+                                });
+                            gop.epoch = packet.epoch;
+                            p.gopQueue.push(
+                                std::move(gop),
+                                [this, epoch]
+                                {
+                                    return !_p->running || epoch != _p->epoch;
+                                });
+                        }
+                        else if (p.reverse && packet.eof)
+                        {
+                            DecodedGOP gop;
+                            gop.epoch = packet.epoch;
+                            gop.eof = true;
+                            p.gopQueue.push(
+                                std::move(gop),
+                                [this, epoch]
+                                {
+                                    return !_p->running || epoch != _p->epoch;
+                                });
+                        }
+                        else if (r < 0 || packet.eof)
+                        {
+                            if (packet.eof)
+                            {
+                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            }
+
+                            // An empty frame marks the end of the video.
+                            DecodedFrame eofFrame;
+                            eofFrame.epoch = packet.epoch;
+                            p.frameQueue.push(
+                                std::move(eofFrame),
+                                [this, epoch]
+                                {
+                                    return !_p->running || epoch != _p->epoch;
+                                });
+                        }
+                    }
+                    av_frame_free(&avFrame);
+                }
+
+                int Read::_decodeVideo(
+                    AVFrame* avFrame,
+                    AVPacket* packet,
+                    Frame::Number seek,
+                    Frame::Number reverseEnd,
+                    size_t epoch)
+                {
+                    DJV_PRIVATE_PTR();
+                    int r = avcodec_send_packet(p.avCodecContext[p.avVideoStream], packet);
                     while (r >= 0)
                     {
-                        r = avcodec_receive_frame(p.avCodecContext[p.avVideoStream], p.avFrame);
+                        r = avcodec_receive_frame(p.avCodecContext[p.avVideoStream], avFrame);
                         if (AVERROR(EAGAIN) == r)
                         {
                             r = 0;
@@ -671,66 +1128,188 @@ namespace djv
                         AVRational r;
                         r.num = p.speed.getDen();
                         r.den = p.speed.getNum();
-                        frame = av_rescale_q(
-                            p.avFrame->pts,
+                        const Frame::Number frame = av_rescale_q(
+                            avFrame->pts,
                             p.avFormatContext->streams[p.avVideoStream]->time_base,
                             r);
                         //std::cout << "decode video = " << frame << std::endl;
 
-                        if (Frame::invalid == dv.seek || frame >= dv.seek)
+                        if (reverseEnd != Frame::invalid)
                         {
-                            std::shared_ptr<Image::Image> image;
-                            if (dv.cacheEnabled && _cache.get(frame, image))
-                            {}
-                            else
+                            if (frame >= seek && frame <= reverseEnd)
                             {
-                                auto info = p.videoInfo.info;
-                                if (!((0 == p.avFrame->sample_aspect_ratio.num && 1 == p.avFrame->sample_aspect_ratio.den) ||
-                                    0 == p.avFrame->sample_aspect_ratio.den))
+                                DecodedFrame decodedFrame;
+                                decodedFrame.frame = createFrame();
+                                av_frame_move_ref(decodedFrame.frame.get(), avFrame);
+                                decodedFrame.number = frame;
+                                decodedFrame.epoch = epoch;
+                                p.reverseStaging.push_back(std::move(decodedFrame));
+                                ++p.decodeCount;
+                            }
+                        }
+                        else if (Frame::invalid == seek || frame >= seek)
+                        {
+                            DecodedFrame decodedFrame;
+                            decodedFrame.frame = createFrame();
+                            av_frame_move_ref(decodedFrame.frame.get(), avFrame);
+                            decodedFrame.number = frame;
+                            decodedFrame.epoch = epoch;
+                            if (!p.frameQueue.push(
+                                std::move(decodedFrame),
+                                [this, epoch]
                                 {
-                                    info.pixelAspectRatio = p.avFrame->sample_aspect_ratio.num / static_cast<float>(p.avFrame->sample_aspect_ratio.den);
-                                }
-                                image = Image::Image::create(info);
-                                av_image_fill_arrays(
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize,
-                                    image->getData(),
-                                    AV_PIX_FMT_RGBA,
-                                    image->getWidth(),
-                                    image->getHeight(),
-                                    1);
-                                sws_scale(
-                                    p.swsContext,
-                                    (uint8_t const* const*)p.avFrame->data,
-                                    p.avFrame->linesize,
-                                    0,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize);
-                                if (dv.cacheEnabled)
-                                {
-                                    _cache.add(frame, image);
-                                }
+                                    return !_p->running || epoch != _p->epoch;
+                                }))
+                            {
+                                return 0;
+                            }
+                            ++p.decodeCount;
+                        }
+                    }
+                    return r;
+                }
+
+                void Read::_convertVideoThread()
+                {
+                    DJV_PRIVATE_PTR();
+                    while (p.running)
+                    {
+                        if (p.reverse)
+                        {
+                            // The frames in a GOP are already in reverse order.
+                            DecodedGOP gop;
+                            if (!p.gopQueue.pop(
+                                gop,
+                                [this]
+                                {
+                                    return !_p->running || !_p->reverse;
+                                }))
+                            {
+                                continue;
                             }
+                            for (const auto& i : gop.frames)
                             {
-                                std::lock_guard<std::mutex> lock(_mutex);
-                                if (Frame::invalid == p.seek)
+                                if (!_addVideoFrame(i.frame.get(), i.number, gop.epoch))
                                 {
-                                    _videoQueue.addFrame(VideoFrame(frame, image));
+                                    break;
                                 }
                             }
+                            if (gop.eof)
+                            {
+                                _addVideoFrame(nullptr, Frame::invalid, gop.epoch);
+                            }
+                        }
+                        else
+                        {
+                            DecodedFrame decodedFrame;
+                            if (!p.frameQueue.pop(
+                                decodedFrame,
+                                [this]
+                                {
+                                    return !_p->running || _p->reverse;
+                                }))
+                            {
+                                continue;
+                            }
+                            _addVideoFrame(decodedFrame.frame.get(), decodedFrame.number, decodedFrame.epoch);
                         }
                     }
-                    return r;
+                }
+
+                bool Read::_addVideoFrame(const AVFrame* avFrame, Frame::Number number, size_t epoch)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (epoch != p.epoch)
+                    {
+                        return false;
+                    }
+
+                    std::shared_ptr<Image::Image> image;
+                    if (avFrame)
+                    {
+                        auto info = p.videoInfo.info;
+                        if (p.yuv)
+                        {
+                            if (avFrame->colorspace != AVCOL_SPC_UNSPECIFIED)
+                            {
+                                info.yuvCoefficients = getYUVCoefficients(avFrame->colorspace, info.size.h);
+                            }
+                            if (avFrame->color_range != AVCOL_RANGE_UNSPECIFIED)
+                            {
+                                info.yuvRange = getYUVRange(
+                                    avFrame->color_range,
+                                    static_cast<AVPixelFormat>(avFrame->format));
+                            }
+                        }
+                        const auto& sampleAspectRatio = avFrame->sample_aspect_ratio;
+                        if (!((0 == sampleAspectRatio.num && 1 == sampleAspectRatio.den) ||
+                            0 == sampleAspectRatio.den))
+                        {
+                            info.pixelAspectRatio = sampleAspectRatio.num / static_cast<float>(sampleAspectRatio.den);
+                        }
+                        image = Image::Image::create(info);
+                        _convertVideo(avFrame, image);
+                        ++p.convertCount;
+                    }
+
+                    // Wait for room in the video queue.
+                    while (p.running)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (epoch != p.epoch || p.seek != Frame::invalid)
+                            {
+                                return false;
+                            }
+                            if (!image)
+                            {
+                                _videoQueue.setFinished(true);
+                                return true;
+                            }
+                            if (_videoQueue.getCount() < _videoQueue.getMax())
+                            {
+                                _videoQueue.addFrame(VideoFrame(number, image));
+                                return true;
+                            }
+                        }
+                        std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                    }
+                    return false;
+                }
+
+                void Read::_convertVideo(const AVFrame* avFrame, const std::shared_ptr<Image::Image>& image)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.yuv)
+                    {
+                        copyPlanes(avFrame, image);
+                        return;
+                    }
+                    // The conversion runs on its own thread in parallel with
+                    // decoding. The scaler is given the whole frame as one slice,
+                    // splitting it would clamp the chroma interpolation at each
+                    // slice boundary.
+                    uint8_t* dst[4] = { image->getData(), nullptr, nullptr, nullptr };
+                    int dstStride[4] = { static_cast<int>(image->getScanlineByteCount()), 0, 0, 0 };
+                    sws_scale(
+                        p.swsContext,
+                        avFrame->data,
+                        avFrame->linesize,
+                        0,
+                        avFrame->height,
+                        dst,
+                        dstStride);
                 }
 
                 int Read::_decodeAudio(const DecodeAudio& da, Frame::Number& frame)
                 {
                     DJV_PRIVATE_PTR();
-                    int r = avcodec_send_packet(p.avCodecContext[p.avAudioStream], da.packet);
+                    const auto& audioTrack = p.audioTracks.at(da.stream);
+                    const auto avCodecParameters = p.avCodecParameters[da.stream];
+                    int r = avcodec_send_packet(p.avCodecContext[da.stream], da.packet);
                     while (r >= 0)
                     {
-                        r = avcodec_receive_frame(p.avCodecContext[p.avAudioStream], p.avFrame);
+                        r = avcodec_receive_frame(p.avCodecContext[da.stream], p.avFrame);
                         if (AVERROR(EAGAIN) == r)
                         {
                             r = 0;
@@ -741,25 +1320,34 @@ namespace djv
                             break;
                         }
 
+                        // Audio files are seeked by sample, see IRead::seek().
                         AVRational r;
-                        r.num = p.speed.getDen();
-                        r.den = p.speed.getNum();
+                        if (p.avVideoStream != -1)
+                        {
+                            r.num = p.speed.getDen();
+                            r.den = p.speed.getNum();
+                        }
+                        else
+                        {
+                            r.num = 1;
+                            r.den = static_cast<int>(audioTrack.info.info.sampleRate);
+                        }
                         frame = av_rescale_q(
                             p.avFrame->pts,
-                            p.avFormatContext->streams[p.avAudioStream]->time_base,
+                            p.avFormatContext->streams[da.stream]->time_base,
                             r);
                         //std::cout << "decode audio = " << frame << std::endl;
 
                         if (Frame::invalid == da.seek || frame >= da.seek)
                         {
-                            auto info = p.audioInfo.info;
+                            auto info = audioTrack.info.info;
                             info.sampleCount = p.avFrame->nb_samples;
                             auto audioData = Audio::Data::create(info);
-                            switch (p.avCodecParameters[p.avAudioStream]->format)
+                            switch (avCodecParameters->format)
                             {
                             case AV_SAMPLE_FMT_S16:
                             {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
+                                if (avCodecParameters->channels == info.channelCount)
                                 {
                                     memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
                                 }
@@ -769,14 +1357,14 @@ namespace djv
                                         reinterpret_cast<int16_t*>(p.avFrame->data[0]),
                                         reinterpret_cast<int16_t*>(audioData->getData()),
                                         audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
+                                        avCodecParameters->channels,
                                         info.channelCount);
                                 }
                                 break;
                             }
                             case AV_SAMPLE_FMT_S32:
                             {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
+                                if (avCodecParameters->channels == info.channelCount)
                                 {
                                     memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
                                 }
@@ -786,14 +1374,14 @@ namespace djv
                                         reinterpret_cast<int32_t*>(p.avFrame->data[0]),
                                         reinterpret_cast<int32_t*>(audioData->getData()),
                                         audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
+                                        avCodecParameters->channels,
                                         info.channelCount);
                                 }
                                 break;
                             }
                             case AV_SAMPLE_FMT_FLT:
                             {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
+                                if (avCodecParameters->channels == info.channelCount)
                                 {
                                     memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
                                 }
@@ -803,14 +1391,14 @@ namespace djv
                                         reinterpret_cast<float*>(p.avFrame->data[0]),
                                         reinterpret_cast<float*>(audioData->getData()),
                                         audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
+                                        avCodecParameters->channels,
                                         info.channelCount);
                                 }
                                 break;
                             }
                             case AV_SAMPLE_FMT_DBL:
                             {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
+                                if (avCodecParameters->channels == info.channelCount)
                                 {
                                     memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
                                 }
@@ -820,7 +1408,7 @@ namespace djv
                                         reinterpret_cast<double*>(p.avFrame->data[0]),
                                         reinterpret_cast<double*>(audioData->getData()),
                                         audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
+                                        avCodecParameters->channels,
                                         info.channelCount);
                                 }
                                 break;
@@ -895,7 +1483,7 @@ namespace djv
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 if (Frame::invalid == p.seek)
                                 {
-                                    _audioQueue.addFrame(AudioFrame(audioData));
+                                    getAudioTrackQueue(audioTrack.track).addFrame(AudioFrame(audioData));
                                 }
                             }
                         }
@@ -903,6 +1491,17 @@ namespace djv
                     return r;
                 }
 
+                void Read::_clearAudioQueues(bool finished)
+                {
+                    DJV_PRIVATE_PTR();
+                    for (const auto& i : p.audioTracks)
+                    {
+                        auto& queue = getAudioTrackQueue(i.second.track);
+                        queue.clearFrames();
+                        queue.setFinished(finished);
+                    }
+                }
+
             } // namespace FFmpeg
         } // namespace IO
     } // namespace AV
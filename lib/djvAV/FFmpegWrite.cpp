@@ -0,0 +1,710 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/FFmpeg.h>
+
+#include <djvAV/ImageUtil.h>
+#include <djvAV/OCIOLUT3D.h>
+
+#include <djvCore/FileSystem.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+
+} // extern "C"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace FFmpeg
+            {
+                namespace
+                {
+                    //! \todo Should this be configurable?
+                    const size_t frameQueueMax = 4;
+
+                    std::shared_ptr<AVFrame> createFrame()
+                    {
+                        return std::shared_ptr<AVFrame>(
+                            av_frame_alloc(),
+                            [](AVFrame* value)
+                            {
+                                av_frame_free(&value);
+                            });
+                    }
+
+                    //! Get the planar YUV type for the given pixel format, or None if
+                    //! the pixel format is not handled by Image::convertRGBToYUV().
+                    Image::Type getYUVType(AVPixelFormat value)
+                    {
+                        Image::Type out = Image::Type::None;
+                        switch (value)
+                        {
+                        case AV_PIX_FMT_YUV420P:
+                        case AV_PIX_FMT_YUVJ420P:     out = Image::Type::YUV_420P_U8;  break;
+                        case AV_PIX_FMT_YUV422P:
+                        case AV_PIX_FMT_YUVJ422P:     out = Image::Type::YUV_422P_U8;  break;
+                        case AV_PIX_FMT_YUV444P:
+                        case AV_PIX_FMT_YUVJ444P:     out = Image::Type::YUV_444P_U8;  break;
+                        case AV_PIX_FMT_YUV420P10LE:  out = Image::Type::YUV_420P_U10; break;
+                        case AV_PIX_FMT_YUV422P10LE:  out = Image::Type::YUV_422P_U10; break;
+                        case AV_PIX_FMT_YUV444P10LE:  out = Image::Type::YUV_444P_U10; break;
+                        case AV_PIX_FMT_YUV420P16LE:  out = Image::Type::YUV_420P_U16; break;
+                        case AV_PIX_FMT_YUV422P16LE:  out = Image::Type::YUV_422P_U16; break;
+                        case AV_PIX_FMT_YUV444P16LE:  out = Image::Type::YUV_444P_U16; break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                    Image::YUVRange getYUVRange(AVPixelFormat value)
+                    {
+                        Image::YUVRange out = Image::YUVRange::Video;
+                        switch (value)
+                        {
+                        case AV_PIX_FMT_YUVJ420P:
+                        case AV_PIX_FMT_YUVJ422P:
+                        case AV_PIX_FMT_YUVJ444P: out = Image::YUVRange::Full; break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                    //! Convert interleaved image data to the given type, flipping it
+                    //! vertically if it is mirrored.
+                    void convertRGB(const Image::Data& in, Image::Data& out, size_t threadCount)
+                    {
+                        const auto& info = in.getInfo();
+                        const uint16_t w = info.size.w;
+                        const uint16_t h = info.size.h;
+                        const bool endianConvert = info.layout.endian != Memory::getEndian();
+                        const size_t scanlineByteCount = w * info.getPixelByteCount();
+                        const size_t wordSize = Image::Type::RGB_U10 == info.type ?
+                            info.getPixelByteCount() :
+                            Image::getByteCount(Image::getDataType(info.type));
+                        const size_t tiles = Math::clamp(threadCount, size_t(1), static_cast<size_t>(std::max(h, uint16_t(1))));
+                        std::vector<std::future<void> > futures;
+                        for (size_t i = 0; i < tiles; ++i)
+                        {
+                            const uint16_t y0 = static_cast<uint16_t>(i * h / tiles);
+                            const uint16_t y1 = static_cast<uint16_t>((i + 1) * h / tiles);
+                            futures.push_back(std::async(
+                                std::launch::async,
+                                [&in, &out, &info, y0, y1, w, h, endianConvert, scanlineByteCount, wordSize]
+                                {
+                                    std::vector<uint8_t> scanline(endianConvert ? scanlineByteCount : 0);
+                                    for (uint16_t y = y0; y < y1; ++y)
+                                    {
+                                        const uint8_t* inP = in.getData(info.layout.mirror.y ? (h - 1 - y) : y);
+                                        if (endianConvert)
+                                        {
+                                            Memory::endian(inP, scanline.data(), scanlineByteCount / wordSize, wordSize);
+                                            inP = scanline.data();
+                                        }
+                                        Image::convert(inP, info.type, out.getData(y), out.getType(), w);
+                                    }
+                                }));
+                        }
+                        for (auto& i : futures)
+                        {
+                            i.get();
+                        }
+                    }
+
+                } // namespace
+
+                struct Write::Private
+                {
+                    Options options;
+                    AVFormatContext* avFormatContext = nullptr;
+                    AVCodecContext* avCodecContext = nullptr;
+                    AVStream* avVideoStream = nullptr;
+                    AVPixelFormat avPixelFormat = AV_PIX_FMT_NONE;
+                    SwsContext* swsContext = nullptr;
+                    SwsContext* resizeContext = nullptr;
+
+                    //! Images are converted to this RGBA type first, and then to
+                    //! planar YUV if yuvInfo is valid or with the software scaler
+                    //! otherwise.
+                    Image::Info rgbInfo;
+                    Image::Info yuvInfo;
+                    std::shared_ptr<const OCIO::LUT3D> colorSpaceLUT;
+
+                    PipelineQueue<std::shared_ptr<AVFrame> > frameQueue { frameQueueMax };
+                    int64_t pts = 0;
+                    size_t frameCount = 0;
+                    std::chrono::steady_clock::time_point startTime;
+
+                    std::atomic<bool> running;
+                    std::thread convertThread;
+                    std::thread encodeThread;
+                };
+
+                void Write::_init(
+                    const FileSystem::FileInfo& fileInfo,
+                    const Info& info,
+                    const WriteOptions& writeOptions,
+                    const Options& options,
+                    const std::shared_ptr<ResourceSystem>& resourceSystem,
+                    const std::shared_ptr<LogSystem>& logSystem)
+                {
+                    IWrite::_init(fileInfo, info, writeOptions, resourceSystem, logSystem);
+                    DJV_PRIVATE_PTR();
+                    p.options = options;
+                    p.running = false;
+
+                    if (!_info.video.size())
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                            DJV_TEXT("cannot be written") << ". " << DJV_TEXT("There is no video.");
+                        throw FileSystem::Error(ss.str());
+                    }
+                    const auto& videoInfo = _info.video[0];
+                    const Image::Size& size = videoInfo.info.size;
+
+                    try
+                    {
+                        // Open the output format and find the encoder.
+                        const std::string fileName = _fileInfo.getFileName();
+                        int r = avformat_alloc_output_context2(&p.avFormatContext, nullptr, nullptr, fileName.c_str());
+                        if (r < 0)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                            throw FileSystem::Error(ss.str());
+                        }
+                        const AVCodec* avCodec = p.options.codec.empty() ?
+                            avcodec_find_encoder(p.avFormatContext->oformat->video_codec) :
+                            avcodec_find_encoder_by_name(p.options.codec.c_str());
+                        if (!avCodec)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("does not match any video codecs") << ".";
+                            throw FileSystem::Error(ss.str());
+                        }
+
+                        // Use the requested pixel format, or the closest one that the
+                        // encoder supports.
+                        p.avPixelFormat = av_get_pix_fmt(p.options.pixelFormat.c_str());
+                        if (avCodec->pix_fmts)
+                        {
+                            bool supported = false;
+                            for (const AVPixelFormat* i = avCodec->pix_fmts; *i != AV_PIX_FMT_NONE; ++i)
+                            {
+                                if (*i == p.avPixelFormat)
+                                {
+                                    supported = true;
+                                    break;
+                                }
+                            }
+                            if (!supported)
+                            {
+                                p.avPixelFormat = avcodec_find_best_pix_fmt_of_list(
+                                    avCodec->pix_fmts,
+                                    AV_PIX_FMT_NONE == p.avPixelFormat ? AV_PIX_FMT_RGBA : p.avPixelFormat,
+                                    0,
+                                    nullptr);
+                            }
+                        }
+                        if (AV_PIX_FMT_NONE == p.avPixelFormat)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be written") << ". " << DJV_TEXT("The pixel format is not supported.");
+                            throw FileSystem::Error(ss.str());
+                        }
+
+                        // Create the video stream and initialize the encoder.
+                        p.avVideoStream = avformat_new_stream(p.avFormatContext, nullptr);
+                        p.avCodecContext = avcodec_alloc_context3(avCodec);
+                        if (!p.avVideoStream || !p.avCodecContext)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be opened") << ".";
+                            throw FileSystem::Error(ss.str());
+                        }
+                        const Time::Speed& speed = videoInfo.speed;
+                        p.avCodecContext->codec_id = avCodec->id;
+                        p.avCodecContext->codec_type = AVMEDIA_TYPE_VIDEO;
+                        p.avCodecContext->width = size.w;
+                        p.avCodecContext->height = size.h;
+                        p.avCodecContext->sample_aspect_ratio = av_d2q(videoInfo.info.pixelAspectRatio, 255);
+                        p.avCodecContext->pix_fmt = p.avPixelFormat;
+                        p.avCodecContext->time_base = { speed.getDen(), speed.getNum() };
+                        p.avCodecContext->framerate = { speed.getNum(), speed.getDen() };
+                        p.avCodecContext->bit_rate = p.options.bitRate;
+                        p.avCodecContext->gop_size = p.options.gopSize;
+                        p.avCodecContext->thread_count = p.options.threadCount;
+                        p.avCodecContext->thread_type = FF_THREAD_SLICE;
+                        if (avCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS)
+                        {
+                            p.avCodecContext->thread_type |= FF_THREAD_FRAME;
+                        }
+                        if (p.avFormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+                        {
+                            p.avCodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+                        }
+
+                        // Planar YUV formats are converted with Image::convertRGBToYUV(),
+                        // other formats with the software scaler.
+                        const Image::Type yuvType = getYUVType(p.avPixelFormat);
+                        if (yuvType != Image::Type::None)
+                        {
+                            p.yuvInfo = Image::Info(size, yuvType);
+                            p.yuvInfo.yuvCoefficients = Image::YUVCoefficients::BT709;
+                            p.yuvInfo.yuvRange = getYUVRange(p.avPixelFormat);
+                            p.yuvInfo.layout.endian = Memory::Endian::LSB;
+                            p.rgbInfo = Image::Info(size, Image::getYUVConvertType(yuvType));
+                            p.avCodecContext->colorspace = AVCOL_SPC_BT709;
+                            p.avCodecContext->color_range =
+                                Image::YUVRange::Full == p.yuvInfo.yuvRange ?
+                                AVCOL_RANGE_JPEG :
+                                AVCOL_RANGE_MPEG;
+                        }
+                        else
+                        {
+                            p.rgbInfo = Image::Info(size, Image::Type::RGBA_U8);
+                            p.swsContext = sws_getContext(
+                                size.w,
+                                size.h,
+                                AV_PIX_FMT_RGBA,
+                                size.w,
+                                size.h,
+                                p.avPixelFormat,
+                                SWS_BICUBIC,
+                                0,
+                                0,
+                                0);
+                            if (!p.swsContext)
+                            {
+                                std::stringstream ss;
+                                ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                    DJV_TEXT("cannot be written") << ". " << DJV_TEXT("The pixel format is not supported.");
+                                throw FileSystem::Error(ss.str());
+                            }
+                        }
+
+                        r = avcodec_open2(p.avCodecContext, avCodec, nullptr);
+                        if (r < 0)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                            throw FileSystem::Error(ss.str());
+                        }
+                        r = avcodec_parameters_from_context(p.avVideoStream->codecpar, p.avCodecContext);
+                        if (r < 0)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                            throw FileSystem::Error(ss.str());
+                        }
+                        p.avVideoStream->time_base = p.avCodecContext->time_base;
+                        p.avVideoStream->avg_frame_rate = p.avCodecContext->framerate;
+
+                        // Open the file and write the header.
+                        av_dump_format(p.avFormatContext, 0, fileName.c_str(), 1);
+                        if (!(p.avFormatContext->oformat->flags & AVFMT_NOFILE))
+                        {
+                            r = avio_open(&p.avFormatContext->pb, fileName.c_str(), AVIO_FLAG_WRITE);
+                            if (r < 0)
+                            {
+                                std::stringstream ss;
+                                ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                    DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
+                                throw FileSystem::Error(ss.str());
+                            }
+                        }
+                        r = avformat_write_header(p.avFormatContext, nullptr);
+                        if (r < 0)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be written") << ". " << FFmpeg::getErrorString(r);
+                            throw FileSystem::Error(ss.str());
+                        }
+
+                        if (_options.colorSpaceConvert.isValid())
+                        {
+                            p.colorSpaceLUT = OCIO::LUT3D::getCached(_options.colorSpaceConvert);
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        _close();
+                        throw;
+                    }
+
+                    p.startTime = std::chrono::steady_clock::now();
+                    p.running = true;
+                    p.convertThread = std::thread(
+                        [this]
+                        {
+                            _convertThread();
+                        });
+                    p.encodeThread = std::thread(
+                        [this]
+                        {
+                            _encodeThread();
+                        });
+                }
+
+                Write::Write() :
+                    _p(new Private)
+                {}
+
+                Write::~Write()
+                {
+                    DJV_PRIVATE_PTR();
+
+                    // Finish the queue so that the remaining frames are encoded and
+                    // the trailer is written before the threads exit. If one of the
+                    // threads has failed the other one is cancelled.
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _videoQueue.setFinished(true);
+                    }
+                    if (p.convertThread.joinable())
+                    {
+                        p.convertThread.join();
+                    }
+                    if (p.encodeThread.joinable())
+                    {
+                        p.encodeThread.join();
+                    }
+                    _close();
+                }
+
+                std::shared_ptr<Write> Write::create(
+                    const FileSystem::FileInfo& fileInfo,
+                    const Info& info,
+                    const WriteOptions& writeOptions,
+                    const Options& options,
+                    const std::shared_ptr<ResourceSystem>& resourceSystem,
+                    const std::shared_ptr<LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<Write>(new Write);
+                    out->_init(fileInfo, info, writeOptions, options, resourceSystem, logSystem);
+                    return out;
+                }
+
+                bool Write::isRunning() const
+                {
+                    return _p->running;
+                }
+
+                void Write::_convertThread()
+                {
+                    DJV_PRIVATE_PTR();
+                    try
+                    {
+                        const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                        const auto cancel = [&p] { return !p.running; };
+                        while (p.running)
+                        {
+                            std::shared_ptr<Image::Image> image;
+                            bool finished = false;
+                            size_t threadCount = 1;
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                threadCount = _threadCount;
+                                if (!_videoQueue.isEmpty())
+                                {
+                                    image = _videoQueue.popFrame().image;
+                                }
+                                else if (_videoQueue.isFinished())
+                                {
+                                    finished = true;
+                                }
+                            }
+                            if (image)
+                            {
+                                p.frameQueue.push(_convert(image, threadCount), cancel);
+                            }
+                            else if (finished)
+                            {
+                                // An empty frame tells the encoding thread to flush.
+                                p.frameQueue.push(nullptr, cancel);
+                                break;
+                            }
+                            else
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _logSystem->log("djv::AV::IO::FFmpeg::Write", e.what(), LogLevel::Error);
+                        p.running = false;
+                    }
+                }
+
+                void Write::_encodeThread()
+                {
+                    DJV_PRIVATE_PTR();
+                    try
+                    {
+                        const auto cancel = [&p] { return !p.running; };
+                        std::shared_ptr<AVFrame> avFrame;
+                        while (p.frameQueue.pop(avFrame, cancel))
+                        {
+                            _encode(avFrame.get());
+                            if (!avFrame)
+                            {
+                                const int r = av_write_trailer(p.avFormatContext);
+                                if (r < 0)
+                                {
+                                    std::stringstream ss;
+                                    ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                        DJV_TEXT("cannot be written") << ". " << FFmpeg::getErrorString(r);
+                                    throw FileSystem::Error(ss.str());
+                                }
+                                const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - p.startTime;
+                                std::stringstream ss;
+                                ss << _fileInfo << ": " << p.frameCount << " frames, " <<
+                                    (elapsed.count() > 0.F ? p.frameCount / elapsed.count() : 0.F) << " fps";
+                                _logSystem->log("djv::AV::IO::FFmpeg::Write", ss.str());
+                                break;
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _logSystem->log("djv::AV::IO::FFmpeg::Write", e.what(), LogLevel::Error);
+                    }
+                    p.running = false;
+                }
+
+                std::shared_ptr<AVFrame> Write::_convert(const std::shared_ptr<Image::Image>& value, size_t threadCount)
+                {
+                    DJV_PRIVATE_PTR();
+                    const auto& info = value->getInfo();
+                    const auto& size = p.rgbInfo.size;
+                    auto avFrame = createFrame();
+                    avFrame->format = p.avPixelFormat;
+                    avFrame->width = size.w;
+                    avFrame->height = size.h;
+                    avFrame->pts = p.pts++;
+                    int r = av_frame_get_buffer(avFrame.get(), 0);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(FFmpeg::getErrorString(r));
+                    }
+
+                    // Planar YUV images that already match the output are copied
+                    // without conversion.
+                    std::shared_ptr<Image::Data> yuv;
+                    if (p.yuvInfo.isValid() && !p.colorSpaceLUT && info == p.yuvInfo)
+                    {
+                        yuv = value;
+                    }
+                    else
+                    {
+                        std::shared_ptr<Image::Image> image = Image::convertYUV(value);
+                        if (p.colorSpaceLUT)
+                        {
+                            image = p.colorSpaceLUT->apply(image, threadCount);
+                        }
+                        const Image::Info rgbInfo(image->getSize(), p.rgbInfo.type);
+                        std::shared_ptr<Image::Data> rgb = image;
+                        if (image->getInfo() != rgbInfo)
+                        {
+                            rgb = Image::Data::create(rgbInfo);
+                            convertRGB(*image, *rgb, threadCount);
+                        }
+                        if (rgbInfo.size != size)
+                        {
+                            // Resize images that do not match the output size.
+                            const AVPixelFormat avRGBFormat = Image::Type::RGBA_U8 == rgbInfo.type ?
+                                AV_PIX_FMT_RGBA :
+                                AV_PIX_FMT_RGBA64;
+                            p.resizeContext = sws_getCachedContext(
+                                p.resizeContext,
+                                rgbInfo.size.w,
+                                rgbInfo.size.h,
+                                avRGBFormat,
+                                size.w,
+                                size.h,
+                                avRGBFormat,
+                                SWS_BICUBIC,
+                                0,
+                                0,
+                                0);
+                            auto tmp = Image::Data::create(p.rgbInfo);
+                            const uint8_t* inData[] = { rgb->getData() };
+                            const int inLinesize[] = { static_cast<int>(rgbInfo.getScanlineByteCount()) };
+                            uint8_t* outData[] = { tmp->getData() };
+                            const int outLinesize[] = { static_cast<int>(p.rgbInfo.getScanlineByteCount()) };
+                            sws_scale(p.resizeContext, inData, inLinesize, 0, rgbInfo.size.h, outData, outLinesize);
+                            rgb = tmp;
+                        }
+                        if (p.yuvInfo.isValid())
+                        {
+                            yuv = Image::Data::create(p.yuvInfo);
+                            Image::convertRGBToYUV(*rgb, *yuv, threadCount);
+                            if (Memory::getEndian() != Memory::Endian::LSB && Image::getDataType(p.yuvInfo.type) != Image::DataType::U8)
+                            {
+                                Memory::endian(yuv->getData(), yuv->getData(), yuv->getDataByteCount() / 2, 2);
+                            }
+                        }
+                        else
+                        {
+                            const uint8_t* data[] = { rgb->getData() };
+                            const int linesize[] = { static_cast<int>(p.rgbInfo.getScanlineByteCount()) };
+                            sws_scale(
+                                p.swsContext,
+                                data,
+                                linesize,
+                                0,
+                                size.h,
+                                avFrame->data,
+                                avFrame->linesize);
+                        }
+                    }
+                    if (yuv)
+                    {
+                        const auto& yuvInfo = yuv->getInfo();
+                        const uint8_t byteCount = Image::getByteCount(Image::getDataType(yuvInfo.type));
+                        for (uint8_t i = 0; i < 3; ++i)
+                        {
+                            const auto planeSize = yuvInfo.getPlaneSize(i);
+                            av_image_copy_plane(
+                                avFrame->data[i],
+                                avFrame->linesize[i],
+                                yuv->getPlaneData(i),
+                                static_cast<int>(yuvInfo.getPlaneScanlineByteCount(i)),
+                                planeSize.w * byteCount,
+                                planeSize.h);
+                        }
+                    }
+                    return avFrame;
+                }
+
+                void Write::_encode(const AVFrame* avFrame)
+                {
+                    DJV_PRIVATE_PTR();
+                    int r = avcodec_send_frame(p.avCodecContext, avFrame);
+                    if (r < 0)
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                            DJV_TEXT("cannot be written") << ". " << FFmpeg::getErrorString(r);
+                        throw FileSystem::Error(ss.str());
+                    }
+                    if (avFrame)
+                    {
+                        ++p.frameCount;
+                    }
+                    AVPacket* avPacket = av_packet_alloc();
+                    while (r >= 0)
+                    {
+                        r = avcodec_receive_packet(p.avCodecContext, avPacket);
+                        if (AVERROR(EAGAIN) == r || AVERROR_EOF == r)
+                        {
+                            break;
+                        }
+                        else if (r < 0)
+                        {
+                            av_packet_free(&avPacket);
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be written") << ". " << FFmpeg::getErrorString(r);
+                            throw FileSystem::Error(ss.str());
+                        }
+                        av_packet_rescale_ts(avPacket, p.avCodecContext->time_base, p.avVideoStream->time_base);
+                        avPacket->stream_index = p.avVideoStream->index;
+                        r = av_interleaved_write_frame(p.avFormatContext, avPacket);
+                        if (r < 0)
+                        {
+                            av_packet_free(&avPacket);
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << _fileInfo << "' " <<
+                                DJV_TEXT("cannot be written") << ". " << FFmpeg::getErrorString(r);
+                            throw FileSystem::Error(ss.str());
+                        }
+                    }
+                    av_packet_free(&avPacket);
+                }
+
+                void Write::_close()
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.swsContext)
+                    {
+                        sws_freeContext(p.swsContext);
+                        p.swsContext = nullptr;
+                    }
+                    if (p.resizeContext)
+                    {
+                        sws_freeContext(p.resizeContext);
+                        p.resizeContext = nullptr;
+                    }
+                    if (p.avCodecContext)
+                    {
+                        avcodec_free_context(&p.avCodecContext);
+                    }
+                    if (p.avFormatContext)
+                    {
+                        if (p.avFormatContext->pb && !(p.avFormatContext->oformat->flags & AVFMT_NOFILE))
+                        {
+                            avio_closep(&p.avFormatContext->pb);
+                        }
+                        avformat_free_context(p.avFormatContext);
+                        p.avFormatContext = nullptr;
+                    }
+                }
+
+            } // namespace FFmpeg
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
@@ -33,6 +33,7 @@
 #include <djvCore/Context.h>
 #include <djvCore/CoreSystem.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/ResourceBundle.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
@@ -61,6 +62,8 @@ namespace djv
             {
                 //! \todo Should this be configurable?
                 const size_t glyphCacheMax = 10000;
+                const size_t textCacheMax = 10000;
+                const size_t threadCountMax = 4;
                 const bool lcdHinting = true;
 
                 class MetricsRequest
@@ -126,6 +129,53 @@ namespace djv
                     std::promise<std::vector<TextLine> > promise;
                 };
 
+                //! This class provides the key for the text caches.
+                class TextCacheKey
+                {
+                public:
+                    TextCacheKey() {}
+                    TextCacheKey(
+                        const std::string& text,
+                        const Info& info,
+                        uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max()) :
+                        text(text),
+                        info(info),
+                        maxLineWidth(maxLineWidth)
+                    {}
+
+                    std::string text;
+                    Info info;
+                    uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max();
+
+                    bool operator < (const TextCacheKey& other) const
+                    {
+                        return std::tie(info, maxLineWidth, text) < std::tie(other.info, other.maxLineWidth, other.text);
+                    }
+                };
+
+                template<typename T>
+                std::future<T> getReadyFuture(const T& value)
+                {
+                    std::promise<T> promise;
+                    promise.set_value(value);
+                    return promise.get_future();
+                }
+
+                //! Move a share of the queued requests to a worker thread, leaving
+                //! the rest for the other threads.
+                template<typename T>
+                void takeRequests(std::list<T>& queue, std::list<T>& out, size_t threadCount)
+                {
+                    const size_t size = queue.size();
+                    if (size)
+                    {
+                        const size_t count = (size + threadCount - 1) / threadCount;
+                        auto end = queue.begin();
+                        std::advance(end, count);
+                        out.splice(out.end(), queue, queue.begin(), end);
+                    }
+                }
+
                 constexpr bool isSpace(djv_char_t c)
                 {
                     return ' ' == c || '\t' == c;
@@ -169,17 +219,45 @@ namespace djv
                 std::runtime_error(what)
             {}
 
-            struct System::Private
+            //! FreeType faces are not thread safe, so each worker thread has its
+            //! own FreeType instance and request lists.
+            struct System::Worker
             {
                 FT_Library ftLibrary = nullptr;
+                std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
+                std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
+
+                std::list<MetricsRequest> metricsRequests;
+                std::list<MeasureRequest> measureRequests;
+                std::list<MeasureGlyphsRequest> measureGlyphsRequests;
+                std::list<GlyphsRequest> glyphsRequests;
+                std::list<TextLinesRequest> textLinesRequests;
+
+                std::thread thread;
+            };
+
+            struct System::Private
+            {
                 FileSystem::Path fontPath;
+                std::shared_ptr<ResourceBundle> bundle;
+
+                //! The font files are listed and given family IDs once, so that
+                //! an ID means the same family on every worker thread even if
+                //! a face fails to load on one of them.
+                struct FontFile
+                {
+                    FamilyID familyID = 0;
+                    std::string fileName;
+                    const ResourceBundle::Entry* entry = nullptr;
+                };
+                std::vector<FontFile> fontFiles;
+
                 std::map<FamilyID, std::string> fontFileNames;
                 std::map<FamilyID, std::string> fontNames;
                 std::shared_ptr<MapSubject<FamilyID, std::string> > fontNamesSubject;
                 std::mutex fontNamesMutex;
                 std::shared_ptr<Time::Timer> fontNamesTimer;
                 std::map<FamilyID, std::map<FaceID, std::string> > fontFaceNames;
-                std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
 
                 std::list<MetricsRequest> metricsQueue;
                 std::list<MeasureRequest> measureQueue;
@@ -188,30 +266,42 @@ namespace djv
                 std::list<TextLinesRequest> textLinesQueue;
                 std::condition_variable requestCV;
                 std::mutex requestMutex;
-                std::list<MetricsRequest> metricsRequests;
-                std::list<MeasureRequest> measureRequests;
-                std::list<MeasureGlyphsRequest> measureGlyphsRequests;
-                std::list<GlyphsRequest> glyphsRequests;
-                std::list<TextLinesRequest> textLinesRequests;
 
-                std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
                 Memory::Cache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
+                std::mutex glyphCacheMutex;
                 std::atomic<size_t> glyphCacheSize;
                 std::atomic<float> glyphCachePercentageUsed;
 
+                Memory::Cache<Info, Metrics> metricsCache;
+                Memory::Cache<TextCacheKey, glm::vec2> measureCache;
+                Memory::Cache<TextCacheKey, std::vector<BBox2f> > measureGlyphsCache;
+                Memory::Cache<TextCacheKey, std::vector<std::shared_ptr<Glyph> > > glyphsCache;
+                Memory::Cache<TextCacheKey, std::vector<TextLine> > textLinesCache;
+                std::mutex textCacheMutex;
+                std::atomic<size_t> textCacheHits;
+                std::atomic<size_t> textCacheMisses;
+
                 std::shared_ptr<Time::Timer> statsTimer;
-                std::thread thread;
+                std::vector<std::unique_ptr<Worker> > workers;
                 std::atomic<bool> running;
 
-                bool getText(const std::string&, const Info&, std::basic_string<djv_char_t>&, FT_Face&, std::string& error);
-                std::shared_ptr<Glyph> getGlyph(const GlyphInfo &);
+                bool hasRequests() const;
+
+                bool getText(Worker&, const std::string&, const Info&, std::basic_string<djv_char_t>&, FT_Face&, std::string& error);
+                std::shared_ptr<Glyph> getGlyph(Worker&, const GlyphInfo &);
                 void measure(
+                    Worker&,
                     const std::basic_string<djv_char_t>& utf32,
                     const Info&,
                     FT_Face,
                     uint16_t maxLineWidth,
                     glm::vec2&,
                     std::vector<BBox2f>* = nullptr);
+
+                template<typename T, typename U>
+                bool getCached(const Memory::Cache<T, U>&, const T&, U&);
+                template<typename T, typename U>
+                void addCached(Memory::Cache<T, U>&, const T&, const U&);
             };
 
             void System::_init(const std::shared_ptr<Core::Context>& context)
@@ -223,10 +313,45 @@ namespace djv
                 addDependency(context->getSystemT<CoreSystem>());
 
                 p.fontPath = _getResourceSystem()->getPath(FileSystem::ResourcePath::Fonts);
+                p.bundle = _getResourceSystem()->getBundle();
+
+                // Fonts in the resource bundle are opened from memory,
+                // otherwise they are opened from the fonts directory.
+                FamilyID familyID = 0;
+                if (p.bundle)
+                {
+                    const std::string fontsName = ResourceSystem::getBundleName(FileSystem::ResourcePath::Fonts, std::string());
+                    for (const auto& i : p.bundle->getNames(fontsName))
+                    {
+                        Private::FontFile fontFile;
+                        fontFile.familyID = ++familyID;
+                        fontFile.fileName = i;
+                        fontFile.entry = p.bundle->getEntry(i);
+                        p.fontFiles.push_back(fontFile);
+                    }
+                }
+                if (p.fontFiles.empty())
+                {
+                    for (const auto& i : FileSystem::FileInfo::directoryList(p.fontPath))
+                    {
+                        Private::FontFile fontFile;
+                        fontFile.familyID = ++familyID;
+                        fontFile.fileName = i.getFileName();
+                        p.fontFiles.push_back(fontFile);
+                    }
+                }
+
                 p.fontNamesSubject = MapSubject<FamilyID, std::string>::create();
                 p.glyphCache.setMax(glyphCacheMax);
                 p.glyphCacheSize = 0;
                 p.glyphCachePercentageUsed = 0.F;
+                p.metricsCache.setMax(textCacheMax);
+                p.measureCache.setMax(textCacheMax);
+                p.measureGlyphsCache.setMax(textCacheMax);
+                p.glyphsCache.setMax(textCacheMax);
+                p.textLinesCache.setMax(textCacheMax);
+                p.textCacheHits = 0;
+                p.textCacheMisses = 0;
 
                 p.fontNamesTimer = Time::Timer::create(context);
                 p.fontNamesTimer->setRepeating(true);
@@ -251,62 +376,82 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     std::stringstream ss;
-                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%";
+                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%\n";
+                    ss << "Text cache: " << getTextCacheSize() << ", " << getTextCacheHitRate() << "% hits";
                     _log(ss.str());
                 });
 
+                const size_t threadCount = std::max(
+                    static_cast<size_t>(1),
+                    std::min(static_cast<size_t>(std::thread::hardware_concurrency()), threadCountMax));
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.workers.push_back(std::unique_ptr<Worker>(new Worker));
+                }
+                {
+                    std::stringstream ss;
+                    ss << "Thread count: " << threadCount;
+                    _log(ss.str());
+                }
+
                 p.running = true;
-                p.thread = std::thread(
-                    [this]
+                for (size_t i = 0; i < threadCount; ++i)
                 {
-                    DJV_PRIVATE_PTR();
-                    _initFreeType();
-                    const auto timeout = Time::getValue(Time::TimerValue::Fast);
-                    while (p.running)
+                    Worker* worker = p.workers[i].get();
+                    worker->thread = std::thread(
+                        [this, worker, i]
                     {
+                        DJV_PRIVATE_PTR();
+                        _initFreeType(*worker, 0 == i);
+                        const auto timeout = Time::getValue(Time::TimerValue::Fast);
+                        while (p.running)
                         {
-                            std::unique_lock<std::mutex> lock(p.requestMutex);
-                            p.requestCV.wait_for(
-                                lock,
-                                std::chrono::milliseconds(timeout),
-                                [this]
+                            bool pending = false;
                             {
-                                DJV_PRIVATE_PTR();
-                                return
-                                    p.metricsQueue.size() ||
-                                    p.measureQueue.size() ||
-                                    p.glyphsQueue.size() ||
-                                    p.textLinesQueue.size();
-                            });
-                            p.metricsRequests = std::move(p.metricsQueue);
-                            p.measureRequests = std::move(p.measureQueue);
-                            p.measureGlyphsRequests = std::move(p.measureGlyphsQueue);
-                            p.glyphsRequests = std::move(p.glyphsQueue);
-                            p.textLinesRequests = std::move(p.textLinesQueue);
-                        }
-                        if (p.metricsRequests.size())
-                        {
-                            _handleMetricsRequests();
-                        }
-                        if (p.measureRequests.size())
-                        {
-                            _handleMeasureRequests();
-                        }
-                        if (p.measureGlyphsRequests.size())
-                        {
-                            _handleMeasureGlyphsRequests();
-                        }
-                        if (p.glyphsRequests.size())
-                        {
-                            _handleGlyphsRequests();
-                        }
-                        if (p.textLinesRequests.size())
-                        {
-                            _handleTextLinesRequests();
+                                std::unique_lock<std::mutex> lock(p.requestMutex);
+                                p.requestCV.wait_for(
+                                    lock,
+                                    std::chrono::milliseconds(timeout),
+                                    [this]
+                                {
+                                    return _p->hasRequests();
+                                });
+                                const size_t threadCount = p.workers.size();
+                                takeRequests(p.metricsQueue, worker->metricsRequests, threadCount);
+                                takeRequests(p.measureQueue, worker->measureRequests, threadCount);
+                                takeRequests(p.measureGlyphsQueue, worker->measureGlyphsRequests, threadCount);
+                                takeRequests(p.glyphsQueue, worker->glyphsRequests, threadCount);
+                                takeRequests(p.textLinesQueue, worker->textLinesRequests, threadCount);
+                                pending = p.hasRequests();
+                            }
+                            if (pending)
+                            {
+                                p.requestCV.notify_one();
+                            }
+                            if (worker->metricsRequests.size())
+                            {
+                                _handleMetricsRequests(*worker);
+                            }
+                            if (worker->measureRequests.size())
+                            {
+                                _handleMeasureRequests(*worker);
+                            }
+                            if (worker->measureGlyphsRequests.size())
+                            {
+                                _handleMeasureGlyphsRequests(*worker);
+                            }
+                            if (worker->glyphsRequests.size())
+                            {
+                                _handleGlyphsRequests(*worker);
+                            }
+                            if (worker->textLinesRequests.size())
+                            {
+                                _handleTextLinesRequests(*worker);
+                            }
                         }
-                    }
-                    _delFreeType();
-                });
+                        _delFreeType(*worker);
+                    });
+                }
             }
 
             System::System() :
@@ -317,9 +462,12 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
-                if (p.thread.joinable())
+                for (const auto& i : p.workers)
                 {
-                    p.thread.join();
+                    if (i->thread.joinable())
+                    {
+                        i->thread.join();
+                    }
                 }
             }
 
@@ -338,6 +486,11 @@ namespace djv
             std::future<Metrics> System::getMetrics(const Info & info)
             {
                 DJV_PRIVATE_PTR();
+                Metrics metrics;
+                if (p.getCached(p.metricsCache, info, metrics))
+                {
+                    return getReadyFuture(metrics);
+                }
                 MetricsRequest request;
                 request.info = info;
                 auto future = request.promise.get_future();
@@ -352,6 +505,11 @@ namespace djv
             std::future<glm::vec2> System::measure(const std::string& text, const Info& info)
             {
                 DJV_PRIVATE_PTR();
+                glm::vec2 size = glm::vec2(0.F, 0.F);
+                if (p.getCached(p.measureCache, TextCacheKey(text, info), size))
+                {
+                    return getReadyFuture(size);
+                }
                 MeasureRequest request;
                 request.text = text;
                 request.info = info;
@@ -367,6 +525,11 @@ namespace djv
             std::future<std::vector<BBox2f> > System::measureGlyphs(const std::string& text, const Info& info)
             {
                 DJV_PRIVATE_PTR();
+                std::vector<BBox2f> glyphGeom;
+                if (p.getCached(p.measureGlyphsCache, TextCacheKey(text, info), glyphGeom))
+                {
+                    return getReadyFuture(glyphGeom);
+                }
                 MeasureGlyphsRequest request;
                 request.text = text;
                 request.info = info;
@@ -382,6 +545,11 @@ namespace djv
             std::future<std::vector<std::shared_ptr<Glyph> > > System::getGlyphs(const std::string& text, const Info& info)
             {
                 DJV_PRIVATE_PTR();
+                std::vector<std::shared_ptr<Glyph> > glyphs;
+                if (p.getCached(p.glyphsCache, TextCacheKey(text, info), glyphs))
+                {
+                    return getReadyFuture(glyphs);
+                }
                 GlyphsRequest request;
                 request.text = text;
                 request.info = info;
@@ -397,6 +565,11 @@ namespace djv
             std::future<std::vector<TextLine> > System::textLines(const std::string& text, uint16_t maxLineWidth, const Info& info)
             {
                 DJV_PRIVATE_PTR();
+                std::vector<TextLine> lines;
+                if (p.getCached(p.textLinesCache, TextCacheKey(text, info, maxLineWidth), lines))
+                {
+                    return getReadyFuture(lines);
+                }
                 TextLinesRequest request;
                 request.text = text;
                 request.info = info;
@@ -413,6 +586,13 @@ namespace djv
             void System::cacheGlyphs(const std::string& text, const Info& info)
             {
                 DJV_PRIVATE_PTR();
+                {
+                    std::unique_lock<std::mutex> lock(p.textCacheMutex);
+                    if (p.glyphsCache.contains(TextCacheKey(text, info)))
+                    {
+                        return;
+                    }
+                }
                 GlyphsRequest request;
                 request.text = text;
                 request.info = info;
@@ -434,28 +614,53 @@ namespace djv
                 return _p->glyphCachePercentageUsed;
             }
 
-            void System::_initFreeType()
+            size_t System::getTextCacheSize() const
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.textCacheMutex);
+                return
+                    p.metricsCache.getSize() +
+                    p.measureCache.getSize() +
+                    p.measureGlyphsCache.getSize() +
+                    p.glyphsCache.getSize() +
+                    p.textLinesCache.getSize();
+            }
+
+            float System::getTextCacheHitRate() const
+            {
+                DJV_PRIVATE_PTR();
+                const size_t hits = p.textCacheHits;
+                const size_t total = hits + p.textCacheMisses;
+                return total > 0 ? (hits / static_cast<float>(total) * 100.F) : 0.F;
+            }
+
+            void System::_initFreeType(Worker& worker, bool primary)
             {
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    FT_Error ftError = FT_Init_FreeType(&p.ftLibrary);
+                    FT_Error ftError = FT_Init_FreeType(&worker.ftLibrary);
                     if (ftError)
                     {
                         throw Error("FreeType cannot be initialized.");
                     }
-                    int versionMajor = 0;
-                    int versionMinor = 0;
-                    int versionPatch = 0;
-                    FT_Library_Version(p.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
+                    if (primary)
                     {
+                        int versionMajor = 0;
+                        int versionMinor = 0;
+                        int versionPatch = 0;
+                        FT_Library_Version(worker.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
                         std::stringstream ss;
                         ss << "FreeType version: " << versionMajor << "." << versionMinor << "." << versionPatch;
                         _log(ss.str());
                     }
-                    for (const auto & i : FileSystem::FileInfo::directoryList(p.fontPath))
+
+                    const FaceID faceID = 1;
+                    for (const auto & i : p.fontFiles)
                     {
-                        const std::string & fileName = i.getFileName();
+                        const FamilyID familyID = i.familyID;
+                        const std::string & fileName = i.fileName;
+                        if (primary)
                         {
                             std::stringstream ss;
                             ss << "Loading font: " << fileName;
@@ -463,32 +668,43 @@ namespace djv
                         }
 
                         FT_Face ftFace;
-                        ftError = FT_New_Face(p.ftLibrary, fileName.c_str(), 0, &ftFace);
+                        ftError = i.entry ?
+                            FT_New_Memory_Face(
+                                worker.ftLibrary,
+                                reinterpret_cast<const FT_Byte*>(p.bundle->getData(*i.entry)),
+                                static_cast<FT_Long>(i.entry->size),
+                                0,
+                                &ftFace) :
+                            FT_New_Face(worker.ftLibrary, fileName.c_str(), 0, &ftFace);
                         if (ftError)
                         {
-                            std::stringstream ss;
-                            ss << "Cannot load font: " << fileName;
-                            _log(ss.str(), LogLevel::Error);
+                            if (primary)
+                            {
+                                std::stringstream ss;
+                                ss << "Cannot load font: " << fileName;
+                                _log(ss.str(), LogLevel::Error);
+                            }
                         }
                         else
                         {
-                            std::stringstream ss;
-                            ss << "    Family: " << ftFace->family_name << '\n';
-                            ss << "    Style: " << ftFace->style_name << '\n';
-                            ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
-                            ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
-                            ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
-                            _log(ss.str());
-                            static FamilyID familyID = 0;
-                            static FaceID faceID = 1;
-                            ++familyID;
-                            p.fontFileNames[familyID] = fileName;
-                            p.fontNames[familyID] = ftFace->family_name;
-                            p.fontFaceNames[familyID][faceID] = ftFace->style_name;
-                            p.fontFaces[familyID][faceID] = ftFace;
+                            worker.fontFaces[familyID][faceID] = ftFace;
+                            if (primary)
+                            {
+                                std::stringstream ss;
+                                ss << "    Family: " << ftFace->family_name << '\n';
+                                ss << "    Style: " << ftFace->style_name << '\n';
+                                ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
+                                ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
+                                ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
+                                _log(ss.str());
+                                std::unique_lock<std::mutex> lock(p.fontNamesMutex);
+                                p.fontFileNames[familyID] = fileName;
+                                p.fontNames[familyID] = ftFace->family_name;
+                                p.fontFaceNames[familyID][faceID] = ftFace->style_name;
+                            }
                         }
                     }
-                    if (!p.fontFaces.size())
+                    if (!worker.fontFaces.size())
                     {
                         throw Error("No fonts were found.");
                     }
@@ -499,30 +715,29 @@ namespace djv
                 }
             }
 
-            void System::_delFreeType()
+            void System::_delFreeType(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-                if (p.ftLibrary)
+                if (worker.ftLibrary)
                 {
-                    for (const auto & i : p.fontFaces)
+                    for (const auto & i : worker.fontFaces)
                     {
                         for (const auto & j : i.second)
                         {
                             FT_Done_Face(j.second);
                         }
                     }
-                    FT_Done_FreeType(p.ftLibrary);
+                    FT_Done_FreeType(worker.ftLibrary);
                 }
             }
 
-            void System::_handleMetricsRequests()
+            void System::_handleMetricsRequests(Worker& worker)
             {
                 DJV_PRIVATE_PTR();
-                for (auto & request : p.metricsRequests)
+                for (auto & request : worker.metricsRequests)
                 {
                     Metrics metrics;
-                    const auto family = p.fontFaces.find(request.info.getFamily());
-                    if (family != p.fontFaces.end())
+                    const auto family = worker.fontFaces.find(request.info.getFamily());
+                    if (family != worker.fontFaces.end())
                     {
                         const auto font = family->second.find(request.info.getFace());
                         if (font != family->second.end())
@@ -545,23 +760,25 @@ namespace djv
                             }
                         }
                     }
+                    p.addCached(p.metricsCache, request.info, metrics);
                     request.promise.set_value(std::move(metrics));
                 }
-                p.metricsRequests.clear();
+                worker.metricsRequests.clear();
             }
 
-            void System::_handleMeasureRequests()
+            void System::_handleMeasureRequests(Worker& worker)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.measureRequests)
+                for (auto& request : worker.measureRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
                     FT_Face font;
                     std::string error;
                     glm::vec2 size = glm::vec2(0.F, 0.F);
-                    if (p.getText(request.text, request.info, utf32, font, error))
+                    if (p.getText(worker, request.text, request.info, utf32, font, error))
                     {
-                        p.measure(utf32, request.info, font, request.maxLineWidth, size);
+                        p.measure(worker, utf32, request.info, font, request.maxLineWidth, size);
+                        p.addCached(p.measureCache, TextCacheKey(request.text, request.info), size);
                     }
                     else
                     {
@@ -571,22 +788,23 @@ namespace djv
                     }
                     request.promise.set_value(size);
                 }
-                p.measureRequests.clear();
+                worker.measureRequests.clear();
             }
 
-            void System::_handleMeasureGlyphsRequests()
+            void System::_handleMeasureGlyphsRequests(Worker& worker)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.measureGlyphsRequests)
+                for (auto& request : worker.measureGlyphsRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
                     FT_Face font;
                     std::string error;
                     glm::vec2 size = glm::vec2(0.F, 0.F);
                     std::vector<BBox2f> glyphGeom;
-                    if (p.getText(request.text, request.info, utf32, font, error))
+                    if (p.getText(worker, request.text, request.info, utf32, font, error))
                     {
-                        p.measure(utf32, request.info, font, request.maxLineWidth, size, &glyphGeom);
+                        p.measure(worker, utf32, request.info, font, request.maxLineWidth, size, &glyphGeom);
+                        p.addCached(p.measureGlyphsCache, TextCacheKey(request.text, request.info), glyphGeom);
                     }
                     else
                     {
@@ -596,18 +814,20 @@ namespace djv
                     }
                     request.promise.set_value(glyphGeom);
                 }
-                p.measureGlyphsRequests.clear();
+                worker.measureGlyphsRequests.clear();
             }
 
-            void System::_handleGlyphsRequests()
+            void System::_handleGlyphsRequests(Worker& worker)
             {
                 DJV_PRIVATE_PTR();
-                for (auto & request : p.glyphsRequests)
+                for (auto & request : worker.glyphsRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
+                    bool valid = false;
                     try
                     {
-                        utf32 = p.utf32Convert.from_bytes(request.text);
+                        utf32 = worker.utf32Convert.from_bytes(request.text);
+                        valid = true;
                     }
                     catch (const std::exception & e)
                     {
@@ -616,30 +836,27 @@ namespace djv
                         _log(ss.str(), LogLevel::Error);
                     }
                     const size_t size = utf32.size();
-                    if (request.cacheOnly)
+                    std::vector<std::shared_ptr<Glyph> > glyphs(size);
+                    for (size_t i = 0; i < size; ++i)
                     {
-                        for (size_t i = 0; i < size; ++i)
-                        {
-                            p.getGlyph(GlyphInfo(utf32[i], request.info));
-                        }
+                        glyphs[i] = p.getGlyph(worker, GlyphInfo(utf32[i], request.info));
                     }
-                    else
+                    if (valid)
+                    {
+                        p.addCached(p.glyphsCache, TextCacheKey(request.text, request.info), glyphs);
+                    }
+                    if (!request.cacheOnly)
                     {
-                        std::vector<std::shared_ptr<Glyph> > glyphs(size);
-                        for (size_t i = 0; i < size; ++i)
-                        {
-                            glyphs[i] = p.getGlyph(GlyphInfo(utf32[i], request.info));
-                        }
                         request.promise.set_value(std::move(glyphs));
                     }
                 }
-                p.glyphsRequests.clear();
+                worker.glyphsRequests.clear();
             }
 
-            void System::_handleTextLinesRequests()
+            void System::_handleTextLinesRequests(Worker& worker)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.textLinesRequests)
+                for (auto& request : worker.textLinesRequests)
                 {
                     // Input:
                     //   Speckled Dace are capable of |living in an array of habitats
@@ -660,7 +877,7 @@ namespace djv
                     FT_Face font;
                     std::string error;
                     std::vector<TextLine> lines;
-                    if (p.getText(request.text, request.info, utf32, font, error))
+                    if (p.getText(worker, request.text, request.info, utf32, font, error))
                     {
                         // Get the glyphs.
                         std::vector<std::shared_ptr<Glyph> > glyphs(utf32.size());
@@ -669,7 +886,7 @@ namespace djv
                         for (; i != utf32.end(); ++i)
                         {
                             const auto info = GlyphInfo(*i, request.info);
-                            auto glyph = p.getGlyph(info);
+                            auto glyph = p.getGlyph(worker, info);
                             glyphs[i - utf32Begin] = glyph;
                         }
 
@@ -709,7 +926,7 @@ namespace djv
                                     const size_t offset = lineBegin - utf32.begin();
                                     const size_t size = i - lineBegin;
                                     TextLine line;
-                                    line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                    line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                     line.size = glm::vec2(pos.x, font->size->metrics.height / 64.F);
                                     line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                     lines.push_back(line);
@@ -738,7 +955,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(lineBreakPos, font->size->metrics.height / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -761,7 +978,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(pos.x, font->size->metrics.height / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -798,7 +1015,7 @@ namespace djv
                                 const size_t offset = lineBegin - utf32.begin();
                                 const size_t size = i - lineBegin;
                                 TextLine textLine;
-                                textLine.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                textLine.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                 textLine.size = glm::vec2(pos.x, font->size->metrics.height / 64.F);
                                 textLine.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                 lines.push_back(textLine);
@@ -810,6 +1027,8 @@ namespace djv
                                 _log(ss.str(), LogLevel::Error);
                             }
                         }
+
+                        p.addCached(p.textLinesCache, TextCacheKey(request.text, request.info, request.maxLineWidth), lines);
                     }
                     else
                     {
@@ -819,10 +1038,21 @@ namespace djv
                     }
                     request.promise.set_value(lines);
                 }
-                p.textLinesRequests.clear();
+                worker.textLinesRequests.clear();
+            }
+
+            bool System::Private::hasRequests() const
+            {
+                return
+                    metricsQueue.size() ||
+                    measureQueue.size() ||
+                    measureGlyphsQueue.size() ||
+                    glyphsQueue.size() ||
+                    textLinesQueue.size();
             }
 
             bool System::Private::getText(
+                Worker& worker,
                 const std::string& value,
                 const Info& info,
                 std::basic_string<djv_char_t>& utf32,
@@ -830,8 +1060,8 @@ namespace djv
                 std::string& error)
             {
                 bool out = false;
-                const auto family = fontFaces.find(info.getFamily());
-                if (family != fontFaces.end())
+                const auto family = worker.fontFaces.find(info.getFamily());
+                if (family != worker.fontFaces.end())
                 {
                     auto i = family->second.find(info.getFace());
                     if (i != family->second.end())
@@ -850,7 +1080,7 @@ namespace djv
                         {
                             try
                             {
-                                utf32 = utf32Convert.from_bytes(value);
+                                utf32 = worker.utf32Convert.from_bytes(value);
                                 font = i->second;
                                 out = true;
                             }
@@ -864,18 +1094,23 @@ namespace djv
                 return out;
             }
 
-            std::shared_ptr<Glyph> System::Private::getGlyph(const GlyphInfo & info)
+            std::shared_ptr<Glyph> System::Private::getGlyph(Worker& worker, const GlyphInfo & info)
             {
                 std::shared_ptr<Glyph> out;
+                bool cached = false;
+                {
+                    std::unique_lock<std::mutex> lock(glyphCacheMutex);
+                    cached = glyphCache.get(info, out);
+                }
                 FT_Face ftFace = nullptr;
-                if (!glyphCache.get(info, out))
+                if (!cached)
                 {
                     out = Glyph::create();
                     out->info = info;
                     if (info.info.getFamily() != 0 || info.info.getFace() != 0)
                     {
-                        const auto i = fontFaces.find(info.info.getFamily());
-                        if (i != fontFaces.end())
+                        const auto i = worker.fontFaces.find(info.info.getFamily());
+                        if (i != worker.fontFaces.end())
                         {
                             const auto j = i->second.find(info.info.getFace());
                             if (j != i->second.end())
@@ -960,6 +1195,16 @@ namespace djv
                             out->rsbDelta = ftFace->glyph->rsb_delta;
                             FT_Done_Glyph(ftGlyph);
                         }
+                        // Another worker may have rendered the same glyph while
+                        // the lock was released; keep the first one so that every
+                        // request gets the same glyph object. The duplicate work is
+                        // tolerated rather than serializing rendering.
+                        std::unique_lock<std::mutex> lock(glyphCacheMutex);
+                        std::shared_ptr<Glyph> existing;
+                        if (glyphCache.get(info, existing))
+                        {
+                            return existing;
+                        }
                         glyphCache.add(info, out);
                         glyphCacheSize = glyphCache.getSize();
                         glyphCachePercentageUsed = glyphCache.getPercentageUsed();
@@ -969,6 +1214,7 @@ namespace djv
             }
 
             void System::Private::measure(
+                Worker& worker,
                 const std::basic_string<djv_char_t>& utf32,
                 const Info& info,
                 FT_Face font,
@@ -983,7 +1229,7 @@ namespace djv
                 for (auto i = utf32.begin(); i != utf32.end(); ++i)
                 {
                     const auto glyphInfo = GlyphInfo(*i, info);
-                    const auto glyph = getGlyph(glyphInfo);
+                    const auto glyph = getGlyph(worker, glyphInfo);
 
                     if (glyphGeom)
                     {
@@ -1053,6 +1299,32 @@ namespace djv
                 size.y = pos.y;
             }
 
+            template<typename T, typename U>
+            bool System::Private::getCached(const Memory::Cache<T, U>& cache, const T& key, U& value)
+            {
+                bool out = false;
+                {
+                    std::unique_lock<std::mutex> lock(textCacheMutex);
+                    out = cache.get(key, value);
+                }
+                if (out)
+                {
+                    ++textCacheHits;
+                }
+                else
+                {
+                    ++textCacheMisses;
+                }
+                return out;
+            }
+
+            template<typename T, typename U>
+            void System::Private::addCached(Memory::Cache<T, U>& cache, const T& key, const U& value)
+            {
+                std::unique_lock<std::mutex> lock(textCacheMutex);
+                cache.add(key, value);
+            }
+
         } // namespace Font
     } // namespace AV
 } // namespace djv
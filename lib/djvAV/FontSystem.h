@@ -140,6 +140,11 @@ namespace djv
 
             //! This class provides a font system.
             //!
+            //! Results are cached by text and font information; requests that hit
+            //! the cache return futures that are already ready. Requests that miss
+            //! the cache are spread across several worker threads, each with their
+            //! own FreeType instance.
+            //!
             //! \todo Add support for LCD pixel sub-sampling and gamma correction:
             //! - https://www.freetype.org/freetype2/docs/text-rendering-general.html
             class System : public Core::ISystem
@@ -194,15 +199,24 @@ namespace djv
 
                 //! Get the glyph cache percentage used.
                 float getGlyphCachePercentage() const;
+
+                //! Get the number of cached metrics, measurements, glyph runs,
+                //! and line breaks.
+                size_t getTextCacheSize() const;
+
+                //! Get the percentage of text requests that were served from the cache.
+                float getTextCacheHitRate() const;
             
             private:
-                void _initFreeType();
-                void _delFreeType();
-                void _handleMetricsRequests();
-                void _handleMeasureRequests();
-                void _handleTextLinesRequests();
-                void _handleMeasureGlyphsRequests();
-                void _handleGlyphsRequests();
+                struct Worker;
+
+                void _initFreeType(Worker&, bool primary);
+                void _delFreeType(Worker&);
+                void _handleMetricsRequests(Worker&);
+                void _handleMeasureRequests(Worker&);
+                void _handleTextLinesRequests(Worker&);
+                void _handleMeasureGlyphsRequests(Worker&);
+                void _handleGlyphsRequests(Worker&);
 
                 DJV_PRIVATE();
             };
@@ -52,7 +52,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides IFF image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
@@ -51,6 +51,7 @@ namespace djv
             {
                 static const std::string pluginName = "IFF";
                 static const std::set<std::string> fileExtensions = { ".iff", ".z" };
+                static const std::vector<std::string> magicNumbers = { "FOR4" };
 
                 //! This class provides the IFF file reader.
                 class Read : public ISequenceRead
@@ -74,10 +75,11 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO &);
-                    
-                    int  _tiles       = 0;
-                    bool _compression = false;
+                    Info _open(
+                        const std::string &,
+                        Core::FileSystem::FileIO &,
+                        int & tileCount,
+                        bool & compression);
                 };
 
                 //! This class provides the IFF file I/O plugin.
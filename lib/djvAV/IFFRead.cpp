@@ -33,6 +33,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -56,37 +58,146 @@ namespace djv
                         return size;
                     }
 
-                    size_t readRle(FileSystem::FileIO& io, uint8_t* out, size_t size)
+                    const uint8_t* readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size)
                     {
-                        const size_t pos = io.getPos();
-                        const uint8_t* const end = out + size;
-                        while (out < end)
+                        const uint8_t* const outEnd = out + size;
+                        while (out < outEnd)
                         {
                             // Information.
-                            uint8_t in = 0;
-                            io.readU8(&in);
-                            const uint8_t count = (in & 0x7f) + 1;
-                            const bool run = (in & 0x80) ? true : false;
+                            if (in >= end)
+                            {
+                                return nullptr;
+                            }
+                            const size_t count = (*in & 0x7f) + 1;
+                            const bool run = (*in & 0x80) ? true : false;
+                            ++in;
+                            if (out + count > outEnd)
+                            {
+                                return nullptr;
+                            }
 
                             // Find runs.
                             if (!run)
                             {
                                 // Verbatim.
-                                io.readU8(out, count);
-                                out += count;
+                                if (in + count > end)
+                                {
+                                    return nullptr;
+                                }
+                                memcpy(out, in, count);
+                                in += count;
                             }
                             else
                             {
                                 // Duplicate.
-                                io.readU8(&in);
-                                const uint8_t p = in;
-                                for (int i = 0; i < count; i++)
+                                if (in >= end)
+                                {
+                                    return nullptr;
+                                }
+                                memset(out, *in, count);
+                                ++in;
+                            }
+                            out += count;
+                        }
+                        return in;
+                    }
+
+                    //! This struct provides the data for a tile, read from the
+                    //! file so that the tiles can be decoded in parallel.
+                    struct Tile
+                    {
+                        uint16_t xmin = 0;
+                        uint16_t ymin = 0;
+                        uint16_t xmax = 0;
+                        uint16_t ymax = 0;
+                        bool compression = false;
+                        std::vector<uint8_t> data;
+                    };
+
+                    void readTile(const Tile& tile, Image::Image& out)
+                    {
+                        const Image::Type type = out.getType();
+                        const size_t channels = Image::getChannelCount(type);
+                        const size_t channelByteCount = Image::getByteCount(Image::getDataType(type));
+                        const size_t byteCount = Image::getByteCount(type);
+                        const size_t tw = tile.xmax - tile.xmin + 1;
+                        const size_t th = tile.ymax - tile.ymin + 1;
+                        const uint8_t* p = tile.data.data();
+                        const uint8_t* const end = p + tile.data.size();
+                        if (tile.compression)
+                        {
+                            // The channel bytes are stored in planes in reverse
+                            // order, map them to the image bytes.
+                            const bool lsb = Memory::getEndian() == Memory::Endian::LSB;
+                            const int rgb16[]  = { 0, 2, 4, 1, 3, 5 };
+                            const int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
+                            const int rgb16MSB[]  = { 1, 3, 5, 0, 2, 4 };
+                            const int rgba16MSB[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+                            const int* map = nullptr;
+                            switch (type)
+                            {
+                            case Image::Type::RGB_U16:  map = lsb ? rgb16 : rgb16MSB; break;
+                            case Image::Type::RGBA_U16: map = lsb ? rgba16 : rgba16MSB; break;
+                            default: break;
+                            }
+                            std::vector<uint8_t> plane(tw * th);
+                            for (int c = static_cast<int>(channels * channelByteCount) - 1; c >= 0; --c)
+                            {
+                                // Uncompress.
+                                p = readRle(p, end, plane.data(), tw * th);
+                                if (!p)
                                 {
-                                    *out++ = p;
+                                    throw FileSystem::Error(DJV_TEXT("File not supported."));
+                                }
+                                const uint8_t* inP = plane.data();
+                                const size_t mc = map ? map[c] : c;
+                                for (uint16_t py = tile.ymin; py <= tile.ymax; ++py)
+                                {
+                                    uint8_t* outP = out.getData(tile.xmin, py) + mc;
+                                    for (size_t px = 0; px < tw; ++px, outP += byteCount)
+                                    {
+                                        *outP = *inP++;
+                                    }
+                                }
+                            }
+                            if (p != end)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("File not supported."));
+                            }
+                        }
+                        else
+                        {
+                            if (tile.data.size() < tw * th * byteCount)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("File not supported."));
+                            }
+                            // Map: ABGR to RGBA
+                            const bool swap = channelByteCount > 1 && Memory::getEndian() == Memory::Endian::LSB;
+                            for (uint16_t py = tile.ymin; py <= tile.ymax; ++py)
+                            {
+                                uint8_t* outP = out.getData(tile.xmin, py);
+                                for (size_t px = 0; px < tw; ++px, p += byteCount)
+                                {
+                                    for (size_t c = 0; c < channels; ++c, outP += channelByteCount)
+                                    {
+                                        const uint8_t* inP = p + (channels - 1 - c) * channelByteCount;
+                                        if (swap)
+                                        {
+                                            outP[0] = inP[1];
+                                            outP[1] = inP[0];
+                                        }
+                                        else
+                                        {
+                                            memcpy(outP, inP, channelByteCount);
+                                        }
+                                    }
                                 }
                             }
                         }
-                        return io.getPos() - pos;
                     }
 
                 } // namespace
@@ -113,24 +224,27 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    int tileCount = 0;
+                    bool compression = false;
+                    return _open(fileName, io, tileCount, compression);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     std::shared_ptr<Image::Image> out;
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
+                    int tileCount = 0;
+                    bool compression = false;
+                    const auto info = _open(fileName, io, tileCount, compression);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
                     uint8_t type[4];
-                    uint8_t pixels[32];
                     uint32_t size;
                     uint32_t chunkSize;
-                    uint32_t tilesRgba = _tiles;
+                    uint32_t tilesRgba = tileCount;
+                    std::vector<Tile> tiles;
 
-                    const size_t channelByteCount = Image::getByteCount(Image::getDataType(info.video[0].info.type));
                     const size_t byteCount = Image::getByteCount(info.video[0].info.type);
 
                     // Read FOR4 <size> TBMP block
@@ -198,19 +312,17 @@ namespace djv
                                         uint32_t imageSize = size;
 
                                         // Get tile coordinates.
-                                        uint16_t xmin;
-                                        uint16_t xmax;
-                                        uint16_t ymin;
-                                        uint16_t ymax;
-                                        io.readU16(&xmin, 1);
-                                        io.readU16(&ymin, 1);
-                                        io.readU16(&xmax, 1);
-                                        io.readU16(&ymax, 1);
-
-                                        if (xmin > xmax ||
-                                            ymin > ymax ||
-                                            xmax >= info.video[0].info.size.w ||
-                                            ymax >= info.video[0].info.size.h)
+                                        Tile tile;
+                                        io.readU16(&tile.xmin, 1);
+                                        io.readU16(&tile.ymin, 1);
+                                        io.readU16(&tile.xmax, 1);
+                                        io.readU16(&tile.ymax, 1);
+
+                                        if (imageSize < 8 ||
+                                            tile.xmin > tile.xmax ||
+                                            tile.ymin > tile.ymax ||
+                                            tile.xmax >= info.video[0].info.size.w ||
+                                            tile.ymax >= info.video[0].info.size.h)
                                         {
                                             throw FileSystem::Error(DJV_TEXT("File not supported."));
                                         }
@@ -218,234 +330,34 @@ namespace djv
                                         // NOTE: tile w = xmax - xmin + 1
                                         //       tile h = ymax - ymin + 1
 
-                                        uint32_t tw = xmax - xmin + 1;
-                                        uint32_t th = ymax - ymin + 1;
-
-                                        if (!tw || !th)
-                                        {
-                                            throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                        }
-
-                                        bool tile_compress = false;
+                                        const uint32_t tw = tile.xmax - tile.xmin + 1;
+                                        const uint32_t th = tile.ymax - tile.ymin + 1;
 
                                         // If tile compression fails to be less than
                                         // image data stored uncompressed, the tile
                                         // is written uncompressed.
 
-                                        // Set channels.
-                                        uint8_t channels = Image::getChannelCount(info.video[0].info.type);
-
-                                        // Set tile pixels.
-
                                         // Append xmin, xmax, ymin and ymax.
-                                        uint32_t tileSize =
-                                            tw * th * channels *
-                                            Image::getByteCount(Image::getDataType(info.video[0].info.type)) + 8;
+                                        const uint32_t tileSize = tw * th * byteCount + 8;
 
                                         // Test compressed.
-                                        if (tileSize > imageSize)
-                                        {
-                                            tile_compress = true;
-                                        }
+                                        tile.compression = tileSize > imageSize;
 
-                                        // Handle 8-bit data.
-                                        if (info.video[0].info.type == Image::Type::RGB_U8 ||
-                                            info.video[0].info.type == Image::Type::RGBA_U8)
+                                        switch (info.video[0].info.type)
                                         {
-                                            // Tile compress.
-                                            if (tile_compress)
-                                            {
-                                                int p = 0;
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1;
-                                                    c >= 0;
-                                                    --c)
-                                                {
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + c;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
-                                                {
-                                                    throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                }
-                                            }
-                                            else
-                                            {
-                                                for (uint16_t py = ymin; py <= ymax; py++)
-                                                {
-                                                    uint8_t* out_dy = out->getData(xmin, py);
-
-                                                    // Tile scanline.
-                                                    std::vector<uint8_t> scanline(tw * byteCount);
-                                                    uint8_t* outP = scanline.data();
-
-                                                    // Set bytes.
-                                                    for (uint16_t px = xmin; px <= xmax; px++)
-                                                    {
-                                                        // Get pixels.
-                                                        io.read(&pixels, byteCount);
-
-                                                        if (size < static_cast<uint32_t>(byteCount))
-                                                        {
-                                                            throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                        }
-
-                                                        size -= byteCount;
-
-                                                        // Map: RGB(A)8 ABGR to ARGB
-                                                        for (int c = channels - 1; c >= 0; --c)
-                                                        {
-                                                            uint8_t pixel;
-                                                            uint8_t* inP = pixels + c * channelByteCount;
-                                                            memcpy(&pixel, inP, 1);
-                                                            *outP++ = pixel;
-                                                        }
-                                                    }
-
-                                                    // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
-                                                }
-                                            }
-                                        }
-                                        // Handle 16-bit data.
-                                        else if (
-                                            info.video[0].info.type == Image::Type::RGB_U16 ||
-                                            info.video[0].info.type == Image::Type::RGBA_U16)
-                                        {
-                                            if (tile_compress)
-                                            {
-                                                // Set bytes.
-                                                int p = 0;
-
-                                                // Set map.
-                                                int* map = NULL;
-
-                                                if (Memory::getEndian() == Memory::Endian::LSB)
-                                                {
-                                                    int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                                    int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                                    if (info.video[0].info.type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-                                                else
-                                                {
-                                                    int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                                    int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                                    if (info.video[0].info.type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
-                                                {
-                                                    int mc = map[c];
-
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + mc;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
-                                                {
-                                                    throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                }
-                                            }
-                                            else
-                                            {
-                                                for (uint16_t py = ymin; py <= ymax; py++)
-                                                {
-                                                    uint8_t* out_dy = out->getData(xmin, py);
-
-                                                    // Tile scanline.
-                                                    std::vector<uint16_t> scanline(tw * byteCount);
-                                                    uint16_t* outP = scanline.data();
-
-                                                    // Set bytes.
-                                                    for (uint16_t px = xmin; px <= xmax; px++)
-                                                    {
-                                                        // Get pixels.
-                                                        io.read(&pixels, byteCount);
-
-                                                        if (size < static_cast<uint32_t>(byteCount))
-                                                        {
-                                                            throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                        }
-
-                                                        size -= byteCount;
-
-                                                        // Map: RGB8 ABGR to ARGB
-                                                        for (int c = channels - 1; c >= 0; --c)
-                                                        {
-                                                            uint16_t pixel;
-                                                            uint8_t* in = pixels + c * channelByteCount;
-
-                                                            if (Memory::getEndian() == Memory::Endian::LSB)
-                                                            {
-                                                                Memory::endian(in, &pixel, 1, 2);
-                                                            }
-                                                            else
-                                                            {
-                                                                memcpy(&pixel, in, 2);
-                                                            }
-
-                                                            // Set pixel.
-                                                            *outP++ = pixel;
-                                                        }
-                                                    }
-
-                                                    // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
-                                                }
-                                            }
-                                        }
-                                        else
-                                        {
-                                            io.seek(chunkSize);
+                                        case Image::Type::RGB_U8:
+                                        case Image::Type::RGBA_U8:
+                                        case Image::Type::RGB_U16:
+                                        case Image::Type::RGBA_U16:
+                                            // Read the tile data, it is decoded after
+                                            // all of the tiles have been read.
+                                            tile.data.resize(imageSize - 8);
+                                            io.read(tile.data.data(), tile.data.size());
+                                            tiles.push_back(std::move(tile));
+                                            break;
+                                        default:
+                                            io.seek(imageSize - 8);
+                                            break;
                                         }
 
                                         // Seek to align to chunksize.
@@ -486,6 +398,28 @@ namespace djv
                         }
                     }
 
+                    // Decode the tiles.
+                    const size_t threadCount = getBlockThreadCount(tiles.size());
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
+                    {
+                        const size_t begin = i * tiles.size() / threadCount;
+                        const size_t end = (i + 1) * tiles.size() / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [&tiles, out, begin, end]
+                            {
+                                for (size_t j = begin; j < end; ++j)
+                                {
+                                    readTile(tiles[j], *out);
+                                }
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+
                     return out;
                 }
 
@@ -737,12 +671,16 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io)
+                Info Read::_open(
+                    const std::string &  fileName,
+                    FileSystem::FileIO & io,
+                    int &                tileCount,
+                    bool &               compression)
                 {
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
                     io.open(fileName, FileSystem::FileIO::Mode::Read);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _tiles, _compression);
+                    Header().read(io, imageInfo, tileCount, compression);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -56,12 +56,15 @@
 #endif // TIFF_FOUND
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/Path.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/String.h>
 
+#include <unordered_map>
+
 using namespace djv::Core;
 
 namespace djv
@@ -162,37 +165,14 @@ namespace djv
 
             Frame::Sequence Cache::getFrames() const
             {
-                Frame::Sequence out;
                 std::vector<Frame::Index> frames;
+                frames.reserve(_cache.size());
                 for (const auto& i : _cache)
                 {
                     frames.push_back(i.first);
                 }
-                const size_t size = frames.size();
-                if (size)
-                {
-                    std::sort(frames.begin(), frames.end());
-                    Frame::Number rangeStart = frames[0];
-                    Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
-                    {
-                        if (frames[i] != prevFrame + 1)
-                        {
-                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
-                        }
-                    }
-                    if (size > 1)
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart));
-                    }
-                }
-                return out;
+                std::sort(frames.begin(), frames.end());
+                return Frame::fromFrames(frames);
             }
 
             void Cache::setMax(size_t value)
@@ -266,7 +246,7 @@ namespace djv
             {
                 const auto range = _inOutPoints.getRange(_sequenceSize);
                 Frame::Index frame = _currentFrame;
-                _sequence = Frame::Sequence();
+                std::vector<Frame::Range> ranges;
                 switch (_direction)
                 {
                 case Direction::Forward:
@@ -279,7 +259,7 @@ namespace djv
                             frame = range.max;
                         }
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
+                    ranges.push_back(Frame::Range(frame));
                     const Frame::Index first = frame;
                     for (size_t i = 0; i < _max; ++i)
                     {
@@ -291,14 +271,14 @@ namespace djv
                         if (frame > range.max)
                         {
                             frame = range.min;
-                            if (frame != _sequence.ranges.back().max)
+                            if (frame != ranges.back().max)
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                ranges.push_back(Frame::Range(frame));
                             }
                         }
                         else
                         {
-                            _sequence.ranges.back().max = frame;
+                            ranges.back().max = frame;
                         }
                     }
                     break;
@@ -313,7 +293,7 @@ namespace djv
                             frame = range.min;
                         }
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
+                    ranges.push_back(Frame::Range(frame));
                     const Frame::Index first = frame;
                     for (size_t i = 0; i < _max; ++i)
                     {
@@ -325,20 +305,21 @@ namespace djv
                         if (frame < range.min)
                         {
                             frame = range.max;
-                            if (frame != _sequence.ranges.back().max)
+                            if (frame != ranges.back().max)
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                ranges.push_back(Frame::Range(frame));
                             }
                         }
                         else
                         {
-                            _sequence.ranges.back().min = frame;
+                            ranges.back().min = frame;
                         }
                     }
                     break;
                 }
                 default: break;
                 }
+                _sequence.setRanges(ranges);
                 auto i = _cache.begin();
                 while (i != _cache.end())
                 {
@@ -364,6 +345,22 @@ namespace djv
             IRead::~IRead()
             {}
 
+            AudioQueue& IRead::getAudioTrackQueue(size_t track)
+            {
+                if (track == _options.audioTrack)
+                {
+                    return _audioQueue;
+                }
+                auto i = _audioTrackQueues.find(track);
+                if (i == _audioTrackQueues.end())
+                {
+                    std::unique_ptr<AudioQueue> queue(new AudioQueue);
+                    queue->setMax(_options.audioQueueSize);
+                    i = _audioTrackQueues.insert(std::make_pair(track, std::move(queue))).first;
+                }
+                return *i->second;
+            }
+
             void IRead::setPlayback(bool value)
             {
                 std::lock_guard<std::mutex> lock(_mutex);
@@ -434,7 +431,8 @@ namespace djv
                 const std::string& pluginName,
                 const std::string& pluginInfo,
                 const std::set<std::string>& fileExtensions,
-                const std::shared_ptr<Context>& context)
+                const std::shared_ptr<Context>& context,
+                const std::vector<std::string>& magicNumbers)
             {
                 _context        = context;
                 _logSystem      = context->getSystemT<LogSystem>();
@@ -442,6 +440,7 @@ namespace djv
                 _pluginName     = pluginName;
                 _pluginInfo     = pluginInfo;
                 _fileExtensions = fileExtensions;
+                _magicNumbers   = magicNumbers;
             }
 
             IPlugin::~IPlugin()
@@ -449,11 +448,16 @@ namespace djv
 
             namespace
             {
+                std::string getExtension(const FileSystem::Path& path)
+                {
+                    std::string out = path.getExtension();
+                    std::transform(out.begin(), out.end(), out.begin(), tolower);
+                    return out;
+                }
+
                 bool checkExtension(const std::string & value, const std::set<std::string> & extensions)
                 {
-                    std::string extension = FileSystem::Path(value).getExtension();
-                    std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
-                    return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+                    return extensions.find(getExtension(FileSystem::Path(value))) != extensions.end();
                 }
 
             } // namespace
@@ -493,11 +497,38 @@ namespace djv
                 return nullptr;
             }
 
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t magicNumberSizeMax = 16;
+
+                bool checkMagicNumbers(const std::string& value, const std::vector<std::string>& magicNumbers)
+                {
+                    for (const auto& i : magicNumbers)
+                    {
+                        if (value.size() >= i.size() && 0 == value.compare(0, i.size(), i))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+            } // namespace
+
             struct System::Private
             {
+                std::shared_ptr<GLFW::System> glfwSystem;
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
+                std::unordered_map<std::string, std::shared_ptr<IPlugin> > extensionToPlugin;
+                std::vector<std::pair<std::string, std::shared_ptr<IPlugin> > > magicNumberToPlugin;
+
+                std::shared_ptr<IPlugin> getPlugin(const FileSystem::FileInfo&) const;
+                std::shared_ptr<IPlugin> getReadPlugin(const FileSystem::FileInfo&) const;
+                std::shared_ptr<IPlugin> getMagicNumberPlugin(const std::string&) const;
+                static bool readMagicNumber(const FileSystem::FileInfo&, std::string&);
             };
 
             void System::_init(const std::shared_ptr<Context>& context)
@@ -506,7 +537,8 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(context->getSystemT<GLFW::System>());
+                // The GLFW system is not requested until something is written,
+                // so that reading doesn't require a display.
                 addDependency(context->getSystemT<OCIO::System>());
 
                 p.optionsChanged = ValueSubject<bool>::create();
@@ -541,7 +573,19 @@ namespace djv
                         const auto& fileExtensions = i.second->getFileExtensions();
                         p.sequenceExtensions.insert(fileExtensions.begin(), fileExtensions.end());
                     }
-                
+
+                    // The first plugin (in name order) registered for an extension
+                    // or magic number is used.
+                    for (const auto& j : i.second->getFileExtensions())
+                    {
+                        p.extensionToPlugin.insert(std::make_pair(j, i.second));
+                    }
+                    for (const auto& j : i.second->getMagicNumbers())
+                    {
+                        p.magicNumberToPlugin.push_back(std::make_pair(j, i.second));
+                    }
+
+
                     std::stringstream ss;
                     ss << "I/O plugin: " << i.second->getPluginName() << '\n';
                     ss << "    Information: " << i.second->getPluginInfo() << '\n';
@@ -622,49 +666,37 @@ namespace djv
             bool System::canSequence(const FileSystem::FileInfo& fileInfo) const
             {
                 DJV_PRIVATE_PTR();
-                return std::find(
-                    p.sequenceExtensions.begin(),
-                    p.sequenceExtensions.end(),
-                    fileInfo.getPath().getExtension()) != p.sequenceExtensions.end();
+                return p.sequenceExtensions.find(fileInfo.getPath().getExtension()) != p.sequenceExtensions.end();
             }
 
             bool System::canRead(const FileSystem::FileInfo& fileInfo) const
             {
                 DJV_PRIVATE_PTR();
-                for (const auto & i : p.plugins)
+                auto plugin = p.getPlugin(fileInfo);
+                if (plugin && plugin->canRead(fileInfo))
                 {
-                    if (i.second->canRead(fileInfo))
-                    {
-                        return true;
-                    }
+                    // The file can be read by either this plugin or the plugin
+                    // matching the magic number, so it doesn't need to be opened.
+                    return true;
                 }
-                return false;
+                return p.getReadPlugin(fileInfo) != nullptr;
             }
 
             bool System::canWrite(const FileSystem::FileInfo& fileInfo, const Info & info) const
             {
                 DJV_PRIVATE_PTR();
-                for (const auto & i : p.plugins)
-                {
-                    if (i.second->canWrite(fileInfo, info))
-                    {
-                        return true;
-                    }
-                }
-                return false;
+                auto plugin = p.getPlugin(fileInfo);
+                return plugin && plugin->canWrite(fileInfo, info);
             }
 
             std::shared_ptr<IRead> System::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options)
             {
                 DJV_PRIVATE_PTR();
+                auto plugin = p.getReadPlugin(fileInfo);
                 std::shared_ptr<IRead> out;
-                for (const auto & i : p.plugins)
+                if (plugin)
                 {
-                    if (i.second->canRead(fileInfo))
-                    {
-                        out = i.second->read(fileInfo, options);
-                        break;
-                    }
+                    out = plugin->read(fileInfo, options);
                 }
                 if (!out)
                 {
@@ -679,13 +711,19 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IWrite> out;
-                for (const auto & i : p.plugins)
+                auto plugin = p.getPlugin(fileInfo);
+                if (plugin && plugin->canWrite(fileInfo, info))
                 {
-                    if (i.second->canWrite(fileInfo, info))
+                    // Writers convert images with OpenGL.
+                    if (!p.glfwSystem)
                     {
-                        out = i.second->write(fileInfo, info, options);
-                        break;
+                        if (auto context = getContext().lock())
+                        {
+                            p.glfwSystem = context->getSystemT<GLFW::System>();
+                            addDependency(p.glfwSystem);
+                        }
                     }
+                    out = plugin->write(fileInfo, info, options);
                 }
                 if (!out)
                 {
@@ -696,6 +734,69 @@ namespace djv
                 return out;
             }
 
+            std::shared_ptr<IPlugin> System::Private::getPlugin(const FileSystem::FileInfo& fileInfo) const
+            {
+                const auto i = extensionToPlugin.find(getExtension(fileInfo.getPath()));
+                return i != extensionToPlugin.end() ? i->second : nullptr;
+            }
+
+            std::shared_ptr<IPlugin> System::Private::getReadPlugin(const FileSystem::FileInfo& fileInfo) const
+            {
+                auto plugin = getPlugin(fileInfo);
+                if (plugin && !plugin->canRead(fileInfo))
+                {
+                    plugin.reset();
+                }
+
+                // Only files without an extension, or with the extension of a
+                // plugin that has magic numbers, are opened here so that checking
+                // a directory listing doesn't touch every unrecognized file.
+                if (FileSystem::FileType::File == fileInfo.getType() &&
+                    ((!plugin && fileInfo.getPath().getExtension().empty()) ||
+                    (plugin && !plugin->getMagicNumbers().empty())))
+                {
+                    std::string magicNumber;
+                    if (readMagicNumber(fileInfo, magicNumber) &&
+                        (!plugin || !checkMagicNumbers(magicNumber, plugin->getMagicNumbers())))
+                    {
+                        if (auto magicNumberPlugin = getMagicNumberPlugin(magicNumber))
+                        {
+                            plugin = magicNumberPlugin;
+                        }
+                    }
+                }
+                return plugin;
+            }
+
+            std::shared_ptr<IPlugin> System::Private::getMagicNumberPlugin(const std::string& value) const
+            {
+                for (const auto& i : magicNumberToPlugin)
+                {
+                    if (checkMagicNumbers(value, { i.first }))
+                    {
+                        return i.second;
+                    }
+                }
+                return nullptr;
+            }
+
+            bool System::Private::readMagicNumber(const FileSystem::FileInfo& fileInfo, std::string& out)
+            {
+                bool r = false;
+                try
+                {
+                    FileSystem::FileIO io;
+                    io.open(fileInfo.getFileName(), FileSystem::FileIO::Mode::Read);
+                    const size_t size = std::min(io.getSize(), magicNumberSizeMax);
+                    out.resize(size);
+                    io.read(&out[0], size);
+                    r = size > 0;
+                }
+                catch (const std::exception&)
+                {}
+                return r;
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
@@ -31,6 +31,7 @@
 
 #include <djvAV/AudioData.h>
 #include <djvAV/Image.h>
+#include <djvAV/OCIO.h>
 #include <djvAV/Tags.h>
 
 #include <djvCore/Error.h>
@@ -42,6 +43,7 @@
 #include <djvCore/ValueObserver.h>
 
 #include <future>
+#include <map>
 #include <queue>
 #include <mutex>
 #include <set>
@@ -242,6 +244,18 @@ namespace djv
             {
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! The audio track to read into the audio queue when the file
+                //! has more than one.
+                size_t audioTrack = 0;
+
+                //! Enable this to also decode the other audio tracks, each into
+                //! its own queue (see IRead::getAudioTrackQueue()). The file is
+                //! still only demuxed once.
+                bool allAudioTracks = false;
+
+                //! Disable this to only read the audio from a file.
+                bool videoEnabled = true;
             };
 
             //! This class provides playback in/out points.
@@ -331,6 +345,12 @@ namespace djv
                 //! frame number, for audio files it represents the audio sample.
                 virtual void seek(int64_t value, Direction) = 0;
 
+                //! Get the queue for an audio track. The queue for
+                //! ReadOptions::audioTrack is the audio queue, the queues for
+                //! the other tracks are only filled when ReadOptions::allAudioTracks
+                //! is enabled. The mutex must be locked when calling this function.
+                AudioQueue& getAudioTrackQueue(size_t);
+
                 virtual bool hasCache() const { return false; }
                 bool isCacheEnabled() const;
                 size_t getCacheMaxByteCount() const;
@@ -351,12 +371,18 @@ namespace djv
                 Core::Frame::Sequence _cacheSequence;
                 Core::Frame::Sequence _cachedFrames;
                 Cache _cache;
+                std::map<size_t, std::unique_ptr<AudioQueue> > _audioTrackQueues;
             };
 
             //! This class provides options for writing.
             struct WriteOptions : IOOptions
             {
                 std::string colorSpace;
+
+                //! The color space conversion applied to images before they
+                //! are written. This is independent of colorSpace, which only
+                //! controls how the file is tagged.
+                OCIO::Convert colorSpaceConvert;
             };
 
             //! This class provides an interface for writing.
@@ -386,7 +412,8 @@ namespace djv
                     const std::string& pluginName,
                     const std::string& pluginInfo,
                     const std::set<std::string>& fileExtensions,
-                    const std::shared_ptr<Core::Context>&);
+                    const std::shared_ptr<Core::Context>&,
+                    const std::vector<std::string>& magicNumbers = std::vector<std::string>());
 
             public:
                 virtual ~IPlugin() = 0;
@@ -395,6 +422,9 @@ namespace djv
                 const std::string & getPluginInfo() const;
                 const std::set<std::string> & getFileExtensions() const;
 
+                //! Get the byte sequences that identify the start of a file.
+                const std::vector<std::string> & getMagicNumbers() const;
+
                 virtual bool canSequence() const;
                 virtual bool canRead(const Core::FileSystem::FileInfo&) const;
                 virtual bool canWrite(const Core::FileSystem::FileInfo&, const Info &) const;
@@ -420,6 +450,7 @@ namespace djv
                 std::string _pluginName;
                 std::string _pluginInfo;
                 std::set<std::string> _fileExtensions;
+                std::vector<std::string> _magicNumbers;
             };
 
             //! This class provides an I/O system.
@@ -449,9 +480,16 @@ namespace djv
 
                 const std::set<std::string>& getSequenceExtensions() const;
                 bool canSequence(const Core::FileSystem::FileInfo&) const;
+
+                //! This function uses the same rules as read(), files without an
+                //! extension are identified by their magic number.
                 bool canRead(const Core::FileSystem::FileInfo&) const;
                 bool canWrite(const Core::FileSystem::FileInfo&, const Info &) const;
 
+                //! The plugin is chosen by the file extension. Files without an
+                //! extension, or whose contents don't match their extension, are
+                //! identified by their magic number. Files with an unknown extension
+                //! are not opened.
                 //! Throws:
                 //! - Core::FileSystem::Error
                 std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions& = ReadOptions());
@@ -286,6 +286,11 @@ namespace djv
                 return _fileExtensions;
             }
 
+            inline const std::vector<std::string> & IPlugin::getMagicNumbers() const
+            {
+                return _magicNumbers;
+            }
+
             inline size_t Cache::getReadBehind() const
             {
                 return _readBehind;
@@ -29,6 +29,7 @@
 
 #include <djvAV/ImageConvert.h>
 
+#include <djvAV/ImageUtil.h>
 #include <djvAV/OpenGLMesh.h>
 #include <djvAV/OpenGLOffscreenBuffer.h>
 #include <djvAV/OpenGLShader.h>
@@ -65,10 +66,10 @@ namespace djv
             void Convert::_init(const std::shared_ptr<ResourceSystem>& resourceSystem)
             {
                 DJV_PRIVATE_PTR();
-                const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
                 p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
-                    FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
-                    FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                    resourceSystem,
+                    "djvAVImageConvertVertex.glsl",
+                    "djvAVImageConvertFragment.glsl"));
             }
 
             Convert::Convert() :
@@ -85,9 +86,22 @@ namespace djv
                 return out;
             }
 
-            void Convert::process(const Data& data, const Info& info, Data& out)
+            void Convert::process(const Data& value, const Info& info, Data& out)
             {
                 DJV_PRIVATE_PTR();
+
+                // Planar YUV data is converted to RGBA on the CPU before it is
+                // uploaded.
+                std::shared_ptr<Data> yuv;
+                if (isYUVType(value.getType()))
+                {
+                    auto yuvInfo = value.getInfo();
+                    yuvInfo.type = getYUVConvertType(yuvInfo.type);
+                    yuv = Data::create(yuvInfo);
+                    convertYUV(value, *yuv);
+                }
+                const Data& data = yuv ? *yuv : value;
+
                 if (!p.offscreenBuffer || (p.offscreenBuffer && info != p.offscreenBuffer->getInfo()))
                 {
                     p.offscreenBuffer = OpenGL::OffscreenBuffer::create(info);
@@ -44,16 +44,30 @@ namespace djv
                 _pixelByteCount = info.getPixelByteCount();
                 _scanlineByteCount = info.getScanlineByteCount();
                 _dataByteCount = info.getDataByteCount();
+                const uint8_t planeCount = info.getPlaneCount();
+                for (uint8_t i = 1; i < planeCount; ++i)
+                {
+                    _planeOffsets[i] = _planeOffsets[i - 1] + info.getPlaneByteCount(i - 1);
+                }
 #if defined(DJV_MMAP)
-                _fileIO = fileIO;
-                if (_fileIO)
+                if (fileIO && fileIO->getSize() - fileIO->getPos() >= _dataByteCount)
                 {
+                    // Use the data directly from the memory-map and start paging
+                    // it in, so it is resident by the time the image is used.
+                    _fileIO = fileIO;
                     _p = _fileIO->mmapP();
+                    _fileIO->mmapReadAhead();
                 }
                 else if (_dataByteCount)
                 {
                     _data = new uint8_t[_dataByteCount];
                     _p = _data;
+                    if (fileIO)
+                    {
+                        const size_t size = fileIO->getSize() - fileIO->getPos();
+                        memcpy(_data, fileIO->mmapP(), size);
+                        memset(_data + size, 0, _dataByteCount - size);
+                    }
                 }
 #else // DJV_MMAP
                 if (_dataByteCount)
@@ -87,11 +101,7 @@ namespace djv
 
             size_t Data::getDataByteCount() const
             {
-#if defined(DJV_MMAP)
-                return _fileIO ? (_fileIO->getSize() - _fileIO->getPos()) : _dataByteCount;
-#else
                 return _dataByteCount;
-#endif // DJV_MMAP
             }
 
             void Data::zero()
@@ -108,11 +118,19 @@ namespace djv
                 if (_fileIO)
                 {
                     _data = new uint8_t[_dataByteCount];
-                    memcpy(_data, _fileIO->mmapP(), std::min(_fileIO->getSize() - _fileIO->getPos(), _dataByteCount));
+                    memcpy(_data, _p, _dataByteCount);
                     _p = _data;
                     _fileIO.reset();
                 }
             }
+
+            void Data::readAhead() const
+            {
+                if (_fileIO)
+                {
+                    _fileIO->mmapReadAhead();
+                }
+            }
 #endif // DJV_MMAP
 
             bool Data::operator == (const Data& other) const
@@ -112,6 +112,8 @@ namespace djv
                 float pixelAspectRatio = 1.F;
                 Type type = Type::None;
                 Layout layout;
+                YUVCoefficients yuvCoefficients = YUVCoefficients::BT709;
+                YUVRange yuvRange = YUVRange::Video;
 
                 float getAspectRatio() const;
                 GLenum getGLFormat() const;
@@ -121,6 +123,17 @@ namespace djv
                 size_t getScanlineByteCount() const;
                 size_t getDataByteCount() const;
 
+                //! \name Planes
+                //! Planar YUV data has three planes, other data has one.
+                ///@{
+
+                uint8_t getPlaneCount() const;
+                Size getPlaneSize(uint8_t) const;
+                size_t getPlaneScanlineByteCount(uint8_t) const;
+                size_t getPlaneByteCount(uint8_t) const;
+
+                ///@}
+
                 bool operator == (const Info&) const;
                 bool operator != (const Info&) const;
             };
@@ -168,10 +181,22 @@ namespace djv
                 uint8_t* getData(uint16_t y);
                 uint8_t* getData(uint16_t x, uint16_t y);
 
+                const uint8_t* getPlaneData(uint8_t) const;
+                uint8_t* getPlaneData(uint8_t);
+
                 void zero();
 
+                //! Get whether the data is used directly from a memory-mapped file.
+                bool isMemoryMapped() const;
+
 #if defined(DJV_MMAP)
+                //! Copy memory-mapped data so the image no longer references the
+                //! file.
                 void detach();
+
+                //! Advise the operating system that the memory-mapped data will
+                //! be needed soon.
+                void readAhead() const;
 #endif // DJV_MMAP
 
                 bool operator == (const Data&) const;
@@ -183,6 +208,7 @@ namespace djv
                 uint8_t _pixelByteCount = 0;
                 size_t _scanlineByteCount = 0;
                 size_t _dataByteCount = 0;
+                size_t _planeOffsets[3] = { 0, 0, 0 };
                 uint8_t* _data = nullptr;
                 const uint8_t* _p = nullptr;
 #if defined(DJV_MMAP)
@@ -130,20 +130,56 @@ namespace djv
 
             inline size_t Info::getPixelByteCount() const
             {
-                return AV::Image::getByteCount(type);
+                return isYUVType(type) ?
+                    AV::Image::getByteCount(AV::Image::getDataType(type)) :
+                    AV::Image::getByteCount(type);
             }
 
             inline size_t Info::getScanlineByteCount() const
             {
-                const size_t byteCount = static_cast<size_t>(size.w) * AV::Image::getByteCount(type);
+                return getPlaneScanlineByteCount(0);
+            }
+
+            inline size_t Info::getDataByteCount() const
+            {
+                size_t out = 0;
+                const uint8_t planeCount = getPlaneCount();
+                for (uint8_t i = 0; i < planeCount; ++i)
+                {
+                    out += getPlaneByteCount(i);
+                }
+                return out;
+            }
+
+            inline uint8_t Info::getPlaneCount() const
+            {
+                return isYUVType(type) ? 3 : 1;
+            }
+
+            inline Size Info::getPlaneSize(uint8_t plane) const
+            {
+                Size out = size;
+                if (plane > 0)
+                {
+                    const uint8_t shiftX = getChromaShiftX(type);
+                    const uint8_t shiftY = getChromaShiftY(type);
+                    out.w = (size.w + (1 << shiftX) - 1) >> shiftX;
+                    out.h = (size.h + (1 << shiftY) - 1) >> shiftY;
+                }
+                return out;
+            }
+
+            inline size_t Info::getPlaneScanlineByteCount(uint8_t plane) const
+            {
+                const size_t byteCount = static_cast<size_t>(getPlaneSize(plane).w) * getPixelByteCount();
                 const size_t q = byteCount / layout.alignment * layout.alignment;
                 const size_t r = byteCount - q;
                 return q + (r ? layout.alignment : 0);
             }
 
-            inline size_t Info::getDataByteCount() const
+            inline size_t Info::getPlaneByteCount(uint8_t plane) const
             {
-                return size.h * getScanlineByteCount();
+                return getPlaneSize(plane).h * getPlaneScanlineByteCount(plane);
             }
 
             inline bool Info::operator == (const Info& other) const
@@ -152,7 +188,9 @@ namespace djv
                     other.size.w == size.w &&
                     other.size.h == size.h &&
                     other.type == type &&
-                    other.layout == layout;
+                    other.layout == layout &&
+                    other.yuvCoefficients == yuvCoefficients &&
+                    other.yuvRange == yuvRange;
             }
 
             inline bool Info::operator != (const Info& other) const
@@ -243,6 +281,20 @@ namespace djv
                 return _p + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
+            inline const uint8_t* Data::getPlaneData(uint8_t plane) const
+            {
+                return _p + _planeOffsets[plane];
+            }
+
+            inline bool Data::isMemoryMapped() const
+            {
+#if defined(DJV_MMAP)
+                return _fileIO.get();
+#else // DJV_MMAP
+                return false;
+#endif // DJV_MMAP
+            }
+
             inline uint8_t* Data::getData()
             {
 #if defined(DJV_MMAP)
@@ -267,6 +319,14 @@ namespace djv
                 return _data + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
+            inline uint8_t* Data::getPlaneData(uint8_t plane)
+            {
+#if defined(DJV_MMAP)
+                detach();
+#endif // DJV_MMAP
+                return _data + _planeOffsets[plane];
+            }
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
@@ -0,0 +1,399 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImageScopes.h>
+
+#include <djvAV/ImageUtil.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! Rec. 709 luma coefficients.
+                const float lumaR = .2126F;
+                const float lumaG = .7152F;
+                const float lumaB = .0722F;
+
+                Type getFloatType(uint8_t channelCount)
+                {
+                    Type out = Type::None;
+                    switch (channelCount)
+                    {
+                    case 1: out = Type::L_F32;    break;
+                    case 2: out = Type::LA_F32;   break;
+                    case 3: out = Type::RGB_F32;  break;
+                    case 4: out = Type::RGBA_F32; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                //! This struct provides a regular grid of samples converted
+                //! to floating point.
+                struct Samples
+                {
+                    uint8_t               channelCount = 0;
+                    uint16_t              width        = 0;
+                    uint16_t              height       = 0;
+                    std::vector<uint16_t> x;
+                    std::vector<float>    data;
+                };
+
+                Samples getSamples(const std::shared_ptr<Data>& value, size_t sampleCountMax)
+                {
+                    Samples out;
+                    const auto data = convertYUV(value);
+                    const auto& info = data->getInfo();
+                    const size_t w = info.size.w;
+                    const size_t h = info.size.h;
+                    const Type floatType = getFloatType(getChannelCount(info.type));
+                    if (!w || !h || Type::None == floatType)
+                        return out;
+
+                    const size_t pixelCount = w * h;
+                    size_t stride = 1;
+                    if (sampleCountMax > 0 && pixelCount > sampleCountMax)
+                    {
+                        stride = static_cast<size_t>(std::ceil(std::sqrt(
+                            pixelCount / static_cast<double>(sampleCountMax))));
+                    }
+                    out.channelCount = getChannelCount(info.type);
+                    out.width = static_cast<uint16_t>((w + stride - 1) / stride);
+                    out.height = static_cast<uint16_t>((h + stride - 1) / stride);
+                    out.x.resize(out.width);
+                    for (uint16_t i = 0; i < out.width; ++i)
+                    {
+                        const size_t x = i * stride;
+                        out.x[i] = static_cast<uint16_t>(info.layout.mirror.x ? (w - 1 - x) : x);
+                    }
+                    out.data.resize(static_cast<size_t>(out.width) * out.height * out.channelCount);
+
+                    const size_t pixelByteCount = info.getPixelByteCount();
+                    const bool endianConvert = info.layout.endian != Memory::getEndian();
+                    const size_t wordSize = Type::RGB_U10 == info.type ?
+                        pixelByteCount :
+                        getByteCount(getDataType(info.type));
+                    std::vector<uint8_t> row(out.width * pixelByteCount);
+                    for (uint16_t j = 0; j < out.height; ++j)
+                    {
+                        const uint8_t* p = data->getData(static_cast<uint16_t>(j * stride));
+                        if (1 == stride)
+                        {
+                            memcpy(row.data(), p, row.size());
+                        }
+                        else
+                        {
+                            uint8_t* rowP = row.data();
+                            const size_t step = stride * pixelByteCount;
+                            for (uint16_t i = 0; i < out.width; ++i, p += step, rowP += pixelByteCount)
+                            {
+                                memcpy(rowP, p, pixelByteCount);
+                            }
+                        }
+                        if (endianConvert && wordSize > 1)
+                        {
+                            Memory::endian(row.data(), row.size() / wordSize, wordSize);
+                        }
+                        convert(
+                            row.data(),
+                            info.type,
+                            out.data.data() + static_cast<size_t>(j) * out.width * out.channelCount,
+                            floatType,
+                            out.width);
+                    }
+                    return out;
+                }
+
+                Stats getStats(const Samples& samples)
+                {
+                    Stats out;
+                    out.channelCount = samples.channelCount;
+                    const size_t count = static_cast<size_t>(samples.width) * samples.height;
+                    out.sampleCount = count;
+                    if (!count)
+                        return out;
+                    const float* p = samples.data.data();
+                    for (uint8_t c = 0; c < samples.channelCount; ++c)
+                    {
+                        float min = p[c];
+                        float max = p[c];
+                        double sum = 0.0;
+                        const float* q = p + c;
+                        for (size_t i = 0; i < count; ++i, q += samples.channelCount)
+                        {
+                            min = std::min(min, *q);
+                            max = std::max(max, *q);
+                            sum += *q;
+                        }
+                        out.min[c] = min;
+                        out.max[c] = max;
+                        out.average[c] = static_cast<float>(sum / count);
+                    }
+                    return out;
+                }
+
+                //! Convert the samples to RGB, expanding luminance images.
+                void getRGB(const Samples& samples, std::vector<float>& out)
+                {
+                    const size_t count = static_cast<size_t>(samples.width) * samples.height;
+                    out.resize(count * 3);
+                    const float* p = samples.data.data();
+                    float* outP = out.data();
+                    switch (samples.channelCount)
+                    {
+                    case 1:
+                    case 2:
+                        for (size_t i = 0; i < count; ++i, p += samples.channelCount, outP += 3)
+                        {
+                            outP[0] = outP[1] = outP[2] = p[0];
+                        }
+                        break;
+                    default:
+                        for (size_t i = 0; i < count; ++i, p += samples.channelCount, outP += 3)
+                        {
+                            outP[0] = p[0];
+                            outP[1] = p[1];
+                            outP[2] = p[2];
+                        }
+                        break;
+                    }
+                }
+
+                inline size_t getBin(float value, size_t bins)
+                {
+                    const float v = Math::clamp(value, 0.F, 1.F);
+                    return std::min(static_cast<size_t>(v * bins), bins - 1);
+                }
+
+                //! Scale the density counts to 8-bit values. The square root
+                //! keeps sparse areas visible next to dense ones.
+                void getDensity(const std::vector<uint32_t>& counts, uint8_t* out, size_t stride, size_t size)
+                {
+                    uint32_t max = 0;
+                    for (const auto i : counts)
+                    {
+                        max = std::max(max, i);
+                    }
+                    if (!max)
+                        return;
+                    const float scale = 1.F / std::sqrt(static_cast<float>(max));
+                    for (size_t i = 0; i < size; ++i, out += stride)
+                    {
+                        if (counts[i])
+                        {
+                            *out = static_cast<uint8_t>(std::max(1.F, std::sqrt(static_cast<float>(counts[i])) * scale * 255.F));
+                        }
+                    }
+                }
+
+            } // namespace
+
+            Stats::Stats()
+            {}
+
+            bool Stats::operator == (const Stats& other) const
+            {
+                return
+                    min == other.min &&
+                    max == other.max &&
+                    average == other.average &&
+                    channelCount == other.channelCount &&
+                    sampleCount == other.sampleCount;
+            }
+
+            bool Stats::operator != (const Stats& other) const
+            {
+                return !(*this == other);
+            }
+
+            ScopesOptions::ScopesOptions()
+            {}
+
+            bool ScopesOptions::operator == (const ScopesOptions& other) const
+            {
+                return
+                    sampleCountMax == other.sampleCountMax &&
+                    histogramBins == other.histogramBins &&
+                    waveformWidth == other.waveformWidth &&
+                    waveformLevels == other.waveformLevels &&
+                    waveformMode == other.waveformMode &&
+                    vectorscopeSize == other.vectorscopeSize;
+            }
+
+            bool ScopesOptions::operator != (const ScopesOptions& other) const
+            {
+                return !(*this == other);
+            }
+
+            Scopes::Scopes()
+            {}
+
+            Stats getStats(const std::shared_ptr<Data>& data, size_t sampleCountMax)
+            {
+                Stats out;
+                if (data)
+                {
+                    out = getStats(getSamples(data, sampleCountMax));
+                }
+                return out;
+            }
+
+            Scopes getScopes(const std::shared_ptr<Data>& data, const ScopesOptions& options)
+            {
+                Scopes out;
+                out.options = options;
+                if (!data)
+                    return out;
+                out.uid = data->getUID();
+
+                const Samples samples = getSamples(data, options.sampleCountMax);
+                out.stats = getStats(samples);
+                const size_t count = static_cast<size_t>(samples.width) * samples.height;
+                if (!count)
+                    return out;
+                std::vector<float> rgb;
+                getRGB(samples, rgb);
+                std::vector<float> luma(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    luma[i] = rgb[i * 3] * lumaR + rgb[i * 3 + 1] * lumaG + rgb[i * 3 + 2] * lumaB;
+                }
+
+                // Histogram.
+                const size_t bins = std::max(options.histogramBins, uint16_t(1));
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    out.histogram[c].resize(bins, 0);
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    ++out.histogram[0][getBin(rgb[i * 3], bins)];
+                    ++out.histogram[1][getBin(rgb[i * 3 + 1], bins)];
+                    ++out.histogram[2][getBin(rgb[i * 3 + 2], bins)];
+                    ++out.histogram[3][getBin(luma[i], bins)];
+                }
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    for (const auto i : out.histogram[c])
+                    {
+                        out.histogramMax = std::max(out.histogramMax, i);
+                    }
+                }
+
+                // Waveform. The first row of the image is the highest level.
+                const size_t imageWidth = data->getWidth();
+                const size_t waveformWidth = std::max(options.waveformWidth, uint16_t(1));
+                const size_t levels = std::max(options.waveformLevels, uint16_t(1));
+                std::vector<size_t> columns(samples.width);
+                for (uint16_t i = 0; i < samples.width; ++i)
+                {
+                    columns[i] = std::min(samples.x[i] * waveformWidth / imageWidth, waveformWidth - 1);
+                }
+                switch (options.waveformMode)
+                {
+                case WaveformMode::Luma:
+                {
+                    std::vector<uint32_t> counts(waveformWidth * levels, 0);
+                    for (uint16_t j = 0; j < samples.height; ++j)
+                    {
+                        const float* p = luma.data() + static_cast<size_t>(j) * samples.width;
+                        for (uint16_t i = 0; i < samples.width; ++i)
+                        {
+                            ++counts[(levels - 1 - getBin(p[i], levels)) * waveformWidth + columns[i]];
+                        }
+                    }
+                    out.waveform = Image::create(Info(
+                        static_cast<uint16_t>(waveformWidth),
+                        static_cast<uint16_t>(levels),
+                        Type::L_U8));
+                    out.waveform->zero();
+                    getDensity(counts, out.waveform->getData(), 1, counts.size());
+                    break;
+                }
+                case WaveformMode::RGBParade:
+                {
+                    out.waveform = Image::create(Info(
+                        static_cast<uint16_t>(waveformWidth * 3),
+                        static_cast<uint16_t>(levels),
+                        Type::RGB_U8));
+                    out.waveform->zero();
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        std::vector<uint32_t> counts(waveformWidth * 3 * levels, 0);
+                        for (uint16_t j = 0; j < samples.height; ++j)
+                        {
+                            const float* p = rgb.data() + static_cast<size_t>(j) * samples.width * 3 + c;
+                            for (uint16_t i = 0; i < samples.width; ++i, p += 3)
+                            {
+                                ++counts[(levels - 1 - getBin(*p, levels)) * waveformWidth * 3 + c * waveformWidth + columns[i]];
+                            }
+                        }
+                        getDensity(counts, out.waveform->getData() + c, 3, counts.size());
+                    }
+                    break;
+                }
+                default: break;
+                }
+
+                // Vectorscope.
+                const size_t size = std::max(options.vectorscopeSize, uint16_t(1));
+                std::vector<uint32_t> counts(size * size, 0);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const float cb = (rgb[i * 3 + 2] - luma[i]) / 1.8556F;
+                    const float cr = (rgb[i * 3] - luma[i]) / 1.5748F;
+                    const size_t x = getBin(cb + .5F, size);
+                    const size_t y = size - 1 - getBin(cr + .5F, size);
+                    ++counts[y * size + x];
+                }
+                out.vectorscope = Image::create(Info(
+                    static_cast<uint16_t>(size),
+                    static_cast<uint16_t>(size),
+                    Type::L_U8));
+                out.vectorscope->zero();
+                getDensity(counts, out.vectorscope->getData(), 1, counts.size());
+
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
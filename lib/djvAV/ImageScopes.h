@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/Image.h>
+
+#include <glm/vec4.hpp>
+
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This class provides image statistics.
+            class Stats
+            {
+            public:
+                Stats();
+
+                glm::vec4 min     = glm::vec4(0.F, 0.F, 0.F, 0.F);
+                glm::vec4 max     = glm::vec4(0.F, 0.F, 0.F, 0.F);
+                glm::vec4 average = glm::vec4(0.F, 0.F, 0.F, 0.F);
+                uint8_t   channelCount = 0;
+                size_t    sampleCount  = 0;
+
+                bool operator == (const Stats&) const;
+                bool operator != (const Stats&) const;
+            };
+
+            //! This enumeration provides the waveform modes.
+            enum class WaveformMode
+            {
+                Luma,
+                RGBParade,
+
+                Count,
+                First = Luma
+            };
+
+            //! This class provides the options for computing scopes.
+            class ScopesOptions
+            {
+            public:
+                ScopesOptions();
+
+                //! The maximum number of pixels that are sampled. Larger images
+                //! are sampled on a regular grid.
+                size_t       sampleCountMax  = 512 * 512;
+                uint16_t     histogramBins   = 256;
+                uint16_t     waveformWidth   = 256;
+                uint16_t     waveformLevels  = 256;
+                WaveformMode waveformMode    = WaveformMode::Luma;
+                uint16_t     vectorscopeSize = 256;
+
+                bool operator == (const ScopesOptions&) const;
+                bool operator != (const ScopesOptions&) const;
+            };
+
+            //! This class provides histogram, waveform, and vectorscope data.
+            class Scopes
+            {
+            public:
+                Scopes();
+
+                //! The UID of the image data the scopes were computed from.
+                Core::UID uid = 0;
+
+                ScopesOptions options;
+                Stats         stats;
+
+                //! The histogram bins for the red, green, blue, and luma channels.
+                std::vector<uint32_t> histogram[4];
+                uint32_t              histogramMax = 0;
+
+                //! The waveform density as an L_U8 image for luma mode, or an
+                //! RGB_U8 image with the channels side by side for parade mode.
+                std::shared_ptr<Image> waveform;
+
+                //! The Cb/Cr density as an L_U8 image.
+                std::shared_ptr<Image> vectorscope;
+            };
+
+            //! Get statistics from a subsample of the image data.
+            Stats getStats(const std::shared_ptr<Data>&, size_t sampleCountMax = ScopesOptions().sampleCountMax);
+
+            //! Get scopes from a subsample of the image data.
+            Scopes getScopes(const std::shared_ptr<Data>&, const ScopesOptions& = ScopesOptions());
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -30,7 +30,17 @@
 #include <djvAV/ImageUtil.h>
 
 #include <djvAV/Color.h>
-#include <djvAV/ImageData.h>
+#include <djvAV/Image.h>
+
+#include <djvCore/Math.h>
+
+#include <algorithm>
+#include <future>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
 
 using namespace djv::Core;
 
@@ -84,6 +94,408 @@ namespace djv
                     outP->b = average[2] / static_cast<float>(width * height);
                 }
 
+                template<typename T>
+                inline T clampYUV(float value, float max)
+                {
+                    return static_cast<T>(std::min(std::max(value, 0.F), max) + .5F);
+                }
+
+                template<typename TIn, typename TOut>
+                void convertYUVScalar(
+                    const TIn* yP,
+                    const TIn* uP,
+                    const TIn* vP,
+                    TOut* out,
+                    uint16_t x0,
+                    uint16_t x1,
+                    uint8_t shiftX,
+                    const YUVToRGB& k)
+                {
+                    out += x0 * 4;
+                    for (uint16_t x = x0; x < x1; ++x, out += 4)
+                    {
+                        const uint16_t cx = x >> shiftX;
+                        const float y = yP[x] * k.yScale + k.yOffset;
+                        const float u = (uP[cx] - k.cOffset) * k.cScale;
+                        const float v = (vP[cx] - k.cOffset) * k.cScale;
+                        out[0] = clampYUV<TOut>(y + k.rv * v, k.max);
+                        out[1] = clampYUV<TOut>(y + k.gu * u + k.gv * v, k.max);
+                        out[2] = clampYUV<TOut>(y + k.bu * u, k.max);
+                        out[3] = static_cast<TOut>(k.max);
+                    }
+                }
+
+                //! This struct provides the coefficients for converting RGB samples
+                //! to YUV. The chroma values are centered on zero, the offset is
+                //! added when they are subsampled.
+                struct RGBToYUV
+                {
+                    float yr      = 0.F;
+                    float yg      = 0.F;
+                    float yb      = 0.F;
+                    float yOffset = 0.F;
+                    float ur      = 0.F;
+                    float ug      = 0.F;
+                    float ub      = 0.F;
+                    float vr      = 0.F;
+                    float vg      = 0.F;
+                    float vb      = 0.F;
+                    float cOffset = 0.F;
+                    float max     = 0.F;
+                };
+
+                RGBToYUV getRGBToYUV(const Info& out, float inMax)
+                {
+                    float kr = 0.F;
+                    float kb = 0.F;
+                    switch (out.yuvCoefficients)
+                    {
+                    case YUVCoefficients::BT601:  kr = .299F;  kb = .114F;  break;
+                    case YUVCoefficients::BT709:  kr = .2126F; kb = .0722F; break;
+                    case YUVCoefficients::BT2020: kr = .2627F; kb = .0593F; break;
+                    default: break;
+                    }
+                    const float kg = 1.F - kr - kb;
+
+                    const uint8_t bitDepth = getBitDepth(out.type);
+                    const float outMax = static_cast<float>((1 << bitDepth) - 1);
+                    const float s = static_cast<float>(1 << (bitDepth - 8));
+                    float yScale = 0.F;
+                    float cScale = 0.F;
+                    RGBToYUV k;
+                    switch (out.yuvRange)
+                    {
+                    case YUVRange::Video:
+                        yScale = 219.F * s / inMax;
+                        cScale = 224.F * s / inMax;
+                        k.yOffset = 16.F * s;
+                        break;
+                    case YUVRange::Full:
+                        yScale = outMax / inMax;
+                        cScale = outMax / inMax;
+                        break;
+                    default: break;
+                    }
+                    k.yr = kr * yScale;
+                    k.yg = kg * yScale;
+                    k.yb = kb * yScale;
+                    const float u = cScale / (2.F * (1.F - kb));
+                    k.ur = -kr * u;
+                    k.ug = -kg * u;
+                    k.ub = (1.F - kb) * u;
+                    const float v = cScale / (2.F * (1.F - kr));
+                    k.vr = (1.F - kr) * v;
+                    k.vg = -kg * v;
+                    k.vb = -kb * v;
+                    k.cOffset = 128.F * s;
+                    k.max = outMax;
+                    return k;
+                }
+
+                template<typename TIn, typename TOut>
+                void convertRGBToYUVScalar(
+                    const TIn* in,
+                    uint8_t channels,
+                    TOut* yP,
+                    float* uP,
+                    float* vP,
+                    uint16_t x0,
+                    uint16_t x1,
+                    const RGBToYUV& k)
+                {
+                    in += x0 * channels;
+                    for (uint16_t x = x0; x < x1; ++x, in += channels)
+                    {
+                        const float r = in[0];
+                        const float g = in[1];
+                        const float b = in[2];
+                        yP[x] = clampYUV<TOut>(k.yr * r + k.yg * g + k.yb * b + k.yOffset, k.max);
+                        uP[x] = k.ur * r + k.ug * g + k.ub * b;
+                        vP[x] = k.vr * r + k.vg * g + k.vb * b;
+                    }
+                }
+
+#if defined(DJV_IMAGE_SSE2)
+                // The SSE2 kernels convert four pixels at a time. The samples are
+                // widened to 32-bit floats, converted, and then packed back down
+                // and interleaved into RGBA.
+                inline __m128 loadYUV4(const uint8_t* p)
+                {
+                    int32_t tmp = 0;
+                    memcpy(&tmp, p, 4);
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(tmp), zero), zero);
+                    return _mm_cvtepi32_ps(v);
+                }
+
+                inline __m128 loadYUV4(const uint16_t* p)
+                {
+                    const __m128i v = _mm_unpacklo_epi16(
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)),
+                        _mm_setzero_si128());
+                    return _mm_cvtepi32_ps(v);
+                }
+
+                template<typename T>
+                inline __m128 loadChroma4(const T* p, uint16_t cx, uint8_t shiftX)
+                {
+                    return shiftX ?
+                        _mm_setr_ps(p[cx], p[cx], p[cx + 1], p[cx + 1]) :
+                        loadYUV4(p + cx);
+                }
+
+                inline void storeRGBA4(__m128i r, __m128i g, __m128i b, __m128i a, uint8_t* out)
+                {
+                    const __m128i rg0 = _mm_unpacklo_epi32(r, g);
+                    const __m128i ba0 = _mm_unpacklo_epi32(b, a);
+                    const __m128i rg1 = _mm_unpackhi_epi32(r, g);
+                    const __m128i ba1 = _mm_unpackhi_epi32(b, a);
+                    const __m128i p01 = _mm_packs_epi32(_mm_unpacklo_epi64(rg0, ba0), _mm_unpackhi_epi64(rg0, ba0));
+                    const __m128i p23 = _mm_packs_epi32(_mm_unpacklo_epi64(rg1, ba1), _mm_unpackhi_epi64(rg1, ba1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(p01, p23));
+                }
+
+                inline void storeRGBA4(__m128i r, __m128i g, __m128i b, __m128i a, uint16_t* out)
+                {
+                    // There is no unsigned 32-bit to 16-bit pack in SSE2, so bias the
+                    // values into the signed range and flip the sign bit back after.
+                    const __m128i bias32 = _mm_set1_epi32(32768);
+                    const __m128i bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+                    r = _mm_sub_epi32(r, bias32);
+                    g = _mm_sub_epi32(g, bias32);
+                    b = _mm_sub_epi32(b, bias32);
+                    a = _mm_sub_epi32(a, bias32);
+                    const __m128i rg0 = _mm_unpacklo_epi32(r, g);
+                    const __m128i ba0 = _mm_unpacklo_epi32(b, a);
+                    const __m128i rg1 = _mm_unpackhi_epi32(r, g);
+                    const __m128i ba1 = _mm_unpackhi_epi32(b, a);
+                    const __m128i p01 = _mm_xor_si128(
+                        _mm_packs_epi32(_mm_unpacklo_epi64(rg0, ba0), _mm_unpackhi_epi64(rg0, ba0)),
+                        bias16);
+                    const __m128i p23 = _mm_xor_si128(
+                        _mm_packs_epi32(_mm_unpacklo_epi64(rg1, ba1), _mm_unpackhi_epi64(rg1, ba1)),
+                        bias16);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), p01);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), p23);
+                }
+
+                template<typename TIn, typename TOut>
+                uint16_t convertYUVSSE2(
+                    const TIn* yP,
+                    const TIn* uP,
+                    const TIn* vP,
+                    TOut* out,
+                    uint16_t width,
+                    uint8_t shiftX,
+                    const YUVToRGB& k)
+                {
+                    const __m128 yScale  = _mm_set1_ps(k.yScale);
+                    const __m128 yOffset = _mm_set1_ps(k.yOffset);
+                    const __m128 cScale  = _mm_set1_ps(k.cScale);
+                    const __m128 cOffset = _mm_set1_ps(k.cOffset);
+                    const __m128 rv      = _mm_set1_ps(k.rv);
+                    const __m128 gu      = _mm_set1_ps(k.gu);
+                    const __m128 gv      = _mm_set1_ps(k.gv);
+                    const __m128 bu      = _mm_set1_ps(k.bu);
+                    const __m128 zero    = _mm_setzero_ps();
+                    const __m128 max     = _mm_set1_ps(k.max);
+                    const __m128i a      = _mm_set1_epi32(static_cast<int32_t>(k.max));
+                    const uint16_t width4 = width / 4 * 4;
+                    for (uint16_t x = 0; x < width4; x += 4, out += 16)
+                    {
+                        const uint16_t cx = x >> shiftX;
+                        const __m128 y = _mm_add_ps(_mm_mul_ps(loadYUV4(yP + x), yScale), yOffset);
+                        const __m128 u = _mm_mul_ps(_mm_sub_ps(loadChroma4(uP, cx, shiftX), cOffset), cScale);
+                        const __m128 v = _mm_mul_ps(_mm_sub_ps(loadChroma4(vP, cx, shiftX), cOffset), cScale);
+                        const __m128 r = _mm_add_ps(y, _mm_mul_ps(rv, v));
+                        const __m128 g = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(gu, u), _mm_mul_ps(gv, v)));
+                        const __m128 b = _mm_add_ps(y, _mm_mul_ps(bu, u));
+                        storeRGBA4(
+                            _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(r, zero), max)),
+                            _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(g, zero), max)),
+                            _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(b, zero), max)),
+                            a,
+                            out);
+                    }
+                    return width4;
+                }
+
+                inline void loadRGBA4(const uint8_t* p, __m128& r, __m128& g, __m128& b)
+                {
+                    const __m128i mask = _mm_set1_epi32(0xff);
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                    r = _mm_cvtepi32_ps(_mm_and_si128(v, mask));
+                    g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask));
+                    b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask));
+                }
+
+                inline void loadRGBA4(const uint16_t* p, __m128& r, __m128& g, __m128& b)
+                {
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128i p01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                    const __m128i p23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+                    const __m128i t0 = _mm_unpacklo_epi16(p01, p23);
+                    const __m128i t1 = _mm_unpackhi_epi16(p01, p23);
+                    const __m128i rg = _mm_unpacklo_epi16(t0, t1);
+                    const __m128i ba = _mm_unpackhi_epi16(t0, t1);
+                    r = _mm_cvtepi32_ps(_mm_unpacklo_epi16(rg, zero));
+                    g = _mm_cvtepi32_ps(_mm_unpackhi_epi16(rg, zero));
+                    b = _mm_cvtepi32_ps(_mm_unpacklo_epi16(ba, zero));
+                }
+
+                inline void storeY4(__m128i y, uint8_t* out)
+                {
+                    const __m128i tmp = _mm_packs_epi32(y, y);
+                    const int32_t v = _mm_cvtsi128_si32(_mm_packus_epi16(tmp, tmp));
+                    memcpy(out, &v, 4);
+                }
+
+                inline void storeY4(__m128i y, uint16_t* out)
+                {
+                    const __m128i tmp = _mm_xor_si128(
+                        _mm_packs_epi32(_mm_sub_epi32(y, _mm_set1_epi32(32768)), _mm_setzero_si128()),
+                        _mm_set1_epi16(static_cast<int16_t>(0x8000)));
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), tmp);
+                }
+
+                // Convert four RGBA pixels at a time. The luma values are packed
+                // into the output and the chroma values are stored as floats to be
+                // subsampled.
+                template<typename TIn, typename TOut>
+                uint16_t convertRGBToYUVSSE2(
+                    const TIn* in,
+                    TOut* yP,
+                    float* uP,
+                    float* vP,
+                    uint16_t width,
+                    const RGBToYUV& k)
+                {
+                    const __m128 yr      = _mm_set1_ps(k.yr);
+                    const __m128 yg      = _mm_set1_ps(k.yg);
+                    const __m128 yb      = _mm_set1_ps(k.yb);
+                    const __m128 yOffset = _mm_set1_ps(k.yOffset);
+                    const __m128 ur      = _mm_set1_ps(k.ur);
+                    const __m128 ug      = _mm_set1_ps(k.ug);
+                    const __m128 ub      = _mm_set1_ps(k.ub);
+                    const __m128 vr      = _mm_set1_ps(k.vr);
+                    const __m128 vg      = _mm_set1_ps(k.vg);
+                    const __m128 vb      = _mm_set1_ps(k.vb);
+                    const __m128 zero    = _mm_setzero_ps();
+                    const __m128 max     = _mm_set1_ps(k.max);
+                    const uint16_t width4 = width / 4 * 4;
+                    for (uint16_t x = 0; x < width4; x += 4, in += 16)
+                    {
+                        __m128 r;
+                        __m128 g;
+                        __m128 b;
+                        loadRGBA4(in, r, g, b);
+                        const __m128 y = _mm_add_ps(
+                            _mm_add_ps(_mm_mul_ps(yr, r), _mm_mul_ps(yg, g)),
+                            _mm_add_ps(_mm_mul_ps(yb, b), yOffset));
+                        storeY4(_mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(y, zero), max)), yP + x);
+                        _mm_storeu_ps(uP + x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ur, r), _mm_mul_ps(ug, g)), _mm_mul_ps(ub, b)));
+                        _mm_storeu_ps(vP + x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vr, r), _mm_mul_ps(vg, g)), _mm_mul_ps(vb, b)));
+                    }
+                    return width4;
+                }
+#endif // DJV_IMAGE_SSE2
+
+                template<typename TIn, typename TOut>
+                void convertRGBToYUV(const Data& in, Data& out, uint16_t y0, uint16_t y1)
+                {
+                    const auto& info = out.getInfo();
+                    const uint16_t w = info.size.w;
+                    const uint8_t channels = getChannelCount(in.getType());
+                    const uint8_t shiftX = getChromaShiftX(info.type);
+                    const uint8_t shiftY = getChromaShiftY(info.type);
+                    const uint16_t cw = info.getPlaneSize(1).w;
+                    const size_t scanlineByteCount[3] =
+                    {
+                        info.getPlaneScanlineByteCount(0),
+                        info.getPlaneScanlineByteCount(1),
+                        info.getPlaneScanlineByteCount(2)
+                    };
+                    const auto k = getRGBToYUV(info, static_cast<float>(std::numeric_limits<TIn>::max()));
+
+                    // The chroma values of the scanlines that share a chroma
+                    // scanline are averaged together.
+                    const uint16_t rows = 1 << shiftY;
+                    std::vector<float> uv(static_cast<size_t>(w) * rows * 2);
+                    for (uint16_t y = y0; y < y1; y += rows)
+                    {
+                        const uint16_t rowCount = std::min(rows, static_cast<uint16_t>(y1 - y));
+                        for (uint16_t row = 0; row < rowCount; ++row)
+                        {
+                            const TIn* inP = reinterpret_cast<const TIn*>(in.getData(y + row));
+                            TOut* yP = reinterpret_cast<TOut*>(out.getPlaneData(0) + (y + row) * scanlineByteCount[0]);
+                            float* uP = uv.data() + row * w * 2;
+                            float* vP = uP + w;
+                            uint16_t x = 0;
+#if defined(DJV_IMAGE_SSE2)
+                            if (4 == channels)
+                            {
+                                x = convertRGBToYUVSSE2(inP, yP, uP, vP, w, k);
+                            }
+#endif // DJV_IMAGE_SSE2
+                            convertRGBToYUVScalar(inP, channels, yP, uP, vP, x, w, k);
+                        }
+
+                        const uint16_t cy = y >> shiftY;
+                        TOut* uOut = reinterpret_cast<TOut*>(out.getPlaneData(1) + cy * scanlineByteCount[1]);
+                        TOut* vOut = reinterpret_cast<TOut*>(out.getPlaneData(2) + cy * scanlineByteCount[2]);
+                        for (uint16_t cx = 0; cx < cw; ++cx)
+                        {
+                            const uint16_t x0 = cx << shiftX;
+                            const uint16_t x1 = std::min(static_cast<uint16_t>(x0 + (1 << shiftX)), w);
+                            float u = 0.F;
+                            float v = 0.F;
+                            for (uint16_t row = 0; row < rowCount; ++row)
+                            {
+                                const float* uP = uv.data() + row * w * 2;
+                                const float* vP = uP + w;
+                                for (uint16_t x = x0; x < x1; ++x)
+                                {
+                                    u += uP[x];
+                                    v += vP[x];
+                                }
+                            }
+                            const float n = static_cast<float>(rowCount * (x1 - x0));
+                            uOut[cx] = clampYUV<TOut>(u / n + k.cOffset, k.max);
+                            vOut[cx] = clampYUV<TOut>(v / n + k.cOffset, k.max);
+                        }
+                    }
+                }
+
+                template<typename TIn, typename TOut>
+                void convertYUV(const Data& in, Data& out)
+                {
+                    const auto& info = in.getInfo();
+                    const uint16_t w = info.size.w;
+                    const uint16_t h = info.size.h;
+                    const uint8_t shiftX = getChromaShiftX(info.type);
+                    const uint8_t shiftY = getChromaShiftY(info.type);
+                    const size_t scanlineByteCount[3] =
+                    {
+                        info.getPlaneScanlineByteCount(0),
+                        info.getPlaneScanlineByteCount(1),
+                        info.getPlaneScanlineByteCount(2)
+                    };
+                    const auto k = getYUVToRGB(info, static_cast<float>(std::numeric_limits<TOut>::max()));
+                    for (uint16_t y = 0; y < h; ++y)
+                    {
+                        const uint16_t cy = y >> shiftY;
+                        const TIn* yP = reinterpret_cast<const TIn*>(in.getPlaneData(0) + y * scanlineByteCount[0]);
+                        const TIn* uP = reinterpret_cast<const TIn*>(in.getPlaneData(1) + cy * scanlineByteCount[1]);
+                        const TIn* vP = reinterpret_cast<const TIn*>(in.getPlaneData(2) + cy * scanlineByteCount[2]);
+                        TOut* outP = reinterpret_cast<TOut*>(out.getData(y));
+                        uint16_t x = 0;
+#if defined(DJV_IMAGE_SSE2)
+                        x = convertYUVSSE2(yP, uP, vP, outP, w, shiftX, k);
+#endif // DJV_IMAGE_SSE2
+                        convertYUVScalar(yP, uP, vP, outP, x, w, shiftX, k);
+                    }
+                }
+
             } // namespace
 
             Color getAverageColor(const std::shared_ptr<Data>& data)
@@ -94,6 +506,10 @@ namespace djv
                     const uint16_t w = data->getWidth();
                     const uint16_t h = data->getHeight();
                     const AV::Image::Type type = data->getType();
+                    if (isYUVType(type))
+                    {
+                        return getAverageColor(convertYUV(data));
+                    }
                     const uint8_t c = getChannelCount(type);
                     const uint8_t* p = data->getData();
                     out = Color(type);
@@ -111,6 +527,140 @@ namespace djv
                 return out;
             }
 
+            YUVToRGB getYUVToRGB(const Info& in, float outMax)
+            {
+                float kr = 0.F;
+                float kb = 0.F;
+                switch (in.yuvCoefficients)
+                {
+                case YUVCoefficients::BT601:  kr = .299F;  kb = .114F;  break;
+                case YUVCoefficients::BT709:  kr = .2126F; kb = .0722F; break;
+                case YUVCoefficients::BT2020: kr = .2627F; kb = .0593F; break;
+                default: break;
+                }
+                const float kg = 1.F - kr - kb;
+
+                const uint8_t bitDepth = getBitDepth(in.type);
+                const float inMax = static_cast<float>((1 << bitDepth) - 1);
+                const float s = static_cast<float>(1 << (bitDepth - 8));
+                YUVToRGB out;
+                switch (in.yuvRange)
+                {
+                case YUVRange::Video:
+                    out.yScale = outMax / (219.F * s);
+                    out.yOffset = -16.F * s * out.yScale;
+                    out.cScale = outMax / (224.F * s);
+                    break;
+                case YUVRange::Full:
+                    out.yScale = outMax / inMax;
+                    out.cScale = outMax / inMax;
+                    break;
+                default: break;
+                }
+                out.cOffset = 128.F * s;
+                out.rv = 2.F * (1.F - kr);
+                out.gu = -2.F * kb * (1.F - kb) / kg;
+                out.gv = -2.F * kr * (1.F - kr) / kg;
+                out.bu = 2.F * (1.F - kb);
+                out.max = outMax;
+                return out;
+            }
+
+            Type getYUVConvertType(Type value)
+            {
+                return DataType::U8 == getDataType(value) ? Type::RGBA_U8 : Type::RGBA_U16;
+            }
+
+            void convertYUV(const Data& in, Data& out)
+            {
+                switch (in.getType())
+                {
+                case Type::YUV_420P_U8:
+                case Type::YUV_422P_U8:
+                case Type::YUV_444P_U8:
+                    convertYUV<U8_T, U8_T>(in, out);
+                    break;
+                case Type::YUV_420P_U10:
+                case Type::YUV_422P_U10:
+                case Type::YUV_444P_U10:
+                case Type::YUV_420P_U16:
+                case Type::YUV_422P_U16:
+                case Type::YUV_444P_U16:
+                    convertYUV<U16_T, U16_T>(in, out);
+                    break;
+                default: break;
+                }
+            }
+
+            std::shared_ptr<Data> convertYUV(const std::shared_ptr<Data>& value)
+            {
+                std::shared_ptr<Data> out = value;
+                if (value && isYUVType(value->getType()))
+                {
+                    auto info = value->getInfo();
+                    info.type = getYUVConvertType(info.type);
+                    out = Data::create(info);
+                    convertYUV(*value, *out);
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image> convertYUV(const std::shared_ptr<Image>& value)
+            {
+                std::shared_ptr<Image> out = value;
+                if (value && isYUVType(value->getType()))
+                {
+                    auto info = value->getInfo();
+                    info.type = getYUVConvertType(info.type);
+                    out = Image::create(info);
+                    out->setPluginName(value->getPluginName());
+                    out->setTags(value->getTags());
+                    convertYUV(*value, *out);
+                }
+                return out;
+            }
+
+            void convertRGBToYUV(const Data& in, Data& out, size_t threadCount)
+            {
+                const auto& info = out.getInfo();
+                const size_t h = info.size.h;
+                const size_t rows = static_cast<size_t>(1) << getChromaShiftY(info.type);
+                const size_t tiles = Math::clamp(threadCount, size_t(1), std::max((h + rows - 1) / rows, size_t(1)));
+                std::vector<std::future<void> > futures;
+                for (size_t i = 0; i < tiles; ++i)
+                {
+                    // Keep the slices aligned to the chroma scanlines.
+                    const uint16_t y0 = static_cast<uint16_t>(i * h / tiles / rows * rows);
+                    const uint16_t y1 = static_cast<uint16_t>(i + 1 < tiles ? (i + 1) * h / tiles / rows * rows : h);
+                    futures.push_back(std::async(
+                        std::launch::async,
+                        [&in, &out, y0, y1]
+                        {
+                            switch (out.getType())
+                            {
+                            case Type::YUV_420P_U8:
+                            case Type::YUV_422P_U8:
+                            case Type::YUV_444P_U8:
+                                convertRGBToYUV<U8_T, U8_T>(in, out, y0, y1);
+                                break;
+                            case Type::YUV_420P_U10:
+                            case Type::YUV_422P_U10:
+                            case Type::YUV_444P_U10:
+                            case Type::YUV_420P_U16:
+                            case Type::YUV_422P_U16:
+                            case Type::YUV_444P_U16:
+                                convertRGBToYUV<U16_T, U16_T>(in, out, y0, y1);
+                                break;
+                            default: break;
+                            }
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
@@ -29,7 +29,7 @@
 
 #pragma once
 
-#include <djvAV/AV.h>
+#include <djvAV/Pixel.h>
 
 #include <memory>
 
@@ -41,9 +41,57 @@ namespace djv
         {
             class Color;
             class Data;
+            class Image;
+            class Info;
+
+            //! This struct provides the coefficients for converting YUV samples
+            //! to RGB:
+            //!
+            //! y = Y * yScale + yOffset
+            //! u = (U - cOffset) * cScale
+            //! v = (V - cOffset) * cScale
+            //! R = y + rv * v
+            //! G = y + gu * u + gv * v
+            //! B = y + bu * u
+            struct YUVToRGB
+            {
+                float yScale  = 0.F;
+                float yOffset = 0.F;
+                float cScale  = 0.F;
+                float cOffset = 0.F;
+                float rv      = 0.F;
+                float gu      = 0.F;
+                float gv      = 0.F;
+                float bu      = 0.F;
+                float max     = 0.F;
+            };
+
+            //! Get the coefficients for converting YUV samples of the given image
+            //! to RGB values in the range [0, max].
+            YUVToRGB getYUVToRGB(const Info&, float max = 1.F);
 
             Color getAverageColor(const std::shared_ptr<Data>&);
 
+            //! Get the type that planar YUV data is converted to.
+            Type getYUVConvertType(Type);
+
+            //! Convert planar YUV data to RGBA. The output data must be the same
+            //! size as the input and use the type from getYUVConvertType().
+            void convertYUV(const Data&, Data&);
+
+            //! Convert planar YUV data to RGBA. Other data is returned unchanged.
+            std::shared_ptr<Data> convertYUV(const std::shared_ptr<Data>&);
+
+            //! Convert a planar YUV image to RGBA, keeping the tags and plugin
+            //! name. Other images are returned unchanged.
+            std::shared_ptr<Image> convertYUV(const std::shared_ptr<Image>&);
+
+            //! Convert RGB or RGBA data to planar YUV using the coefficients and
+            //! range of the output data. The input must be the same size as the
+            //! output and use the data type from getYUVConvertType(). The data is
+            //! converted in horizontal slices that are run in parallel.
+            void convertRGBToYUV(const Data&, Data&, size_t threadCount = 1);
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
@@ -61,7 +61,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides Joint Photographic Experts Group (JPEG) image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
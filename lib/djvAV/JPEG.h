@@ -56,6 +56,7 @@ namespace djv
             {
                 static const std::string pluginName = "JPEG";
                 static const std::set<std::string> fileExtensions = { ".jpeg", ".jpg", ".jfif" };
+                static const std::vector<std::string> magicNumbers = { "\xff\xd8\xff" };
 
                 //! This struct provides the JPEG file I/O options.
                 struct Options
@@ -0,0 +1,547 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/OCIOLUT3D.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageUtil.h>
+
+#include <djvCore/Cache.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <cmath>
+#include <future>
+#include <mutex>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_LUT3D_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace _OCIO = OCIO_NAMESPACE;
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OCIO
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t cacheMax = 4;
+
+                //! The number of pixels that are shaped at a time.
+                const size_t shapeChunk = 64;
+
+                //! The default log2 allocation used by OpenColorIO.
+                const float log2MinDefault = -10.F;
+                const float log2MaxDefault = 6.F;
+
+                Image::Type getFloatType(uint8_t channelCount)
+                {
+                    return channelCount == 2 || channelCount == 4 ? Image::Type::RGBA_F32 : Image::Type::RGB_F32;
+                }
+
+                std::mutex cacheMutex;
+
+                Memory::Cache<std::string, std::shared_ptr<const LUT3D> >& getCache()
+                {
+                    static Memory::Cache<std::string, std::shared_ptr<const LUT3D> > cache;
+                    cache.setMax(cacheMax);
+                    return cache;
+                }
+
+                //! Compute the tetrahedral interpolation for one pixel. The inputs
+                //! are lattice coordinates and the strides are in floats.
+                //!
+                //! The tetrahedron is chosen without branches: the axis with the
+                //! largest fraction is the first edge and the two largest make the
+                //! second. Ties are broken in red, green, blue order.
+                inline void tetrahedral(
+                    float fr, float fg, float fb,
+                    float cellMax,
+                    const size_t* strides,
+                    size_t& c000,
+                    size_t& c1,
+                    size_t& c2,
+                    float* w)
+                {
+                    const float r0 = std::min(static_cast<float>(static_cast<size_t>(fr)), cellMax);
+                    const float g0 = std::min(static_cast<float>(static_cast<size_t>(fg)), cellMax);
+                    const float b0 = std::min(static_cast<float>(static_cast<size_t>(fb)), cellMax);
+                    const float dr = fr - r0;
+                    const float dg = fg - g0;
+                    const float db = fb - b0;
+                    const bool rg = dr >= dg;
+                    const bool rb = dr >= db;
+                    const bool gb = dg >= db;
+                    c000 =
+                        static_cast<size_t>(r0) * strides[0] +
+                        static_cast<size_t>(g0) * strides[1] +
+                        static_cast<size_t>(b0) * strides[2];
+                    c1 = c000 +
+                        (rg && rb) * strides[0] +
+                        (!rg && gb) * strides[1] +
+                        (!rb && !gb) * strides[2];
+                    c2 = c000 +
+                        (rg || rb) * strides[0] +
+                        (!rg || gb) * strides[1] +
+                        (!rb || !gb) * strides[2];
+                    const float max = std::max(dr, std::max(dg, db));
+                    const float min = std::min(dr, std::min(dg, db));
+                    const float mid = dr + dg + db - max - min;
+                    w[0] = 1.F - max;
+                    w[1] = max - mid;
+                    w[2] = mid - min;
+                    w[3] = min;
+                }
+
+#if defined(DJV_LUT3D_SSE2)
+                //! Compute the tetrahedral interpolation for four pixels, with the
+                //! same tetrahedron selection as tetrahedral(). The weights are
+                //! stored as four groups of four.
+                inline void tetrahedralSSE2(
+                    const float* r,
+                    const float* g,
+                    const float* b,
+                    float cellMax,
+                    const size_t* strides,
+                    int32_t* c000,
+                    int32_t* c1,
+                    int32_t* c2,
+                    float* w)
+                {
+                    const __m128 one = _mm_set1_ps(1.F);
+                    const __m128 ones = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                    const __m128 cellMaxV = _mm_set1_ps(cellMax);
+                    const __m128 sr = _mm_set1_ps(static_cast<float>(strides[0]));
+                    const __m128 sg = _mm_set1_ps(static_cast<float>(strides[1]));
+                    const __m128 sb = _mm_set1_ps(static_cast<float>(strides[2]));
+
+                    // The coordinates are not negative, so truncation is the floor.
+                    const __m128 fr = _mm_loadu_ps(r);
+                    const __m128 fg = _mm_loadu_ps(g);
+                    const __m128 fb = _mm_loadu_ps(b);
+                    const __m128 r0 = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(fr)), cellMaxV);
+                    const __m128 g0 = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(fg)), cellMaxV);
+                    const __m128 b0 = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(fb)), cellMaxV);
+                    const __m128 dr = _mm_sub_ps(fr, r0);
+                    const __m128 dg = _mm_sub_ps(fg, g0);
+                    const __m128 db = _mm_sub_ps(fb, b0);
+                    const __m128 rg = _mm_cmpge_ps(dr, dg);
+                    const __m128 rb = _mm_cmpge_ps(dr, db);
+                    const __m128 gb = _mm_cmpge_ps(dg, db);
+
+                    const __m128 base = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(r0, sr), _mm_mul_ps(g0, sg)),
+                        _mm_mul_ps(b0, sb));
+                    const __m128 o1 = _mm_add_ps(
+                        _mm_add_ps(
+                            _mm_and_ps(_mm_and_ps(rg, rb), sr),
+                            _mm_andnot_ps(rg, _mm_and_ps(gb, sg))),
+                        _mm_andnot_ps(_mm_or_ps(rb, gb), sb));
+                    const __m128 o2 = _mm_add_ps(
+                        _mm_add_ps(
+                            _mm_and_ps(_mm_or_ps(rg, rb), sr),
+                            _mm_and_ps(_mm_or_ps(_mm_andnot_ps(rg, ones), gb), sg)),
+                        _mm_andnot_ps(_mm_and_ps(rb, gb), sb));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(c000), _mm_cvttps_epi32(base));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(c1), _mm_cvttps_epi32(_mm_add_ps(base, o1)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(c2), _mm_cvttps_epi32(_mm_add_ps(base, o2)));
+
+                    const __m128 max = _mm_max_ps(dr, _mm_max_ps(dg, db));
+                    const __m128 min = _mm_min_ps(dr, _mm_min_ps(dg, db));
+                    const __m128 mid = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(dr, dg), db), max), min);
+                    _mm_storeu_ps(w, _mm_sub_ps(one, max));
+                    _mm_storeu_ps(w + 4, _mm_sub_ps(max, mid));
+                    _mm_storeu_ps(w + 8, _mm_sub_ps(mid, min));
+                    _mm_storeu_ps(w + 12, min);
+                }
+#endif // DJV_LUT3D_SSE2
+
+            } // namespace
+
+            struct LUT3D::Private
+            {
+                size_t edgeLen = 0;
+                LUT3DShaper shaper = LUT3DShaper::Uniform;
+                float shaperMin = 0.F;
+                float shaperMax = 1.F;
+                float shaperOffset = 0.F;
+                std::vector<float> data;
+
+                //! The LUT data padded to four floats per entry, so that each
+                //! entry can be loaded with one SIMD load.
+                std::vector<float> table;
+
+                void updateTable();
+
+                //! Map input values to lattice coordinates.
+                void shape(const float*, size_t pixelCount, uint8_t channelCount, float* r, float* g, float* b) const;
+
+                //! Map a normalized lattice coordinate back to an input value.
+                float unshape(float) const;
+            };
+
+            void LUT3D::_init(size_t edgeLen)
+            {
+                DJV_PRIVATE_PTR();
+                p.edgeLen = std::max(edgeLen, size_t(2));
+                p.data.resize(p.edgeLen * p.edgeLen * p.edgeLen * 3);
+                float* d = p.data.data();
+                const float scale = 1.F / static_cast<float>(p.edgeLen - 1);
+                for (size_t b = 0; b < p.edgeLen; ++b)
+                {
+                    for (size_t g = 0; g < p.edgeLen; ++g)
+                    {
+                        for (size_t r = 0; r < p.edgeLen; ++r, d += 3)
+                        {
+                            d[0] = r * scale;
+                            d[1] = g * scale;
+                            d[2] = b * scale;
+                        }
+                    }
+                }
+                p.updateTable();
+            }
+
+            LUT3D::LUT3D() :
+                _p(new Private)
+            {}
+
+            LUT3D::~LUT3D()
+            {}
+
+            std::shared_ptr<LUT3D> LUT3D::create(size_t edgeLen)
+            {
+                auto out = std::shared_ptr<LUT3D>(new LUT3D);
+                out->_init(edgeLen);
+                return out;
+            }
+
+            std::shared_ptr<LUT3D> LUT3D::create(const Convert& convert, size_t edgeLen)
+            {
+                auto out = std::shared_ptr<LUT3D>(new LUT3D);
+                out->_init(edgeLen);
+                auto config = _OCIO::GetCurrentConfig();
+
+                // Use the allocation of the input color space for the shaper,
+                // the same as OpenColorIO does when it bakes LUTs for the GPU.
+                if (auto colorSpace = config->getColorSpace(convert.input.c_str()))
+                {
+                    float vars[3] = { 0.F, 1.F, 0.F };
+                    const bool log2 = _OCIO::ALLOCATION_LG2 == colorSpace->getAllocation();
+                    if (log2)
+                    {
+                        vars[0] = log2MinDefault;
+                        vars[1] = log2MaxDefault;
+                    }
+                    const int varCount = colorSpace->getAllocationNumVars();
+                    if (varCount >= 2 && varCount <= 3)
+                    {
+                        colorSpace->getAllocationVars(vars);
+                    }
+                    out->setShaper(log2 ? LUT3DShaper::Log2 : LUT3DShaper::Uniform, vars[0], vars[1], vars[2]);
+                }
+
+                // Bake the processor by running the lattice through it.
+                const size_t edgeLen3 = out->_p->edgeLen * out->_p->edgeLen * out->_p->edgeLen;
+                std::vector<float> data = out->_p->data;
+                for (auto& i : data)
+                {
+                    i = out->_p->unshape(i);
+                }
+                auto processor = config->getProcessor(convert.input.c_str(), convert.output.c_str());
+                _OCIO::PackedImageDesc imageDesc(data.data(), static_cast<long>(edgeLen3), 1, 3);
+                processor->apply(imageDesc);
+                out->setData(data);
+                return out;
+            }
+
+            std::shared_ptr<const LUT3D> LUT3D::getCached(const Convert& convert, size_t edgeLen)
+            {
+                auto config = _OCIO::GetCurrentConfig();
+                std::stringstream ss;
+                ss << config->getCacheID() << '\n' << convert.input << '\n' << convert.output << '\n' << edgeLen;
+                const std::string key = ss.str();
+                std::shared_ptr<const LUT3D> out;
+                {
+                    std::unique_lock<std::mutex> lock(cacheMutex);
+                    if (getCache().get(key, out))
+                    {
+                        return out;
+                    }
+                }
+                out = create(convert, edgeLen);
+                std::unique_lock<std::mutex> lock(cacheMutex);
+                std::shared_ptr<const LUT3D> existing;
+                if (getCache().get(key, existing))
+                {
+                    out = existing;
+                }
+                else
+                {
+                    getCache().add(key, out);
+                }
+                return out;
+            }
+
+            size_t LUT3D::getEdgeLen() const
+            {
+                return _p->edgeLen;
+            }
+
+            LUT3DShaper LUT3D::getShaper() const
+            {
+                return _p->shaper;
+            }
+
+            float LUT3D::getShaperMin() const
+            {
+                return _p->shaperMin;
+            }
+
+            float LUT3D::getShaperMax() const
+            {
+                return _p->shaperMax;
+            }
+
+            float LUT3D::getShaperOffset() const
+            {
+                return _p->shaperOffset;
+            }
+
+            void LUT3D::setShaper(LUT3DShaper shaper, float min, float max, float offset)
+            {
+                DJV_PRIVATE_PTR();
+                p.shaper = shaper;
+                p.shaperMin = min;
+                p.shaperMax = max > min ? max : min + 1.F;
+                p.shaperOffset = offset;
+            }
+
+            const std::vector<float>& LUT3D::getData() const
+            {
+                return _p->data;
+            }
+
+            void LUT3D::setData(const std::vector<float>& value)
+            {
+                DJV_PRIVATE_PTR();
+                if (value.size() == p.data.size())
+                {
+                    p.data = value;
+                    p.updateTable();
+                }
+            }
+
+            void LUT3D::apply(float* data, size_t pixelCount, uint8_t channelCount) const
+            {
+                DJV_PRIVATE_PTR();
+                const float cellMax = static_cast<float>(p.edgeLen - 2);
+                const size_t strides[] = { 4, 4 * p.edgeLen, 4 * p.edgeLen * p.edgeLen };
+                const size_t s111 = strides[0] + strides[1] + strides[2];
+                const float* table = p.table.data();
+                float r[shapeChunk];
+                float g[shapeChunk];
+                float b[shapeChunk];
+                for (size_t i = 0; i < pixelCount; i += shapeChunk)
+                {
+                    const size_t count = std::min(shapeChunk, pixelCount - i);
+                    float* chunk = data + i * channelCount;
+                    p.shape(chunk, count, channelCount, r, g, b);
+                    size_t j = 0;
+#if defined(DJV_LUT3D_SSE2)
+                    int32_t c000[4];
+                    int32_t c1[4];
+                    int32_t c2[4];
+                    float w[16];
+                    float tmp[4];
+                    for (; j + 4 <= count; j += 4)
+                    {
+                        tetrahedralSSE2(r + j, g + j, b + j, cellMax, strides, c000, c1, c2, w);
+                        for (size_t k = 0; k < 4; ++k)
+                        {
+                            __m128 v = _mm_mul_ps(_mm_loadu_ps(table + c000[k]), _mm_set1_ps(w[k]));
+                            v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(table + c1[k]), _mm_set1_ps(w[4 + k])));
+                            v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(table + c2[k]), _mm_set1_ps(w[8 + k])));
+                            v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(table + c000[k] + s111), _mm_set1_ps(w[12 + k])));
+                            _mm_storeu_ps(tmp, v);
+                            float* out = chunk + (j + k) * channelCount;
+                            out[0] = tmp[0];
+                            out[1] = tmp[1];
+                            out[2] = tmp[2];
+                        }
+                    }
+#endif // DJV_LUT3D_SSE2
+                    for (; j < count; ++j)
+                    {
+                        size_t c000 = 0;
+                        size_t c1 = 0;
+                        size_t c2 = 0;
+                        float w[4];
+                        tetrahedral(r[j], g[j], b[j], cellMax, strides, c000, c1, c2, w);
+                        float* out = chunk + j * channelCount;
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            out[c] =
+                                table[c000 + c] * w[0] +
+                                table[c1 + c] * w[1] +
+                                table[c2 + c] * w[2] +
+                                table[c000 + s111 + c] * w[3];
+                        }
+                    }
+                }
+            }
+
+            std::shared_ptr<Image::Image> LUT3D::apply(const std::shared_ptr<Image::Image>& value, size_t threadCount) const
+            {
+                const auto image = Image::convertYUV(value);
+                const auto& info = image->getInfo();
+                Image::Info outInfo = info;
+                outInfo.layout.endian = Memory::getEndian();
+                auto out = Image::Image::create(outInfo);
+                out->setPluginName(image->getPluginName());
+                out->setTags(image->getTags());
+
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const Image::Type floatType = getFloatType(Image::getChannelCount(info.type));
+                const uint8_t floatChannelCount = Image::getChannelCount(floatType);
+                const bool endianConvert = info.layout.endian != Memory::getEndian();
+                const size_t scanlineByteCount = w * info.getPixelByteCount();
+                const size_t wordSize = Image::Type::RGB_U10 == info.type ?
+                    info.getPixelByteCount() :
+                    Image::getByteCount(Image::getDataType(info.type));
+
+                const size_t tiles = Math::clamp(threadCount, size_t(1), static_cast<size_t>(h));
+                std::vector<std::future<void> > futures;
+                for (size_t i = 0; i < tiles; ++i)
+                {
+                    const uint16_t y0 = static_cast<uint16_t>(i * h / tiles);
+                    const uint16_t y1 = static_cast<uint16_t>((i + 1) * h / tiles);
+                    futures.push_back(std::async(
+                        std::launch::async,
+                        [this, image, out, y0, y1, w, floatType, floatChannelCount, endianConvert, scanlineByteCount, wordSize]
+                        {
+                            const auto type = image->getType();
+                            std::vector<uint8_t> scanline(endianConvert ? scanlineByteCount : 0);
+                            std::vector<float> tmp(static_cast<size_t>(w) * floatChannelCount);
+                            for (uint16_t y = y0; y < y1; ++y)
+                            {
+                                const uint8_t* in = image->getData(y);
+                                if (endianConvert)
+                                {
+                                    Memory::endian(in, scanline.data(), scanlineByteCount / wordSize, wordSize);
+                                    in = scanline.data();
+                                }
+                                Image::convert(in, type, tmp.data(), floatType, w);
+                                apply(tmp.data(), w, floatChannelCount);
+                                Image::convert(tmp.data(), floatType, out->getData(y), type, w);
+                            }
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+                return out;
+            }
+
+            void LUT3D::Private::updateTable()
+            {
+                const size_t size = data.size() / 3;
+                table.resize(size * 4);
+                const float* in = data.data();
+                float* out = table.data();
+                for (size_t i = 0; i < size; ++i, in += 3, out += 4)
+                {
+                    out[0] = in[0];
+                    out[1] = in[1];
+                    out[2] = in[2];
+                    out[3] = 0.F;
+                }
+            }
+
+            void LUT3D::Private::shape(const float* data, size_t pixelCount, uint8_t channelCount, float* r, float* g, float* b) const
+            {
+                const float n = static_cast<float>(edgeLen - 1);
+                const float scale = n / (shaperMax - shaperMin);
+                float* out[] = { r, g, b };
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    const float* in = data + c;
+                    float* o = out[c];
+                    switch (shaper)
+                    {
+                    case LUT3DShaper::Uniform:
+                        for (size_t i = 0; i < pixelCount; ++i, in += channelCount)
+                        {
+                            o[i] = (*in - shaperMin) * scale;
+                        }
+                        break;
+                    case LUT3DShaper::Log2:
+                        for (size_t i = 0; i < pixelCount; ++i, in += channelCount)
+                        {
+                            const float v = *in + shaperOffset;
+                            o[i] = v > 0.F ? (std::log2(v) - shaperMin) * scale : 0.F;
+                        }
+                        break;
+                    }
+
+                    // Clamp to the lattice; this also maps NaN to zero.
+                    for (size_t i = 0; i < pixelCount; ++i)
+                    {
+                        o[i] = o[i] > 0.F ? (o[i] < n ? o[i] : n) : 0.F;
+                    }
+                }
+            }
+
+            float LUT3D::Private::unshape(float value) const
+            {
+                const float v = shaperMin + value * (shaperMax - shaperMin);
+                float out = 0.F;
+                switch (shaper)
+                {
+                case LUT3DShaper::Uniform: out = v; break;
+                case LUT3DShaper::Log2: out = std::pow(2.F, v) - shaperOffset; break;
+                }
+                return out;
+            }
+
+        } // namespace OCIO
+    } // namespace AV
+} // namespace djv
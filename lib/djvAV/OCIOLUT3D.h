@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/OCIO.h>
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            class Image;
+
+        } // namespace Image
+
+        namespace OCIO
+        {
+            //! This constant provides the default 3D LUT edge length. This
+            //! matches the LUT used for display so that converted files look
+            //! the same as the viewer.
+            const size_t lut3DEdgeLenDefault = 32;
+
+            //! This enumeration provides the 3D LUT input shapers.
+            enum class LUT3DShaper
+            {
+                Uniform, //!< Linear mapping from [min, max]
+                Log2     //!< Log2 mapping from [2^min, 2^max] minus an offset
+            };
+
+            //! This class provides a 3D LUT for color space conversions on the
+            //! CPU.
+            //!
+            //! Input values are mapped into the LUT with a shaper, which is
+            //! taken from the allocation of the input color space. This keeps
+            //! scene-linear values above 1.0 instead of clamping them; values
+            //! outside of the allocation range are clamped.
+            class LUT3D
+            {
+                DJV_NON_COPYABLE(LUT3D);
+
+            protected:
+                void _init(size_t edgeLen);
+                LUT3D();
+
+            public:
+                ~LUT3D();
+
+                //! Create an identity LUT.
+                static std::shared_ptr<LUT3D> create(size_t edgeLen = lut3DEdgeLenDefault);
+
+                //! Create a LUT from the current OpenColorIO configuration.
+                //! Throws:
+                //! - std::exception
+                static std::shared_ptr<LUT3D> create(const Convert&, size_t edgeLen = lut3DEdgeLenDefault);
+
+                //! Get a LUT from the current OpenColorIO configuration. The LUTs
+                //! are cached by configuration and color spaces, so multiple
+                //! writers share the same LUT.
+                //! Throws:
+                //! - std::exception
+                static std::shared_ptr<const LUT3D> getCached(const Convert&, size_t edgeLen = lut3DEdgeLenDefault);
+
+                size_t getEdgeLen() const;
+
+                //! \name Shaper
+                ///@{
+
+                LUT3DShaper getShaper() const;
+                float getShaperMin() const;
+                float getShaperMax() const;
+                float getShaperOffset() const;
+
+                void setShaper(LUT3DShaper, float min, float max, float offset = 0.F);
+
+                ///@}
+
+                //! Get the LUT data. The data is RGB triplets with red changing
+                //! fastest, indexed by the shaped input values.
+                const std::vector<float>& getData() const;
+
+                void setData(const std::vector<float>&);
+
+                //! Apply the LUT to floating point RGB or RGBA pixels in place.
+                void apply(float*, size_t pixelCount, uint8_t channelCount) const;
+
+                //! Apply the LUT to an image. The image is split into tiles of
+                //! scanlines which are processed in parallel.
+                std::shared_ptr<Image::Image> apply(const std::shared_ptr<Image::Image>&, size_t threadCount = 1) const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace OCIO
+    } // namespace AV
+} // namespace djv
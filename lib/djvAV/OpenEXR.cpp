@@ -598,7 +598,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides OpenEXR file I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
@@ -56,6 +56,7 @@ namespace djv
             {
                 static const std::string pluginName = "OpenEXR";
                 static const std::set<std::string> fileExtensions = { ".exr" };
+                static const std::vector<std::string> magicNumbers = { std::string("\x76\x2f\x31\x01", 4) };
 
                 //! This enumeration provides how the OpenEXR channels are grouped together.
                 enum class Channels
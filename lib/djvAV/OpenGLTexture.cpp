@@ -46,6 +46,7 @@ namespace djv
                 _filterMag = filterMag;
                 if (_info.isValid())
                 {
+                    const Image::Size textureSize = getTextureSize(_info);
 #if defined(DJV_OPENGL_PBO)
                     glGenBuffers(1, &_pbo);
                     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
@@ -66,8 +67,8 @@ namespace djv
                         GL_TEXTURE_2D,
                         0,
                         getInternalFormat(_info.type),
-                        _info.size.w,
-                        _info.size.h,
+                        textureSize.w,
+                        textureSize.h,
                         0,
                         _info.getGLFormat(),
                         _info.getGLType(),
@@ -105,6 +106,7 @@ namespace djv
                 _info = info;
                 if (_info.isValid())
                 {
+                    const Image::Size textureSize = getTextureSize(_info);
                     if (_id)
                     {
                         glDeleteTextures(1, &_id);
@@ -133,8 +135,8 @@ namespace djv
                         GL_TEXTURE_2D,
                         0,
                         getInternalFormat(_info.type),
-                        _info.size.w,
-                        _info.size.h,
+                        textureSize.w,
+                        textureSize.h,
                         0,
                         _info.getGLFormat(),
                         _info.getGLType(),
@@ -145,6 +147,11 @@ namespace djv
             void Texture::copy(const Image::Data & data)
             {
                 const auto & info = data.getInfo();
+                if (info.getPlaneCount() > 1)
+                {
+                    _copyPlanes(data);
+                    return;
+                }
 #if defined(DJV_OPENGL_ES2)
                 glBindTexture(GL_TEXTURE_2D, _id);
                 glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
@@ -250,6 +257,91 @@ namespace djv
                 glBindTexture(GL_TEXTURE_2D, _id);
             }
 
+            Image::Size Texture::getTextureSize(const Image::Info& info)
+            {
+                Image::Size out = info.size;
+                if (info.getPlaneCount() > 1)
+                {
+                    const Image::Size chroma = info.getPlaneSize(1);
+                    if (chroma.w < info.size.w)
+                    {
+                        out.w = std::max(info.size.w, static_cast<uint16_t>(chroma.w * 2));
+                        out.h = info.size.h + chroma.h;
+                    }
+                    else
+                    {
+                        out.h = info.size.h + chroma.h * 2;
+                    }
+                }
+                return out;
+            }
+
+            glm::ivec2 Texture::getPlanePos(const Image::Info& info, uint8_t plane)
+            {
+                glm::ivec2 out(0, 0);
+                if (plane > 0)
+                {
+                    const Image::Size chroma = info.getPlaneSize(1);
+                    out.y = info.size.h;
+                    if (2 == plane)
+                    {
+                        if (chroma.w < info.size.w)
+                        {
+                            out.x = chroma.w;
+                        }
+                        else
+                        {
+                            out.y += chroma.h;
+                        }
+                    }
+                }
+                return out;
+            }
+
+            void Texture::_copyPlanes(const Image::Data& data)
+            {
+                const auto& info = data.getInfo();
+#if defined(DJV_OPENGL_PBO) && !defined(DJV_OPENGL_ES2)
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
+                glBufferSubData(
+                    GL_PIXEL_UNPACK_BUFFER,
+                    0,
+                    info.getDataByteCount(),
+                    data.getData());
+#endif // DJV_OPENGL_PBO
+
+                glBindTexture(GL_TEXTURE_2D, _id);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+#if !defined(DJV_OPENGL_ES2)
+                glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
+                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+#endif // DJV_OPENGL_ES2
+                for (uint8_t i = 0; i < info.getPlaneCount(); ++i)
+                {
+                    const glm::ivec2 pos = getPlanePos(info, i);
+                    const Image::Size size = info.getPlaneSize(i);
+                    glTexSubImage2D(
+                        GL_TEXTURE_2D,
+                        0,
+                        pos.x,
+                        pos.y,
+                        size.w,
+                        size.h,
+                        info.getGLFormat(),
+                        info.getGLType(),
+#if defined(DJV_OPENGL_PBO) && !defined(DJV_OPENGL_ES2)
+                        reinterpret_cast<const void*>(data.getPlaneData(i) - data.getData())
+#else // DJV_OPENGL_PBO
+                        data.getPlaneData(i)
+#endif // DJV_OPENGL_PBO
+                        );
+                }
+#if !defined(DJV_OPENGL_ES2)
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+#endif // DJV_OPENGL_ES2
+            }
+
             GLenum Texture::getInternalFormat(Image::Type type)
             {
                 const GLenum data[] =
@@ -279,7 +371,17 @@ namespace djv
                     GL_RGBA,
                     GL_RGBA,
                     GL_RGBA,
-                    GL_RGBA
+                    GL_RGBA,
+
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE
 #else // DJV_OPENGL_ES2
                     GL_R8,
                     GL_R16,
@@ -304,7 +406,17 @@ namespace djv
                     GL_RGBA16,
                     GL_RGBA32I,
                     GL_RGBA16F,
-                    GL_RGBA32F
+                    GL_RGBA32F,
+
+                    GL_R8,
+                    GL_R8,
+                    GL_R8,
+                    GL_R16,
+                    GL_R16,
+                    GL_R16,
+                    GL_R16,
+                    GL_R16,
+                    GL_R16
 #endif // DJV_OPENGL_ES2
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Image::Type::Count));
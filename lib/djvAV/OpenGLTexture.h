@@ -32,6 +32,8 @@
 #include <djvAV/ImageData.h>
 #include <djvAV/OpenGL.h>
 
+#include <glm/vec2.hpp>
+
 namespace djv
 {
     namespace AV
@@ -39,6 +41,11 @@ namespace djv
         namespace OpenGL
         {
             //! This class provides an OpenGL texture.
+            //!
+            //! Planar YUV images are stored in a single channel texture with the
+            //! planes packed together; the luma plane is at the top and the chroma
+            //! planes are placed below it. Use getPlanePos() to find the location
+            //! of each plane.
             class Texture
             {
                 DJV_NON_COPYABLE(Texture);
@@ -67,7 +74,15 @@ namespace djv
 
                 static GLenum getInternalFormat(Image::Type);
 
+                //! Get the size of the texture needed for the given image information.
+                static Image::Size getTextureSize(const Image::Info&);
+
+                //! Get the position of an image plane within the texture.
+                static glm::ivec2 getPlanePos(const Image::Info&, uint8_t plane);
+
             private:
+                void _copyPlanes(const Image::Data&);
+
                 Image::Info _info;
                 GLenum _filterMin = GL_LINEAR;
                 GLenum _filterMag = GL_LINEAR;
@@ -50,8 +50,9 @@ namespace djv
                     out->_init(
                         "PNG",
                         DJV_TEXT("This plugin provides Portable Network Graphics (PNG) image I/O."),
-                        { ".png" },
-                        context);
+                        fileExtensions,
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
@@ -47,6 +47,7 @@ namespace djv
             {
                 static const std::string pluginName = "PNG";
                 static const std::set<std::string> fileExtensions = { ".png" };
+                static const std::vector<std::string> magicNumbers = { std::string("\x89PNG\r\n\x1a\n", 8) };
 
                 //! This struct provides a PNG error message.
                 struct ErrorStruct
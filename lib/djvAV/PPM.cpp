@@ -135,7 +135,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides NetPBM image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
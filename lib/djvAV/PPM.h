@@ -46,6 +46,7 @@ namespace djv
             {
                 static const std::string pluginName = "PPM";
                 static const std::set<std::string> fileExtensions = { ".ppm" };
+                static const std::vector<std::string> magicNumbers = { "P1", "P2", "P3", "P4", "P5", "P6" };
 
                 //! This enumeration provides the PPM file data types.
                 enum class Data
@@ -91,9 +91,15 @@ namespace djv
                     }
                     case Data::Binary:
                     {
+                        const size_t fileDataByteCount = io->getSize() - io->getPos();
 #if defined(DJV_MMAP)
-                        out = Image::Image::create(imageInfo, io);
-#else // DJV_MMAP
+                        if (fileDataByteCount >= imageInfo.getDataByteCount())
+                        {
+                            out = Image::Image::create(imageInfo, io);
+                            out->setPluginName(pluginName);
+                            break;
+                        }
+#endif // DJV_MMAP
                         bool convertEndian = false;
                         if (imageInfo.layout.endian != Memory::getEndian())
                         {
@@ -102,10 +108,14 @@ namespace djv
                         }
                         out = Image::Image::create(imageInfo);
                         out->setPluginName(pluginName);
-                        io->read(out->getData(), io->getSize() - io->getPos());
+                        const size_t dataByteCount = out->getDataByteCount();
+                        if (fileDataByteCount < dataByteCount)
+                        {
+                            out->zero();
+                        }
+                        io->read(out->getData(), std::min(fileDataByteCount, dataByteCount));
                         if (convertEndian)
                         {
-                            const size_t dataByteCount = out->getDataByteCount();
                             switch (Image::getDataType(imageInfo.type))
                             {
                                 case Image::DataType::U10:
@@ -117,7 +127,6 @@ namespace djv
                                 default: break;                            
                             }
                         }
-#endif // DJV_MMAP
                         break;
                     }
                     default: break;
@@ -591,7 +591,16 @@ namespace djv
         DJV_TEXT("RGBA_U16"),
         DJV_TEXT("RGBA_U32"),
         DJV_TEXT("RGBA_F16"),
-        DJV_TEXT("RGBA_F32"));
+        DJV_TEXT("RGBA_F32"),
+        DJV_TEXT("YUV_420P_U8"),
+        DJV_TEXT("YUV_422P_U8"),
+        DJV_TEXT("YUV_444P_U8"),
+        DJV_TEXT("YUV_420P_U10"),
+        DJV_TEXT("YUV_422P_U10"),
+        DJV_TEXT("YUV_444P_U10"),
+        DJV_TEXT("YUV_420P_U16"),
+        DJV_TEXT("YUV_422P_U16"),
+        DJV_TEXT("YUV_444P_U16"));
 
     DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
         AV::Image,
@@ -613,6 +622,19 @@ namespace djv
         DJV_TEXT("F16"),
         DJV_TEXT("F32"));
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        YUVCoefficients,
+        DJV_TEXT("BT601"),
+        DJV_TEXT("BT709"),
+        DJV_TEXT("BT2020"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        YUVRange,
+        DJV_TEXT("Video"),
+        DJV_TEXT("Full"));
+
     picojson::value toJSON(AV::Image::Type value)
     {
         std::stringstream ss;
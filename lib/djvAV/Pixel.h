@@ -76,6 +76,20 @@ namespace djv
                 RGBA_F16,
                 RGBA_F32,
 
+                //! Planar YUV types, the Y plane is followed by the subsampled U
+                //! and V planes. The 10-bit types use the low bits of 16-bit
+                //! samples, their data type is U16 and getBitDepth() gives the
+                //! 10-bit range.
+                YUV_420P_U8,
+                YUV_422P_U8,
+                YUV_444P_U8,
+                YUV_420P_U10,
+                YUV_422P_U10,
+                YUV_444P_U10,
+                YUV_420P_U16,
+                YUV_422P_U16,
+                YUV_444P_U16,
+
                 Count,
                 First = None
             };
@@ -111,6 +125,29 @@ namespace djv
             };
             DJV_ENUM_HELPERS(DataType);
 
+            //! This enumeration provides the YUV to RGB conversion coefficients.
+            enum class YUVCoefficients
+            {
+                BT601,
+                BT709,
+                BT2020,
+
+                Count,
+                First = BT601
+            };
+            DJV_ENUM_HELPERS(YUVCoefficients);
+
+            //! This enumeration provides the YUV value ranges.
+            enum class YUVRange
+            {
+                Video,
+                Full,
+
+                Count,
+                First = Video
+            };
+            DJV_ENUM_HELPERS(YUVRange);
+
             typedef uint8_t   U8_T;
             typedef uint16_t U10_T;
             typedef uint16_t U12_T;
@@ -175,6 +212,9 @@ namespace djv
 
             bool isIntType(Type);
             bool isFloatType(Type);
+            bool isYUVType(Type);
+            uint8_t getChromaShiftX(Type);
+            uint8_t getChromaShiftY(Type);
             Core::IntRange getIntRange(Type);
             Core::FloatRange getFloatRange(Type);
             Type getIntType(uint8_t channelCount, uint8_t bitDepth);
@@ -225,6 +265,8 @@ namespace djv
             void convert_F32_F16(F32_T, F16_T &);
             void convert_F32_F32(F32_T, F32_T &);
 
+            //! Convert interleaved pixels. Note that the planar YUV types are not
+            //! supported, see convertYUV() instead.
             void convert(const void *, Type, void *, Type, size_t);
 
         } // namespace Image
@@ -233,6 +275,8 @@ namespace djv
     DJV_ENUM_SERIALIZE_HELPERS(AV::Image::Type);
     DJV_ENUM_SERIALIZE_HELPERS(AV::Image::Channels);
     DJV_ENUM_SERIALIZE_HELPERS(AV::Image::DataType);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::YUVCoefficients);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::YUVRange);
 
     picojson::value toJSON(AV::Image::Type);
 
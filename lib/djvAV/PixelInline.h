@@ -91,7 +91,17 @@ namespace djv
                     Channels::RGBA,
                     Channels::RGBA,
                     Channels::RGBA,
-                    Channels::RGBA
+                    Channels::RGBA,
+
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB,
+                    Channels::RGB
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -105,7 +115,8 @@ namespace djv
                     1, 1, 1, 1, 1,
                     2, 2, 2, 2, 2,
                     3, 3, 3, 3, 3, 3,
-                    4, 4, 4, 4, 4
+                    4, 4, 4, 4, 4,
+                    3, 3, 3, 3, 3, 3, 3, 3, 3
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -140,7 +151,17 @@ namespace djv
                     DataType::U16,
                     DataType::U32,
                     DataType::F16,
-                    DataType::F32
+                    DataType::F32,
+
+                    DataType::U8,
+                    DataType::U8,
+                    DataType::U8,
+                    DataType::U16,
+                    DataType::U16,
+                    DataType::U16,
+                    DataType::U16,
+                    DataType::U16,
+                    DataType::U16
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -154,7 +175,8 @@ namespace djv
                     8, 16, 32, 16, 32,
                     8, 16, 32, 16, 32,
                     8, 10, 16, 32, 16, 32,
-                    8, 16, 32, 16, 32
+                    8, 16, 32, 16, 32,
+                    8, 8, 8, 10, 10, 10, 16, 16, 16
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -184,7 +206,8 @@ namespace djv
                     1, 2, 4, 2, 4,
                     2, 4, 8, 4, 8,
                     3, 4, 6, 12, 6, 12,
-                    4, 8, 16, 8, 16
+                    4, 8, 16, 8, 16,
+                    3, 3, 3, 6, 6, 6, 6, 6, 6
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -215,6 +238,7 @@ namespace djv
                     true, true, true, false, false,
                     true, true, true, true, false, false,
                     true, true, true, false, false,
+                    true, true, true, true, true, true, true, true, true
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -228,12 +252,45 @@ namespace djv
                     false, false, false, true, true,
                     false, false, false, true, true,
                     false, false, false, false, true, true,
-                    false, false, false, true, true
+                    false, false, false, true, true,
+                    false, false, false, false, false, false, false, false, false
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
             }
 
+            inline bool isYUVType(Type value)
+            {
+                return value >= Type::YUV_420P_U8 && value <= Type::YUV_444P_U16;
+            }
+
+            inline uint8_t getChromaShiftX(Type value)
+            {
+                switch (value)
+                {
+                case Type::YUV_420P_U8:
+                case Type::YUV_422P_U8:
+                case Type::YUV_420P_U10:
+                case Type::YUV_422P_U10:
+                case Type::YUV_420P_U16:
+                case Type::YUV_422P_U16: return 1;
+                default: break;
+                }
+                return 0;
+            }
+
+            inline uint8_t getChromaShiftY(Type value)
+            {
+                switch (value)
+                {
+                case Type::YUV_420P_U8:
+                case Type::YUV_420P_U10:
+                case Type::YUV_420P_U16: return 1;
+                default: break;
+                }
+                return 0;
+            }
+
             inline Core::IntRange getIntRange(Type value)
             {
                 using namespace Core;
@@ -265,6 +322,16 @@ namespace djv
                     IntRange(U32Range.min, U32Range.max),
                     IntRange(0, 0),
                     IntRange(0, 0),
+
+                    IntRange(U8Range.min, U8Range.max),
+                    IntRange(U8Range.min, U8Range.max),
+                    IntRange(U8Range.min, U8Range.max),
+                    IntRange(U10Range.min, U10Range.max),
+                    IntRange(U10Range.min, U10Range.max),
+                    IntRange(U10Range.min, U10Range.max),
+                    IntRange(U16Range.min, U16Range.max),
+                    IntRange(U16Range.min, U16Range.max),
+                    IntRange(U16Range.min, U16Range.max)
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -301,6 +368,16 @@ namespace djv
                     FloatRange(0.F, 0.F),
                     FloatRange(F16Range.min, F16Range.max),
                     FloatRange(F32Range.min, F32Range.max),
+
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F),
+                    FloatRange(0.F, 0.F)
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -423,7 +500,17 @@ namespace djv
                     GL_RGBA,
                     GL_RGBA,
                     GL_RGBA,
-                    GL_RGBA
+                    GL_RGBA,
+
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE,
+                    GL_LUMINANCE
 #else // DJV_OPENGL_ES2
                     GL_RED,
                     GL_RED,
@@ -448,7 +535,17 @@ namespace djv
                     GL_RGBA,
                     GL_RGBA,
                     GL_RGBA,
-                    GL_RGBA
+                    GL_RGBA,
+
+                    GL_RED,
+                    GL_RED,
+                    GL_RED,
+                    GL_RED,
+                    GL_RED,
+                    GL_RED,
+                    GL_RED,
+                    GL_RED,
+                    GL_RED
 #endif // DJV_OPENGL_ES2
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
@@ -504,7 +601,17 @@ namespace djv
 #else
                     GL_HALF_FLOAT,
 #endif
-                    GL_FLOAT
+                    GL_FLOAT,
+
+                    GL_UNSIGNED_BYTE,
+                    GL_UNSIGNED_BYTE,
+                    GL_UNSIGNED_BYTE,
+                    GL_UNSIGNED_SHORT,
+                    GL_UNSIGNED_SHORT,
+                    GL_UNSIGNED_SHORT,
+                    GL_UNSIGNED_SHORT,
+                    GL_UNSIGNED_SHORT,
+                    GL_UNSIGNED_SHORT
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Type::Count));
                 return data[static_cast<size_t>(value)];
@@ -69,9 +69,7 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO&);
-
-                    std::vector<int32_t> _rleOffset;
+                    Info _open(const std::string &, Core::FileSystem::FileIO&, std::vector<int32_t>& rleOffset);
                 };
 
                 //! This class provides the RLA file I/O plugin.
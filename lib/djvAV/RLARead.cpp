@@ -32,6 +32,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -64,86 +66,117 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    std::vector<int32_t> rleOffset;
+                    return _open(fileName, io, rleOffset);
                 }
 
                 namespace
                 {
-                    void readRle(
-                        FileSystem::FileIO& io,
-                        uint8_t*            out,
-                        size_t              size,
-                        size_t              channels,
-                        size_t              bytes)
+                    //! Get the next channel of a scanline, each channel is stored
+                    //! as a big-endian 16-bit size followed by the channel data.
+                    const uint8_t* readChannel(
+                        const uint8_t*& in,
+                        const uint8_t*  end,
+                        size_t&         size)
+                    {
+                        if (in + 2 > end)
+                        {
+                            return nullptr;
+                        }
+                        const int16_t _size = static_cast<int16_t>((in[0] << 8) | in[1]);
+                        in += 2;
+                        if (_size < 0 || in + _size > end)
+                        {
+                            return nullptr;
+                        }
+                        const uint8_t* out = in;
+                        size = static_cast<size_t>(_size);
+                        in += size;
+                        return out;
+                    }
+
+                    bool readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channels,
+                        size_t         bytes)
                     {
-                        int16_t _size = 0;
-                        io.read16(&_size);
-                        std::vector<uint8_t> buf;
-                        buf.resize(_size);
-                        io.read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        const size_t outInc = channels * bytes;
                         for (size_t b = 0; b < bytes; ++b)
                         {
                             uint8_t* outP = out + (Memory::Endian::LSB == Memory::getEndian() ? (bytes - 1 - b) : b);
-                            const size_t outInc = channels * bytes;
                             for (size_t i = 0; i < size;)
                             {
-                                int count = *((const int8_t*)p);
-                                ++p;
+                                if (in >= end)
+                                {
+                                    return false;
+                                }
+                                int count = *reinterpret_cast<const int8_t*>(in);
+                                ++in;
                                 if (count >= 0)
                                 {
                                     ++count;
+                                    if (i + count > size || in >= end)
+                                    {
+                                        return false;
+                                    }
+                                    const uint8_t value = *in;
                                     for (int j = 0; j < count; ++j, outP += outInc)
                                     {
-                                        *outP = *p;
+                                        *outP = value;
                                     }
-                                    ++p;
+                                    ++in;
                                 }
                                 else
                                 {
                                     count = -count;
-                                    for (int j = 0; j < count; ++j, ++p, outP += outInc)
+                                    if (i + count > size || in + count > end)
                                     {
-                                        *outP = *p;
+                                        return false;
+                                    }
+                                    for (int j = 0; j < count; ++j, ++in, outP += outInc)
+                                    {
+                                        *outP = *in;
                                     }
                                 }
                                 i += count;
                             }
                         }
+                        return true;
                     }
 
-                    void readFloat(
-                        FileSystem::FileIO& io,
-                        uint8_t*            out,
-                        size_t              size,
-                        size_t              channels)
+                    bool readFloat(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channels)
                     {
-                        int16_t _size = 0;
-                        io.read16(&_size);
-                        std::vector<uint8_t> buf(_size);
-                        io.read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        if (in + size * 4 > end)
+                        {
+                            return false;
+                        }
                         const size_t outInc = channels * 4;
                         if (Memory::Endian::LSB == Memory::getEndian())
                         {
-                            for (size_t i = 0; i < size; ++i, p += 4, out += outInc)
+                            for (size_t i = 0; i < size; ++i, in += 4, out += outInc)
                             {
-                                out[0] = p[3];
-                                out[1] = p[2];
-                                out[2] = p[1];
-                                out[3] = p[0];
+                                out[0] = in[3];
+                                out[1] = in[2];
+                                out[2] = in[1];
+                                out[3] = in[0];
                             }
                         }
                         else
                         {
-                            for (size_t i = 0; i < size; ++i, p += 4, out += outInc)
+                            for (size_t i = 0; i < size; ++i, in += 4, out += outInc)
                             {
-                                out[0] = p[0];
-                                out[1] = p[1];
-                                out[2] = p[2];
-                                out[3] = p[3];
+                                memcpy(out, in, 4);
                             }
                         }
+                        return true;
                     }
 
                 } // namespace
@@ -152,30 +185,61 @@ namespace djv
                 {
                     std::shared_ptr<Image::Image> out;
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
+                    std::vector<int32_t> rleOffset;
+                    const auto info = _open(fileName, io, rleOffset);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
+                    // Read the whole file so the scanlines can be decoded in
+                    // parallel using the offset table.
+                    const size_t fileSize = io.getSize();
+                    std::vector<uint8_t> buf(fileSize);
+                    io.setPos(0);
+                    io.read(buf.data(), fileSize);
+                    const uint8_t* const bufP = buf.data();
+                    const uint8_t* const end = bufP + fileSize;
+
                     const size_t w = info.video[0].info.size.w;
                     const size_t h = info.video[0].info.size.h;
                     const size_t channels = Image::getChannelCount(info.video[0].info.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(info.video[0].info.type));
-                    const Image::DataType dataType = Image::getDataType(info.video[0].info.type);
-                    uint8_t* dataP = out->getData();
-                    for (uint16_t y = 0; y < h; ++y, dataP += w * channels * bytes)
+                    const bool floatData = Image::DataType::F32 == Image::getDataType(info.video[0].info.type);
+                    const size_t threadCount = getBlockThreadCount(h);
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
                     {
-                        io.setPos(_rleOffset[y]);
-                        for (int c = 0; c < channels; ++c)
-                        {
-                            if (Image::DataType::F32 == dataType)
-                            {
-                                readFloat(io, dataP + c * bytes, w, channels);
-                            }
-                            else
+                        const size_t y0 = i * h / threadCount;
+                        const size_t y1 = (i + 1) * h / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [&rleOffset, out, bufP, end, fileSize, y0, y1, w, channels, bytes, floatData]
                             {
-                                readRle(io, dataP + c * bytes, w, channels, bytes);
-                            }
-                        }
+                                for (size_t y = y0; y < y1; ++y)
+                                {
+                                    if (rleOffset[y] < 0 || static_cast<size_t>(rleOffset[y]) >= fileSize)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Read error."));
+                                    }
+                                    const uint8_t* p = bufP + rleOffset[y];
+                                    uint8_t* dataP = out->getData(static_cast<uint16_t>(y));
+                                    for (size_t c = 0; c < channels; ++c)
+                                    {
+                                        size_t size = 0;
+                                        const uint8_t* channelP = readChannel(p, end, size);
+                                        if (!channelP ||
+                                            !(floatData ?
+                                                readFloat(channelP, channelP + size, dataP + c * bytes, w, channels) :
+                                                readRle(channelP, channelP + size, dataP + c * bytes, w, channels, bytes)))
+                                        {
+                                            throw FileSystem::Error(DJV_TEXT("Read error."));
+                                        }
+                                    }
+                                }
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
                     }
 
                     return out;
@@ -241,7 +305,7 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io)
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io, std::vector<int32_t>& rleOffset)
                 {
                     // Open the file.
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
@@ -258,8 +322,8 @@ namespace djv
                     const int h = header.active[3] - header.active[2] + 1;
 
                     // Read the scanline table.
-                    _rleOffset.resize(h);
-                    io.read32(_rleOffset.data(), h);
+                    rleOffset.resize(h);
+                    io.read32(rleOffset.data(), h);
 
                     // Get file information.
                     if (header.matteChannels > 1)
@@ -31,6 +31,7 @@
 
 #include <djvAV/Color.h>
 #include <djvAV/GLFWSystem.h>
+#include <djvAV/ImageUtil.h>
 #include <djvAV/OpenGLMesh.h>
 #include <djvAV/OpenGLShader.h>
 #include <djvAV/OpenGLTexture.h>
@@ -41,7 +42,6 @@
 
 #include <djvCore/Cache.h>
 #include <djvCore/Context.h>
-#include <djvCore/FileIO.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/Range.h>
 #include <djvCore/ResourceSystem.h>
@@ -118,6 +118,14 @@ namespace djv
                     GLint exposureEnabledLoc    = 0;
                     GLint softClipLoc           = 0;
                     GLint imageChannelLoc       = 0;
+#if !defined(DJV_OPENGL_ES2)
+                    GLint yuvLoc                = 0;
+                    GLint yuvRectLoc[3]         = { 0, 0, 0 };
+                    GLint yuvTexelSizeLoc       = 0;
+                    GLint yuvMatrixLoc          = 0;
+                    GLint yuvScaleLoc           = 0;
+                    GLint yuvOffsetLoc          = 0;
+#endif // DJV_OPENGL_ES2
                     GLint textureSamplerLoc     = 0;
                 };
 
@@ -181,6 +189,14 @@ namespace djv
                     bool            exposureEnabled     = false;
                     float           softClip            = 0.F;
                     ImageChannel    imageChannel        = ImageChannel::None;
+#if !defined(DJV_OPENGL_ES2)
+                    bool            yuv                 = false;
+                    glm::vec4       yuvRect[3];
+                    glm::vec2       yuvTexelSize        = glm::vec2(0.F, 0.F);
+                    glm::mat3x3     yuvMatrix           = glm::mat3x3(1.F);
+                    glm::vec3       yuvScale            = glm::vec3(1.F, 1.F, 1.F);
+                    glm::vec3       yuvOffset           = glm::vec3(0.F, 0.F, 0.F);
+#endif // DJV_OPENGL_ES2
                     ImageCache      imageCache          = ImageCache::Atlas;
                     uint8_t         atlasIndex          = 0;
                     GLuint          textureID           = 0;
@@ -224,6 +240,20 @@ namespace djv
                         }
 #endif // DJV_OPENGL_ES2
                         shader->setUniform(data.imageChannelLoc, static_cast<int>(imageChannel));
+#if !defined(DJV_OPENGL_ES2)
+                        shader->setUniform(data.yuvLoc, yuv);
+                        if (yuv)
+                        {
+                            for (size_t i = 0; i < 3; ++i)
+                            {
+                                shader->setUniform(data.yuvRectLoc[i], yuvRect[i]);
+                            }
+                            shader->setUniform(data.yuvTexelSizeLoc, yuvTexelSize);
+                            shader->setUniform(data.yuvMatrixLoc, yuvMatrix);
+                            shader->setUniform(data.yuvScaleLoc, yuvScale);
+                            shader->setUniform(data.yuvOffsetLoc, yuvOffset);
+                        }
+#endif // DJV_OPENGL_ES2
                         switch (imageCache)
                         {
                         case ImageCache::Atlas:
@@ -539,16 +569,12 @@ namespace djv
                 _updateImageFilter();
 
                 auto resourceSystem = context->getSystemT<ResourceSystem>();
-                const FileSystem::Path shaderPath = resourceSystem->getPath(FileSystem::ResourcePath::Shaders);
                 try
                 {
-                    p.vertexFileName = std::string(FileSystem::Path(shaderPath, "djvAVRender2DVertex.glsl"));
-                    FileSystem::FileIO io;
-                    io.open(p.vertexFileName, FileSystem::FileIO::Mode::Read);
-                    p.vertexSource = FileSystem::FileIO::readContents(io);
-                    p.fragmentFileName = std::string(FileSystem::Path(shaderPath, "djvAVRender2DFragment.glsl"));
-                    io.open(p.fragmentFileName, FileSystem::FileIO::Mode::Read);
-                    p.fragmentSource = FileSystem::FileIO::readContents(io);
+                    p.vertexFileName = "djvAVRender2DVertex.glsl";
+                    p.vertexSource = resourceSystem->readContents(FileSystem::ResourcePath::Shaders, p.vertexFileName);
+                    p.fragmentFileName = "djvAVRender2DFragment.glsl";
+                    p.fragmentSource = resourceSystem->readContents(FileSystem::ResourcePath::Shaders, p.fragmentFileName);
                 }
                 catch (const std::exception& e)
                 {
@@ -565,6 +591,8 @@ namespace djv
                         DJV_PRIVATE_PTR();
                         std::stringstream ss;
                         ss << "Texture atlas: " << p.textureAtlas->getPercentageUsed() << "%\n";
+                        ss << "Texture atlas evictions: " << p.textureAtlas->getEvictionCount() << "\n";
+                        ss << "Texture atlas defragments: " << p.textureAtlas->getDefragmentCount() << "\n";
                         ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
                         ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
                         ss << "Dynamic textures: " << p.dynamicTextures.size() << "\n";
@@ -615,6 +643,7 @@ namespace djv
                 _size = size;
                 _currentClipRect = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
                 p.viewport = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+                p.textureAtlas->nextFrame();
             }
 
             void Render2D::endFrame()
@@ -635,6 +664,16 @@ namespace djv
                     p.primitiveData.colorSpaceSamplerLoc = glGetUniformLocation(program, "colorSpaceSampler");
 #endif // DJV_OPENGL_ES2
                     p.primitiveData.imageChannelLoc = glGetUniformLocation(program, "imageChannel");
+#if !defined(DJV_OPENGL_ES2)
+                    p.primitiveData.yuvLoc = glGetUniformLocation(program, "yuv");
+                    p.primitiveData.yuvRectLoc[0] = glGetUniformLocation(program, "yuvRect[0]");
+                    p.primitiveData.yuvRectLoc[1] = glGetUniformLocation(program, "yuvRect[1]");
+                    p.primitiveData.yuvRectLoc[2] = glGetUniformLocation(program, "yuvRect[2]");
+                    p.primitiveData.yuvTexelSizeLoc = glGetUniformLocation(program, "yuvTexelSize");
+                    p.primitiveData.yuvMatrixLoc = glGetUniformLocation(program, "yuvMatrix");
+                    p.primitiveData.yuvScaleLoc = glGetUniformLocation(program, "yuvScale");
+                    p.primitiveData.yuvOffsetLoc = glGetUniformLocation(program, "yuvOffset");
+#endif // DJV_OPENGL_ES2
                     p.primitiveData.colorMatrixLoc = glGetUniformLocation(program, "colorMatrix");
                     p.primitiveData.colorMatrixEnabledLoc = glGetUniformLocation(program, "colorMatrixEnabled");
                     p.primitiveData.colorInvertLoc = glGetUniformLocation(program, "colorInvert");
@@ -1106,6 +1145,12 @@ namespace djv
                                 id = p.textureAtlas->addItem(glyph->imageData, data.item);
                                 p.glyphTextureIDs[uid] = id;
                             }
+                            if (!id)
+                            {
+                                // The texture atlas is full of glyphs used in this frame.
+                                x += glyph->advance;
+                                continue;
+                            }
                             
                             if (data.item.textureIndex != textureIndex || 0 == clipped.size())
                             {
@@ -1459,6 +1504,16 @@ namespace djv
                 return _p->textureAtlas->getPercentageUsed();
             }
 
+            size_t Render2D::getTextureAtlasEvictionCount() const
+            {
+                return _p->textureAtlas->getEvictionCount();
+            }
+
+            size_t Render2D::getTextureAtlasDefragmentCount() const
+            {
+                return _p->textureAtlas->getDefragmentCount();
+            }
+
             size_t Render2D::getDynamicTextureCount() const
             {
                 return _p->dynamicTextureCache.size();
@@ -1584,7 +1639,9 @@ namespace djv
                         }
                         if (!textureAtlas->getItem(id, item))
                         {
-                            textureIDs[uid] = textureAtlas->addItem(image, item);
+                            // The texture atlas only holds packed pixels so planar
+                            // YUV images are converted on the CPU.
+                            textureIDs[uid] = textureAtlas->addItem(Image::convertYUV(image), item);
                         }
                         primitive->atlasIndex = item.textureIndex;
                         if (info.layout.mirror.x)
@@ -1616,21 +1673,62 @@ namespace djv
                         }
                         else
                         {
+#if defined(DJV_OPENGL_ES2)
+                            // OpenGL ES 2 does not support the YUV shader so planar
+                            // YUV images are converted on the CPU.
+                            const auto textureImage = Image::convertYUV(image);
+#else // DJV_OPENGL_ES2
+                            const auto& textureImage = image;
+#endif // DJV_OPENGL_ES2
                             std::shared_ptr<OpenGL::Texture> texture;
                             if (dynamicTextures.size())
                             {
                                 texture = dynamicTextures.back();
                                 dynamicTextures.pop_back();
-                                texture->set(image->getInfo());
+                                texture->set(textureImage->getInfo());
                             }
                             else
                             {
-                                texture = OpenGL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
+                                texture = OpenGL::Texture::create(textureImage->getInfo(), GL_LINEAR, GL_NEAREST);
                             }
-                            texture->copy(*image);
+                            texture->copy(*textureImage);
                             dynamicTextureCache[uid] = texture;
                             primitive->textureID = texture->getID();
                         }
+#if !defined(DJV_OPENGL_ES2)
+                        if (Image::isYUVType(info.type))
+                        {
+                            primitive->yuv = true;
+                            const Image::Size textureSize = OpenGL::Texture::getTextureSize(info);
+                            const glm::vec2 textureSizeF(textureSize.w, textureSize.h);
+                            for (uint8_t j = 0; j < 3; ++j)
+                            {
+                                const glm::ivec2 planePos = OpenGL::Texture::getPlanePos(info, j);
+                                const Image::Size planeSize = info.getPlaneSize(j);
+                                primitive->yuvRect[j] = glm::vec4(
+                                    planePos.x / textureSizeF.x,
+                                    planePos.y / textureSizeF.y,
+                                    planeSize.w / textureSizeF.x,
+                                    planeSize.h / textureSizeF.y);
+                            }
+                            primitive->yuvTexelSize = glm::vec2(1.F / textureSizeF.x, 1.F / textureSizeF.y);
+
+                            // The texture samples are normalized to the storage type
+                            // so scale them back to integer values before applying
+                            // the YUV coefficients.
+                            const auto k = Image::getYUVToRGB(info);
+                            const float sampleMax = static_cast<float>(Image::getIntRange(
+                                Image::DataType::U8 == Image::getDataType(info.type) ?
+                                Image::Type::L_U8 :
+                                Image::Type::L_U16).max);
+                            primitive->yuvMatrix = glm::mat3x3(
+                                1.F,  1.F,  1.F,
+                                0.F,  k.gu, k.bu,
+                                k.rv, k.gv, 0.F);
+                            primitive->yuvScale = glm::vec3(k.yScale, k.cScale, k.cScale) * sampleMax;
+                            primitive->yuvOffset = glm::vec3(k.yOffset, -k.cOffset * k.cScale, -k.cOffset * k.cScale);
+                        }
+#endif // DJV_OPENGL_ES2
                         if (info.layout.mirror.x)
                         {
                             textureU.min = 1.F;
@@ -289,6 +289,8 @@ namespace djv
                 ///@{
 
                 float getTextureAtlasPercentage() const;
+                size_t getTextureAtlasEvictionCount() const;
+                size_t getTextureAtlasDefragmentCount() const;
                 size_t getDynamicTextureCount() const;
                 size_t getVBOSize() const;
 
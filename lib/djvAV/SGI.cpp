@@ -49,7 +49,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides SGI image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
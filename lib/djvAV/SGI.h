@@ -45,6 +45,7 @@ namespace djv
             {
                 static const std::string pluginName = "SGI";
                 static const std::set<std::string> fileExtensions = { ".sgi", ".rgba", ".rgb", ".bw" };
+                static const std::vector<std::string> magicNumbers = { std::string("\x01\xda", 2) };
 
                 //! This class provides the SGI file reader.
                 class Read : public ISequenceRead
@@ -68,11 +69,11 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO&);
-
-                    bool _compression = false;
-                    std::vector<uint32_t> _rleOffset;
-                    std::vector<uint32_t> _rleSize;
+                    Info _open(
+                        const std::string &,
+                        Core::FileSystem::FileIO&,
+                        bool& compression,
+                        std::vector<uint32_t>& rleOffset);
                 };
                 
                 //! This class provides the SGI file I/O plugin.
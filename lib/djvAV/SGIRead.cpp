@@ -32,6 +32,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -64,101 +66,123 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    return _open(fileName, io, compression, rleOffset);
                 }
 
                 namespace
                 {
-                    template<typename T>
-                    bool read(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        bool        endian)
+                    //! Decode a run-length encoded scanline. The control words
+                    //! are big-endian and the pixel values are copied without
+                    //! byte swapping, so the scanline keeps the file endian.
+                    template<size_t N>
+                    bool readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size)
                     {
-                        const size_t bytes = sizeof(T);
-                        const T* inP = reinterpret_cast<const T*>(in);
-                        T* outP = reinterpret_cast<T*>(out);
-                        const T* const outEnd = outP + size;
-                        while (outP < outEnd)
+                        uint8_t* const outEnd = out + size * N;
+                        while (out < outEnd)
                         {
                             // Information.
-                            if (inP > end)
+                            if (in + N > end)
                             {
                                 return false;
                             }
-                            const size_t count = *inP & 0x7f;
-                            const bool   run = !(*inP & 0x80);
-                            const size_t length = run ? 1 : count;
-                            ++inP;
-
-                            // Unpack.
-                            if (inP + length > end)
+                            const uint8_t control = in[N - 1];
+                            const size_t count = control & 0x7f;
+                            in += N;
+                            if (!count)
+                            {
+                                break;
+                            }
+                            const size_t byteCount = count * N;
+                            if (out + byteCount > outEnd)
                             {
                                 return false;
                             }
-                            if (run)
+
+                            // Unpack.
+                            if (control & 0x80)
                             {
-                                if (!endian)
+                                if (in + byteCount > end)
                                 {
-                                    for (size_t j = 0; j < count; ++j, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    return false;
                                 }
-                                else
-                                {
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    if (count > 1)
-                                    {
-                                        for (size_t j = 0; j < count - 1; ++j)
-                                        {
-                                            outP[1 + j] = outP[0];
-                                        }
-                                    }
-                                    outP += count;
-                                }
-                                ++inP;
+                                memcpy(out, in, byteCount);
+                                in += byteCount;
                             }
                             else
                             {
-                                if (!endian)
+                                if (in + N > end)
                                 {
-                                    for (size_t j = 0; j < length; ++j, ++inP, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    return false;
+                                }
+                                if (1 == N)
+                                {
+                                    memset(out, in[0], count);
                                 }
                                 else
                                 {
-                                    Memory::endian(inP, outP, length, bytes);
-                                    inP += length;
-                                    outP += length;
+                                    for (size_t i = 0; i < byteCount; i += N)
+                                    {
+                                        memcpy(out + i, in, N);
+                                    }
                                 }
+                                in += N;
                             }
+                            out += byteCount;
                         }
                         return true;
                     }
 
                     bool readRle(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        size_t      bytes,
-                        bool        endian)
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         bytes)
                     {
                         switch (bytes)
                         {
-                        case 1: return read<uint8_t>(in, end, out, size, false);
-                        case 2: return read<uint16_t>(in, end, out, size, endian);
+                        case 1: return readRle<1>(in, end, out, size);
+                        case 2: return readRle<2>(in, end, out, size);
                         default: break;
                         }
                         return false;
                     }
 
+                    template<size_t N>
+                    void interleave(
+                        const uint8_t* in,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         pixelByteCount)
+                    {
+                        for (size_t x = 0; x < size; ++x, in += N, out += pixelByteCount)
+                        {
+                            memcpy(out, in, N);
+                        }
+                    }
+
+                    void interleave(
+                        const uint8_t* in,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channelByteCount,
+                        size_t         pixelByteCount)
+                    {
+                        switch (channelByteCount)
+                        {
+                        case 1: interleave<1>(in, out, size, pixelByteCount); break;
+                        case 2: interleave<2>(in, out, size, pixelByteCount); break;
+                        case 4: interleave<4>(in, out, size, pixelByteCount); break;
+                        default: break;
+                        }
+                    }
+
                     void planarInterleave(
                         const std::shared_ptr<Image::Data>& in,
                         std::shared_ptr<Image::Image>& out)
@@ -172,37 +196,12 @@ namespace djv
                         {
                             for (size_t y = 0; y < h; ++y)
                             {
-                                const uint8_t* inP = in->getData() + (c * in->getHeight() + y) * in->getWidth() * channelByteCount;
-                                uint8_t* outP = out->getData(0, y) + c * channelByteCount;
-                                for (
-                                    size_t x = 0;
-                                    x < w;
-                                    ++x, inP += channelByteCount,
-                                    outP += pixelByteCount)
-                                {
-                                    switch (channelByteCount)
-                                    {
-                                    case 4:
-                                        outP[3] = inP[3];
-                                        outP[2] = inP[2];
-                                        outP[1] = inP[1];
-                                        outP[0] = inP[0];
-                                        break;
-                                    case 3:
-                                        outP[2] = inP[2];
-                                        outP[1] = inP[1];
-                                        outP[0] = inP[0];
-                                        break;
-                                    case 2:
-                                        outP[1] = inP[1];
-                                        outP[0] = inP[0];
-                                        break;
-                                    case 1:
-                                        outP[0] = inP[0];
-                                        break;
-                                    default: break;
-                                    }
-                                }
+                                interleave(
+                                    in->getData() + (c * in->getHeight() + y) * in->getWidth() * channelByteCount,
+                                    out->getData(0, y) + c * channelByteCount,
+                                    w,
+                                    channelByteCount,
+                                    pixelByteCount);
                             }
                         }
                     }
@@ -213,7 +212,9 @@ namespace djv
                 {
                     std::shared_ptr<Image::Image> out;
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    const auto info = _open(fileName, io, compression, rleOffset);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
@@ -222,47 +223,74 @@ namespace djv
                     const Image::Info& imageInfo = info.video[0].info;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(imageInfo.type));
-                    const size_t dataByteCount = out->getDataByteCount();
-                    std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
-                    if (!_compression)
+                    if (!compression)
                     {
+                        const size_t dataByteCount = out->getDataByteCount();
+                        std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
                         if (1 == bytes)
                         {
                             io.readU8(tmp->getData(), dataByteCount);
                         }
                         else
                         {
-                            io.read(tmp->getData(), size / bytes, bytes);
+                            // Only read as much as the image holds, the file may
+                            // have trailing data.
+                            io.read(tmp->getData(), dataByteCount / bytes, bytes);
                         }
+
+                        // Interleave the image channels.
+                        planarInterleave(tmp, out);
                     }
                     else
                     {
+                        // The offset table gives the position of every channel
+                        // of every scanline, so the scanlines are decoded in
+                        // parallel and interleaved directly into the image.
                         std::vector<uint8_t> rleData(size);
-                        io.read(rleData.data(), size / bytes, bytes);
-                        const uint8_t* inP = rleData.data();
-                        const uint8_t* end = inP + size;
-                        uint8_t* outP = tmp->getData();
-                        for (size_t c = 0; c < channels; ++c)
+                        io.read(rleData.data(), size);
+                        const uint8_t* const rleP = rleData.data();
+                        const uint8_t* const end = rleP + size;
+                        const size_t w = imageInfo.size.w;
+                        const size_t h = imageInfo.size.h;
+                        const size_t pixelByteCount = out->getPixelByteCount();
+                        const size_t threadCount = getBlockThreadCount(h);
+                        std::vector<std::future<void> > futures;
+                        for (size_t i = 0; i < threadCount; ++i)
                         {
-                            for (size_t y = 0; y < imageInfo.size.h; ++y, outP += imageInfo.size.w * bytes)
-                            {
-                                if (!readRle(
-                                    inP + _rleOffset[y + imageInfo.size.h * c] - pos,
-                                    end,
-                                    outP,
-                                    imageInfo.size.w,
-                                    bytes,
-                                    io.hasEndianConversion()))
+                            const size_t y0 = i * h / threadCount;
+                            const size_t y1 = (i + 1) * h / threadCount;
+                            futures.push_back(std::async(
+                                std::launch::async,
+                                [&rleOffset, out, rleP, end, pos, size, y0, y1, w, h, channels, bytes, pixelByteCount]
                                 {
-                                    throw FileSystem::Error(DJV_TEXT("Read error."));
-                                }
-                            }
+                                    std::vector<uint8_t> scanline(w * bytes);
+                                    for (size_t y = y0; y < y1; ++y)
+                                    {
+                                        for (size_t c = 0; c < channels; ++c)
+                                        {
+                                            const size_t offset = rleOffset[y + h * c];
+                                            if (offset < pos ||
+                                                offset - pos >= size ||
+                                                !readRle(rleP + offset - pos, end, scanline.data(), w, bytes))
+                                            {
+                                                throw FileSystem::Error(DJV_TEXT("Read error."));
+                                            }
+                                            interleave(
+                                                scanline.data(),
+                                                out->getData(0, static_cast<uint16_t>(y)) + c * bytes,
+                                                w,
+                                                bytes,
+                                                pixelByteCount);
+                                        }
+                                    }
+                                }));
+                        }
+                        for (auto& i : futures)
+                        {
+                            i.get();
                         }
                     }
 
-                    // Interleave the image channels.
-                    planarInterleave(tmp, out);
-
                     return out;
                 }
 
@@ -338,12 +366,25 @@ namespace djv
                 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io)
+                Info Read::_open(
+                    const std::string &    fileName,
+                    FileSystem::FileIO&    io,
+                    bool&                  compression,
+                    std::vector<uint32_t>& rleOffset)
                 {
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
                     io.open(fileName, FileSystem::FileIO::Mode::Read);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _compression);
+                    Header().read(io, imageInfo, compression);
+                    if (compression)
+                    {
+                        // Read the scanline offset table and skip the scanline
+                        // length table.
+                        const size_t size = imageInfo.size.h * Image::getChannelCount(imageInfo.type);
+                        rleOffset.resize(size);
+                        io.readU32(rleOffset.data(), size);
+                        io.seek(size * 4);
+                    }
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
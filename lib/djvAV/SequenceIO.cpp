@@ -30,10 +30,13 @@
 #include <djvAV/SequenceIO.h>
 
 #include <djvAV/ImageConvert.h>
+#include <djvAV/ImageUtil.h>
+#include <djvAV/OCIOLUT3D.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/OS.h>
 #include <djvCore/Path.h>
@@ -44,6 +47,7 @@
 #include <GLFW/glfw3.h>
 
 #include <future>
+#include <thread>
 
 using namespace djv::Core;
 
@@ -57,9 +61,18 @@ namespace djv
             {
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
+#if defined(DJV_MMAP)
+                const size_t readAheadFrameCount = 8;
+#endif // DJV_MMAP
 
             } // namespace
 
+            size_t getBlockThreadCount(size_t blockCount)
+            {
+                const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1U);
+                return std::max(std::min(std::min(hardwareThreads, blockThreadCountMax), blockCount), size_t(1));
+            }
+
             struct ISequenceRead::Future
             {
                 Frame::Number frame = Frame::invalid;
@@ -77,6 +90,11 @@ namespace djv
                 std::thread thread;
                 std::atomic<bool> running;
                 std::chrono::system_clock::time_point infoTimer;
+#if defined(DJV_MMAP)
+                bool memoryMapped = false;
+                Frame::Number readAheadFrame = Frame::invalid;
+                Direction readAheadDirection = Direction::Forward;
+#endif // DJV_MMAP
             };
 
             void ISequenceRead::_init(
@@ -217,6 +235,9 @@ namespace djv
                         if (queueCount > 0)
                         {
                             read = _readQueue(queueCount, cacheEnabled);
+#if defined(DJV_MMAP)
+                            _readAhead(inOutPoints);
+#endif // DJV_MMAP
                         }
 
                         // Fill the cache.
@@ -335,6 +356,12 @@ namespace djv
                     std::shared_ptr<Image::Image> cachedImage;
                     if (cacheEnabled && _cache.get(p.frame, cachedImage))
                     {
+#if defined(DJV_MMAP)
+                        // Memory-mapped images are kept in the cache without
+                        // copying, so make sure the pages are resident before
+                        // the frame is displayed.
+                        cachedImage->readAhead();
+#endif // DJV_MMAP
                         images.push_back(std::make_pair(p.frame, cachedImage));
                     }
                     else
@@ -384,12 +411,12 @@ namespace djv
                     const auto result = future.get();
                     if (result.image)
                     {
+#if defined(DJV_MMAP)
+                        p.memoryMapped = result.image->isMemoryMapped();
+#endif // DJV_MMAP
                         images.push_back(std::make_pair(result.frame, result.image));
                         if (cacheEnabled)
                         {
-#if defined(DJV_MMAP)
-                            result.image->detach();
-#endif // DJV_MMAP
                             _cache.add(result.frame, result.image);
                         }
                     }
@@ -417,6 +444,70 @@ namespace djv
                 return futures.size();
             }
 
+#if defined(DJV_MMAP)
+            void ISequenceRead::_readAhead(const AV::IO::InOutPoints& inOutPoints)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Start paging in the frames that will be read next in the
+                // playback direction, so the memory-mapped data is resident by
+                // the time the frames are needed. This only helps plugins that
+                // use the data directly from the memory-map.
+                const size_t sequenceSize = _sequence.getSize();
+                if (!p.memoryMapped || !sequenceSize || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize))
+                {
+                    return;
+                }
+                const auto range = inOutPoints.getRange(sequenceSize);
+
+                // Continue after the last frame that was paged in, so each frame
+                // is only paged in once.
+                Frame::Number frame = p.frame;
+                size_t count = readAheadFrameCount;
+                if (p.readAheadFrame != Frame::invalid && p.readAheadDirection == p.direction)
+                {
+                    const Frame::Number distance = Direction::Forward == p.direction ?
+                        (p.readAheadFrame - p.frame) :
+                        (p.frame - p.readAheadFrame);
+                    if (distance >= 0 && distance < static_cast<Frame::Number>(readAheadFrameCount))
+                    {
+                        frame = Direction::Forward == p.direction ? (p.readAheadFrame + 1) : (p.readAheadFrame - 1);
+                        count = readAheadFrameCount - static_cast<size_t>(distance) - 1;
+                    }
+                }
+                p.readAheadDirection = p.direction;
+
+                for (size_t i = 0; i < count && frame >= range.min && frame <= range.max; ++i)
+                {
+                    // Cached frames are paged in when they are added to the queue.
+                    if (!_cache.contains(frame))
+                    {
+                        try
+                        {
+                            // The pages stay in the file system cache after the
+                            // file is closed.
+                            FileSystem::FileIO io;
+                            io.open(_fileInfo.getFileName(_sequence.getFrame(frame)), FileSystem::FileIO::Mode::Read);
+                            io.mmapReadAhead();
+                        }
+                        catch (const std::exception&)
+                        {}
+                    }
+                    p.readAheadFrame = frame;
+                    switch (p.direction)
+                    {
+                    case Direction::Forward:
+                        ++frame;
+                        break;
+                    case Direction::Reverse:
+                        --frame;
+                        break;
+                    default: break;
+                    }
+                }
+            }
+#endif // DJV_MMAP
+
             void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
             {
                 DJV_PRIVATE_PTR();
@@ -505,9 +596,6 @@ namespace djv
                         const auto result = i->get();
                         if (result.image)
                         {
-#if defined(DJV_MMAP)
-                            result.image->detach();
-#endif // DJV_MMAP
                             _cache.add(result.frame, result.image);
                         }
                         i = p.cacheFutures.erase(i);
@@ -525,6 +613,7 @@ namespace djv
                 Frame::Number frameNumber = Frame::invalid;
                 GLFWwindow * glfwWindow = nullptr;
                 std::shared_ptr<Image::Convert> convert;
+                std::shared_ptr<const OCIO::LUT3D> colorSpaceLUT;
                 std::thread thread;
                 std::atomic<bool> running;
             };
@@ -550,10 +639,10 @@ namespace djv
                 if (p.fileInfo.isSequenceValid())
                 {
                     auto sequence = p.fileInfo.getSequence();
-                    if (sequence.ranges.size())
+                    if (sequence.getRanges().size())
                     {
                         sequence.sort();
-                        p.frameNumber = sequence.ranges[0].min;
+                        p.frameNumber = sequence.getRanges()[0].min;
                     }
                 }
 
@@ -600,15 +689,21 @@ namespace djv
                         }
 
                         p.convert = Image::Convert::create(_resourceSystem);
+                        if (_options.colorSpaceConvert.isValid())
+                        {
+                            p.colorSpaceLUT = OCIO::LUT3D::getCached(_options.colorSpaceConvert);
+                        }
 
                         const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
                         while (p.running)
                         {
                             std::vector<std::shared_ptr<Image::Image> > images;
+                            size_t threadCount = 1;
                             {
                                 std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
                                 if (lock.owns_lock())
                                 {
+                                    threadCount = _threadCount;
                                     while (!_videoQueue.isEmpty() && images.size() < _threadCount)
                                     {
                                         auto frame = _videoQueue.popFrame();
@@ -641,7 +736,11 @@ namespace djv
                                     {
                                         ++p.frameNumber;
                                     }
-                                    auto image = images[i];
+                                    auto image = Image::convertYUV(images[i]);
+                                    if (p.colorSpaceLUT)
+                                    {
+                                        image = p.colorSpaceLUT->apply(image, threadCount);
+                                    }
                                     const Image::Type imageType = _getImageType(image->getType());
                                     if (Image::Type::None == imageType)
                                     {
@@ -696,6 +795,7 @@ namespace djv
                         }
 
                         p.convert.reset();
+                        p.colorSpaceLUT.reset();
                     }
                     catch (const std::exception & e)
                     {
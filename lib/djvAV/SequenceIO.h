@@ -39,6 +39,13 @@ namespace djv
     {
         namespace IO
         {
+            //! This constant provides the maximum number of threads used to
+            //! decode the blocks (strips, tiles, or scanlines) of a single image.
+            const size_t blockThreadCountMax = 4;
+
+            //! Get the number of threads to use for the given number of blocks.
+            size_t getBlockThreadCount(size_t blockCount);
+
             //! This class provides an interface for reading sequences.
             class ISequenceRead : public IRead
             {
@@ -75,6 +82,9 @@ namespace djv
                 std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
                 size_t _readQueue(size_t count, bool cacheEnabled);
                 void _readCache(size_t count, const AV::IO::InOutPoints&);
+#if defined(DJV_MMAP)
+                void _readAhead(const AV::IO::InOutPoints&);
+#endif // DJV_MMAP
 
                 DJV_PRIVATE();
             };
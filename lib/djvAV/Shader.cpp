@@ -31,6 +31,7 @@
 
 #include <djvCore/FileIO.h>
 #include <djvCore/Path.h>
+#include <djvCore/ResourceSystem.h>
 
 using namespace djv::Core;
 
@@ -80,6 +81,28 @@ namespace djv
                 return out;
             }
 
+            std::shared_ptr<Shader> Shader::create(
+                const std::shared_ptr<ResourceSystem>& resourceSystem,
+                const std::string & vertexFileName,
+                const std::string & fragmentFileName)
+            {
+                auto out = std::shared_ptr<Shader>(new Shader);
+                try
+                {
+                    out->_vertex.second = resourceSystem->readContents(FileSystem::ResourcePath::Shaders, vertexFileName);
+                    out->_vertex.first = vertexFileName;
+                    out->_fragment.second = resourceSystem->readContents(FileSystem::ResourcePath::Shaders, fragmentFileName);
+                    out->_fragment.first = fragmentFileName;
+                }
+                catch (const std::exception & e)
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The shader cannot be created") << ". " << e.what();
+                    throw ShaderError(ss.str());
+                }
+                return out;
+            }
+
             const std::string & Shader::getVertexName() const
             {
                 return _vertex.first;
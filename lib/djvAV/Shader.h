@@ -39,6 +39,8 @@ namespace djv
 {
     namespace Core
     {
+        class ResourceSystem;
+
         namespace FileSystem
         {
             class Path;
@@ -74,6 +76,15 @@ namespace djv
                 //! - ShaderError
                 static std::shared_ptr<Shader> create(const Core::FileSystem::Path & vertex, const Core::FileSystem::Path & fragment);
 
+                //! Create a shader from files in the shaders resource path. The
+                //! files are read from the resource bundle if possible.
+                //! Throws:
+                //! - ShaderError
+                static std::shared_ptr<Shader> create(
+                    const std::shared_ptr<Core::ResourceSystem>&,
+                    const std::string & vertexFileName,
+                    const std::string & fragmentFileName);
+
                 const std::string & getVertexName() const;
                 const std::string & getVertexSource() const;
                 const std::string & getFragmentName() const;
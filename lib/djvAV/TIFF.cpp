@@ -94,7 +94,8 @@ namespace djv
                         pluginName,
                         DJV_TEXT("This plugin provides Tagged Image File Format (TIFF) image I/O."),
                         fileExtensions,
-                        context);
+                        context,
+                        magicNumbers);
                     return out;
                 }
 
@@ -157,7 +158,8 @@ namespace djv
         Compression,
         DJV_TEXT("None"),
         DJV_TEXT("RLE"),
-        DJV_TEXT("LZW"));
+        DJV_TEXT("LZW"),
+        DJV_TEXT("ZIP"));
 
 } // namespace djv
 
@@ -41,12 +41,16 @@ namespace djv
         {
             //! This namespace provides Tagged Image File Format (TIFF) I/O.
             //!
+            //! Images are read and written a strip or tile at a time, with the
+            //! strips and tiles of each image (de)compressed in parallel.
+            //!
             //! References:
             //! - http://www.libtiff.org
             namespace TIFF
             {
                 static const std::string pluginName = "TIFF";
                 static const std::set<std::string> fileExtensions = { ".tiff", ".tif" };
+                static const std::vector<std::string> magicNumbers = { std::string("II\x2a\x00", 4), std::string("MM\x00\x2a", 4) };
 
                 //! This enumeration provides the TIFF file compression types.
                 enum class Compression
@@ -54,6 +58,7 @@ namespace djv
                     None,
                     RLE,
                     LZW,
+                    ZIP,
 
                     Count,
                     First
@@ -99,6 +104,8 @@ namespace djv
                 private:
                     struct File;
                     Info _open(const std::string &, File &);
+                    void _readStrips(const std::string &, File &, const std::shared_ptr<Image::Image> &);
+                    void _readTiles(const std::string &, File &, const std::shared_ptr<Image::Image> &);
                 };
                 
                 //! This class provides the TIFF file writer.
@@ -32,6 +32,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -56,6 +58,7 @@ namespace djv
                     ::TIFF * f           = nullptr;
                     bool     compression = false;
                     bool     palette     = false;
+                    bool     separate    = false;
                     uint16 * colormap[3] = { nullptr, nullptr, nullptr };
                 };
 
@@ -91,13 +94,27 @@ namespace djv
                     const auto info = _open(fileName, f);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
-                    for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
+                    if (f.separate)
                     {
-                        if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
+                        for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
                         {
-                            throw FileSystem::Error(DJV_TEXT("Error reading scanline."));
+                            if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Error reading scanline."));
+                            }
                         }
-                        if (f.palette)
+                    }
+                    else if (TIFFIsTiled(f.f))
+                    {
+                        _readTiles(fileName, f, out);
+                    }
+                    else
+                    {
+                        _readStrips(fileName, f, out);
+                    }
+                    if (f.palette)
+                    {
+                        for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
                         {
                             TIFF::paletteLoad(
                                 out->getData(y),
@@ -109,6 +126,126 @@ namespace djv
                     return out;
                 }
 
+                void Read::_readStrips(const std::string & fileName, File & f, const std::shared_ptr<Image::Image> & image)
+                {
+                    const uint32 height = image->getHeight();
+                    uint32 rowsPerStrip = 0;
+                    TIFFGetFieldDefaulted(f.f, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+                    rowsPerStrip = std::max(std::min(rowsPerStrip, height), uint32(1));
+                    const size_t stripCount = (height + rowsPerStrip - 1) / rowsPerStrip;
+                    const size_t scanlineSize = static_cast<size_t>(TIFFScanlineSize(f.f));
+                    const size_t threadCount = getBlockThreadCount(stripCount);
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
+                    {
+                        const size_t begin = i * stripCount / threadCount;
+                        const size_t end = (i + 1) * stripCount / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [&fileName, &f, image, i, begin, end, height, rowsPerStrip, scanlineSize]
+                            {
+                                // A libtiff handle cannot be shared between threads, so
+                                // each additional thread opens the file again.
+                                File threadFile;
+                                ::TIFF * tiff = f.f;
+                                if (i > 0)
+                                {
+                                    threadFile.f = TIFFOpen(fileName.data(), "r");
+                                    if (!threadFile.f)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Cannot open file."));
+                                    }
+                                    tiff = threadFile.f;
+                                }
+                                std::vector<uint8_t> buf(static_cast<size_t>(TIFFStripSize(tiff)));
+                                for (size_t strip = begin; strip < end; ++strip)
+                                {
+                                    const uint32 y = static_cast<uint32>(strip * rowsPerStrip);
+                                    const uint32 rows = std::min(rowsPerStrip, height - y);
+                                    if (TIFFReadEncodedStrip(
+                                        tiff,
+                                        TIFFComputeStrip(tiff, y, 0),
+                                        buf.data(),
+                                        static_cast<tmsize_t>(rows * scanlineSize)) == -1)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Error reading strip."));
+                                    }
+                                    for (uint32 j = 0; j < rows; ++j)
+                                    {
+                                        memcpy(image->getData(y + j), buf.data() + j * scanlineSize, scanlineSize);
+                                    }
+                                }
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                }
+
+                void Read::_readTiles(const std::string & fileName, File & f, const std::shared_ptr<Image::Image> & image)
+                {
+                    const uint32 width = image->getWidth();
+                    const uint32 height = image->getHeight();
+                    uint32 tileWidth = 0;
+                    uint32 tileHeight = 0;
+                    TIFFGetField(f.f, TIFFTAG_TILEWIDTH, &tileWidth);
+                    TIFFGetField(f.f, TIFFTAG_TILELENGTH, &tileHeight);
+                    if (!tileWidth || !tileHeight)
+                    {
+                        throw FileSystem::Error(DJV_TEXT("Error reading tile."));
+                    }
+                    const size_t tilesAcross = (width + tileWidth - 1) / tileWidth;
+                    const size_t tilesDown = (height + tileHeight - 1) / tileHeight;
+                    const size_t tileCount = tilesAcross * tilesDown;
+                    const size_t pixelSize = static_cast<size_t>(TIFFScanlineSize(f.f)) / width;
+                    const size_t tileRowSize = static_cast<size_t>(TIFFTileRowSize(f.f));
+                    const size_t threadCount = getBlockThreadCount(tileCount);
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
+                    {
+                        const size_t begin = i * tileCount / threadCount;
+                        const size_t end = (i + 1) * tileCount / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [&fileName, &f, image, i, begin, end, width, height, tileWidth, tileHeight,
+                            tilesAcross, pixelSize, tileRowSize]
+                            {
+                                File threadFile;
+                                ::TIFF * tiff = f.f;
+                                if (i > 0)
+                                {
+                                    threadFile.f = TIFFOpen(fileName.data(), "r");
+                                    if (!threadFile.f)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Cannot open file."));
+                                    }
+                                    tiff = threadFile.f;
+                                }
+                                std::vector<uint8_t> buf(static_cast<size_t>(TIFFTileSize(tiff)));
+                                for (size_t tile = begin; tile < end; ++tile)
+                                {
+                                    const uint32 x = static_cast<uint32>(tile % tilesAcross * tileWidth);
+                                    const uint32 y = static_cast<uint32>(tile / tilesAcross * tileHeight);
+                                    if (TIFFReadEncodedTile(tiff, TIFFComputeTile(tiff, x, y, 0, 0), buf.data(), -1) == -1)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Error reading tile."));
+                                    }
+                                    const size_t size = std::min(tileWidth, width - x) * pixelSize;
+                                    const uint32 rows = std::min(tileHeight, height - y);
+                                    for (uint32 j = 0; j < rows; ++j)
+                                    {
+                                        memcpy(image->getData(y + j) + x * pixelSize, buf.data() + j * tileRowSize, size);
+                                    }
+                                }
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                }
+
                 Info Read::_open(const std::string & fileName, File & f)
                 {
 #if defined(DJV_PLATFORM_WINDOWS)
@@ -181,6 +318,7 @@ namespace djv
 
                     f.compression = compression != COMPRESSION_NONE;
                     f.palette = PHOTOMETRIC_PALETTE == photometric;
+                    f.separate = PLANARCONFIG_SEPARATE == channels;
 
                     AV::Tags tags;
                     char * tag = 0;
@@ -31,6 +31,8 @@
 
 #include <djvCore/FileSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -71,6 +73,9 @@ namespace djv
 
                 namespace
                 {
+                    //! \todo Should this be configurable?
+                    const size_t stripSize = 65536;
+
                     struct File
                     {
                         ~File()
@@ -84,7 +89,130 @@ namespace djv
 
                         ::TIFF * f = nullptr;
                     };
-                }
+
+                    //! This struct provides an in-memory file used to compress strips
+                    //! in parallel. Only the data written while capturing is kept.
+                    struct MemoryFile
+                    {
+                        toff_t pos = 0;
+                        toff_t size = 0;
+                        bool capture = false;
+                        std::vector<uint8_t> data;
+                    };
+
+                    tmsize_t memoryRead(thandle_t, void *, tmsize_t)
+                    {
+                        return 0;
+                    }
+
+                    tmsize_t memoryWrite(thandle_t handle, void * buf, tmsize_t size)
+                    {
+                        auto file = reinterpret_cast<MemoryFile *>(handle);
+                        if (file->capture)
+                        {
+                            const uint8_t * p = reinterpret_cast<const uint8_t *>(buf);
+                            file->data.insert(file->data.end(), p, p + size);
+                        }
+                        file->pos += size;
+                        file->size = std::max(file->size, file->pos);
+                        return size;
+                    }
+
+                    toff_t memorySeek(thandle_t handle, toff_t offset, int whence)
+                    {
+                        auto file = reinterpret_cast<MemoryFile *>(handle);
+                        switch (whence)
+                        {
+                        case SEEK_SET: file->pos = offset; break;
+                        case SEEK_CUR: file->pos += offset; break;
+                        case SEEK_END: file->pos = file->size + offset; break;
+                        default: break;
+                        }
+                        return file->pos;
+                    }
+
+                    int memoryClose(thandle_t)
+                    {
+                        return 0;
+                    }
+
+                    toff_t memorySize(thandle_t handle)
+                    {
+                        return reinterpret_cast<MemoryFile *>(handle)->size;
+                    }
+
+                    int memoryMap(thandle_t, void **, toff_t *)
+                    {
+                        return 0;
+                    }
+
+                    void memoryUnmap(thandle_t, void *, toff_t)
+                    {}
+
+                    void setFields(::TIFF * f, const Image::Info & info, uint16 compression, uint32 rowsPerStrip)
+                    {
+                        uint16 photometric      = 0;
+                        uint16 samples          = 0;
+                        uint16 sampleDepth      = 0;
+                        uint16 sampleFormat     = 0;
+                        uint16 extraSamples[]   = { EXTRASAMPLE_ASSOCALPHA };
+                        uint16 extraSamplesSize = 0;
+                        switch (Image::getChannelCount(info.type))
+                        {
+                        case 1:
+                            photometric = PHOTOMETRIC_MINISBLACK;
+                            samples = 1;
+                            break;
+                        case 2:
+                            photometric = PHOTOMETRIC_MINISBLACK;
+                            samples = 2;
+                            extraSamplesSize = 1;
+                            break;
+                        case 3:
+                            photometric = PHOTOMETRIC_RGB;
+                            samples = 3;
+                            break;
+                        case 4:
+                            photometric = PHOTOMETRIC_RGB;
+                            samples = 4;
+                            extraSamplesSize = 1;
+                            break;
+                        default: break;
+                        }
+                        switch (Image::getDataType(info.type))
+                        {
+                        case Image::DataType::U8:
+                            sampleDepth = 8;
+                            sampleFormat = SAMPLEFORMAT_UINT;
+                            break;
+                        case Image::DataType::U16:
+                            sampleDepth = 16;
+                            sampleFormat = SAMPLEFORMAT_UINT;
+                            break;
+                        case Image::DataType::U32:
+                            sampleDepth = 32;
+                            sampleFormat = SAMPLEFORMAT_UINT;
+                            break;
+                        case Image::DataType::F32:
+                            sampleDepth = 32;
+                            sampleFormat = SAMPLEFORMAT_IEEEFP;
+                            break;
+                        default: break;
+                        }
+                        TIFFSetField(f, TIFFTAG_IMAGEWIDTH, info.size.w);
+                        TIFFSetField(f, TIFFTAG_IMAGELENGTH, info.size.h);
+                        TIFFSetField(f, TIFFTAG_PHOTOMETRIC, photometric);
+                        TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, samples);
+                        TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, sampleDepth);
+                        TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, sampleFormat);
+                        TIFFSetField(f, TIFFTAG_EXTRASAMPLES, extraSamplesSize, extraSamples);
+                        TIFFSetField(f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+                        TIFFSetField(f, TIFFTAG_COMPRESSION, compression);
+                        TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                        TIFFSetField(f, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+                    }
+
+                } // namespace
 
                 Image::Type Write::_getImageType(Image::Type value) const
                 {
@@ -138,55 +266,7 @@ namespace djv
                     }
 
                     const auto& info = image->getInfo();
-                    uint16 photometric      = 0;
-                    uint16 samples          = 0;
-                    uint16 sampleDepth      = 0;
-                    uint16 sampleFormat     = 0;
-                    uint16 extraSamples[]   = { EXTRASAMPLE_ASSOCALPHA };
-                    uint16 extraSamplesSize = 0;
-                    uint16 compression      = 0;
-                    switch (Image::getChannelCount(info.type))
-                    {
-                    case 1:
-                        photometric = PHOTOMETRIC_MINISBLACK;
-                        samples = 1;
-                        break;
-                    case 2:
-                        photometric = PHOTOMETRIC_MINISBLACK;
-                        samples = 2;
-                        extraSamplesSize = 1;
-                        break;
-                    case 3:
-                        photometric = PHOTOMETRIC_RGB;
-                        samples = 3;
-                        break;
-                    case 4:
-                        photometric = PHOTOMETRIC_RGB;
-                        samples = 4;
-                        extraSamplesSize = 1;
-                        break;
-                    default: break;
-                    }
-                    switch (Image::getDataType(info.type))
-                    {
-                    case Image::DataType::U8:
-                        sampleDepth = 8;
-                        sampleFormat = SAMPLEFORMAT_UINT;
-                        break;
-                    case Image::DataType::U16:
-                        sampleDepth = 16;
-                        sampleFormat = SAMPLEFORMAT_UINT;
-                        break;
-                    case Image::DataType::U32:
-                        sampleDepth = 32;
-                        sampleFormat = SAMPLEFORMAT_UINT;
-                        break;
-                    case Image::DataType::F32:
-                        sampleDepth = 32;
-                        sampleFormat = SAMPLEFORMAT_IEEEFP;
-                        break;
-                    default: break;
-                    }
+                    uint16 compression = 0;
                     switch (_p->options.compression)
                     {
                     case Compression::None:
@@ -198,18 +278,18 @@ namespace djv
                     case Compression::LZW:
                         compression = COMPRESSION_LZW;
                         break;
+                    case Compression::ZIP:
+                        compression = COMPRESSION_ADOBE_DEFLATE;
+                        break;
                     default: break;
                     }
-                    TIFFSetField(f.f, TIFFTAG_IMAGEWIDTH, info.size.w);
-                    TIFFSetField(f.f, TIFFTAG_IMAGELENGTH, info.size.h);
-                    TIFFSetField(f.f, TIFFTAG_PHOTOMETRIC, photometric);
-                    TIFFSetField(f.f, TIFFTAG_SAMPLESPERPIXEL, samples);
-                    TIFFSetField(f.f, TIFFTAG_BITSPERSAMPLE, sampleDepth);
-                    TIFFSetField(f.f, TIFFTAG_SAMPLEFORMAT, sampleFormat);
-                    TIFFSetField(f.f, TIFFTAG_EXTRASAMPLES, extraSamplesSize, extraSamples);
-                    TIFFSetField(f.f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
-                    TIFFSetField(f.f, TIFFTAG_COMPRESSION, compression);
-                    TIFFSetField(f.f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                    const size_t scanlineSize = info.getScanlineByteCount();
+                    const uint32 height = info.size.h;
+                    const uint32 rowsPerStrip = std::max(std::min(
+                        static_cast<uint32>(stripSize / std::max(scanlineSize, size_t(1))),
+                        height),
+                        uint32(1));
+                    setFields(f.f, info, compression, rowsPerStrip);
 
                     std::string tag = _info.tags.getTag("Creator");
                     if (!tag.empty())
@@ -232,11 +312,90 @@ namespace djv
                         TIFFSetField(f.f, TIFFTAG_IMAGEDESCRIPTION, tag.data());
                     }
 
-                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    const size_t stripCount = (height + rowsPerStrip - 1) / rowsPerStrip;
+                    if (COMPRESSION_NONE == compression)
+                    {
+                        for (size_t strip = 0; strip < stripCount; ++strip)
+                        {
+                            const uint32 y = static_cast<uint32>(strip * rowsPerStrip);
+                            const uint32 rows = std::min(rowsPerStrip, height - y);
+                            if (TIFFWriteEncodedStrip(
+                                f.f,
+                                static_cast<uint32>(strip),
+                                (tdata_t *)image->getData(y),
+                                static_cast<tmsize_t>(rows * scanlineSize)) == -1)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                            }
+                        }
+                        return;
+                    }
+
+                    // Compress the strips in parallel. Each thread encodes its strips
+                    // into an in-memory file and keeps the compressed data, which is
+                    // then written to the file in order.
+                    std::vector<std::vector<uint8_t> > strips(stripCount);
+                    const size_t threadCount = getBlockThreadCount(stripCount);
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
+                    {
+                        const size_t begin = i * stripCount / threadCount;
+                        const size_t end = (i + 1) * stripCount / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [&strips, image, info, compression, begin, end, height, rowsPerStrip, scanlineSize]
+                            {
+                                MemoryFile memoryFile;
+                                File threadFile;
+                                threadFile.f = TIFFClientOpen(
+                                    "djv::AV::IO::TIFF::Write",
+                                    "wm",
+                                    reinterpret_cast<thandle_t>(&memoryFile),
+                                    memoryRead,
+                                    memoryWrite,
+                                    memorySeek,
+                                    memoryClose,
+                                    memorySize,
+                                    memoryMap,
+                                    memoryUnmap);
+                                if (!threadFile.f)
+                                {
+                                    throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                                }
+                                setFields(threadFile.f, info, compression, rowsPerStrip);
+                                for (size_t strip = begin; strip < end; ++strip)
+                                {
+                                    const uint32 y = static_cast<uint32>(strip * rowsPerStrip);
+                                    const uint32 rows = std::min(rowsPerStrip, height - y);
+                                    memoryFile.capture = true;
+                                    const tmsize_t r = TIFFWriteEncodedStrip(
+                                        threadFile.f,
+                                        static_cast<uint32>(strip),
+                                        (tdata_t *)image->getData(y),
+                                        static_cast<tmsize_t>(rows * scanlineSize));
+                                    memoryFile.capture = false;
+                                    if (-1 == r)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                                    }
+                                    strips[strip] = std::move(memoryFile.data);
+                                    memoryFile.data = std::vector<uint8_t>();
+                                }
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                    for (size_t strip = 0; strip < stripCount; ++strip)
                     {
-                        if (TIFFWriteScanline(f.f, (tdata_t *)image->getData(y), y) == -1)
+                        if (TIFFWriteRawStrip(
+                            f.f,
+                            static_cast<uint32>(strip),
+                            strips[strip].data(),
+                            static_cast<tmsize_t>(strips[strip].size())) == -1)
                         {
-                            throw FileSystem::Error(DJV_TEXT("Error writing scanline."));
+                            throw FileSystem::Error(DJV_TEXT("Error writing strip."));
                         }
                     }
                 }
@@ -69,10 +69,7 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO&);
-
-                    bool _bgr = false;
-                    bool _compression = false;
+                    Info _open(const std::string &, Core::FileSystem::FileIO&, bool& bgr, bool& compression);
                 };
                 
                 //! This class provides the Targa file I/O plugin.
@@ -64,146 +64,153 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    bool bgr = false;
+                    bool compression = false;
+                    return _open(fileName, io, bgr, compression);
                 }
 
                 namespace
                 {
+                    template<size_t N, bool BGR>
                     const uint8_t* readRle(
                         const uint8_t* in,
                         const uint8_t* end,
                         uint8_t*       out,
-                        size_t         size,
-                        size_t         channels)
+                        size_t         size)
                     {
-                        const uint8_t* const outEnd = out + size * channels;
+                        const uint8_t* const outEnd = out + size * N;
                         while (out < outEnd)
                         {
                             // Information.
-                            if (in > end)
+                            if (in >= end)
                             {
-                                return 0;
+                                return nullptr;
                             }
-                            const uint8_t count  = (*in & 0x7f) + 1;
-                            const bool    run    = (*in & 0x80) ? true : false;
-                            const size_t  length = run ? 1 : count;
+                            const size_t count = (*in & 0x7f) + 1;
+                            const bool   run   = (*in & 0x80) ? true : false;
+                            const size_t byteCount = count * N;
                             ++in;
-
-                            // Unpack.
-                            if (in + length * channels > end)
+                            if (out + byteCount > outEnd)
                             {
-                                return 0;
+                                return nullptr;
                             }
+
+                            // Unpack.
                             if (run)
                             {
-                                for (size_t j = 0; j < count; ++j, out += channels)
+                                if (in + N > end)
                                 {
-                                    switch (channels)
-                                    {
-                                    case 4:
-                                        out[3] = in[3];
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 3:
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 2:
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 1:
-                                        out[0] = in[0];
-                                        break;
-                                    default: break;
-                                    }
+                                    return nullptr;
+                                }
+                                uint8_t pixel[N];
+                                memcpy(pixel, in, N);
+                                if (BGR)
+                                {
+                                    std::swap(pixel[0], pixel[2]);
                                 }
-                                in += channels;
+                                for (size_t j = 0; j < count; ++j, out += N)
+                                {
+                                    memcpy(out, pixel, N);
+                                }
+                                in += N;
                             }
                             else
                             {
-                                for (size_t j = 0; j < count; ++j, in += channels, out += channels)
+                                if (in + byteCount > end)
+                                {
+                                    return nullptr;
+                                }
+                                if (BGR)
                                 {
-                                    switch (channels)
+                                    for (size_t j = 0; j < count; ++j, in += N, out += N)
                                     {
-                                    case 4:
-                                        out[3] = in[3];
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 3:
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 2:
+                                        out[0] = in[2];
                                         out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 1:
-                                        out[0] = in[0];
-                                        break;
-                                    default: break;
+                                        out[2] = in[0];
+                                        if (4 == N)
+                                        {
+                                            out[3] = in[3];
+                                        }
                                     }
                                 }
+                                else
+                                {
+                                    memcpy(out, in, byteCount);
+                                    in += byteCount;
+                                    out += byteCount;
+                                }
                             }
                         }
                         return in;
                     }
 
+                    const uint8_t* readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channels,
+                        bool           bgr)
+                    {
+                        switch (channels)
+                        {
+                        case 1: return readRle<1, false>(in, end, out, size);
+                        case 2: return readRle<2, false>(in, end, out, size);
+                        case 3: return bgr ? readRle<3, true>(in, end, out, size) : readRle<3, false>(in, end, out, size);
+                        case 4: return bgr ? readRle<4, true>(in, end, out, size) : readRle<4, false>(in, end, out, size);
+                        default: break;
+                        }
+                        return nullptr;
+                    }
+
                 } // namespace
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     std::shared_ptr<Image::Image> out;
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
+                    bool bgr = false;
+                    bool compression = false;
+                    const auto info = _open(fileName, io, bgr, compression);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
                     const Image::Info& imageInfo = info.video[0].info;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
-                    if (!_compression)
+                    if (!compression)
                     {
                         io.read(out->getData(), out->getDataByteCount());
-                    }
-                    else
-                    {
-                        const size_t tmpSize = io.getSize() - io.getPos();
-                        std::vector<uint8_t> tmp(tmpSize);
-                        io.read(tmp.data(), tmpSize);
-                        const uint8_t* p = tmp.data();
-                        const uint8_t* const end = p + tmpSize;
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        if (bgr)
                         {
-                            p = readRle(
-                                p,
-                                end,
-                                out->getData(0, y),
-                                imageInfo.size.w,
-                                channels);
-                            if (!p)
+                            for (uint16_t y = 0; y < imageInfo.size.h; ++y)
                             {
-                                throw FileSystem::Error(DJV_TEXT("Read error."));
+                                uint8_t* p = out->getData(0, y);
+                                for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += channels)
+                                {
+                                    const uint8_t tmp = p[0];
+                                    p[0] = p[2];
+                                    p[2] = tmp;
+                                }
                             }
                         }
                     }
-
-                    if (_bgr)
+                    else
                     {
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        // Packets may cross scanlines so the image is decoded
+                        // in one pass, with the BGR swizzle done as each packet
+                        // is unpacked.
+                        const size_t tmpSize = io.getSize() - io.getPos();
+                        std::vector<uint8_t> tmp(tmpSize);
+                        io.read(tmp.data(), tmpSize);
+                        if (!readRle(
+                            tmp.data(),
+                            tmp.data() + tmpSize,
+                            out->getData(),
+                            static_cast<size_t>(imageInfo.size.w) * imageInfo.size.h,
+                            channels,
+                            bgr))
                         {
-                            uint8_t* p = out->getData(0, y);
-                            for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += channels)
-                            {
-                                const uint8_t tmp = p[0];
-                                p[0] = p[2];
-                                p[2] = tmp;
-                            }
+                            throw FileSystem::Error(DJV_TEXT("Read error."));
                         }
                     }
 
@@ -329,12 +336,12 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io)
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io, bool& bgr, bool& compression)
                 {
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::LSB);
                     io.open(fileName, FileSystem::FileIO::Mode::Read);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _bgr, _compression);
+                    Header().read(io, imageInfo, bgr, compression);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -31,7 +31,11 @@
 
 #include <djvAV/OpenGLTexture.h>
 
-#include <djvCore/BBox.h>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 
 using namespace djv::Core;
 
@@ -43,103 +47,522 @@ namespace djv
         {
             namespace
             {
-                uint64_t _timestamp = 0;
+                //! \todo Should this be configurable?
+                const float shelfFit = 1.5F;
 
-            } // namespace
+                const uint16_t shelfNone = std::numeric_limits<uint16_t>::max();
 
-            //! This class provides the nodes used for box packing.
-            //!
-            //! References:
-            //! - http://blackpawn.com/texts/lightmaps/
-            class TextureAtlas::BoxPackingNode : public std::enable_shared_from_this< TextureAtlas::BoxPackingNode>
-            {
-            private:
-                explicit BoxPackingNode(int border);
+                //! Shelves are indexed by their height and then by how much of
+                //! them is used, so the first shelf of each height has the most
+                //! room.
+                typedef std::tuple<uint16_t, uint16_t, uint16_t> ShelfKey;
 
-            public:
-                static std::shared_ptr<BoxPackingNode> create(int border);
+                struct Shelf
+                {
+                    uint16_t              y          = 0;
+                    uint16_t              h          = 0;
+                    uint16_t              x          = 0;
+                    uint64_t              generation = 0;
+                    std::vector<uint32_t> items;
+
+                    //! The least recently used list. Only shelves with items are
+                    //! in the list.
+                    bool                  lru        = false;
+                    uint16_t              lruPrev    = shelfNone;
+                    uint16_t              lruNext    = shelfNone;
+
+                    //! The neighboring shelves on the page.
+                    uint16_t              below      = shelfNone;
+                    uint16_t              above      = shelfNone;
+                };
+
+                struct Page
+                {
+                    //! Shelves with a height of zero are unused and can be recycled.
+                    std::vector<Shelf>    shelves;
+                    std::vector<uint16_t> freeShelves;
+                    std::set<ShelfKey>    openShelves;
+                    std::set<ShelfKey>    emptyShelves;
+                    uint16_t              lruHead = shelfNone;
+                    uint16_t              lruTail = shelfNone;
+                    uint16_t              top     = shelfNone;
+                    uint16_t              y       = 0;
+                    uint64_t              area    = 0;
+                };
+
+                struct Item
+                {
+                    UID              uid   = 0;
+                    TextureAtlasRect rect;
+                    uint16_t         shelf = 0;
+                    uint32_t         slot  = 0;
+                };
 
-                UID uid = 0;
-                uint64_t timestamp = 0;
+            } // namespace
 
-                BBox2i bbox;
-                uint8_t border = 0;
-                uint8_t textureIndex = 0;
-                std::shared_ptr<BoxPackingNode> children[2];
+            struct TextureAtlasPacker::Private
+            {
+                uint8_t pageCount = 0;
+                uint16_t pageSize = 0;
+                std::vector<Page> pages;
+                std::vector<Item> items;
+                std::vector<uint32_t> freeItems;
+                std::unordered_map<UID, uint32_t> uids;
+                uint64_t generation = 1;
+                uint8_t lastPage = 0;
+                size_t evictionCount = 0;
+                size_t defragmentCount = 0;
+
+                uint16_t addShelf(uint8_t page, uint16_t y, uint16_t h, uint16_t below);
+                void removeShelf(uint8_t page, uint16_t shelf);
+                void indexShelf(uint8_t page, uint16_t shelf);
+                void unindexShelf(uint8_t page, uint16_t shelf);
+                void touchShelf(uint8_t page, uint16_t shelf);
+                void untouchShelf(uint8_t page, uint16_t shelf);
+                int findOpenShelf(uint8_t page, uint16_t w, uint16_t hMin, float hMax) const;
+                bool allocate(uint8_t page, uint16_t w, uint16_t h, uint32_t item);
+                void removeItem(uint32_t);
+                void evictShelf(uint8_t page, uint16_t shelf);
+                void coalesce(uint8_t page, uint16_t shelf);
+            };
 
-                bool isBranch() const { return children[0].get(); }
-                bool isOccupied() const { return uid != 0; }
+            uint16_t TextureAtlasPacker::Private::addShelf(uint8_t pageIndex, uint16_t y, uint16_t h, uint16_t below)
+            {
+                auto& page = pages[pageIndex];
+                uint16_t out = 0;
+                if (page.freeShelves.size())
+                {
+                    out = page.freeShelves.back();
+                    page.freeShelves.pop_back();
+                }
+                else
+                {
+                    out = static_cast<uint16_t>(page.shelves.size());
+                    page.shelves.push_back(Shelf());
+                }
+                auto& shelf = page.shelves[out];
+                shelf.y = y;
+                shelf.h = h;
+                shelf.below = below;
+                shelf.above = below != shelfNone ? page.shelves[below].above : page.top;
+                if (shelf.above != shelfNone)
+                {
+                    page.shelves[shelf.above].below = out;
+                }
+                else
+                {
+                    page.top = out;
+                }
+                if (below != shelfNone)
+                {
+                    page.shelves[below].above = out;
+                }
+                indexShelf(pageIndex, out);
+                return out;
+            }
 
-                std::shared_ptr<BoxPackingNode> insert(const std::shared_ptr<Image::Data> &);
-            };
+            void TextureAtlasPacker::Private::removeShelf(uint8_t pageIndex, uint16_t shelfIndex)
+            {
+                auto& page = pages[pageIndex];
+                auto& shelf = page.shelves[shelfIndex];
+                unindexShelf(pageIndex, shelfIndex);
+                untouchShelf(pageIndex, shelfIndex);
+                if (shelf.below != shelfNone)
+                {
+                    page.shelves[shelf.below].above = shelf.above;
+                }
+                if (shelf.above != shelfNone)
+                {
+                    page.shelves[shelf.above].below = shelf.below;
+                }
+                else
+                {
+                    page.top = shelf.below;
+                }
+                shelf = Shelf();
+                page.freeShelves.push_back(shelfIndex);
+            }
 
-            TextureAtlas::BoxPackingNode::BoxPackingNode(int border) :
-                timestamp(++_timestamp),
-                border(border)
-            {}
+            void TextureAtlasPacker::Private::indexShelf(uint8_t pageIndex, uint16_t shelfIndex)
+            {
+                auto& page = pages[pageIndex];
+                const auto& shelf = page.shelves[shelfIndex];
+                const ShelfKey key(shelf.h, shelf.x, shelfIndex);
+                if (shelf.items.empty())
+                {
+                    page.emptyShelves.insert(key);
+                }
+                else if (shelf.x < pageSize)
+                {
+                    page.openShelves.insert(key);
+                }
+            }
 
-            std::shared_ptr<TextureAtlas::BoxPackingNode> TextureAtlas::BoxPackingNode::create(int border)
+            void TextureAtlasPacker::Private::unindexShelf(uint8_t pageIndex, uint16_t shelfIndex)
             {
-                auto out = std::shared_ptr<BoxPackingNode>(new BoxPackingNode(border));
-                return out;
+                auto& page = pages[pageIndex];
+                const auto& shelf = page.shelves[shelfIndex];
+                const ShelfKey key(shelf.h, shelf.x, shelfIndex);
+                page.emptyShelves.erase(key);
+                page.openShelves.erase(key);
             }
 
-            std::shared_ptr<TextureAtlas::BoxPackingNode> TextureAtlas::BoxPackingNode::insert(const std::shared_ptr<Image::Data> & data)
+            void TextureAtlasPacker::Private::touchShelf(uint8_t pageIndex, uint16_t shelfIndex)
             {
-                if (isBranch())
+                auto& page = pages[pageIndex];
+                auto& shelf = page.shelves[shelfIndex];
+                shelf.generation = generation;
+                if (page.lruHead != shelfIndex)
                 {
-                    if (auto node = children[0]->insert(data))
+                    untouchShelf(pageIndex, shelfIndex);
+                    shelf.lru = true;
+                    shelf.lruNext = page.lruHead;
+                    if (page.lruHead != shelfNone)
                     {
-                        return node;
+                        page.shelves[page.lruHead].lruPrev = shelfIndex;
+                    }
+                    page.lruHead = shelfIndex;
+                    if (shelfNone == page.lruTail)
+                    {
+                        page.lruTail = shelfIndex;
                     }
-                    return children[1]->insert(data);
                 }
-                else if (isOccupied())
+            }
+
+            void TextureAtlasPacker::Private::untouchShelf(uint8_t pageIndex, uint16_t shelfIndex)
+            {
+                auto& page = pages[pageIndex];
+                auto& shelf = page.shelves[shelfIndex];
+                if (shelf.lru)
                 {
-                    return nullptr;
+                    if (shelf.lruPrev != shelfNone)
+                    {
+                        page.shelves[shelf.lruPrev].lruNext = shelf.lruNext;
+                    }
+                    else
+                    {
+                        page.lruHead = shelf.lruNext;
+                    }
+                    if (shelf.lruNext != shelfNone)
+                    {
+                        page.shelves[shelf.lruNext].lruPrev = shelf.lruPrev;
+                    }
+                    else
+                    {
+                        page.lruTail = shelf.lruPrev;
+                    }
+                    shelf.lru = false;
+                    shelf.lruPrev = shelfNone;
+                    shelf.lruNext = shelfNone;
                 }
-                else
+            }
+
+            int TextureAtlasPacker::Private::findOpenShelf(uint8_t pageIndex, uint16_t w, uint16_t hMin, float hMax) const
+            {
+                // Only the emptiest shelf of each height needs to be checked.
+                const auto& page = pages[pageIndex];
+                auto i = page.openShelves.lower_bound(ShelfKey(hMin, 0, 0));
+                while (i != page.openShelves.end() && std::get<0>(*i) <= hMax)
                 {
-                    const glm::ivec2 & dataSize = glm::ivec2(data->getWidth(), data->getHeight()) + border * 2;
-                    const glm::ivec2 & bboxSize = bbox.getSize();
-                    if (dataSize.x > bboxSize.x || dataSize.y > bboxSize.y)
+                    if (std::get<1>(*i) + w <= pageSize)
                     {
-                        return nullptr;
+                        return std::get<2>(*i);
                     }
-                    if (dataSize == bboxSize)
+                    if (std::get<0>(*i) == pageSize)
                     {
-                        return shared_from_this();
+                        break;
                     }
-                    children[0] = create(border);
-                    children[1] = create(border);
-                    const int dw = bboxSize.x - dataSize.x;
-                    const int dh = bboxSize.y - dataSize.y;
-                    if (dw > dh)
+                    i = page.openShelves.lower_bound(ShelfKey(std::get<0>(*i) + 1, 0, 0));
+                }
+                return -1;
+            }
+
+            bool TextureAtlasPacker::Private::allocate(uint8_t pageIndex, uint16_t w, uint16_t h, uint32_t itemIndex)
+            {
+                auto& page = pages[pageIndex];
+
+                // Find the shortest shelf with room for the item. Empty shelves that
+                // are much taller than the item are split, and other tall shelves are
+                // only used as a last resort.
+                const float fit = h * shelfFit;
+                int best = findOpenShelf(pageIndex, w, h, fit);
+                const auto empty = page.emptyShelves.lower_bound(ShelfKey(h, 0, 0));
+                if (empty != page.emptyShelves.end() &&
+                    std::get<0>(*empty) <= fit &&
+                    (-1 == best || std::get<0>(*empty) < page.shelves[best].h))
+                {
+                    best = std::get<2>(*empty);
+                }
+                if (-1 == best && page.y + h <= pageSize)
+                {
+                    best = addShelf(pageIndex, page.y, h, page.top);
+                    page.y += h;
+                }
+                if (-1 == best && empty != page.emptyShelves.end())
+                {
+                    const uint16_t split = std::get<2>(*empty);
+                    unindexShelf(pageIndex, split);
+                    const uint16_t y = page.shelves[split].y;
+                    const uint16_t splitH = page.shelves[split].h;
+                    page.shelves[split].h = h;
+                    indexShelf(pageIndex, split);
+                    addShelf(pageIndex, static_cast<uint16_t>(y + h), static_cast<uint16_t>(splitH - h), split);
+                    best = split;
+                }
+                if (-1 == best)
+                {
+                    const float looseMin = std::min(fit + 1.F, static_cast<float>(pageSize));
+                    best = findOpenShelf(pageIndex, w, static_cast<uint16_t>(looseMin), pageSize);
+                }
+                if (-1 == best)
+                {
+                    return false;
+                }
+
+                const uint16_t shelfIndex = static_cast<uint16_t>(best);
+                unindexShelf(pageIndex, shelfIndex);
+                auto& shelf = page.shelves[shelfIndex];
+                auto& item = items[itemIndex];
+                item.rect.page = pageIndex;
+                item.rect.x = shelf.x;
+                item.rect.y = shelf.y;
+                item.rect.w = w;
+                item.rect.h = h;
+                item.shelf = shelfIndex;
+                item.slot = static_cast<uint32_t>(shelf.items.size());
+                shelf.items.push_back(itemIndex);
+                shelf.x += w;
+                page.area += w * h;
+                indexShelf(pageIndex, shelfIndex);
+                touchShelf(pageIndex, shelfIndex);
+                return true;
+            }
+
+            void TextureAtlasPacker::Private::removeItem(uint32_t index)
+            {
+                auto& item = items[index];
+                const uint8_t pageIndex = item.rect.page;
+                const uint16_t shelfIndex = item.shelf;
+                auto& page = pages[pageIndex];
+                auto& shelf = page.shelves[shelfIndex];
+                unindexShelf(pageIndex, shelfIndex);
+                const uint32_t last = shelf.items.back();
+                shelf.items[item.slot] = last;
+                items[last].slot = item.slot;
+                shelf.items.pop_back();
+                page.area -= item.rect.w * item.rect.h;
+                if (shelf.items.empty())
+                {
+                    shelf.x = 0;
+                }
+                else if (item.rect.x + item.rect.w == shelf.x)
+                {
+                    shelf.x = item.rect.x;
+                }
+                const bool empty = shelf.items.empty();
+                indexShelf(pageIndex, shelfIndex);
+                uids.erase(item.uid);
+                item = Item();
+                freeItems.push_back(index);
+                if (empty)
+                {
+                    untouchShelf(pageIndex, shelfIndex);
+                    coalesce(pageIndex, shelfIndex);
+                }
+            }
+
+            void TextureAtlasPacker::Private::evictShelf(uint8_t pageIndex, uint16_t shelfIndex)
+            {
+                auto& page = pages[pageIndex];
+                auto& shelf = page.shelves[shelfIndex];
+                unindexShelf(pageIndex, shelfIndex);
+                untouchShelf(pageIndex, shelfIndex);
+                for (const auto i : shelf.items)
+                {
+                    auto& item = items[i];
+                    page.area -= item.rect.w * item.rect.h;
+                    uids.erase(item.uid);
+                    item = Item();
+                    freeItems.push_back(i);
+                }
+                evictionCount += shelf.items.size();
+                shelf.items.clear();
+                shelf.x = 0;
+                indexShelf(pageIndex, shelfIndex);
+                coalesce(pageIndex, shelfIndex);
+            }
+
+            void TextureAtlasPacker::Private::coalesce(uint8_t pageIndex, uint16_t shelfIndex)
+            {
+                auto& page = pages[pageIndex];
+
+                // Merge the empty shelf with its empty neighbors so that taller
+                // items can use them.
+                const uint16_t above = page.shelves[shelfIndex].above;
+                if (above != shelfNone && page.shelves[above].items.empty())
+                {
+                    const uint16_t h = page.shelves[above].h;
+                    removeShelf(pageIndex, above);
+                    unindexShelf(pageIndex, shelfIndex);
+                    page.shelves[shelfIndex].h += h;
+                    indexShelf(pageIndex, shelfIndex);
+                    ++defragmentCount;
+                }
+                const uint16_t below = page.shelves[shelfIndex].below;
+                if (below != shelfNone && page.shelves[below].items.empty())
+                {
+                    const uint16_t h = page.shelves[shelfIndex].h;
+                    removeShelf(pageIndex, shelfIndex);
+                    unindexShelf(pageIndex, below);
+                    page.shelves[below].h += h;
+                    indexShelf(pageIndex, below);
+                    shelfIndex = below;
+                    ++defragmentCount;
+                }
+
+                // Give an empty shelf at the top back to the page.
+                if (page.top == shelfIndex)
+                {
+                    page.y = page.shelves[shelfIndex].y;
+                    removeShelf(pageIndex, shelfIndex);
+                }
+            }
+
+            TextureAtlasPacker::TextureAtlasPacker(uint8_t pageCount, uint16_t pageSize) :
+                _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+                p.pageCount = pageCount;
+                p.pageSize = pageSize;
+                p.pages.resize(pageCount);
+            }
+
+            TextureAtlasPacker::~TextureAtlasPacker()
+            {}
+
+            uint8_t TextureAtlasPacker::getPageCount() const
+            {
+                return _p->pageCount;
+            }
+
+            uint16_t TextureAtlasPacker::getPageSize() const
+            {
+                return _p->pageSize;
+            }
+
+            void TextureAtlasPacker::nextFrame()
+            {
+                ++_p->generation;
+            }
+
+            bool TextureAtlasPacker::getItem(UID uid, TextureAtlasRect& out)
+            {
+                DJV_PRIVATE_PTR();
+                const auto i = p.uids.find(uid);
+                if (i != p.uids.end())
+                {
+                    const auto& item = p.items[i->second];
+                    p.touchShelf(item.rect.page, item.shelf);
+                    out = item.rect;
+                    return true;
+                }
+                return false;
+            }
+
+            bool TextureAtlasPacker::addItem(UID uid, uint16_t w, uint16_t h, TextureAtlasRect& out)
+            {
+                DJV_PRIVATE_PTR();
+                w = std::max(w, uint16_t(1));
+                h = std::max(h, uint16_t(1));
+                if (!p.pageCount || w > p.pageSize || h > p.pageSize)
+                {
+                    return false;
+                }
+                const auto i = p.uids.find(uid);
+                if (i != p.uids.end())
+                {
+                    p.removeItem(i->second);
+                }
+
+                uint32_t index = 0;
+                if (p.freeItems.size())
+                {
+                    index = p.freeItems.back();
+                    p.freeItems.pop_back();
+                }
+                else
+                {
+                    index = static_cast<uint32_t>(p.items.size());
+                    p.items.push_back(Item());
+                }
+
+                // Start with the page that was used last since it is the most
+                // likely to have room.
+                bool added = false;
+                for (uint8_t i = 0; i < p.pageCount && !added; ++i)
+                {
+                    added = p.allocate((p.lastPage + i) % p.pageCount, w, h, index);
+                }
+                while (!added)
+                {
+                    // The pages are full, evict the least recently used shelf from
+                    // the tail of the page lists. Shelves used in the current frame
+                    // are kept since their items may already be queued for drawing.
+                    uint8_t page = 0;
+                    uint16_t shelf = shelfNone;
+                    uint64_t generation = p.generation;
+                    for (uint8_t i = 0; i < p.pageCount; ++i)
                     {
-                        children[0]->bbox.min.x = bbox.min.x;
-                        children[0]->bbox.min.y = bbox.min.y;
-                        children[0]->bbox.max.x = bbox.min.x + dataSize.x - 1;
-                        children[0]->bbox.max.y = bbox.max.y;
-                        children[1]->bbox.min.x = bbox.min.x + dataSize.x;
-                        children[1]->bbox.min.y = bbox.min.y;
-                        children[1]->bbox.max.x = bbox.max.x;
-                        children[1]->bbox.max.y = bbox.max.y;
+                        const uint16_t tail = p.pages[i].lruTail;
+                        if (tail != shelfNone && p.pages[i].shelves[tail].generation < generation)
+                        {
+                            page = i;
+                            shelf = tail;
+                            generation = p.pages[i].shelves[tail].generation;
+                        }
                     }
-                    else
+                    if (shelfNone == shelf)
                     {
-                        children[0]->bbox.min.x = bbox.min.x;
-                        children[0]->bbox.min.y = bbox.min.y;
-                        children[0]->bbox.max.x = bbox.max.x;
-                        children[0]->bbox.max.y = bbox.min.y + dataSize.y - 1;
-                        children[1]->bbox.min.x = bbox.min.x;
-                        children[1]->bbox.min.y = bbox.min.y + dataSize.y;
-                        children[1]->bbox.max.x = bbox.max.x;
-                        children[1]->bbox.max.y = bbox.max.y;
+                        p.freeItems.push_back(index);
+                        return false;
                     }
-                    children[0]->textureIndex = textureIndex;
-                    children[1]->textureIndex = textureIndex;
-                    return children[0]->insert(data);
+                    p.evictShelf(page, shelf);
+                    added = p.allocate(page, w, h, index);
+                }
+
+                auto& item = p.items[index];
+                item.uid = uid;
+                out = item.rect;
+                p.lastPage = out.page;
+                p.uids[uid] = index;
+                return true;
+            }
+
+            size_t TextureAtlasPacker::getItemCount() const
+            {
+                return _p->uids.size();
+            }
+
+            float TextureAtlasPacker::getPercentageUsed() const
+            {
+                DJV_PRIVATE_PTR();
+                uint64_t area = 0;
+                for (const auto& i : p.pages)
+                {
+                    area += i.area;
                 }
+                const float total = static_cast<float>(p.pageSize) * static_cast<float>(p.pageSize) * static_cast<float>(p.pageCount);
+                return total > 0.F ? (area / total * 100.F) : 0.F;
+            }
+
+            size_t TextureAtlasPacker::getEvictionCount() const
+            {
+                return _p->evictionCount;
+            }
+
+            size_t TextureAtlasPacker::getDefragmentCount() const
+            {
+                return _p->defragmentCount;
             }
 
             struct TextureAtlas::Private
@@ -149,8 +572,7 @@ namespace djv
                 Image::Type textureType = Image::Type::None;
                 uint8_t border = 0;
                 std::vector<std::shared_ptr<OpenGL::Texture> > textures;
-                std::vector<std::shared_ptr<BoxPackingNode> > boxPackingNodes;
-                std::map<UID, std::shared_ptr<BoxPackingNode> > cache;
+                std::unique_ptr<TextureAtlasPacker> packer;
             };
 
             TextureAtlas::TextureAtlas(uint8_t textureCount, uint16_t textureSize, Image::Type textureType, GLenum filter, uint8_t border) :
@@ -160,20 +582,14 @@ namespace djv
                 p.textureCount = textureCount;
                 p.textureSize = textureSize;
                 p.textureType = textureType;
+                p.border = border;
 
                 for (uint8_t i = 0; i < p.textureCount; ++i)
                 {
                     auto texture = OpenGL::Texture::create(Image::Info(textureSize, textureSize, textureType), filter, filter);
                     p.textures.push_back(std::move(texture));
-
-                    auto node = BoxPackingNode::create(border);
-                    node->bbox.min.x = 0;
-                    node->bbox.min.y = 0;
-                    node->bbox.max.x = textureSize - 1;
-                    node->bbox.max.y = textureSize - 1;
-                    node->textureIndex = i;
-                    p.boxPackingNodes.push_back(node);
                 }
+                p.packer.reset(new TextureAtlasPacker(textureCount, textureSize));
             }
 
             TextureAtlas::~TextureAtlas()
@@ -205,13 +621,18 @@ namespace djv
                 return out;
             }
 
+            void TextureAtlas::nextFrame()
+            {
+                _p->packer->nextFrame();
+            }
+
             bool TextureAtlas::getItem(UID uid, TextureAtlasItem & out)
             {
                 DJV_PRIVATE_PTR();
-                const auto & i = p.cache.find(uid);
-                if (i != p.cache.end())
+                TextureAtlasRect rect;
+                if (p.packer->getItem(uid, rect))
                 {
-                    _toTextureAtlasItem(i->second, out);
+                    _toTextureAtlasItem(rect, out);
                     return true;
                 }
                 return false;
@@ -223,148 +644,52 @@ namespace djv
 
                 static UID _uid = 0;
 
-                for (uint8_t i = 0; i < p.textureCount; ++i)
-                {
-                    if (auto node = p.boxPackingNodes[i]->insert(data))
-                    {
-                        // The data has been added to the atlas.
-                        node->uid = ++_uid;
-                        p.textures[node->textureIndex]->copy(*data, node->bbox.min.x + p.border, node->bbox.min.y + p.border);
-                        p.cache[node->uid] = node;
-                        _toTextureAtlasItem(node, out);
-                        return node->uid;
-                    }
-                }
-
-                // The atlas is full, over-write older data.
-                std::vector<std::shared_ptr<BoxPackingNode> > nodes;
-                for (uint8_t i = 0; i < p.textureCount; ++i)
-                {
-                    _getAllNodes(p.boxPackingNodes[i], nodes);
-                }
-                std::sort(nodes.begin(), nodes.end(),
-                    [](const std::shared_ptr<BoxPackingNode>& a, const std::shared_ptr<BoxPackingNode>& b)
-                {
-                    return a->timestamp < b->timestamp;
-                });
-                const glm::ivec2 dataSize = glm::ivec2(data->getWidth(), data->getHeight()) + p.border * 2;
-                for (auto node : nodes)
+                TextureAtlasRect rect;
+                const UID uid = ++_uid;
+                if (p.packer->addItem(
+                    uid,
+                    static_cast<uint16_t>(data->getWidth() + p.border * 2),
+                    static_cast<uint16_t>(data->getHeight() + p.border * 2),
+                    rect))
                 {
-                    const glm::ivec2 nodeSize = node->bbox.getSize();
-                    if (dataSize.x <= nodeSize.x && dataSize.y <= nodeSize.y)
-                    {
-                        auto old = node;
-                        _removeFromAtlas(old);
-                        if (old->isBranch())
-                        {
-                            for (uint8_t i = 0; i < 2; ++i)
-                            {
-                                old->children[i].reset();
-                            }
-                        }
-                        old->uid = 0;
-                        old->timestamp = ++_timestamp;
-                        if (auto node = old->insert(data))
-                        {
-                            node->uid = ++_uid;
-
-                            //! \todo Do we need to zero out the old data?
-                            //auto zero = Image::Data::create(Image::Info(data->getSize() + p.border * 2, p.textureType));
-                            //zero->zero();
-                            //p.textures[node->texture]->copy(zero, node->bbox.min);
-
-                            p.textures[node->textureIndex]->copy(
-                                *data,
-                                static_cast<uint16_t>(node->bbox.min.x + p.border),
-                                static_cast<uint16_t>(node->bbox.min.y + p.border));
-                            p.cache[node->uid] = node;
-                            _toTextureAtlasItem(node, out);
-
-                            return node->uid;
-                        }
-                    }
+                    //! \todo Do we need to zero out the old data?
+                    p.textures[rect.page]->copy(
+                        *data,
+                        static_cast<uint16_t>(rect.x + p.border),
+                        static_cast<uint16_t>(rect.y + p.border));
+                    _toTextureAtlasItem(rect, out);
+                    return uid;
                 }
                 return 0;
             }
 
             float TextureAtlas::getPercentageUsed() const
             {
-                DJV_PRIVATE_PTR();
-                float out = 0.F;
-                for (uint8_t i = 0; i < p.textureCount; ++i)
-                {
-                    size_t used = 0;
-                    std::vector<std::shared_ptr<BoxPackingNode> > leafs;
-                    _getLeafNodes(p.boxPackingNodes[i], leafs);
-                    for (const auto & i : leafs)
-                    {
-                        if (i->isOccupied())
-                        {
-                            used += i->bbox.getArea();
-                        }
-                    }
-                    out += used;
-                }
-                return out / static_cast<float>(p.textureSize * p.textureSize) / static_cast<float>(p.textureCount) * 100.F;
+                return _p->packer->getPercentageUsed();
             }
 
-            void TextureAtlas::_getAllNodes(
-                const std::shared_ptr<BoxPackingNode>& node,
-                std::vector<std::shared_ptr<BoxPackingNode> > & out)
+            size_t TextureAtlas::getEvictionCount() const
             {
-                out.push_back(node);
-                if (node->isBranch())
-                {
-                    _getAllNodes(node->children[0], out);
-                    _getAllNodes(node->children[1], out);
-                }
+                return _p->packer->getEvictionCount();
             }
 
-            void TextureAtlas::_getLeafNodes(
-                const std::shared_ptr<BoxPackingNode>& node,
-                std::vector<std::shared_ptr<BoxPackingNode> > & out) const
+            size_t TextureAtlas::getDefragmentCount() const
             {
-                if (node->isBranch())
-                {
-                    _getLeafNodes(node->children[0], out);
-                    _getLeafNodes(node->children[1], out);
-                }
-                else
-                {
-                    out.push_back(node);
-                }
+                return _p->packer->getDefragmentCount();
             }
 
-            void TextureAtlas::_toTextureAtlasItem(
-                const std::shared_ptr<BoxPackingNode>& node,
-                TextureAtlasItem & out)
+            void TextureAtlas::_toTextureAtlasItem(const TextureAtlasRect& rect, TextureAtlasItem & out)
             {
                 DJV_PRIVATE_PTR();
-                out.w = node->bbox.w();
-                out.h = node->bbox.h();
-                out.textureIndex = node->textureIndex;
+                out.w = rect.w;
+                out.h = rect.h;
+                out.textureIndex = rect.page;
                 out.textureU = FloatRange(
-                    (node->bbox.min.x + p.border)     / static_cast<float>(p.textureSize),
-                    (node->bbox.max.x - p.border + 1) / static_cast<float>(p.textureSize));
+                    (rect.x + p.border)          / static_cast<float>(p.textureSize),
+                    (rect.x + rect.w - p.border) / static_cast<float>(p.textureSize));
                 out.textureV = FloatRange(
-                    (node->bbox.min.y + p.border)     / static_cast<float>(p.textureSize),
-                    (node->bbox.max.y - p.border + 1) / static_cast<float>(p.textureSize));
-            }
-
-            void TextureAtlas::_removeFromAtlas(const std::shared_ptr<BoxPackingNode>& node)
-            {
-                DJV_PRIVATE_PTR();
-                auto i = p.cache.find(node->uid);
-                if (i != p.cache.end())
-                {
-                    node->uid = 0;
-                    p.cache.erase(i);
-                }
-                if (node->isBranch())
-                {
-                    _removeFromAtlas(node->children[0]);
-                    _removeFromAtlas(node->children[1]);
-                }
+                    (rect.y + p.border)          / static_cast<float>(p.textureSize),
+                    (rect.y + rect.h - p.border) / static_cast<float>(p.textureSize));
             }
 
         } // namespace Render
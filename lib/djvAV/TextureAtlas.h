@@ -49,6 +49,56 @@ namespace djv
                 Core::FloatRange textureV;
             };
 
+            //! This struct provides the location of an item in a texture atlas page.
+            struct TextureAtlasRect
+            {
+                uint8_t  page = 0;
+                uint16_t x    = 0;
+                uint16_t y    = 0;
+                uint16_t w    = 0;
+                uint16_t h    = 0;
+            };
+
+            //! This class provides the packing for a texture atlas.
+            //!
+            //! Each page is divided into horizontal shelves that are filled from
+            //! left to right. When the pages are full the least recently used shelf
+            //! is evicted as a whole, and neighboring empty shelves are merged. Items
+            //! used since the last call to nextFrame() are never evicted.
+            //!
+            //! The packer only manages the layout so that it can be used without
+            //! OpenGL.
+            class TextureAtlasPacker
+            {
+                DJV_NON_COPYABLE(TextureAtlasPacker);
+
+            public:
+                TextureAtlasPacker(uint8_t pageCount, uint16_t pageSize);
+                ~TextureAtlasPacker();
+
+                uint8_t getPageCount() const;
+                uint16_t getPageSize() const;
+
+                //! Start a new frame. Items used in the previous frames may be evicted.
+                void nextFrame();
+
+                //! Get an item. This marks the item as recently used.
+                bool getItem(Core::UID, TextureAtlasRect&);
+
+                //! Add an item, evicting older items if necessary. Returns false if
+                //! the item is larger than a page or the pages are full of items used
+                //! in the current frame.
+                bool addItem(Core::UID, uint16_t w, uint16_t h, TextureAtlasRect&);
+
+                size_t getItemCount() const;
+                float getPercentageUsed() const;
+                size_t getEvictionCount() const;
+                size_t getDefragmentCount() const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
             //! This class provides a texture atlas.
             class TextureAtlas
             {
@@ -63,24 +113,18 @@ namespace djv
                 Image::Type getTextureType() const;
                 std::vector<GLuint> getTextures() const;
 
+                //! Start a new frame. Items used in the previous frames may be evicted.
+                void nextFrame();
+
                 bool getItem(Core::UID, TextureAtlasItem &);
                 Core::UID addItem(const std::shared_ptr<Image::Data> &, TextureAtlasItem &);
 
                 float getPercentageUsed() const;
+                size_t getEvictionCount() const;
+                size_t getDefragmentCount() const;
 
             private:
-                class BoxPackingNode;
-
-                void _getAllNodes(
-                    const std::shared_ptr<BoxPackingNode>&,
-                    std::vector<std::shared_ptr<BoxPackingNode> >&);
-                void _getLeafNodes(
-                    const std::shared_ptr<BoxPackingNode>&,
-                    std::vector<std::shared_ptr<BoxPackingNode> >&) const;
-                void _toTextureAtlasItem(
-                    const std::shared_ptr<BoxPackingNode>&,
-                    TextureAtlasItem&);
-                void _removeFromAtlas(const std::shared_ptr<BoxPackingNode>&);
+                void _toTextureAtlasItem(const TextureAtlasRect&, TextureAtlasItem&);
 
                 DJV_PRIVATE();
             };
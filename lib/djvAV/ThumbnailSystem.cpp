@@ -29,6 +29,7 @@
 
 #include <djvAV/ThumbnailSystem.h>
 
+#include <djvAV/GLFWSystem.h>
 #include <djvAV/Image.h>
 #include <djvAV/ImageConvert.h>
 #include <djvAV/IO.h>
@@ -207,6 +208,7 @@ namespace djv
 
             DJV_PRIVATE_PTR();
 
+            addDependency(context->getSystemT<GLFW::System>());
             auto io = context->getSystemT<IO::System>();
             addDependency(io);
 
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVPy/AVPy.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Timer.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace djv;
+using namespace djv::Core;
+
+namespace py = pybind11;
+
+namespace
+{
+    //! \todo Should this be configurable?
+    const size_t prefetchDefault = 10;
+
+    //! This class provides an iterator over a range of video frames. The
+    //! frames are read ahead in the background by the I/O plugin, and the GIL
+    //! is released while waiting for them.
+    class Read
+    {
+    public:
+        Read(
+            const std::shared_ptr<Context>& context,
+            const FileSystem::FileInfo& fileInfo,
+            const Frame::Range& range,
+            size_t prefetch,
+            size_t threadCount)
+        {
+            auto io = context->getSystemT<AV::IO::System>();
+            AV::IO::ReadOptions options;
+            options.videoQueueSize = std::max(prefetch, size_t(1));
+            _read = io->read(fileInfo, options);
+            _read->setThreadCount(std::max(threadCount, size_t(1)));
+            {
+                py::gil_scoped_release release;
+                _info = _read->getInfo().get();
+            }
+            if (!_info.video.size())
+            {
+                std::stringstream ss;
+                ss << "No video: " << fileInfo;
+                throw std::invalid_argument(ss.str());
+            }
+
+            _sequence = _info.video[0].sequence;
+            const size_t size = _sequence.getSize();
+            if (size && range != Frame::invalidRange)
+            {
+                _index = _sequence.getIndex(range.min);
+                _end = _sequence.getIndex(range.max);
+                if (Frame::invalidIndex == _index || Frame::invalidIndex == _end)
+                {
+                    std::stringstream ss;
+                    ss << "Invalid frame range: " << range;
+                    throw std::invalid_argument(ss.str());
+                }
+            }
+            else
+            {
+                _end = size ? static_cast<Frame::Index>(size - 1) : 0;
+            }
+            _read->seek(_index, AV::IO::Direction::Forward);
+        }
+
+        const AV::IO::Info& getInfo() const
+        {
+            return _info;
+        }
+
+        std::pair<Frame::Number, std::shared_ptr<AV::Image::Image> > next()
+        {
+            std::shared_ptr<AV::Image::Image> image;
+            if (_index <= _end)
+            {
+                py::gil_scoped_release release;
+                const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                bool finished = false;
+                while (!image && !finished && _read->isRunning())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_read->getMutex());
+                        auto& queue = _read->getVideoQueue();
+                        while (!image && !queue.isEmpty())
+                        {
+                            // Skip frames from before the seek. Frames that
+                            // failed to read are missing from the queue.
+                            auto frame = queue.popFrame();
+                            if (frame.frame >= _index && frame.frame <= _end)
+                            {
+                                _index = frame.frame;
+                                image = frame.image;
+                            }
+                        }
+                        finished = queue.isFinished() && queue.isEmpty();
+                    }
+                    if (!image && !finished)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+                    }
+                }
+            }
+            if (!image)
+            {
+                throw py::stop_iteration();
+            }
+            const Frame::Number frame = _sequence.getSize() ? _sequence.getFrame(_index) : 0;
+            ++_index;
+            return std::make_pair(frame, image);
+        }
+
+    private:
+        std::shared_ptr<AV::IO::IRead> _read;
+        AV::IO::Info _info;
+        Frame::Sequence _sequence;
+        Frame::Index _index = 0;
+        Frame::Index _end = 0;
+    };
+
+} // namespace
+
+void wrapIO(pybind11::module& m)
+{
+    py::class_<AV::IO::VideoInfo>(m, "VideoInfo")
+        .def(py::init<>())
+        .def_readwrite("info", &AV::IO::VideoInfo::info)
+        .def_readwrite("sequence", &AV::IO::VideoInfo::sequence)
+        .def_readwrite("codec", &AV::IO::VideoInfo::codec);
+
+    py::class_<AV::IO::Info>(m, "Info")
+        .def(py::init<>())
+        .def_readwrite("fileName", &AV::IO::Info::fileName)
+        .def_readwrite("video", &AV::IO::Info::video);
+
+    py::class_<Read, std::shared_ptr<Read> >(m, "Read")
+        .def(
+            py::init<const std::shared_ptr<Context>&, const FileSystem::FileInfo&, const Frame::Range&, size_t, size_t>(),
+            py::arg("context"),
+            py::arg("fileInfo"),
+            py::arg("range") = Frame::invalidRange,
+            py::arg("prefetch") = prefetchDefault,
+            py::arg("threadCount") = 4)
+        .def("getInfo", &Read::getInfo)
+        .def("__iter__", [](const std::shared_ptr<Read>& value) { return value; })
+        .def("__next__", &Read::next);
+}
@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVPy/AVPy.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageUtil.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/operators.h>
+#include <pybind11/stl.h>
+
+using namespace djv;
+using namespace djv::Core;
+
+namespace py = pybind11;
+
+namespace
+{
+    std::string getFormat(AV::Image::Type type, Memory::Endian endian)
+    {
+        std::string out;
+        if (endian != Memory::getEndian())
+        {
+            out = Memory::Endian::MSB == endian ? ">" : "<";
+        }
+        switch (AV::Image::getDataType(type))
+        {
+        case AV::Image::DataType::U8:  out += py::format_descriptor<uint8_t>::format();  break;
+        case AV::Image::DataType::U10: out += py::format_descriptor<uint32_t>::format(); break;
+        case AV::Image::DataType::U16: out += py::format_descriptor<uint16_t>::format(); break;
+        case AV::Image::DataType::U32: out += py::format_descriptor<uint32_t>::format(); break;
+        case AV::Image::DataType::F16: out += "e"; break;
+        case AV::Image::DataType::F32: out += py::format_descriptor<float>::format(); break;
+        default: break;
+        }
+        return out;
+    }
+
+    py::buffer_info getBufferInfo(AV::Image::Data& data)
+    {
+        // The buffer is a view of the image data with the shape (height, width,
+        // channels). The first row is the top of the image, mirrored data is
+        // handled with negative strides. RGB_U10 pixels are packed into 32 bits
+        // so they are exposed as a single channel. Planar YUV data cannot be
+        // described with strides and must be converted with convertYUV() first.
+        // Memory mapped data is detached from the file since the buffer is
+        // writable.
+        const auto& info = data.getInfo();
+        if (!info.isValid())
+        {
+            throw std::invalid_argument("The image data is not valid.");
+        }
+        const auto type = info.type;
+        if (AV::Image::isYUVType(type))
+        {
+            throw std::invalid_argument("The image data is planar YUV, use convertYUV() to convert it to RGBA.");
+        }
+        const bool packed = AV::Image::Type::RGB_U10 == type;
+        const py::ssize_t channelCount = packed ? 1 : AV::Image::getChannelCount(type);
+        const py::ssize_t pixelByteCount = data.getPixelByteCount();
+        const py::ssize_t channelByteCount = packed ?
+            pixelByteCount :
+            AV::Image::getByteCount(AV::Image::getDataType(type));
+        const py::ssize_t scanlineByteCount = data.getScanlineByteCount();
+        const py::ssize_t w = info.size.w;
+        const py::ssize_t h = info.size.h;
+        uint8_t* p = data.getData();
+        py::ssize_t xStride = pixelByteCount;
+        py::ssize_t yStride = scanlineByteCount;
+        if (info.layout.mirror.x)
+        {
+            p += (w - 1) * pixelByteCount;
+            xStride = -xStride;
+        }
+        if (info.layout.mirror.y)
+        {
+            p += (h - 1) * scanlineByteCount;
+            yStride = -yStride;
+        }
+        return py::buffer_info(
+            p,
+            channelByteCount,
+            getFormat(type, info.layout.endian),
+            3,
+            { h, w, channelCount },
+            { yStride, xStride, channelByteCount });
+    }
+
+} // namespace
+
+void wrapImage(pybind11::module& m)
+{
+    py::enum_<AV::Image::Type>(m, "Type")
+        .value("None", AV::Image::Type::None)
+        .value("L_U8", AV::Image::Type::L_U8)
+        .value("L_U16", AV::Image::Type::L_U16)
+        .value("L_U32", AV::Image::Type::L_U32)
+        .value("L_F16", AV::Image::Type::L_F16)
+        .value("L_F32", AV::Image::Type::L_F32)
+        .value("LA_U8", AV::Image::Type::LA_U8)
+        .value("LA_U16", AV::Image::Type::LA_U16)
+        .value("LA_U32", AV::Image::Type::LA_U32)
+        .value("LA_F16", AV::Image::Type::LA_F16)
+        .value("LA_F32", AV::Image::Type::LA_F32)
+        .value("RGB_U8", AV::Image::Type::RGB_U8)
+        .value("RGB_U10", AV::Image::Type::RGB_U10)
+        .value("RGB_U16", AV::Image::Type::RGB_U16)
+        .value("RGB_U32", AV::Image::Type::RGB_U32)
+        .value("RGB_F16", AV::Image::Type::RGB_F16)
+        .value("RGB_F32", AV::Image::Type::RGB_F32)
+        .value("RGBA_U8", AV::Image::Type::RGBA_U8)
+        .value("RGBA_U16", AV::Image::Type::RGBA_U16)
+        .value("RGBA_U32", AV::Image::Type::RGBA_U32)
+        .value("RGBA_F16", AV::Image::Type::RGBA_F16)
+        .value("RGBA_F32", AV::Image::Type::RGBA_F32)
+        .value("YUV_420P_U8", AV::Image::Type::YUV_420P_U8)
+        .value("YUV_422P_U8", AV::Image::Type::YUV_422P_U8)
+        .value("YUV_444P_U8", AV::Image::Type::YUV_444P_U8)
+        .value("YUV_420P_U10", AV::Image::Type::YUV_420P_U10)
+        .value("YUV_422P_U10", AV::Image::Type::YUV_422P_U10)
+        .value("YUV_444P_U10", AV::Image::Type::YUV_444P_U10)
+        .value("YUV_420P_U16", AV::Image::Type::YUV_420P_U16)
+        .value("YUV_422P_U16", AV::Image::Type::YUV_422P_U16)
+        .value("YUV_444P_U16", AV::Image::Type::YUV_444P_U16);
+
+    py::class_<AV::Image::Mirror>(m, "Mirror")
+        .def(py::init<>())
+        .def(py::init<bool, bool>())
+        .def_readwrite("x", &AV::Image::Mirror::x)
+        .def_readwrite("y", &AV::Image::Mirror::y)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Layout>(m, "Layout")
+        .def(py::init<>())
+        .def(py::init<const AV::Image::Mirror&, GLint>(), py::arg("mirror"), py::arg("alignment") = 1)
+        .def_readwrite("mirror", &AV::Image::Layout::mirror)
+        .def_readwrite("alignment", &AV::Image::Layout::alignment)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Size>(m, "Size")
+        .def(py::init<uint16_t, uint16_t>(), py::arg("w") = 0, py::arg("h") = 0)
+        .def_readwrite("w", &AV::Image::Size::w)
+        .def_readwrite("h", &AV::Image::Size::h)
+        .def("getAspectRatio", &AV::Image::Size::getAspectRatio)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Info>(m, "Info")
+        .def(py::init<>())
+        .def(py::init<const AV::Image::Size&, AV::Image::Type, const AV::Image::Layout&>(),
+            py::arg("size"), py::arg("type"), py::arg("layout") = AV::Image::Layout())
+        .def_readwrite("name", &AV::Image::Info::name)
+        .def_readwrite("size", &AV::Image::Info::size)
+        .def_readwrite("pixelAspectRatio", &AV::Image::Info::pixelAspectRatio)
+        .def_readwrite("type", &AV::Image::Info::type)
+        .def_readwrite("layout", &AV::Image::Info::layout)
+        .def("getAspectRatio", &AV::Image::Info::getAspectRatio)
+        .def("isValid", &AV::Image::Info::isValid)
+        .def("getPixelByteCount", &AV::Image::Info::getPixelByteCount)
+        .def("getScanlineByteCount", &AV::Image::Info::getScanlineByteCount)
+        .def("getDataByteCount", &AV::Image::Info::getDataByteCount)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Data, std::shared_ptr<AV::Image::Data> >(m, "Data", py::buffer_protocol())
+        .def_static("create", [](const AV::Image::Info& info)
+            {
+                return AV::Image::Data::create(info);
+            })
+        .def_buffer(&getBufferInfo)
+        .def("getUID", &AV::Image::Data::getUID)
+        .def("getInfo", &AV::Image::Data::getInfo)
+        .def("getSize", &AV::Image::Data::getSize)
+        .def("getWidth", &AV::Image::Data::getWidth)
+        .def("getHeight", &AV::Image::Data::getHeight)
+        .def("getAspectRatio", &AV::Image::Data::getAspectRatio)
+        .def("getType", &AV::Image::Data::getType)
+        .def("getLayout", &AV::Image::Data::getLayout)
+        .def("isValid", &AV::Image::Data::isValid)
+        .def("getPixelByteCount", &AV::Image::Data::getPixelByteCount)
+        .def("getScanlineByteCount", &AV::Image::Data::getScanlineByteCount)
+        .def("getDataByteCount", &AV::Image::Data::getDataByteCount)
+        .def("zero", &AV::Image::Data::zero);
+
+    py::class_<AV::Image::Image, std::shared_ptr<AV::Image::Image>, AV::Image::Data>(m, "Image", py::buffer_protocol())
+        .def_static("create", [](const AV::Image::Info& info)
+            {
+                return AV::Image::Image::create(info);
+            })
+        .def_buffer([](AV::Image::Image& image)
+            {
+                return getBufferInfo(image);
+            })
+        .def("getPluginName", &AV::Image::Image::getPluginName)
+        .def("setPluginName", &AV::Image::Image::setPluginName);
+
+    m.def(
+        "convertYUV",
+        static_cast<std::shared_ptr<AV::Image::Image>(*)(const std::shared_ptr<AV::Image::Image>&)>(&AV::Image::convertYUV),
+        py::arg("image"),
+        py::call_guard<py::gil_scoped_release>());
+}
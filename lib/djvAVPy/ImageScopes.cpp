@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVPy/AVPy.h>
+
+#include <djvAV/ImageScopes.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+using namespace djv;
+
+namespace py = pybind11;
+
+namespace
+{
+    py::tuple toTuple(const glm::vec4& value)
+    {
+        return py::make_tuple(value.x, value.y, value.z, value.w);
+    }
+
+} // namespace
+
+void wrapImageScopes(pybind11::module& m)
+{
+    py::class_<AV::Image::Stats>(m, "Stats")
+        .def(py::init<>())
+        .def_property_readonly("min", [](const AV::Image::Stats& value) { return toTuple(value.min); })
+        .def_property_readonly("max", [](const AV::Image::Stats& value) { return toTuple(value.max); })
+        .def_property_readonly("average", [](const AV::Image::Stats& value) { return toTuple(value.average); })
+        .def_readonly("channelCount", &AV::Image::Stats::channelCount)
+        .def_readonly("sampleCount", &AV::Image::Stats::sampleCount);
+
+    m.def(
+        "getStats",
+        &AV::Image::getStats,
+        py::arg("data"),
+        py::arg("sampleCountMax") = AV::Image::ScopesOptions().sampleCountMax,
+        py::call_guard<py::gil_scoped_release>());
+}
@@ -59,6 +59,9 @@ namespace djv
         void Application::_init(const std::vector<std::string>& args)
         {
             Context::_init(args);
+
+            // The AV systems are created on demand, so tools that only read
+            // files run without a display.
             auto avSystem = AV::AVSystem::create(shared_from_this());
         }
 
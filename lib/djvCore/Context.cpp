@@ -34,6 +34,7 @@
 #include <djvCore/IObject.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/OS.h>
+#include <djvCore/ResourceBundle.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Time.h>
@@ -83,6 +84,10 @@ namespace djv
                 {
                     ss << "    " << path << ": " << _resourceSystem->getPath(path) << '\n';
                 }
+                if (auto bundle = _resourceSystem->getBundle())
+                {
+                    ss << "Resource bundle: " << bundle->getFileName() << " (" << bundle->getEntries().size() << " entries)" << '\n';
+                }
                 _logSystem->log("djv::Core::Context", ss.str());
             }
 
@@ -114,6 +119,7 @@ namespace djv
 
         void Context::removeSystem(const std::shared_ptr<ISystemBase>& value)
         {
+            std::lock_guard<std::recursive_mutex> lock(_systemsMutex);
             auto i = _systems.begin();
             while (i != _systems.end())
             {
@@ -146,14 +152,23 @@ namespace djv
             _fpsAverage /= static_cast<float>(_fpsSamples.size());
             //std::cout << "fps = " << _fpsAverage << std::endl;
 
+            // Tick a copy of the systems since new systems may be created
+            // on demand while ticking.
+            std::vector<std::shared_ptr<ISystemBase> > systems;
+            {
+                std::lock_guard<std::recursive_mutex> lock(_systemsMutex);
+                systems = _systems;
+            }
+
             static bool logSystemOrder = true;
             size_t count = 0;
             if (logSystemOrder)
             {
                 logSystemOrder = false;
+                _logStartupTime();
                 std::vector<std::string> dot;
                 dot.push_back("digraph {");
-                for (const auto & system : _systems)
+                for (const auto & system : systems)
                 {
                     {
                         std::stringstream ss;
@@ -176,7 +191,7 @@ namespace djv
             float total = 0.F;
             auto start = std::chrono::steady_clock::now();
             std::vector<std::pair<std::string, float> > systemTickTimes;
-            for (const auto & system : _systems)
+            for (const auto & system : systems)
             {
                 system->tick(dt);
                 auto end = std::chrono::steady_clock::now();
@@ -202,9 +217,47 @@ namespace djv
 
         void Context::_addSystem(const std::shared_ptr<ISystemBase> & system)
         {
+            std::lock_guard<std::recursive_mutex> lock(_systemsMutex);
             _systems.push_back(system);
         }
 
+        void Context::_logStartupTime()
+        {
+            if (!_startupTimeLogged)
+            {
+                _startupTimeLogged = true;
+                std::chrono::duration<float, std::milli> startup = std::chrono::steady_clock::now() - _startTime;
+                std::stringstream ss;
+                ss << "Startup time: " << startup.count() << "ms";
+                _logSystem->log("djv::Core::Context", ss.str());
+            }
+        }
+
+        std::shared_ptr<ISystemBase> Context::_createSystem(const std::type_index& type) const
+        {
+            // The caller holds the systems mutex, so only one thread creates
+            // a given system.
+            std::shared_ptr<ISystemBase> out;
+            const auto i = _systemFactories.find(type);
+            if (i != _systemFactories.end())
+            {
+                // Remove the factory before calling it so that a dependency
+                // cycle returns a null pointer instead of recursing.
+                const auto factory = i->second;
+                _systemFactories.erase(i);
+                const auto start = std::chrono::steady_clock::now();
+                out = factory(std::const_pointer_cast<Context>(shared_from_this()));
+                if (out)
+                {
+                    std::chrono::duration<float, std::milli> diff = std::chrono::steady_clock::now() - start;
+                    std::stringstream ss;
+                    ss << "Created " << out->getSystemName() << " on demand: " << diff.count() << "ms";
+                    _logSystem->log("djv::Core::Context", ss.str());
+                }
+            }
+            return out;
+        }
+
     } // namespace ViewExperiment
 } // namespace djv
 
@@ -32,9 +32,13 @@
 #include <djvCore/Path.h>
 
 #include <chrono>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <typeindex>
 #include <vector>
 
 namespace djv
@@ -82,14 +86,28 @@ namespace djv
             //! Get the list of systems.
             std::vector<std::shared_ptr<ISystemBase> > getSystems() const;
 
-            //! Get the list of systems of the given type.
+            //! Get the list of systems of the given type. Systems that have a
+            //! factory but have not been created yet are not included.
             template<typename T>
             std::vector<std::shared_ptr<T> > getSystemsT() const;
 
-            //! Get a system of the given type. If the system is not found a
-            //! null pointer is returned.
+            //! Get a system of the given type. If the system is not found but
+            //! a factory has been added for it, the system is created. If the
+            //! system is not found a null pointer is returned.
             template<typename T>
             std::shared_ptr<T> getSystemT() const;
+
+            //! Add a factory that creates a system of the given type the first
+            //! time it is requested with getSystemT(). Systems that are needed
+            //! by the factory should also be requested with getSystemT(), so
+            //! that the dependencies are created on demand as well.
+            template<typename T>
+            void addSystemFactory(const std::function<std::shared_ptr<T>(const std::shared_ptr<Context>&)>&);
+
+            //! Add a factory that creates a system of the given type with
+            //! T::create().
+            template<typename T>
+            void addSystemFactory();
             
             //! Remove a system.
             void removeSystem(const std::shared_ptr<ISystemBase>&);
@@ -106,15 +124,27 @@ namespace djv
         protected:
             void _addSystem(const std::shared_ptr<ISystemBase> &);
 
+            //! Log the time since the context was created. Only the first
+            //! call has an effect.
+            void _logStartupTime();
+
         private:
+            std::shared_ptr<ISystemBase> _createSystem(const std::type_index&) const;
+
             std::vector<std::string> _args;
             std::string _name;
             std::shared_ptr<Time::TimerSystem> _timerSystem;
             std::shared_ptr<ResourceSystem> _resourceSystem;
             std::shared_ptr<LogSystem> _logSystem;
             std::shared_ptr<TextSystem> _textSystem;
+            //! The systems and factories are guarded by a mutex since systems
+            //! may be created on demand from worker threads.
+            mutable std::recursive_mutex _systemsMutex;
             std::vector<std::shared_ptr<ISystemBase> > _systems;
+            mutable std::map<std::type_index, std::function<std::shared_ptr<ISystemBase>(const std::shared_ptr<Context>&)> > _systemFactories;
             std::vector<std::pair<std::string, float> > _systemTickTimes;
+            std::chrono::time_point<std::chrono::steady_clock> _startTime = std::chrono::steady_clock::now();
+            bool _startupTimeLogged = false;
             std::chrono::time_point<std::chrono::steady_clock> _fpsTime = std::chrono::steady_clock::now();
             std::list<float> _fpsSamples;
             float _fpsAverage = 0.F;
@@ -53,6 +53,7 @@ namespace djv
         inline std::vector<std::shared_ptr<T> > Context::getSystemsT() const
         {
             std::vector<std::shared_ptr<T> > out;
+            std::lock_guard<std::recursive_mutex> lock(_systemsMutex);
             for (const auto & i : _systems)
             {
                 if (auto system = std::dynamic_pointer_cast<T>(i))
@@ -67,6 +68,7 @@ namespace djv
         inline std::shared_ptr<T> Context::getSystemT() const
         {
             std::shared_ptr<T> out;
+            std::lock_guard<std::recursive_mutex> lock(_systemsMutex);
             for (const auto & i : _systems)
             {
                 if (auto system = std::dynamic_pointer_cast<T>(i))
@@ -75,9 +77,33 @@ namespace djv
                     break;
                 }
             }
+            if (!out && !_systemFactories.empty())
+            {
+                out = std::dynamic_pointer_cast<T>(_createSystem(typeid(T)));
+            }
             return out;
         }
 
+        template<typename T>
+        inline void Context::addSystemFactory(const std::function<std::shared_ptr<T>(const std::shared_ptr<Context>&)>& value)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_systemsMutex);
+            _systemFactories[typeid(T)] = [value](const std::shared_ptr<Context>& context)
+            {
+                return std::static_pointer_cast<ISystemBase>(value(context));
+            };
+        }
+
+        template<typename T>
+        inline void Context::addSystemFactory()
+        {
+            addSystemFactory<T>(
+                [](const std::shared_ptr<Context>& context)
+                {
+                    return T::create(context);
+                });
+        }
+
         inline float Context::getFPSAverage() const
         {
             return _fpsAverage;
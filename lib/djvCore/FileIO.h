@@ -158,6 +158,11 @@ namespace djv
 
                 //! Get a pointer to the end of the memory-map.
                 const uint8_t * mmapEnd() const;
+
+                //! Advise the operating system that the memory-mapped data from
+                //! the current position to the end of the file will be needed
+                //! soon, so it can be paged in asynchronously.
+                void mmapReadAhead() const;
 #endif // DJV_MMAP
 
                 ///@}
@@ -45,7 +45,11 @@ namespace djv
                 return _f != nullptr;
 #endif // DJV_MMAP
 #else // DJV_PLATFORM_WINDOWS
+#if defined(DJV_MMAP)
+                return _f != -1 || _mmap != reinterpret_cast<void *>(-1);
+#else // DJV_MMAP
                 return _f != -1;
+#endif // DJV_MMAP
 #endif //DJV_PLATFORM_WINDOWS
             }
 
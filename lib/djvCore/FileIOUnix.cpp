@@ -213,14 +213,21 @@ namespace djv
                 if (Mode::Read == _mode && _size > 0)
                 {
                     _mmap = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
-                    madvise(_mmap, _size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
                     if (_mmap == (void *) - 1)
                     {
                         throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
                     }
+                    madvise(_mmap, _size, MADV_SEQUENTIAL);
                     _mmapStart = reinterpret_cast<const uint8_t *>(_mmap);
                     _mmapEnd   = _mmapStart + _size;
                     _mmapP     = _mmapStart;
+
+                    // The memory-map keeps a reference to the file, so close the
+                    // descriptor now. Images that hold on to their memory-map
+                    // (for example in the playback cache) would otherwise run
+                    // out of file descriptors.
+                    ::close(_f);
+                    _f = -1;
                 }
 #endif // DJV_MMAP
             }
@@ -297,6 +304,19 @@ namespace djv
                 return out;
             }
             
+#if defined(DJV_MMAP)
+            void FileIO::mmapReadAhead() const
+            {
+                if (_mmapP && _mmapP < _mmapEnd)
+                {
+                    // The address passed to madvise() must be page aligned.
+                    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+                    const uintptr_t p = reinterpret_cast<uintptr_t>(_mmapP) & ~(pageSize - 1);
+                    madvise(reinterpret_cast<void *>(p), reinterpret_cast<uintptr_t>(_mmapEnd) - p, MADV_WILLNEED);
+                }
+            }
+#endif // DJV_MMAP
+
             void FileIO::read(void* in, size_t size, size_t wordSize)
             {
                 switch (_mode)
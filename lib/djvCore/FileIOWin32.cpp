@@ -281,6 +281,21 @@ namespace djv
                 return out;
             }
 
+#if defined(DJV_MMAP)
+            void FileIO::mmapReadAhead() const
+            {
+#if _WIN32_WINNT >= _WIN32_WINNT_WIN8
+                if (_mmapP && _mmapP < _mmapEnd)
+                {
+                    WIN32_MEMORY_RANGE_ENTRY range;
+                    range.VirtualAddress = const_cast<uint8_t *>(_mmapP);
+                    range.NumberOfBytes = _mmapEnd - _mmapP;
+                    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+                }
+#endif // _WIN32_WINNT_WIN8
+            }
+#endif // DJV_MMAP
+
             void FileIO::read(void * in, size_t size, size_t wordSize)
             {
                 switch (_mode)
@@ -29,6 +29,10 @@
 
 #include <djvCore/FileInfo.h>
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 //#pragma optimize("", off)
 
 namespace djv
@@ -68,11 +72,11 @@ namespace djv
                         ss << _path.getDirectoryName();
                     }
                     ss << _path.getBaseName();
-                    if (FileType::Sequence == _type && _sequence.ranges.size() && frame != Frame::invalid)
+                    if (FileType::Sequence == _type && _sequence.getRanges().size() && frame != Frame::invalid)
                     {
                         ss << Frame::toString(frame, _sequence.pad);
                     }
-                    else if (FileType::Sequence == _type && _sequence.ranges.size())
+                    else if (FileType::Sequence == _type && _sequence.getRanges().size())
                     {
                         ss << _sequence;
                     }
@@ -152,7 +156,7 @@ namespace djv
                         std::stringstream ss(_path.getNumber());
                         ss.exceptions(std::istream::failbit | std::istream::badbit);
                         ss >> _sequence;
-                        if (_sequence.ranges.size())
+                        if (_sequence.getRanges().size())
                         {
                             _type = FileType::Sequence;
                         }
@@ -188,7 +192,11 @@ namespace djv
                 return FileInfo(path);
             }
 
-            void FileInfo::_fileSequence(FileInfo& fileInfo, const DirectoryListOptions& options, std::vector<FileInfo>& out)
+            void FileInfo::_fileSequence(
+                FileInfo& fileInfo,
+                const DirectoryListOptions& options,
+                std::vector<FileInfo>& out,
+                std::map<std::pair<std::string, std::string>, size_t>& sequences)
             {
                 std::string extension = fileInfo.getPath().getExtension();
                 std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
@@ -201,17 +209,15 @@ namespace djv
                     fileInfo.evalSequence();
                     if (fileInfo.isSequenceValid())
                     {
-                        const size_t size = out.size();
-                        size_t i = 0;
-                        for (; i < size; ++i)
-                        {
-                            if (out[i].addToSequence(fileInfo))
-                            {
-                                break;
-                            }
-                        }
-                        if (size == i)
+                        // Look up the sequence by the base name and extension
+                        // rather than comparing against every item in the list.
+                        const auto key = std::make_pair(
+                            fileInfo.getPath().getBaseName(),
+                            fileInfo.getPath().getExtension());
+                        const auto j = sequences.find(key);
+                        if (j == sequences.end() || !out[j->second].addToSequence(fileInfo))
                         {
+                            sequences[key] = out.size();
                             out.push_back(fileInfo);
                         }
                     }
@@ -226,54 +232,149 @@ namespace djv
                 }
             }
 
-            void FileInfo::_sort(const DirectoryListOptions& options, std::vector<FileInfo>& out)
+            namespace
             {
-                for (auto & i : out)
+                //! \todo Should this be configurable?
+                const size_t sortThreadMinItems = 1000;
+
+                struct SortKey
                 {
-                    if (i.isSequenceValid())
+                    uint64_t    number = 0;
+                    std::string name;
+                    size_t      index  = 0;
+                };
+
+                //! Get a key for comparing file names in natural order, where runs
+                //! of digits compare by their numeric value ("render.2.exr" before
+                //! "render.10.exr"). Each run of digits is replaced by the number
+                //! of significant digits followed by the digits themselves.
+                std::string getNaturalKey(const std::string& value)
+                {
+                    std::string out;
+                    out.reserve(value.size() + 8);
+                    const size_t size = value.size();
+                    size_t i = 0;
+                    while (i < size)
                     {
-                        i.sortSequence();
+                        if (value[i] >= '0' && value[i] <= '9')
+                        {
+                            size_t j = i;
+                            while (j < size && '0' == value[j])
+                            {
+                                ++j;
+                            }
+                            size_t k = j;
+                            while (k < size && value[k] >= '0' && value[k] <= '9')
+                            {
+                                ++k;
+                            }
+                            const size_t digits = std::min(k - j, size_t(99));
+                            out.push_back(static_cast<char>('0' + digits / 10));
+                            out.push_back(static_cast<char>('0' + digits % 10));
+                            out.append(value, j, k - j);
+                            i = k;
+                        }
+                        else
+                        {
+                            out.push_back(value[i]);
+                            ++i;
+                        }
                     }
+                    return out;
                 }
 
-                switch (options.sort)
+                void getSortKeys(
+                    DirectoryListSort sort,
+                    std::vector<FileInfo>& items,
+                    size_t begin,
+                    size_t end,
+                    std::vector<SortKey>& out)
                 {
-                case DirectoryListSort::Name:
-                    std::sort(
-                        out.begin(), out.end(),
-                        [&options](const FileInfo & a, const FileInfo & b)
+                    for (size_t i = begin; i < end; ++i)
                     {
-                        return options.reverseSort ?
-                            (a.getFileName(Frame::invalid, false) > b.getFileName(Frame::invalid, false)) :
-                            (a.getFileName(Frame::invalid, false) < b.getFileName(Frame::invalid, false));
-                    });
-                    break;
-                case DirectoryListSort::Size:
-                    std::sort(
-                        out.begin(), out.end(),
-                        [&options](const FileInfo & a, const FileInfo & b)
+                        auto& item = items[i];
+                        if (item.isSequenceValid())
+                        {
+                            item.sortSequence();
+                        }
+                        auto& key = out[i];
+                        key.index = i;
+                        key.name = item.getFileName(Frame::invalid, false);
+                        switch (sort)
+                        {
+                        case DirectoryListSort::Size:        key.number = item.getSize(); break;
+                        case DirectoryListSort::Time:        key.number = static_cast<uint64_t>(item.getTime()); break;
+                        case DirectoryListSort::Permissions: key.number = static_cast<uint64_t>(item.getPermissions()); break;
+                        case DirectoryListSort::Natural:     key.name = getNaturalKey(key.name); break;
+                        default: break;
+                        }
+                    }
+                }
+
+            } // namespace
+
+            void FileInfo::_sort(const DirectoryListOptions& options, std::vector<FileInfo>& out)
+            {
+                // Compute the sort keys once for each item, splitting the work
+                // across threads for large listings.
+                const size_t size = out.size();
+                std::vector<SortKey> keys(size);
+                const size_t threadCount = size >= sortThreadMinItems ?
+                    std::max(std::min(static_cast<size_t>(std::thread::hardware_concurrency()), size / sortThreadMinItems), size_t(1)) :
+                    1;
+                if (threadCount > 1)
+                {
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
                     {
-                        return options.reverseSort ? (a.getSize() > b.getSize()) : (a.getSize() < b.getSize());
-                    });
-                    break;
-                case DirectoryListSort::Time:
-                    std::sort(
-                        out.begin(), out.end(),
-                        [&options](const FileInfo & a, const FileInfo & b)
+                        const size_t begin = i * size / threadCount;
+                        const size_t end = (i + 1) * size / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [&options, &out, &keys, begin, end]
+                            {
+                                getSortKeys(options.sort, out, begin, end, keys);
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                }
+                else
+                {
+                    getSortKeys(options.sort, out, 0, size, keys);
+                }
+
+                // Sort the keys, using the file name to break ties.
+                const bool reverse = options.reverseSort;
+                std::sort(
+                    keys.begin(), keys.end(),
+                    [reverse](const SortKey& a, const SortKey& b)
                     {
-                        return options.reverseSort ? (a.getTime() > b.getTime()) : (a.getTime() < b.getTime());
+                        const int compare =
+                            a.number < b.number ? -1 :
+                            a.number > b.number ?  1 :
+                            a.name.compare(b.name);
+                        return reverse ? (compare > 0) : (compare < 0);
                     });
-                    break;
-                default: break;
+
+                std::vector<FileInfo> tmp;
+                tmp.reserve(size);
+                for (const auto& i : keys)
+                {
+                    tmp.push_back(std::move(out[i.index]));
                 }
+                out = std::move(tmp);
+
                 if (options.sortDirectoriesFirst)
                 {
-                    std::stable_sort(
+                    std::stable_partition(
                         out.begin(), out.end(),
-                        [](const FileInfo & a, const FileInfo & b)
-                    {
-                        return FileType::Directory == a.getType() && b.getType() != FileType::Directory;
-                    });
+                        [](const FileInfo & value)
+                        {
+                            return FileType::Directory == value.getType();
+                        });
                 }
             }
 
@@ -371,6 +472,8 @@ namespace djv
         DirectoryListSort,
         DJV_TEXT("Name"),
         DJV_TEXT("Size"),
-        DJV_TEXT("Time"));
+        DJV_TEXT("Time"),
+        DJV_TEXT("Permissions"),
+        DJV_TEXT("Natural"));
 
 } // namespace djv
@@ -33,6 +33,7 @@
 #include <djvCore/Path.h>
 #include <djvCore/PicoJSON.h>
 
+#include <map>
 #include <set>
 
 #include <sys/types.h>
@@ -77,6 +78,8 @@ namespace djv
                 Name,
                 Size,
                 Time,
+                Permissions,
+                Natural,    //!< Name with numbers compared by value
 
                 Count,
                 First = Name
@@ -185,7 +188,11 @@ namespace djv
                 explicit operator std::string() const;
 
             private:
-                static void _fileSequence(FileInfo&, const DirectoryListOptions&, std::vector<FileInfo>&);
+                static void _fileSequence(
+                    FileInfo&,
+                    const DirectoryListOptions&,
+                    std::vector<FileInfo>&,
+                    std::map<std::pair<std::string, std::string>, size_t>&);
                 static void _sort(const DirectoryListOptions&, std::vector<FileInfo>&);
                 
                 Path            _path;
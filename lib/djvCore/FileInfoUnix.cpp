@@ -107,6 +107,7 @@ namespace djv
             std::vector<FileInfo> FileInfo::directoryList(const Path& value, const DirectoryListOptions& options)
             {
                 std::vector<FileInfo> out;
+                std::map<std::pair<std::string, std::string>, size_t> sequences;
                 
                 // List the directory contents.
                 /*if (auto dir = opendir(path.c_str()))
@@ -176,7 +177,7 @@ namespace djv
 
                         if (!filter)
                         {
-                            _fileSequence(fileInfo, options, out);
+                            _fileSequence(fileInfo, options, out, sequences);
                         }
                     }
                     closedir(dir);
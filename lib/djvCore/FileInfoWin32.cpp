@@ -119,6 +119,7 @@ namespace djv
             std::vector<FileInfo> FileInfo::directoryList(const Path & value, const DirectoryListOptions & options)
             {
                 std::vector<FileInfo> out;
+                std::map<std::pair<std::string, std::string>, size_t> sequences;
                 if (!value.isEmpty())
                 {
                     // Prepare the path.
@@ -175,7 +176,7 @@ namespace djv
                             if (!filter)
                             {
                                 FileInfo fileInfo(Path(value, fileName));
-                                _fileSequence(fileInfo, options, out);
+                                _fileSequence(fileInfo, options, out, sequences);
                             }
                         } while (FindNextFileW(hFind, &ffd) != 0);
                         FindClose(hFind);
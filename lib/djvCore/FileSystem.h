@@ -54,6 +54,17 @@ namespace djv
             //! - std::exception
             FILE* fopen(const std::string& fileName, const std::string& mode);
 
+            //! Rename a file, replacing the destination if it exists. The
+            //! replacement is atomic when both files are on the same volume.
+            //! Throws:
+            //! - Error
+            void rename(const std::string& from, const std::string& to);
+
+            //! Remove a file.
+            //! Throws:
+            //! - Error
+            void remove(const std::string&);
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
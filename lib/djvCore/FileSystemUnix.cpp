@@ -29,7 +29,13 @@
 
 #include <djvCore/FileSystem.h>
 
+#include <djvCore/String.h>
+
+#include <sstream>
+
+#include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 namespace djv
 {
@@ -42,6 +48,40 @@ namespace djv
                 return ::fopen(fileName.c_str(), mode.c_str());
             }
 
+            void rename(const std::string& from, const std::string& to)
+            {
+                if (::rename(from.c_str(), to.c_str()) != 0)
+                {
+                    std::stringstream ss;
+                    char buf[String::cStringLength] = "";
+                    ss << DJV_TEXT("The file") << " '" << from << "' " << DJV_TEXT("cannot be renamed") << ". ";
+#if defined(DJV_PLATFORM_LINUX)
+                    ss << strerror_r(errno, buf, String::cStringLength);
+#else // DJV_PLATFORM_LINUX
+                    strerror_r(errno, buf, String::cStringLength);
+                    ss << buf;
+#endif // DJV_PLATFORM_LINUX
+                    throw Error(ss.str());
+                }
+            }
+
+            void remove(const std::string& fileName)
+            {
+                if (::remove(fileName.c_str()) != 0)
+                {
+                    std::stringstream ss;
+                    char buf[String::cStringLength] = "";
+                    ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be removed") << ". ";
+#if defined(DJV_PLATFORM_LINUX)
+                    ss << strerror_r(errno, buf, String::cStringLength);
+#else // DJV_PLATFORM_LINUX
+                    strerror_r(errno, buf, String::cStringLength);
+                    ss << buf;
+#endif // DJV_PLATFORM_LINUX
+                    throw Error(ss.str());
+                }
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
@@ -29,8 +29,19 @@
 
 #include <djvCore/FileIO.h>
 
+#include <djvCore/Error.h>
+
 #include <codecvt>
 #include <locale>
+#include <sstream>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
 
 namespace djv
 {
@@ -46,6 +57,33 @@ namespace djv
                 return out;
             }
 
+            void rename(const std::string& from, const std::string& to)
+            {
+                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                if (!MoveFileExW(
+                    utf16.from_bytes(from).c_str(),
+                    utf16.from_bytes(to).c_str(),
+                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The file") << " '" << from << "' " << DJV_TEXT("cannot be renamed") << ". ";
+                    ss << Core::Error::getLastError();
+                    throw Error(ss.str());
+                }
+            }
+
+            void remove(const std::string& fileName)
+            {
+                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                if (!DeleteFileW(utf16.from_bytes(fileName).c_str()))
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be removed") << ". ";
+                    ss << Core::Error::getLastError();
+                    throw Error(ss.str());
+                }
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
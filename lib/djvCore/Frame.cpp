@@ -40,73 +40,175 @@ namespace djv
     {
         namespace Frame
         {
+            std::vector<Number> Sequence::getFrames(Index value, size_t count) const
+            {
+                std::vector<Number> out;
+                out.reserve(count);
+                if (_isIndexed())
+                {
+                    const Index size = _offsets.back();
+                    const Index end = std::min(value + static_cast<Index>(count), size);
+                    value = std::max(value, Index(0));
+                    if (value < end)
+                    {
+                        size_t i = std::upper_bound(_offsets.begin(), _offsets.end(), value) - _offsets.begin() - 1;
+                        for (; value < end; ++value)
+                        {
+                            if (value >= _offsets[i + 1])
+                            {
+                                ++i;
+                            }
+                            out.push_back(_ranges[i].min + value - _offsets[i]);
+                        }
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const Number frame = getFrame(value + static_cast<Index>(i));
+                        if (frame != invalid)
+                        {
+                            out.push_back(frame);
+                        }
+                    }
+                }
+                return out;
+            }
+
             void Sequence::sort()
             {
-                for (auto & range : ranges)
+                for (auto & range : _ranges)
                 {
                     Frame::sort(range);
                 }
 
-                std::sort(ranges.begin(), ranges.end());
+                std::sort(_ranges.begin(), _ranges.end());
 
-                if (ranges.size())
+                // Since the ranges are sorted by their minimum value, each range can
+                // only overlap or be contiguous with the last merged range.
+                if (_ranges.size())
                 {
                     std::vector<Range> tmp;
-                    tmp.push_back(ranges[0]);
-                    for (size_t i = 1; i < ranges.size(); ++i)
+                    tmp.reserve(_ranges.size());
+                    tmp.push_back(_ranges[0]);
+                    for (size_t i = 1; i < _ranges.size(); ++i)
                     {
-                        const size_t tmpSize = tmp.size();
-                        size_t j = 0;
-                        for (; j < tmpSize; ++j)
+                        auto& back = tmp.back();
+                        if (_ranges[i].min <= back.max + 1)
                         {
-                            if (ranges[i].min == tmp[j].max + 1)
-                            {
-                                tmp[j].max = ranges[i].max;
-                                break;
-                            }
-                            else if (ranges[i].intersects(tmp[j]))
-                            {
-                                tmp[j].expand(ranges[i]);
-                                break;
-                            }
+                            back.max = std::max(back.max, _ranges[i].max);
                         }
-                        if (tmpSize == j)
+                        else
                         {
-                            tmp.push_back(ranges[i]);
+                            tmp.push_back(_ranges[i]);
                         }
                     }
-                    ranges = tmp;
+                    _ranges = std::move(tmp);
                 }
+
+                updateIndex();
             }
             
             bool Sequence::merge(const Range& value)
             {
                 bool out = false;
-                for (auto& i : ranges)
+                auto mergeRange = [&value](Range& i)
                 {
+                    bool out = false;
                     if (i.intersects(value))
                     {
                         i.min = std::min(i.min, value.min);
                         i.max = std::max(i.max, value.max);
                         out = true;
-                        break;
                     }
-                    if (value.max == i.min - 1)
+                    else if (value.max == i.min - 1)
                     {
                         i.min = value.min;
                         out = true;
-                        break;
                     }
-                    if (value.min == i.max + 1)
+                    else if (value.min == i.max + 1)
                     {
                         i.max = value.max;
                         out = true;
-                        break;
                     }
+                    return out;
+                };
+                if (_sorted && _isIndexed())
+                {
+                    // Find the first range that ends at or after the frame before
+                    // the given range.
+                    const auto i = std::lower_bound(
+                        _ranges.begin(), _ranges.end(), value.min - 1,
+                        [](const Range& range, Number value)
+                        {
+                            return range.max < value;
+                        });
+                    if (i != _ranges.end())
+                    {
+                        out = mergeRange(*i);
+                    }
+                }
+                else
+                {
+                    for (auto& i : _ranges)
+                    {
+                        if (mergeRange(i))
+                        {
+                            out = true;
+                            break;
+                        }
+                    }
+                }
+                if (out)
+                {
+                    updateIndex();
                 }
                 return out;
             }
 
+            void Sequence::add(const Range& value)
+            {
+                if (_ranges.size() &&
+                    (_ranges.back().intersects(value) ||
+                    value.min == _ranges.back().max + 1 ||
+                    value.max == _ranges.back().min - 1))
+                {
+                    auto& back = _ranges.back();
+                    back.min = std::min(back.min, value.min);
+                    back.max = std::max(back.max, value.max);
+                }
+                else
+                {
+                    _ranges.push_back(value);
+                }
+                _offsets.clear();
+                _sorted = false;
+            }
+
+            void Sequence::updateIndex()
+            {
+                _offsets.resize(_ranges.size() + 1);
+                _offsets[0] = 0;
+                _sorted = true;
+                for (size_t i = 0; i < _ranges.size(); ++i)
+                {
+                    const auto& range = _ranges[i];
+                    if (range.min > range.max)
+                    {
+                        // Ranges in descending order are not indexed.
+                        _offsets.clear();
+                        _sorted = false;
+                        break;
+                    }
+                    _offsets[i + 1] = _offsets[i] + range.max - range.min + 1;
+                    if (i > 0 && range.min <= _ranges[i - 1].max)
+                    {
+                        _sorted = false;
+                    }
+                }
+            }
+
             void sort(Range & out)
             {
                 const auto _min = std::min(out.min, out.max);
@@ -117,7 +219,7 @@ namespace djv
             
             Sequence fromFrames(const std::vector<Number> & frames)
             {
-                Sequence out;
+                std::vector<Range> ranges;
                 const size_t size = frames.size();
                 if (size)
                 {
@@ -128,20 +230,20 @@ namespace djv
                     {
                         if (frames[i] != prevFrame + 1)
                         {
-                            out.ranges.push_back(Range(rangeStart, prevFrame));
+                            ranges.push_back(Range(rangeStart, prevFrame));
                             rangeStart = frames[i];
                         }
                     }
                     if (size > 1)
                     {
-                        out.ranges.push_back(Range(rangeStart, prevFrame));
+                        ranges.push_back(Range(rangeStart, prevFrame));
                     }
                     else
                     {
-                        out.ranges.push_back(Range(rangeStart));
+                        ranges.push_back(Range(rangeStart));
                     }
                 }
-                return out;
+                return Sequence(ranges);
             }
 
         } // namespace Frame
@@ -150,7 +252,7 @@ namespace djv
     std::ostream & operator << (std::ostream & s, const Core::Frame::Sequence & value)
     {
         std::vector<std::string> pieces;
-        for (const auto & range : value.ranges)
+        for (const auto & range : value.getRanges())
         {
             pieces.push_back(Core::Frame::toString(range, value.pad));
         }
@@ -170,13 +272,15 @@ namespace djv
 
         // Convert the ranges.
         size_t pad = 0;
+        auto ranges = out.getRanges();
         for (const auto & piece : pieces)
         {
             Core::Frame::Range range;
             Core::Frame::fromString(piece, range, pad);
-            out.ranges.push_back(range);
+            ranges.push_back(range);
             out.pad = std::max(pad, out.pad);
         }
+        out.setRanges(ranges);
         return s;
     }
 
@@ -58,6 +58,13 @@ namespace djv
             
             //! This class provides a sequence of frame numbers. A sequence is
             //! composed of multiple frame number ranges (e.g., 1-10,20-30).
+            //!
+            //! The sequence keeps an index of the ranges so that frame and index
+            //! lookups are O(log n). The ranges can only be changed through the
+            //! member functions, which keep the index up to date or invalidate it;
+            //! lookups fall back to a linear search while the index is invalid.
+            //! add() invalidates the index, call sort() or updateIndex() after a
+            //! series of adds.
             class Sequence
             {
             public:
@@ -67,27 +74,51 @@ namespace djv
                 explicit Sequence(const Range& range, size_t pad = 0);
                 explicit Sequence(const std::vector<Range>& ranges, size_t pad = 0);
 
-                std::vector<Range> ranges;
                 size_t pad = 0;
 
+                const std::vector<Range>& getRanges() const;
+                void setRanges(const std::vector<Range>&);
+
                 bool isValid() const;
                 bool contains(Index) const;
                 size_t getSize() const;
                 Number getFrame(Index) const;
                 Index getIndex(Number) const;
 
+                //! Get the frame numbers for the given number of indices, starting
+                //! at the given index. Indices outside of the sequence are skipped.
+                std::vector<Number> getFrames(Index, size_t count) const;
+
                 //! \name Utilities
                 ///@{
                 
-                //! Sort the sequence so that the frame numbers are in ascending order.
+                //! Sort the sequence so that the frame numbers are in ascending order,
+                //! and merge overlapping and contiguous ranges.
                 void sort();
                 
+                //! Merge the range with an existing range if they overlap or are
+                //! contiguous.
                 bool merge(const Range&);
+
+                //! Add a range to the sequence. The range is merged with the last
+                //! range if they overlap or are contiguous, otherwise it is appended;
+                //! call sort() to merge the remaining ranges.
+                void add(const Range&);
+
+                //! Update the index used for lookups.
+                void updateIndex();
                 
                 ///@}
 
                 bool operator == (const Sequence&) const;
                 bool operator != (const Sequence&) const;
+
+            private:
+                bool _isIndexed() const;
+
+                std::vector<Range> _ranges;
+                std::vector<Index> _offsets;
+                bool               _sorted   = false;
             };
 
             //! \name Utilities
@@ -29,6 +29,8 @@
 
 #include <djvCore/Math.h>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace Core
@@ -50,40 +52,69 @@ namespace djv
        
             inline Sequence::Sequence(Number number)
             {
-                ranges.push_back(Range(number));
+                _ranges.push_back(Range(number));
+                updateIndex();
             }
        
             inline Sequence::Sequence(Number min, Number max, size_t pad) :
                 pad(pad)
             {
-                ranges.push_back(Range(min, max));
+                _ranges.push_back(Range(min, max));
+                updateIndex();
             }
 
             inline Sequence::Sequence(const Range & range, size_t pad) :
                 pad(pad)
             {
-                ranges.push_back(range);
+                _ranges.push_back(range);
+                updateIndex();
             }
 
-            inline Sequence::Sequence(const std::vector<Range> & ranges, size_t pad) :
-                ranges(ranges),
-                pad(pad)
-            {}
+            inline Sequence::Sequence(const std::vector<Range> & value, size_t pad) :
+                pad(pad),
+                _ranges(value)
+            {
+                updateIndex();
+            }
+
+            inline const std::vector<Range>& Sequence::getRanges() const
+            {
+                return _ranges;
+            }
+
+            inline void Sequence::setRanges(const std::vector<Range>& value)
+            {
+                _ranges = value;
+                updateIndex();
+            }
 
             inline bool Sequence::isValid() const
             {
-                return ranges.size() > 0;
+                return _ranges.size() > 0;
             }
 
             inline bool Sequence::contains(Index value) const
             {
                 bool out = false;
-                for (const auto& i : ranges)
+                if (_sorted && _isIndexed())
+                {
+                    const auto i = std::lower_bound(
+                        _ranges.begin(), _ranges.end(), value,
+                        [](const Range& range, Number value)
+                        {
+                            return range.max < value;
+                        });
+                    out = i != _ranges.end() && i->min <= value;
+                }
+                else
                 {
-                    if (i.contains(value))
+                    for (const auto& i : _ranges)
                     {
-                        out = true;
-                        break;
+                        if (i.contains(value))
+                        {
+                            out = true;
+                            break;
+                        }
                     }
                 }
                 return out;
@@ -92,15 +123,22 @@ namespace djv
             inline size_t Sequence::getSize() const
             {
                 size_t out = 0;
-                for (const auto& i : ranges)
+                if (_isIndexed())
                 {
-                    if (i.min < i.max)
-                    {
-                        out += i.max - i.min + 1;
-                    }
-                    else
+                    out = static_cast<size_t>(_offsets.back());
+                }
+                else
+                {
+                    for (const auto& i : _ranges)
                     {
-                        out += i.min - i.max + 1;
+                        if (i.min < i.max)
+                        {
+                            out += i.max - i.min + 1;
+                        }
+                        else
+                        {
+                            out += i.min - i.max + 1;
+                        }
                     }
                 }
                 return out;
@@ -109,15 +147,26 @@ namespace djv
             inline Number Sequence::getFrame(Index value) const
             {
                 Number out = invalid;
-                for (const auto& j : ranges)
+                if (_isIndexed())
+                {
+                    if (value >= 0 && value < _offsets.back())
+                    {
+                        const auto i = std::upper_bound(_offsets.begin(), _offsets.end(), value) - _offsets.begin() - 1;
+                        out = _ranges[i].min + value - _offsets[i];
+                    }
+                }
+                else
                 {
-                    const size_t size = j.max - j.min + 1;
-                    if (value < size)
+                    for (const auto& j : _ranges)
                     {
-                        out = j.min + value;
-                        break;
+                        const size_t size = j.max - j.min + 1;
+                        if (value < size)
+                        {
+                            out = j.min + value;
+                            break;
+                        }
+                        value -= size;
                     }
-                    value -= size;
                 }
                 return out;
             }
@@ -125,22 +174,43 @@ namespace djv
             inline Index Sequence::getIndex(Number value) const
             {
                 Index out = invalidIndex;
-                Index tmp = 0;
-                for (const auto& j : ranges)
+                if (_sorted && _isIndexed())
                 {
-                    if (j.contains(value))
+                    const auto i = std::lower_bound(
+                        _ranges.begin(), _ranges.end(), value,
+                        [](const Range& range, Number value)
+                        {
+                            return range.max < value;
+                        });
+                    if (i != _ranges.end() && i->min <= value)
                     {
-                        out = tmp + value - j.min;
-                        break;
+                        out = _offsets[i - _ranges.begin()] + value - i->min;
+                    }
+                }
+                else
+                {
+                    Index tmp = 0;
+                    for (const auto& j : _ranges)
+                    {
+                        if (j.contains(value))
+                        {
+                            out = tmp + value - j.min;
+                            break;
+                        }
+                        tmp += j.max - j.min + 1;
                     }
-                    tmp += j.max - j.min + 1;
                 }
                 return out;
             }
 
+            inline bool Sequence::_isIndexed() const
+            {
+                return _offsets.size() == _ranges.size() + 1;
+            }
+
             inline bool Sequence::operator == (const Sequence & value) const
             {
-                return ranges == value.ranges && pad == value.pad;
+                return _ranges == value._ranges && pad == value.pad;
             }
 
             inline bool Sequence::operator != (const Sequence & value) const
@@ -166,7 +236,7 @@ namespace djv
             inline std::vector<Number> toFrames(const Sequence & value)
             {
                 std::vector<Number> out;
-                for (const auto & range : value.ranges)
+                for (const auto & range : value.getRanges())
                 {
                     for (const auto & i : toFrames(range))
                     {
@@ -256,7 +326,7 @@ namespace djv
             inline std::string toString(const Sequence & value)
             {
                 std::vector<std::string> list;
-                for (const auto & range : value.ranges)
+                for (const auto & range : value.getRanges())
                 {
                     list.push_back(toString(range, value.pad));
                 }
@@ -266,14 +336,16 @@ namespace djv
             inline void fromString(const std::string & value, Sequence & out)
             {
                 const auto & pieces = String::split(value, ',');
+                auto ranges = out.getRanges();
                 for (const auto & piece : pieces)
                 {
                     Range range;
                     size_t pad = 0;
                     fromString(piece, range, pad);
-                    out.ranges.push_back(range);
+                    ranges.push_back(range);
                     out.pad = std::max(out.pad, pad);
                 }
+                out.setRanges(ranges);
             }
 
         } // namespace Frame
@@ -40,6 +40,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <list>
@@ -54,6 +55,9 @@ namespace djv
         {
             const std::string name = "djv::Core::LogSystem";
 
+            //! \todo Should this be configurable?
+            const size_t recordsMax = 10000;
+
             struct Message
             {
                 Message()
@@ -84,7 +88,9 @@ namespace djv
             std::list<Message> queue;
             std::condition_variable queueCV;
             std::list<Message> messages;
-            std::mutex mutex;
+            std::deque<Record> records;
+            uint64_t recordID = 0;
+            mutable std::mutex mutex;
             std::thread thread;
             std::atomic<bool> running;
             std::shared_ptr<Time::Timer> warningsAndErrorsTimer;
@@ -202,10 +208,37 @@ namespace djv
             {
                 std::unique_lock<std::mutex> lock(p.mutex);
                 p.queue.push_back(Message(prefix, message, level));
+                Record record;
+                record.id = p.recordID++;
+                record.time = std::time(nullptr);
+                record.prefix = prefix;
+                record.text = message;
+                record.level = level;
+                p.records.push_back(std::move(record));
+                if (p.records.size() > recordsMax)
+                {
+                    p.records.pop_front();
+                }
             }
             p.queueCV.notify_one();
         }
 
+        std::vector<LogSystem::Record> LogSystem::getRecords(uint64_t id) const
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<Record> out;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (p.records.size() && id <= p.records.back().id)
+            {
+                // The record IDs are sequential so the first record can be
+                // found without searching.
+                const uint64_t first = p.records.front().id;
+                auto i = p.records.begin() + (id > first ? id - first : 0);
+                out.insert(out.end(), i, p.records.end());
+            }
+            return out;
+        }
+
         bool LogSystem::hasConsoleOutput() const
         {
             return _p->consoleOutput;
@@ -32,6 +32,8 @@
 #include <djvCore/ISystem.h>
 #include <djvCore/ListObserver.h>
 
+#include <ctime>
+
 namespace djv
 {
     namespace Core
@@ -56,6 +58,26 @@ namespace djv
             //! Log a message.
             void log(const std::string & prefix, const std::string & message, LogLevel = LogLevel::Information);
 
+            //! \name Records
+            ///@{
+
+            //! This struct provides a log record.
+            struct Record
+            {
+                uint64_t    id      = 0;
+                std::time_t time    = 0;
+                std::string prefix;
+                std::string text;
+                LogLevel    level   = LogLevel::Information;
+            };
+
+            //! Get the records starting with the given ID. Only the most
+            //! recent records are kept in memory, the complete log is
+            //! written to the log file.
+            std::vector<Record> getRecords(uint64_t id = 0) const;
+
+            ///@}
+
             //! \name Warning and Errors
             ///@{
 
@@ -40,6 +40,121 @@ namespace djv
     {
         namespace PicoJSON
         {
+            namespace
+            {
+                inline bool isSpace(char c)
+                {
+                    return ' ' == c || '\t' == c || '\n' == c || '\r' == c;
+                }
+
+                inline const char* skipSpace(const char* p, const char* end)
+                {
+                    for (; p < end && isSpace(*p); ++p)
+                        ;
+                    return p;
+                }
+
+                //! Find the end of a string, p points to the opening quote.
+                const char* skipString(const char* p, const char* end)
+                {
+                    for (++p; p < end; ++p)
+                    {
+                        if ('\\' == *p)
+                        {
+                            ++p;
+                        }
+                        else if ('"' == *p)
+                        {
+                            return p + 1;
+                        }
+                    }
+                    throw std::invalid_argument(DJV_TEXT("Cannot parse the value."));
+                }
+
+                //! Find the end of a value by matching brackets.
+                const char* skipValue(const char* p, const char* end)
+                {
+                    size_t depth = 0;
+                    while (p < end)
+                    {
+                        switch (*p)
+                        {
+                        case '"':
+                            p = skipString(p, end);
+                            continue;
+                        case '{':
+                        case '[':
+                            ++depth;
+                            break;
+                        case '}':
+                        case ']':
+                            if (0 == depth)
+                            {
+                                return p;
+                            }
+                            --depth;
+                            break;
+                        case ',':
+                            if (0 == depth)
+                            {
+                                return p;
+                            }
+                            break;
+                        default: break;
+                        }
+                        ++p;
+                    }
+                    return p;
+                }
+
+            } // namespace
+
+            void split(const char* begin, const char* end, std::map<std::string, std::string>& out)
+            {
+                const char* p = skipSpace(begin, end);
+                if (p == end || *p != '{')
+                {
+                    throw std::invalid_argument(DJV_TEXT("Cannot parse the value."));
+                }
+                p = skipSpace(p + 1, end);
+                while (p < end && *p != '}')
+                {
+                    if (*p != '"')
+                    {
+                        throw std::invalid_argument(DJV_TEXT("Cannot parse the value."));
+                    }
+                    const char* keyEnd = skipString(p, end);
+                    picojson::value key;
+                    std::string error;
+                    picojson::parse(key, p, keyEnd, &error);
+                    if (!error.empty() || !key.is<std::string>())
+                    {
+                        throw std::invalid_argument(DJV_TEXT("Cannot parse the value."));
+                    }
+
+                    p = skipSpace(keyEnd, end);
+                    if (p == end || *p != ':')
+                    {
+                        throw std::invalid_argument(DJV_TEXT("Cannot parse the value."));
+                    }
+                    const char* valueBegin = skipSpace(p + 1, end);
+                    p = skipValue(valueBegin, end);
+                    const char* valueEnd = p;
+                    for (; valueEnd > valueBegin && isSpace(*(valueEnd - 1)); --valueEnd)
+                        ;
+                    out[key.get<std::string>()] = std::string(valueBegin, valueEnd);
+
+                    if (p < end && ',' == *p)
+                    {
+                        p = skipSpace(p + 1, end);
+                    }
+                }
+                if (p == end)
+                {
+                    throw std::invalid_argument(DJV_TEXT("Cannot parse the value."));
+                }
+            }
+
             void write(const picojson::value & value, FileSystem::FileIO & fileIO, size_t indent, bool continueLine)
             {
                 if (value.is<picojson::object>())
@@ -33,6 +33,7 @@
 
 #include <picojson/picojson.h>
 
+#include <map>
 #include <string>
 
 namespace djv
@@ -50,6 +51,12 @@ namespace djv
         {
             void write(const picojson::value &, FileSystem::FileIO &, size_t indent = 0, bool continueLine = false);
 
+            //! Split a JSON object into the unparsed text of each value, so
+            //! that parsing can be deferred until the values are needed.
+            //! Throws:
+            //! - std::invalid_argument
+            void split(const char* begin, const char* end, std::map<std::string, std::string>&);
+
         } // namespace PicoJSON
     } // namespace Core
 
@@ -0,0 +1,352 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCore/ResourceBundle.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            const char     magic[]       = "djvBNDL";
+            const uint32_t byteOrder     = 0x01020304;
+            const uint32_t version       = 1;
+            const size_t   dataAlign     = 16;
+
+            //! The size of a text record with an empty ID and text.
+            const size_t   recordSizeMin = sizeof(uint64_t) + sizeof(uint32_t) * 2;
+
+            struct Header
+            {
+                char     magic[8];
+                uint32_t byteOrder;
+                uint32_t version;
+                uint64_t entryCount;
+                uint64_t tableSize;
+            };
+
+            template<typename T>
+            void append(std::vector<uint8_t>& out, const T& value)
+            {
+                const size_t size = out.size();
+                out.resize(size + sizeof(T));
+                memcpy(out.data() + size, &value, sizeof(T));
+            }
+
+            void append(std::vector<uint8_t>& out, const std::string& value)
+            {
+                append(out, static_cast<uint32_t>(value.size()));
+                out.insert(out.end(), value.begin(), value.end());
+            }
+
+            //! This class provides bounds-checked reading from a buffer.
+            class Reader
+            {
+            public:
+                Reader(const uint8_t* p, const uint8_t* end) :
+                    _p(p),
+                    _end(end)
+                {}
+
+                template<typename T>
+                T get()
+                {
+                    T out;
+                    _check(sizeof(T));
+                    memcpy(&out, _p, sizeof(T));
+                    _p += sizeof(T);
+                    return out;
+                }
+
+                std::string getString()
+                {
+                    const size_t size = get<uint32_t>();
+                    _check(size);
+                    std::string out(reinterpret_cast<const char*>(_p), size);
+                    _p += size;
+                    return out;
+                }
+
+                void skipString()
+                {
+                    const size_t size = get<uint32_t>();
+                    _check(size);
+                    _p += size;
+                }
+
+            private:
+                void _check(size_t size) const
+                {
+                    if (size > static_cast<size_t>(_end - _p))
+                    {
+                        throw FileSystem::Error(DJV_TEXT("The resource bundle is not valid."));
+                    }
+                }
+
+                const uint8_t* _p   = nullptr;
+                const uint8_t* _end = nullptr;
+            };
+
+        } // namespace
+
+        struct ResourceBundle::Private
+        {
+            std::string fileName;
+            FileSystem::FileIO io;
+#if !defined(DJV_MMAP)
+            std::vector<uint8_t> buf;
+#endif // DJV_MMAP
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            std::vector<Entry> entries;
+            std::map<std::string, size_t> nameToEntry;
+        };
+
+        void ResourceBundle::_init(const std::string& fileName)
+        {
+            DJV_PRIVATE_PTR();
+            p.fileName = fileName;
+            p.io.open(fileName, FileSystem::FileIO::Mode::Read);
+            p.size = p.io.getSize();
+#if defined(DJV_MMAP)
+            p.data = p.io.mmapP();
+#else // DJV_MMAP
+            p.buf.resize(p.size);
+            p.io.read(p.buf.data(), p.size);
+            p.io.close();
+            p.data = p.buf.data();
+#endif // DJV_MMAP
+
+            Reader reader(p.data, p.data + p.size);
+            const Header header = reader.get<Header>();
+            if (memcmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+                header.byteOrder != byteOrder ||
+                header.version != version)
+            {
+                std::stringstream ss;
+                ss << DJV_TEXT("The resource bundle is not valid.") << " '" << fileName << "'";
+                throw FileSystem::Error(ss.str());
+            }
+            for (uint64_t i = 0; i < header.entryCount; ++i)
+            {
+                Entry entry;
+                entry.type   = static_cast<EntryType>(reader.get<uint32_t>());
+                entry.name   = reader.getString();
+                entry.width  = reader.get<uint16_t>();
+                entry.height = reader.get<uint16_t>();
+                entry.offset = reader.get<uint64_t>();
+                entry.size   = reader.get<uint64_t>();
+                if (entry.type >= EntryType::Count ||
+                    entry.offset > p.size ||
+                    entry.size > p.size - entry.offset)
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The resource bundle is not valid.") << " '" << fileName << "'";
+                    throw FileSystem::Error(ss.str());
+                }
+                p.nameToEntry[entry.name] = p.entries.size();
+                p.entries.push_back(std::move(entry));
+            }
+        }
+
+        ResourceBundle::ResourceBundle() :
+            _p(new Private)
+        {}
+
+        ResourceBundle::~ResourceBundle()
+        {}
+
+        std::shared_ptr<ResourceBundle> ResourceBundle::create(const std::string& fileName)
+        {
+            auto out = std::shared_ptr<ResourceBundle>(new ResourceBundle);
+            out->_init(fileName);
+            return out;
+        }
+
+        const std::string& ResourceBundle::getFileName() const
+        {
+            return _p->fileName;
+        }
+
+        const std::vector<ResourceBundle::Entry>& ResourceBundle::getEntries() const
+        {
+            return _p->entries;
+        }
+
+        const ResourceBundle::Entry* ResourceBundle::getEntry(const std::string& name) const
+        {
+            DJV_PRIVATE_PTR();
+            const auto i = p.nameToEntry.find(name);
+            return i != p.nameToEntry.end() ? &p.entries[i->second] : nullptr;
+        }
+
+        std::vector<std::string> ResourceBundle::getNames(const std::string& prefix) const
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::string> out;
+            for (auto i = p.nameToEntry.lower_bound(prefix);
+                i != p.nameToEntry.end() && 0 == i->first.compare(0, prefix.size(), prefix);
+                ++i)
+            {
+                out.push_back(i->first);
+            }
+            return out;
+        }
+
+        const uint8_t* ResourceBundle::getData(const Entry& value) const
+        {
+            return _p->data + value.offset;
+        }
+
+        void ResourceBundle::write(
+            const std::string& fileName,
+            const std::vector<std::pair<Entry, std::vector<uint8_t> > >& value)
+        {
+            // Compute the size of the table so the data offsets are known
+            // before it is written.
+            size_t tableSize = 0;
+            for (const auto& i : value)
+            {
+                tableSize +=
+                    sizeof(uint32_t) +
+                    sizeof(uint32_t) + i.first.name.size() +
+                    sizeof(uint16_t) * 2 +
+                    sizeof(uint64_t) * 2;
+            }
+
+            Header header;
+            memset(&header, 0, sizeof(Header));
+            memcpy(header.magic, magic, sizeof(header.magic));
+            header.byteOrder  = byteOrder;
+            header.version    = version;
+            header.entryCount = value.size();
+            header.tableSize  = tableSize;
+
+            std::vector<uint8_t> table;
+            table.reserve(sizeof(Header) + tableSize);
+            append(table, header);
+            uint64_t offset = sizeof(Header) + tableSize;
+            std::vector<uint64_t> offsets;
+            for (const auto& i : value)
+            {
+                offset = (offset + dataAlign - 1) / dataAlign * dataAlign;
+                offsets.push_back(offset);
+                append(table, static_cast<uint32_t>(i.first.type));
+                append(table, i.first.name);
+                append(table, i.first.width);
+                append(table, i.first.height);
+                append(table, offset);
+                append(table, static_cast<uint64_t>(i.second.size()));
+                offset += i.second.size();
+            }
+
+            FileSystem::FileIO io;
+            io.open(fileName, FileSystem::FileIO::Mode::Write);
+            io.write(table.data(), table.size());
+            const std::vector<uint8_t> padding(dataAlign, 0);
+            uint64_t pos = table.size();
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                io.write(padding.data(), offsets[i] - pos);
+                io.write(value[i].second.data(), value[i].second.size());
+                pos = offsets[i] + value[i].second.size();
+            }
+        }
+
+        uint64_t ResourceBundle::getTextHash(const std::string& value)
+        {
+            uint64_t out = 14695981039346656037ULL;
+            for (const auto i : value)
+            {
+                out ^= static_cast<uint8_t>(i);
+                out *= 1099511628211ULL;
+            }
+            return out;
+        }
+
+        std::vector<uint8_t> ResourceBundle::packText(const TextList& value)
+        {
+            std::vector<std::pair<uint64_t, size_t> > hashes;
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                hashes.push_back(std::make_pair(getTextHash(value[i].first), i));
+            }
+            std::sort(hashes.begin(), hashes.end());
+            std::vector<uint8_t> out;
+            append(out, static_cast<uint64_t>(value.size()));
+            for (const auto& i : hashes)
+            {
+                append(out, i.first);
+                append(out, value[i.second].first);
+                append(out, value[i.second].second);
+            }
+            return out;
+        }
+
+        ResourceBundle::TextList ResourceBundle::unpackText(const uint8_t* data, size_t size)
+        {
+            TextList out;
+            Reader reader(data, data + size);
+            const uint64_t count = reader.get<uint64_t>();
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                reader.get<uint64_t>();
+                std::string id = reader.getString();
+                std::string text = reader.getString();
+                out.push_back(std::make_pair(std::move(id), std::move(text)));
+            }
+            return out;
+        }
+
+        std::vector<std::pair<uint64_t, std::string> > ResourceBundle::unpackTextHashes(const uint8_t* data, size_t size)
+        {
+            std::vector<std::pair<uint64_t, std::string> > out;
+            Reader reader(data, data + size);
+            const uint64_t count = reader.get<uint64_t>();
+            out.reserve(std::min(count, static_cast<uint64_t>(size / recordSizeMin)));
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                const uint64_t hash = reader.get<uint64_t>();
+                reader.skipString();
+                out.push_back(std::make_pair(hash, reader.getString()));
+            }
+            return out;
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a packed bundle of resources.
+        //!
+        //! A bundle is a single indexed file containing the contents of the
+        //! resource directories, so that they can be loaded at startup with
+        //! one read (or memory-map) instead of opening each file separately.
+        //! Entries are named by their path relative to the "etc" directory,
+        //! for example "Shaders/djvAVRender2DFragment.glsl".
+        //!
+        //! Bundles are written with the native byte order of the machine that
+        //! created them and are not portable between architectures; a bundle
+        //! with a different byte order or version is rejected when opened.
+        //!
+        //! Bundles are created at build time with the "djv_bundle" tool.
+        class ResourceBundle
+        {
+            DJV_NON_COPYABLE(ResourceBundle);
+            void _init(const std::string& fileName);
+            ResourceBundle();
+
+        public:
+            ~ResourceBundle();
+
+            //! This enumeration provides the entry types.
+            enum class EntryType
+            {
+                File,   //!< The unmodified contents of a file
+                Image,  //!< Pre-decoded 8-bit RGBA pixels, top row first
+                Text,   //!< Pre-hashed text records (see packText())
+
+                Count,
+                First = File
+            };
+
+            //! This struct provides a bundle entry.
+            struct Entry
+            {
+                EntryType   type    = EntryType::First;
+                std::string name;
+                uint16_t    width   = 0;
+                uint16_t    height  = 0;
+                uint64_t    offset  = 0;
+                uint64_t    size    = 0;
+            };
+
+            //! Open a bundle.
+            //! Throws:
+            //! - FileSystem::Error
+            static std::shared_ptr<ResourceBundle> create(const std::string& fileName);
+
+            //! Get the bundle file name.
+            const std::string& getFileName() const;
+
+            //! Get the entries.
+            const std::vector<Entry>& getEntries() const;
+
+            //! Get an entry by name, or nullptr if the entry does not exist.
+            const Entry* getEntry(const std::string& name) const;
+
+            //! Get the entry names that start with the given prefix.
+            std::vector<std::string> getNames(const std::string& prefix) const;
+
+            //! Get the data for an entry. The data is owned by the bundle.
+            const uint8_t* getData(const Entry&) const;
+
+            //! Write a bundle. The entry offsets and sizes are computed from the data.
+            //! Throws:
+            //! - FileSystem::Error
+            static void write(
+                const std::string& fileName,
+                const std::vector<std::pair<Entry, std::vector<uint8_t> > >&);
+
+            //! \name Text
+            ///@{
+
+            typedef std::vector<std::pair<std::string, std::string> > TextList;
+
+            //! Hash a text ID (64-bit FNV-1a).
+            static uint64_t getTextHash(const std::string&);
+
+            //! Pack text into records sorted by the ID hash.
+            static std::vector<uint8_t> packText(const TextList&);
+
+            //! Unpack text records.
+            //! Throws:
+            //! - FileSystem::Error
+            static TextList unpackText(const uint8_t*, size_t);
+
+            //! Unpack text records as pairs of ID hash and text, without
+            //! copying the IDs.
+            //! Throws:
+            //! - FileSystem::Error
+            static std::vector<std::pair<uint64_t, std::string> > unpackTextHashes(const uint8_t*, size_t);
+
+            ///@}
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace Core
+} // namespace djv
@@ -30,10 +30,14 @@
 #include <djvCore/ResourceSystem.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
 #include <djvCore/OS.h>
+#include <djvCore/ResourceBundle.h>
 
 #include <iostream>
+#include <sstream>
 
 using namespace djv::Core::FileSystem;
 
@@ -45,6 +49,7 @@ namespace djv
         {
             Path applicationPath;
             std::map<ResourcePath, Path> paths;
+            std::shared_ptr<ResourceBundle> bundle;
         };
 
         namespace
@@ -174,6 +179,7 @@ namespace djv
             Path settingsFile(documents, applicationName + ".json");
             p.paths[ResourcePath::SettingsFile] = settingsFile;
 
+            Path bundlePath;
             Path testPath = p.paths[ResourcePath::Application];
             testPath.append("djvCore.en.text");
             if (FileInfo(testPath).doesExist())
@@ -188,6 +194,7 @@ namespace djv
                 p.paths[ResourcePath::Text]             = p.paths[ResourcePath::Application];
                 p.paths[ResourcePath::Color]            = p.paths[ResourcePath::Application];
                 p.paths[ResourcePath::Documentation]    = p.paths[ResourcePath::Application];
+                bundlePath = Path(p.paths[ResourcePath::Application], "djvResources.pak");
             }
             else
             {
@@ -204,6 +211,26 @@ namespace djv
                 docs = Path(docs, "_site");
                 docs = Path(docs, "documentation.html");
                 p.paths[ResourcePath::Documentation]    = docs;
+                bundlePath = Path(etc, "djvResources.pak");
+            }
+
+            // Load the resource bundle.
+            env = OS::getEnv("DJV_RESOURCE_BUNDLE");
+            if (!env.empty())
+            {
+                bundlePath = Path(env);
+            }
+            if (FileInfo(bundlePath).doesExist())
+            {
+                try
+                {
+                    p.bundle = ResourceBundle::create(bundlePath.get());
+                }
+                catch (const std::exception & e)
+                {
+                    //! \bug How should we really handle this error?
+                    std::cerr << "[ERROR] Cannot load the resource bundle: " << e.what() << std::endl;
+                }
             }
         }
 
@@ -228,6 +255,37 @@ namespace djv
             return i != p.paths.end() ? i->second : Path();
         }
 
+        const std::shared_ptr<ResourceBundle>& ResourceSystem::getBundle() const
+        {
+            return _p->bundle;
+        }
+
+        std::string ResourceSystem::getBundleName(ResourcePath path, const std::string& fileName)
+        {
+            std::stringstream ss;
+            ss << path << "/" << fileName;
+            return ss.str();
+        }
+
+        std::string ResourceSystem::readContents(ResourcePath path, const std::string& fileName) const
+        {
+            DJV_PRIVATE_PTR();
+            if (p.bundle)
+            {
+                if (auto entry = p.bundle->getEntry(getBundleName(path, fileName)))
+                {
+                    if (ResourceBundle::EntryType::File == entry->type)
+                    {
+                        const char* data = reinterpret_cast<const char*>(p.bundle->getData(*entry));
+                        return std::string(data, data + entry->size);
+                    }
+                }
+            }
+            FileIO io;
+            io.open(std::string(Path(getPath(path), fileName)), FileIO::Mode::Read);
+            return FileIO::readContents(io);
+        }
+
     } // namespace Core
 } // namespace djv
 
@@ -38,6 +38,8 @@ namespace djv
 {
     namespace Core
     {
+        class ResourceBundle;
+
         //! This class provides the location of resources.
         //!
         //! By default the application root is used for bundled resources. This
@@ -45,6 +47,12 @@ namespace djv
         //!
         //! By default log files and settings are written to "$HOME/Documents/DJV".
         //! This may be overridden with the DJV_DOCUMENTS_PATH environment variable.
+        //!
+        //! If a resource bundle ("djvResources.pak") is found next to the
+        //! resource directories it is loaded at startup, and resources are read
+        //! from the bundle before falling back to the loose files. The bundle
+        //! location may be overridden with the DJV_RESOURCE_BUNDLE environment
+        //! variable.
         class ResourceSystem : public ISystemBase
         {
             DJV_NON_COPYABLE(ResourceSystem);
@@ -60,6 +68,18 @@ namespace djv
             //! Get a resource path.
             FileSystem::Path getPath(FileSystem::ResourcePath) const;
 
+            //! Get the resource bundle, or nullptr if no bundle was loaded.
+            const std::shared_ptr<ResourceBundle>& getBundle() const;
+
+            //! Get the resource bundle entry name for a file in a resource path.
+            static std::string getBundleName(FileSystem::ResourcePath, const std::string& fileName);
+
+            //! Read the contents of a file in a resource path, from the bundle
+            //! if possible.
+            //! Throws:
+            //! - FileSystem::Error
+            std::string readContents(FileSystem::ResourcePath, const std::string& fileName) const;
+
         private:
             DJV_PRIVATE();
         };
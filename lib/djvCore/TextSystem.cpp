@@ -30,18 +30,20 @@
 #include <djvCore/TextSystem.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/DirectoryWatcher.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/OS.h>
 #include <djvCore/PicoJSON.h>
+#include <djvCore/ResourceBundle.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
-#include <future>
 #include <locale>
+#include <map>
 #include <set>
 
 //#pragma optimize("", off)
@@ -55,21 +57,26 @@ namespace djv
             std::shared_ptr<ResourceSystem> resourceSystem;
             std::shared_ptr<LogSystem> logSystem;
 
+            bool bundleText = false;
             std::vector<FileSystem::FileInfo> textFiles;
 
             std::vector<std::string> locales;
             std::shared_ptr<ValueSubject<std::string> > currentLocale;
 
-            TextMap text;
+            std::map<std::string, TextMap> text;
+            const TextMap* currentText = nullptr;
+            const TextMap* fallbackText = nullptr;
             std::shared_ptr<ValueSubject<bool> > textChanged;
 
-            std::vector<std::future<TextMap> > readFutures;
-            std::future<std::vector<FileSystem::FileInfo> > statFuture;
-            std::shared_ptr<Time::Timer> timer;
+            bool hotReload = false;
+            std::vector<std::shared_ptr<FileSystem::DirectoryWatcher> > directoryWatchers;
         };
 
         namespace
         {
+            //! The locale used when text is missing from the current locale.
+            const std::string fallbackLocale = "en";
+
             std::string parseLocale(const std::string& value)
             {
                 std::string locale = value;
@@ -134,6 +141,17 @@ namespace djv
 #endif // DJV_PLATFORM_WINDOWS
                 return out;
             }
+
+            std::string getLocale(const FileSystem::Path& value)
+            {
+                std::string out = FileSystem::Path(value.getBaseName()).getExtension();
+                if (out.size() && '.' == out[0])
+                {
+                    out.erase(out.begin());
+                }
+                return out;
+            }
+
         } // namespace
 
         void TextSystem::_init(const std::shared_ptr<Context>& context)
@@ -181,18 +199,35 @@ namespace djv
             ss << "Found locale: " << currentLocale;
             p.logSystem->log(getSystemName(), ss.str());
 
+            // Find the locales in the resource bundle. The loose files in the
+            // text directory are only used if the bundle is missing or hot
+            // reload is enabled; files in the documents directory or
+            // DJV_TEXT_PATH are still loaded on top of the bundle.
+            std::set<std::string> localeSet;
+            if (auto bundle = p.resourceSystem->getBundle())
+            {
+                const std::string textName = ResourceSystem::getBundleName(FileSystem::ResourcePath::Text, std::string());
+                for (const auto& name : bundle->getNames(textName))
+                {
+                    if (ResourceBundle::EntryType::Text == bundle->getEntry(name)->type)
+                    {
+                        const std::string locale = getLocale(FileSystem::Path(name));
+                        if (locale != "all")
+                        {
+                            localeSet.insert(locale);
+                        }
+                        p.bundleText = true;
+                    }
+                }
+            }
+
             // Find the .text files.
             p.textFiles = _getTextFiles();
 
             // Extract the locale names.
-            std::set<std::string> localeSet;
             for (const auto& textFile : p.textFiles)
             {
-                std::string temp = FileSystem::Path(textFile.getPath().getBaseName()).getExtension();
-                if (temp.size() && '.' == temp[0])
-                {
-                    temp.erase(temp.begin());
-                }
+                const std::string temp = getLocale(textFile.getPath());
                 if (temp != "all")
                 {
                     localeSet.insert(temp);
@@ -211,7 +246,7 @@ namespace djv
             if (i == localeSet.end())
             {
                 // Fall back to using English.
-                const auto j = localeSet.find("en");
+                const auto j = localeSet.find(fallbackLocale);
                 if (j != localeSet.end())
                 {
                     currentLocale = *j;
@@ -227,88 +262,15 @@ namespace djv
             ss << "Current locale: " << currentLocale;
             p.logSystem->log(getSystemName(), ss.str());
 
-            // Load the text.
-            for (const auto& j : p.textFiles)
+            // Load the text for the current locale and the fallback.
+            p.currentText = &_load(currentLocale);
+            p.fallbackText = &_load(fallbackLocale);
+
+            const std::string djvTextReload = OS::getEnv("DJV_TEXT_RELOAD");
+            if (!djvTextReload.empty() && djvTextReload != "0")
             {
-                _reload(j);
+                setHotReload(true);
             }
-
-            p.timer = Time::Timer::create(context);
-            p.timer->setRepeating(true);
-            auto weak = std::weak_ptr<TextSystem>(std::dynamic_pointer_cast<TextSystem>(shared_from_this()));
-            p.timer->start(
-                Time::getMilliseconds(Time::TimerValue::Slow),
-                [weak](float)
-                {
-                    if (auto system = weak.lock())
-                    {
-                        bool textChanged = false;
-                        auto j = system->_p->readFutures.begin();
-                        while (j != system->_p->readFutures.end())
-                        {
-                            if (j->valid() &&
-                                j->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                            {
-                                for (const auto& k : j->get())
-                                {
-                                    for (const auto& l : k.second)
-                                    {
-                                        system->_p->text[k.first][l.first] = l.second;
-                                        textChanged = true;
-                                    }
-                                }
-                                j = system->_p->readFutures.erase(j);
-                            }
-                            else
-                            {
-                                ++j;
-                            }
-                        }
-                        if (textChanged)
-                        {
-                            system->_p->textChanged->setAlways(true);
-                        }
-
-                        bool stat = false;
-                        if (system->_p->statFuture.valid())
-                        {
-                            if (system->_p->statFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                            {
-                                auto textFiles = system->_p->statFuture.get();
-                                for (auto j = system->_p->textFiles.begin(), k = textFiles.begin();
-                                    j != system->_p->textFiles.end() && k != textFiles.end();
-                                    ++j, ++k)
-                                {
-                                    if (k->getTime() > j->getTime())
-                                    {
-                                        system->_reload(*k);
-                                        *j = *k;
-                                    }
-                                }
-                                stat = true;
-                            }
-                        }
-                        else
-                        {
-                            stat = true;
-                        }
-                        if (stat)
-                        {
-                            auto textFiles = system->_p->textFiles;
-                            system->_p->statFuture = std::async(
-                                std::launch::async,
-                                [textFiles]
-                                {
-                                    std::vector<FileSystem::FileInfo> out;
-                                    for (const auto& i : textFiles)
-                                    {
-                                        out.push_back(FileSystem::FileInfo(i.getPath()));
-                                    }
-                                    return out;
-                                });
-                        }
-                    }
-                });
         }
 
         TextSystem::TextSystem() :
@@ -340,6 +302,7 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.currentLocale->setIfChanged(value))
             {
+                p.currentText = &_load(value);
                 p.textChanged->setAlways(true);
             }
         }
@@ -347,13 +310,16 @@ namespace djv
         const std::string & TextSystem::getText(const std::string & id) const
         {
             DJV_PRIVATE_PTR();
-            const auto i = p.text.find(p.currentLocale->get());
-            if (i != p.text.end())
+            const uint64_t hash = ResourceBundle::getTextHash(id);
+            for (const auto text : { p.currentText, p.fallbackText })
             {
-                const auto j = i->second.find(id);
-                if (j != i->second.end())
+                if (text)
                 {
-                    return j->second;
+                    const auto i = text->find(hash);
+                    if (i != text->end())
+                    {
+                        return i->second;
+                    }
                 }
             }
             return id;
@@ -364,27 +330,76 @@ namespace djv
             return _p->textChanged;
         }
 
-        std::vector<FileSystem::FileInfo> TextSystem::_getTextFiles() const
+        bool TextSystem::hasHotReload() const
+        {
+            return _p->hotReload;
+        }
+
+        std::vector<std::string> TextSystem::getLoadedLocales() const
+        {
+            std::vector<std::string> out;
+            for (const auto& i : _p->text)
+            {
+                out.push_back(i.first);
+            }
+            return out;
+        }
+
+        void TextSystem::setHotReload(bool value)
         {
             DJV_PRIVATE_PTR();
-            std::vector<FileSystem::FileInfo> out;
-            FileSystem::DirectoryListOptions options;
-            options.filter = "\\.text$";
+            if (value == p.hotReload)
+            {
+                return;
+            }
+            p.hotReload = value;
+            p.directoryWatchers.clear();
 
-            const auto textPath = p.resourceSystem->getPath(FileSystem::ResourcePath::Text);
-            out = FileSystem::FileInfo::directoryList(textPath, options);
-            
-            const auto documentsPath = p.resourceSystem->getPath(FileSystem::ResourcePath::Documents);
-            auto list = FileSystem::FileInfo::directoryList(documentsPath, options);
-            out.insert(out.end(), list.begin(), list.end());
+            // With a resource bundle the text directory is only used when hot
+            // reload is enabled, so the text files have changed.
+            if (p.hotReload)
+            {
+                if (auto context = getContext().lock())
+                {
+                    auto weak = std::weak_ptr<TextSystem>(std::dynamic_pointer_cast<TextSystem>(shared_from_this()));
+                    for (const auto& i : _getTextPaths())
+                    {
+                        auto directoryWatcher = FileSystem::DirectoryWatcher::create(context);
+                        directoryWatcher->setPath(i);
+                        directoryWatcher->setCallback(
+                            [weak]
+                            {
+                                if (auto system = weak.lock())
+                                {
+                                    system->_reload();
+                                }
+                            });
+                        p.directoryWatchers.push_back(directoryWatcher);
+                    }
+                }
+            }
+            if (p.bundleText)
+            {
+                _reload();
+            }
+        }
 
+        std::vector<FileSystem::Path> TextSystem::_getTextPaths() const
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<FileSystem::Path> out;
+            if (!p.bundleText || p.hotReload)
+            {
+                // The loose files are read after the bundle so that edits to
+                // them override the bundled text.
+                out.push_back(p.resourceSystem->getPath(FileSystem::ResourcePath::Text));
+            }
+            out.push_back(p.resourceSystem->getPath(FileSystem::ResourcePath::Documents));
             try
             {
-                const auto envPaths = OS::getStringListEnv("DJV_TEXT_PATH");
-                for (const auto& path : envPaths)
+                for (const auto& path : OS::getStringListEnv("DJV_TEXT_PATH"))
                 {
-                    auto list = FileSystem::FileInfo::directoryList(FileSystem::Path(path), options);
-                    out.insert(out.end(), list.begin(), list.end());
+                    out.push_back(FileSystem::Path(path));
                 }
             }
             catch (const std::exception& e)
@@ -393,32 +408,78 @@ namespace djv
                 ss << DJV_TEXT("Error reading the environment varible") << " 'DJV_TEXT_PATH'. " << e.what();
                 p.logSystem->log(getSystemName(), ss.str(), LogLevel::Error);
             }
+            return out;
+        }
 
+        std::vector<FileSystem::FileInfo> TextSystem::_getTextFiles() const
+        {
+            std::vector<FileSystem::FileInfo> out;
+            FileSystem::DirectoryListOptions options;
+            options.filter = "\\.text$";
+            for (const auto& path : _getTextPaths())
+            {
+                auto list = FileSystem::FileInfo::directoryList(path, options);
+                out.insert(out.end(), list.begin(), list.end());
+            }
             return out;
         }
-        
-        void TextSystem::_reload(const FileSystem::FileInfo& value)
+
+        const TextSystem::TextMap& TextSystem::_load(const std::string& locale)
         {
             DJV_PRIVATE_PTR();
-            auto weak = std::weak_ptr<TextSystem>(std::dynamic_pointer_cast<TextSystem>(shared_from_this()));
-            auto fileInfo = value;
-            p.readFutures.push_back(std::async(
-                std::launch::async,
-                [weak, fileInfo]
+            const auto i = p.text.find(locale);
+            if (i != p.text.end())
+            {
+                return i->second;
+            }
+
+            {
+                std::stringstream ss;
+                ss << "Loading locale: " << locale;
+                p.logSystem->log(getSystemName(), ss.str());
+            }
+            auto& out = p.text[locale];
+
+            // Load the pre-parsed text from the resource bundle.
+            if (auto bundle = p.resourceSystem->getBundle())
+            {
+                const std::string textName = ResourceSystem::getBundleName(FileSystem::ResourcePath::Text, std::string());
+                for (const auto& name : bundle->getNames(textName))
                 {
-                    TextMap out;
-                    if (auto system = weak.lock())
+                    const auto entry = bundle->getEntry(name);
+                    if (ResourceBundle::EntryType::Text == entry->type &&
+                        getLocale(FileSystem::Path(name)) == locale)
                     {
-                        out = system->_readText(fileInfo);
+                        try
+                        {
+                            for (auto& j : ResourceBundle::unpackTextHashes(bundle->getData(*entry), entry->size))
+                            {
+                                out[j.first] = std::move(j.second);
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            p.logSystem->log(getSystemName(), e.what(), LogLevel::Error);
+                        }
                     }
-                    return out;
-                }));
+                }
+            }
+
+            // Load the text files.
+            for (const auto& textFile : p.textFiles)
+            {
+                if (getLocale(textFile.getPath()) == locale)
+                {
+                    _readText(textFile, out);
+                }
+            }
+
+            return out;
         }
 
-        TextSystem::TextMap TextSystem::_readText(const FileSystem::FileInfo& textFile)
+        void TextSystem::_readText(const FileSystem::FileInfo& textFile, TextMap& out)
         {
             DJV_PRIVATE_PTR();
-            TextMap out;
             {
                 std::stringstream ss;
                 ss << "Reading text file: " << textFile.getPath().get();
@@ -427,13 +488,6 @@ namespace djv
             try
             {
                 const auto& path = textFile.getPath();
-                const auto& baseName = path.getBaseName();
-                std::string locale;
-                for (auto j = baseName.rbegin(); j != baseName.rend() && *j != '.'; ++j)
-                {
-                    locale.insert(locale.begin(), *j);
-                }
-
                 FileSystem::FileIO fileIO;
                 fileIO.open(std::string(path), FileSystem::FileIO::Mode::Read);
 #if defined(DJV_MMAP)
@@ -467,7 +521,6 @@ namespace djv
                         {
                             std::string id;
                             std::string text;
-                            std::string description;
                             const auto& obj = item.get<picojson::object>();
                             for (auto i = obj.begin(); i != obj.end(); ++i)
                             {
@@ -479,14 +532,10 @@ namespace djv
                                 {
                                     text = i->second.to_str();
                                 }
-                                else if ("description" == i->first)
-                                {
-                                    description = i->second.to_str();
-                                }
                             }
                             if (!id.empty())
                             {
-                                out[locale][id] = text;
+                                out[ResourceBundle::getTextHash(id)] = text;
                             }
                         }
                     }
@@ -496,9 +545,27 @@ namespace djv
             {
                 p.logSystem->log(getSystemName(), e.what(), LogLevel::Error);
             }
-            return out;
+        }
+
+        void TextSystem::_reload()
+        {
+            DJV_PRIVATE_PTR();
+            p.logSystem->log(getSystemName(), "Reloading text");
+            p.textFiles = _getTextFiles();
+            std::vector<std::string> locales;
+            for (const auto& i : p.text)
+            {
+                locales.push_back(i.first);
+            }
+            p.text.clear();
+            for (const auto& i : locales)
+            {
+                _load(i);
+            }
+            p.currentText = &_load(p.currentLocale->get());
+            p.fallbackText = &_load(fallbackLocale);
+            p.textChanged->setAlways(true);
         }
 
     } // namespace Core
 } // namespace djv
-
@@ -32,7 +32,7 @@
 #include <djvCore/ISystem.h>
 #include <djvCore/ValueObserver.h>
 
-#include <map>
+#include <unordered_map>
 
 namespace djv
 {
@@ -41,6 +41,7 @@ namespace djv
         namespace FileSystem
         {
             class FileInfo;
+            class Path;
         
         } // namespace FileSystem
 
@@ -55,6 +56,13 @@ namespace djv
         //! - FileSystem::ResourcePath::Documents
         //! - DJV_TEXT environment variable, a list of colon (Linux/OSX) or
         //!   semicolon (Windows) separated paths to search
+        //!
+        //! Only the current locale and the English fallback are loaded; other
+        //! locales are loaded when they are first made current.
+        //!
+        //! Text files are not reloaded when they change unless hot reload is
+        //! enabled, either with setHotReload() or the DJV_TEXT_RELOAD
+        //! environment variable.
         class TextSystem : public ISystemBase
         {
             DJV_NON_COPYABLE(TextSystem);
@@ -81,6 +89,9 @@ namespace djv
             //! Set the current locale.
             void setCurrentLocale(const std::string &);
 
+            //! Get the locales that have been loaded.
+            std::vector<std::string> getLoadedLocales() const;
+
             ///@}
 
             //! \name Text
@@ -94,11 +105,28 @@ namespace djv
 
             ///@}
 
+            //! \name Hot Reload
+            ///@{
+
+            //! Get whether text files are reloaded when they change.
+            bool hasHotReload() const;
+
+            //! Set whether text files are reloaded when they change. This is
+            //! intended for editing translations. When hot reload is enabled
+            //! the files in FileSystem::ResourcePath::Text are also loaded if
+            //! there is a resource bundle, and override the bundled text.
+            void setHotReload(bool);
+
+            ///@}
+
         private:
+            typedef std::unordered_map<uint64_t, std::string> TextMap;
+
+            std::vector<FileSystem::Path> _getTextPaths() const;
             std::vector<FileSystem::FileInfo> _getTextFiles() const;
-            void _reload(const FileSystem::FileInfo&);
-            typedef std::map<std::string, std::map<std::string, std::string> > TextMap;
-            TextMap _readText(const FileSystem::FileInfo&);
+            const TextMap& _load(const std::string& locale);
+            void _readText(const FileSystem::FileInfo&, TextMap&);
+            void _reload();
 
             DJV_PRIVATE();
         };
@@ -49,7 +49,9 @@ void wrapFileInfo(pybind11::module& m)
     py::enum_<FileSystem::DirectoryListSort>(m, "DirectoryListSort")
         .value("Name", FileSystem::DirectoryListSort::Name)
         .value("Size", FileSystem::DirectoryListSort::Size)
-        .value("Time", FileSystem::DirectoryListSort::Time);
+        .value("Time", FileSystem::DirectoryListSort::Time)
+        .value("Permissions", FileSystem::DirectoryListSort::Permissions)
+        .value("Natural", FileSystem::DirectoryListSort::Natural);
 
     py::class_<FileSystem::DirectoryListOptions>(m, "DirectoryListOptions")
         .def(py::init<>())
@@ -68,12 +68,27 @@ void wrapFrame(pybind11::module& m)
         .def(py::init<>())
         .def(py::init<const Frame::Range&, size_t>(), py::arg("range"), py::arg("pad") = 0)
         .def(py::init<const std::vector<Frame::Range>&, size_t>(), py::arg("ranges"), py::arg("pad") = 0)
-        .def_readwrite("ranges", &Frame::Sequence::ranges)
+        .def_property(
+            "ranges",
+            [](const Frame::Sequence& value)
+            {
+                return value.getRanges();
+            },
+            [](Frame::Sequence& value, const std::vector<Frame::Range>& ranges)
+            {
+                value.setRanges(ranges);
+            })
         .def_readwrite("pad", &Frame::Sequence::pad)
         .def("isValid", &Frame::Sequence::isValid)
+        .def("contains", &Frame::Sequence::contains)
         .def("getSize", &Frame::Sequence::getSize)
         .def("getFrame", &Frame::Sequence::getFrame)
+        .def("getIndex", &Frame::Sequence::getIndex)
+        .def("getFrames", &Frame::Sequence::getFrames)
         .def("sort", &Frame::Sequence::sort)
+        .def("merge", &Frame::Sequence::merge)
+        .def("add", &Frame::Sequence::add)
+        .def("updateIndex", &Frame::Sequence::updateIndex)
         .def(py::self == py::self)
         .def(py::self != py::self);
 
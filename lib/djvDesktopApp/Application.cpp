@@ -35,9 +35,13 @@
 #include <djvUI/UISystem.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/AudioSystem.h>
+#include <djvAV/FontSystem.h>
 #include <djvAV/GLFWSystem.h>
 #include <djvAV/IO.h>
+#include <djvAV/OCIOSystem.h>
 #include <djvAV/Render2D.h>
+#include <djvAV/ThumbnailSystem.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -67,6 +71,17 @@ namespace djv
         {
             Context::_init(args);
             auto avSystem = AV::AVSystem::create(shared_from_this());
+
+            // Interactive applications use the whole AV library, so create
+            // the systems up front in dependency order.
+            getSystemT<AV::GLFW::System>();
+            getSystemT<AV::OCIO::System>();
+            getSystemT<AV::IO::System>();
+            getSystemT<AV::Font::System>();
+            getSystemT<AV::ThumbnailSystem>();
+            getSystemT<AV::Render::Render2D>();
+            getSystemT<AV::Audio::System>();
+
             auto glfwSystem = GLFWSystem::create(shared_from_this());
             auto uiSystem = UI::UISystem::create(shared_from_this());
             auto avGLFWSystem = getSystemT<AV::GLFW::System>();
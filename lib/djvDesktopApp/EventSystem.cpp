@@ -126,10 +126,10 @@ namespace djv
 
 #if defined(DJV_OPENGL_ES2)
             auto resourceSystem = context->getSystemT<ResourceSystem>();
-            const Core::FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
             p.shader = AV::OpenGL::Shader::create(AV::Render::Shader::create(
-                Core::FileSystem::Path(shaderPath, "djvAVRender2DVertex.glsl"),
-                Core::FileSystem::Path(shaderPath, "djvAVRender2DFragment.glsl")));
+                resourceSystem,
+                "djvAVRender2DVertex.glsl",
+                "djvAVRender2DFragment.glsl"));
 #endif // DJV_OPENGL_ES2
 
             glfwGetFramebufferSize(glfwWindow, &p.resize.x, &p.resize.y);
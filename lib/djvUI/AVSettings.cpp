@@ -54,6 +54,12 @@ namespace djv
                 std::shared_ptr<djv::AV::AVSystem> avSystem;
                 std::shared_ptr<djv::AV::Render::Render2D> renderSystem;
                 std::shared_ptr<djv::AV::IO::System> ioSystem;
+                std::shared_ptr<ValueObserver<djv::AV::TimeUnits> > timeUnitsObserver;
+                std::shared_ptr<ValueObserver<djv::AV::AlphaBlend> > alphaBlendObserver;
+                std::shared_ptr<ValueObserver<Time::FPS> > defaultSpeedObserver;
+                std::shared_ptr<ValueObserver<djv::AV::Render::ImageFilterOptions> > imageFilterOptionsObserver;
+                std::shared_ptr<ValueObserver<bool> > lcdTextObserver;
+                std::shared_ptr<ValueObserver<bool> > ioOptionsChangedObserver;
             };
 
             void AV::_init(const std::shared_ptr<Core::Context>& context)
@@ -64,6 +70,62 @@ namespace djv
                 p.renderSystem = context->getSystemT<djv::AV::Render::Render2D>();
                 p.ioSystem = context->getSystemT<djv::AV::IO::System>();
                 _load();
+
+                auto weak = std::weak_ptr<AV>(std::dynamic_pointer_cast<AV>(shared_from_this()));
+                p.timeUnitsObserver = ValueObserver<djv::AV::TimeUnits>::create(
+                    p.avSystem->observeTimeUnits(),
+                    [weak](djv::AV::TimeUnits)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
+                p.alphaBlendObserver = ValueObserver<djv::AV::AlphaBlend>::create(
+                    p.avSystem->observeAlphaBlend(),
+                    [weak](djv::AV::AlphaBlend)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
+                p.defaultSpeedObserver = ValueObserver<Time::FPS>::create(
+                    p.avSystem->observeDefaultSpeed(),
+                    [weak](Time::FPS)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
+                p.imageFilterOptionsObserver = ValueObserver<djv::AV::Render::ImageFilterOptions>::create(
+                    p.avSystem->observeImageFilterOptions(),
+                    [weak](const djv::AV::Render::ImageFilterOptions&)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
+                p.lcdTextObserver = ValueObserver<bool>::create(
+                    p.avSystem->observeLCDText(),
+                    [weak](bool)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
+                p.ioOptionsChangedObserver = ValueObserver<bool>::create(
+                    p.ioSystem->observeOptionsChanged(),
+                    [weak](bool)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
             }
 
             AV::AV() :
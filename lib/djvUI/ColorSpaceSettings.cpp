@@ -120,6 +120,7 @@ namespace djv
                         if (auto settings = weak.lock())
                         {
                             settings->_p->configs = value;
+                            settings->_changed();
                         }
                     });
                 p.currentIndexObserver = ValueObserver<int>::create(
@@ -129,6 +130,7 @@ namespace djv
                         if (auto settings = weak.lock())
                         {
                             settings->_p->currentIndex = value;
+                            settings->_changed();
                         }
                     });
             }
@@ -116,7 +116,7 @@ namespace djv
             {
                 auto uiSystem = context->getSystemT<UISystem>();
                 auto style = uiSystem->getStyle();
-                if (style->isDirty())
+                if (style->isLayoutDirty())
                 {
                     Event::Init initEvent;
                     for (auto i : p.windows)
@@ -128,6 +128,19 @@ namespace djv
                     }
                     style->setClean();
                 }
+                else if (style->isDirty())
+                {
+                    // Palette changes do not affect the layout, the colors are
+                    // read when the widgets are drawn.
+                    for (auto i : p.windows)
+                    {
+                        if (auto window = i.lock())
+                        {
+                            window->_redraw();
+                        }
+                    }
+                    style->setClean();
+                }
                 auto i = p.windows.begin();
                 while (i != p.windows.end())
                 {
@@ -47,6 +47,7 @@ namespace djv
             struct General::Private
             {
                 std::shared_ptr<TextSystem> textSystem;
+                std::shared_ptr<ValueObserver<std::string> > currentLocaleObserver;
             };
 
             void General::_init(const std::shared_ptr<Core::Context>& context)
@@ -55,6 +56,17 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 p.textSystem = context->getSystemT<TextSystem>();
                 _load();
+
+                auto weak = std::weak_ptr<General>(std::dynamic_pointer_cast<General>(shared_from_this()));
+                p.currentLocaleObserver = ValueObserver<std::string>::create(
+                    p.textSystem->observeCurrentLocale(),
+                    [weak](const std::string&)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            settings->_changed();
+                        }
+                    });
             }
 
             General::General() :
@@ -87,6 +87,17 @@ namespace djv
                 }
             }
 
+            void ISettings::_changed()
+            {
+                if (auto context = _p->context.lock())
+                {
+                    if (auto system = context->getSystemT<System>())
+                    {
+                        system->_settingsChanged();
+                    }
+                }
+            }
+
         } // namespace Settings
     } // namespace UI
 } // namespace djv
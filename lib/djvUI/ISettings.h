@@ -72,6 +72,11 @@ namespace djv
                 //! \todo This function needs to be called by derived classes at the end of their _init() function.
                 void _load();
 
+                //! Notify the settings system that the settings have changed so
+                //! that they are saved. This function needs to be called by
+                //! derived classes when a setting is changed.
+                void _changed();
+
             private:
                 DJV_PRIVATE();
             };
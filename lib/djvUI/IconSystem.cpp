@@ -38,10 +38,12 @@
 #include <djvCore/FileInfo.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/ResourceBundle.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/Timer.h>
 
 #include <atomic>
+#include <set>
 #include <thread>
 
 using namespace djv::Core;
@@ -62,6 +64,7 @@ namespace djv
 
                 ImageRequest(ImageRequest && other) :
                     path(other.path),
+                    bundleName(std::move(other.bundleName)),
                     read(std::move(other.read)),
                     promise(std::move(other.promise))
                 {}
@@ -74,6 +77,7 @@ namespace djv
                     if (this != &other)
                     {
                         path = other.path;
+                        bundleName = std::move(other.bundleName);
                         read = std::move(other.read);
                         promise = std::move(other.promise);
                     }
@@ -81,6 +85,7 @@ namespace djv
                 }
 
                 FileSystem::Path path;
+                std::string bundleName;
                 std::shared_ptr<AV::IO::IRead> read;
                 std::promise<std::shared_ptr<AV::Image::Image> > promise;
             };
@@ -112,7 +117,9 @@ namespace djv
             std::thread thread;
             std::atomic<bool> running;
 
+            static std::string getFileName(const std::string & name, uint16_t dpi);
             FileSystem::Path getPath(const std::string & name, uint16_t dpi, const std::shared_ptr<ResourceSystem>&) const;
+            std::shared_ptr<AV::Image::Image> getBundleImage(const std::string & bundleName) const;
             uint16_t findClosestDPI(uint16_t) const;
         };
 
@@ -130,6 +137,24 @@ namespace djv
             p.imageCache.setMax(imageCacheMax);
             p.imageCachePercentage = 0.F;
 
+            // Find the DPI values in the resource bundle. The icons in the
+            // bundle are already decoded so they don't need to go through
+            // the I/O system.
+            if (auto bundle = p.resourceSystem->getBundle())
+            {
+                const std::string iconsName = ResourceSystem::getBundleName(FileSystem::ResourcePath::Icons, std::string());
+                std::set<uint16_t> dpiSet;
+                for (const auto& i : bundle->getNames(iconsName))
+                {
+                    const size_t size = i.find("DPI/", iconsName.size());
+                    if (size != std::string::npos && size > iconsName.size())
+                    {
+                        dpiSet.insert(std::stoi(i.substr(iconsName.size(), size - iconsName.size())));
+                    }
+                }
+                p.dpiList = std::vector<uint16_t>(dpiSet.begin(), dpiSet.end());
+            }
+
             p.statsTimer = Time::Timer::create(context);
             p.statsTimer->setRepeating(true);
             p.statsTimer->start(
@@ -152,16 +177,19 @@ namespace djv
                 try
                 {
                     // Find the DPI values.
-                    for (const auto & i : FileSystem::FileInfo::directoryList(p.resourceSystem->getPath(FileSystem::ResourcePath::Icons)))
+                    if (p.dpiList.empty())
                     {
-                        const std::string fileName = i.getFileName(Frame::invalid, false);
-                        const size_t size = fileName.size();
-                        if (size > 3 &&
-                            fileName[size - 3] == 'D' &&
-                            fileName[size - 2] == 'P' &&
-                            fileName[size - 1] == 'I')
+                        for (const auto & i : FileSystem::FileInfo::directoryList(p.resourceSystem->getPath(FileSystem::ResourcePath::Icons)))
                         {
-                            p.dpiList.push_back(std::stoi(fileName.substr(0, size - 3)));
+                            const std::string fileName = i.getFileName(Frame::invalid, false);
+                            const size_t size = fileName.size();
+                            if (size > 3 &&
+                                fileName[size - 3] == 'D' &&
+                                fileName[size - 2] == 'P' &&
+                                fileName[size - 1] == 'I')
+                            {
+                                p.dpiList.push_back(std::stoi(fileName.substr(0, size - 3)));
+                            }
                         }
                     }
                     std::sort(p.dpiList.begin(), p.dpiList.end());
@@ -227,7 +255,9 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             ImageRequest request;
-            request.path = p.getPath(name, p.findClosestDPI(size), p.resourceSystem);
+            const uint16_t dpi = p.findClosestDPI(size);
+            request.path = p.getPath(name, dpi, p.resourceSystem);
+            request.bundleName = ResourceSystem::getBundleName(FileSystem::ResourcePath::Icons, p.getFileName(name, dpi));
             auto future = request.promise.get_future();
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
@@ -253,6 +283,15 @@ namespace djv
                 std::shared_ptr<AV::Image::Image> image;
                 p.imageCache.get(key, image);
                 if (!image)
+                {
+                    image = p.getBundleImage(i.bundleName);
+                    if (image)
+                    {
+                        p.imageCache.add(key, image);
+                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                    }
+                }
+                if (!image)
                 {
                     try
                     {
@@ -333,6 +372,13 @@ namespace djv
             }
         }
 
+        std::string IconSystem::Private::getFileName(const std::string & name, uint16_t dpi)
+        {
+            std::stringstream ss;
+            ss << dpi << "DPI/" << name << ".png";
+            return ss.str();
+        }
+
         FileSystem::Path IconSystem::Private::getPath(const std::string & name, uint16_t dpi, const std::shared_ptr<ResourceSystem>& resourceSystem) const
         {
             FileSystem::Path out = resourceSystem->getPath(FileSystem::ResourcePath::Icons);
@@ -349,6 +395,25 @@ namespace djv
             return out;
         }
 
+        std::shared_ptr<AV::Image::Image> IconSystem::Private::getBundleImage(const std::string & bundleName) const
+        {
+            std::shared_ptr<AV::Image::Image> out;
+            if (auto bundle = resourceSystem->getBundle())
+            {
+                const auto entry = bundle->getEntry(bundleName);
+                if (entry && ResourceBundle::EntryType::Image == entry->type)
+                {
+                    const AV::Image::Info info(entry->width, entry->height, AV::Image::Type::RGBA_U8);
+                    if (info.getDataByteCount() == entry->size)
+                    {
+                        out = AV::Image::Image::create(info);
+                        memcpy(out->getData(), bundle->getData(*entry), entry->size);
+                    }
+                }
+            }
+            return out;
+        }
+
         uint16_t IconSystem::Private::findClosestDPI(uint16_t value) const
         {
             const uint16_t dpi = static_cast<uint16_t>(value / static_cast<float>(Style::iconSizeDefault) * static_cast<float>(AV::dpiDefault));
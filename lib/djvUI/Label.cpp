@@ -63,6 +63,7 @@ namespace djv
             std::future<glm::vec2> sizeStringFuture;
             std::vector<std::shared_ptr<AV::Font::Glyph> > glyphs;
             std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > glyphsFuture;
+            size_t styleGeneration = std::numeric_limits<size_t>::max();
         };
 
         void Label::_init(const std::shared_ptr<Context>& context)
@@ -265,7 +266,10 @@ namespace djv
         void Label::_initEvent(Event::Init& event)
         {
             Widget::_initEvent(event);
-            _textUpdate();
+            if (_getStyle()->getGeneration() != _p->styleGeneration)
+            {
+                _textUpdate();
+            }
         }
 
         void Label::_updateEvent(Event::Update& event)
@@ -330,6 +334,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             const auto& style = _getStyle();
+            p.styleGeneration = style->getGeneration();
             const auto fontInfo = p.font.empty() ?
                 style->getFontInfo(p.fontFace, p.fontSizeRole) :
                 style->getFontInfo(p.font, p.fontFace, p.fontSizeRole);
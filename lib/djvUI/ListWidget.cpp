@@ -29,10 +29,13 @@
 
 #include <djvUI/ListWidget.h>
 
-#include <djvUI/ButtonGroup.h>
 #include <djvUI/ListButton.h>
-#include <djvUI/RowLayout.h>
 #include <djvUI/ScrollWidget.h>
+#include <djvUI/Style.h>
+
+#include <djvAV/FontSystem.h>
+
+#include <djvCore/Context.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -43,12 +46,318 @@ namespace djv
 {
     namespace UI
     {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t overscan = 4;
+
+            //! \todo Should this be configurable?
+            const size_t initialRows = 16;
+
+            //! This widget only creates buttons for the rows that are visible
+            //! in the scroll area, plus a few rows of overscan. The buttons are
+            //! recycled as the view is scrolled. The text of every item is
+            //! measured when it is added and when the style changes, so the
+            //! width of the list comes from the widest item whether or not it
+            //! has been shown.
+            class ListView : public Widget
+            {
+                DJV_NON_COPYABLE(ListView);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                ListView();
+
+            public:
+                static std::shared_ptr<ListView> create(const std::shared_ptr<Context>&);
+
+                void setItems(const std::vector<std::string>&);
+                void addItem(const std::string&);
+                void setCurrentItem(int);
+                void setCallback(const std::function<void(int)>&);
+
+                float getRowHeight() const { return _rowHeight; }
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _layoutEvent(Event::Layout&) override;
+
+                void _initEvent(Event::Init&) override;
+                void _updateEvent(Event::Update&) override;
+
+            private:
+                void _textWidthsUpdate();
+                void _measure(size_t index);
+                void _buttonsUpdate(size_t count);
+                void _rowsUpdate();
+
+                std::shared_ptr<AV::Font::System> _fontSystem;
+                std::vector<std::string> _items;
+                std::vector<float> _textWidths;
+                std::map<size_t, std::future<glm::vec2> > _textWidthFutures;
+                float _textWidthMax = 0.F;
+                size_t _styleGeneration = std::numeric_limits<size_t>::max();
+                int _currentItem = -1;
+                std::vector<std::shared_ptr<ListButton> > _buttons;
+                size_t _firstRow = 0;
+                float _rowWidth = 0.F;
+                float _rowHeight = 0.F;
+                std::function<void(int)> _callback;
+            };
+
+            void ListView::_init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::UI::ListView");
+                _fontSystem = context->getSystemT<AV::Font::System>();
+            }
+
+            ListView::ListView()
+            {}
+
+            std::shared_ptr<ListView> ListView::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<ListView>(new ListView);
+                out->_init(context);
+                return out;
+            }
+
+            void ListView::setItems(const std::vector<std::string>& value)
+            {
+                _items = value;
+                _firstRow = 0;
+                _textWidthsUpdate();
+                _rowsUpdate();
+                _resize();
+            }
+
+            void ListView::addItem(const std::string& value)
+            {
+                _items.push_back(value);
+                _textWidths.push_back(0.F);
+                _measure(_items.size() - 1);
+                _rowsUpdate();
+                _resize();
+            }
+
+            void ListView::setCurrentItem(int value)
+            {
+                if (value == _currentItem)
+                    return;
+                _currentItem = value;
+                _rowsUpdate();
+            }
+
+            void ListView::setCallback(const std::function<void(int)>& value)
+            {
+                _callback = value;
+            }
+
+            void ListView::_preLayoutEvent(Event::PreLayout&)
+            {
+                // The rows all share the same height, so measure the buttons
+                // that are currently realized. The width is the widest item text
+                // plus the space the buttons use around their text.
+                float rowWidth = 0.F;
+                float rowHeight = 0.F;
+                size_t row = _firstRow;
+                for (const auto& i : _buttons)
+                {
+                    if (i->isVisible())
+                    {
+                        const glm::vec2& size = i->getMinimumSize();
+                        const float textWidth = row < _textWidths.size() ? _textWidths[row] : 0.F;
+                        rowWidth = std::max(rowWidth, std::max(size.x - textWidth, 0.F) + _textWidthMax);
+                        rowWidth = std::max(rowWidth, size.x);
+                        rowHeight = std::max(rowHeight, size.y);
+                    }
+                    ++row;
+                }
+                _rowWidth = rowWidth;
+                if (rowHeight > 0.F)
+                {
+                    _rowHeight = rowHeight;
+                }
+                _setMinimumSize(glm::vec2(_rowWidth, _rowHeight * _items.size()));
+            }
+
+            void ListView::_layoutEvent(Event::Layout&)
+            {
+                const BBox2f& g = getGeometry();
+
+                // Find the rows that are visible in the scroll area.
+                size_t count = std::min(initialRows, _items.size());
+                if (_rowHeight > 0.F)
+                {
+                    BBox2f visible = g;
+                    if (auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock()))
+                    {
+                        visible = g.intersect(parent->getGeometry());
+                    }
+                    size_t first = 0;
+                    size_t last = 0;
+                    if (visible.isValid() && _items.size())
+                    {
+                        first = static_cast<size_t>(std::max((visible.min.y - g.min.y) / _rowHeight, 0.F));
+                        last = static_cast<size_t>(std::max(ceilf((visible.max.y - g.min.y) / _rowHeight), 0.F));
+                        first = std::min(first, _items.size() - 1);
+                        last = std::min(last, _items.size());
+                    }
+                    const size_t firstRow = first > overscan ? first - overscan : 0;
+                    count = std::min(last + overscan, _items.size()) - std::min(firstRow, _items.size());
+                    if (firstRow != _firstRow || count > _buttons.size())
+                    {
+                        _firstRow = firstRow;
+                        _buttonsUpdate(count);
+                        _rowsUpdate();
+                    }
+                }
+                else if (count > _buttons.size())
+                {
+                    _buttonsUpdate(count);
+                    _rowsUpdate();
+                }
+
+                size_t row = _firstRow;
+                for (const auto& i : _buttons)
+                {
+                    if (i->isVisible())
+                    {
+                        i->setGeometry(BBox2f(g.min.x, g.min.y + _rowHeight * row, g.w(), _rowHeight));
+                    }
+                    ++row;
+                }
+            }
+
+            void ListView::_initEvent(Event::Init& event)
+            {
+                Widget::_initEvent(event);
+                if (_getStyle()->getGeneration() != _styleGeneration)
+                {
+                    _textWidthsUpdate();
+                    _resize();
+                }
+            }
+
+            void ListView::_updateEvent(Event::Update&)
+            {
+                bool resize = false;
+                auto i = _textWidthFutures.begin();
+                while (i != _textWidthFutures.end())
+                {
+                    if (i->second.valid() &&
+                        i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        try
+                        {
+                            const float width = i->second.get().x;
+                            if (i->first < _textWidths.size())
+                            {
+                                _textWidths[i->first] = width;
+                            }
+                            if (width > _textWidthMax)
+                            {
+                                _textWidthMax = width;
+                                resize = true;
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _log(e.what(), LogLevel::Error);
+                        }
+                        i = _textWidthFutures.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (resize)
+                {
+                    _resize();
+                }
+            }
+
+            void ListView::_textWidthsUpdate()
+            {
+                _styleGeneration = _getStyle()->getGeneration();
+                _textWidths = std::vector<float>(_items.size(), 0.F);
+                _textWidthFutures.clear();
+                _textWidthMax = 0.F;
+                for (size_t i = 0; i < _items.size(); ++i)
+                {
+                    _measure(i);
+                }
+            }
+
+            void ListView::_measure(size_t index)
+            {
+                // Use the same font as the list buttons.
+                const auto& style = _getStyle();
+                const auto fontInfo = style->getFontInfo(std::string(), MetricsRole::FontMedium);
+                _textWidthFutures[index] = _fontSystem->measure(_items[index], fontInfo);
+            }
+
+            void ListView::_buttonsUpdate(size_t count)
+            {
+                // Buttons are only ever added to the pool, rows that are not
+                // needed are hidden and recycled later.
+                if (auto context = getContext().lock())
+                {
+                    auto weak = std::weak_ptr<ListView>(std::dynamic_pointer_cast<ListView>(shared_from_this()));
+                    while (_buttons.size() < count)
+                    {
+                        const size_t index = _buttons.size();
+                        auto button = ListButton::create(context);
+                        button->setButtonType(ButtonType::Radio);
+                        button->setCheckedCallback(
+                            [weak, index](bool value)
+                            {
+                                if (value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        const int item = static_cast<int>(widget->_firstRow + index);
+                                        widget->setCurrentItem(item);
+                                        if (widget->_callback)
+                                        {
+                                            widget->_callback(item);
+                                        }
+                                    }
+                                }
+                            });
+                        addChild(button);
+                        _buttons.push_back(button);
+                    }
+                }
+            }
+
+            void ListView::_rowsUpdate()
+            {
+                size_t row = _firstRow;
+                for (const auto& i : _buttons)
+                {
+                    if (row < _items.size())
+                    {
+                        i->setText(_items[row]);
+                        i->setChecked(static_cast<int>(row) == _currentItem);
+                        i->show();
+                    }
+                    else
+                    {
+                        i->hide();
+                    }
+                    ++row;
+                }
+            }
+
+        } // namespace
+
         struct ListWidget::Private
         {
             std::vector<std::string> items;
             int currentItem = -1;
-            std::shared_ptr<ButtonGroup> buttonGroup;
-            std::shared_ptr<VerticalLayout> layout;
+            std::shared_ptr<ListView> view;
             std::shared_ptr<ScrollWidget> scrollWidget;
             std::function<void(int)> callback;
         };
@@ -60,19 +369,16 @@ namespace djv
             DJV_PRIVATE_PTR();
             setClassName("djv::UI::ListWidget");
 
-            p.buttonGroup = ButtonGroup::create(ButtonType::Radio);
-
-            p.layout = VerticalLayout::create(context);
-            p.layout->setSpacing(Layout::Spacing(MetricsRole::None));
+            p.view = ListView::create(context);
 
             p.scrollWidget = ScrollWidget::create(ScrollType::Vertical, context);
-            p.scrollWidget->addChild(p.layout);
+            p.scrollWidget->addChild(p.view);
             addChild(p.scrollWidget);
 
             _updateCurrentItem(Callback::Suppress);
 
             auto weak = std::weak_ptr<ListWidget>(std::dynamic_pointer_cast<ListWidget>(shared_from_this()));
-            p.buttonGroup->setRadioCallback(
+            p.view->setCallback(
                 [weak](int value)
             {
                 if (auto widget = weak.lock())
@@ -117,14 +423,8 @@ namespace djv
         void ListWidget::addItem(const std::string & value)
         {
             DJV_PRIVATE_PTR();
-            if (auto context = getContext().lock())
-            {
-                p.items.push_back(value);
-                auto button = ListButton::create(context);
-                button->setText(value);
-                p.buttonGroup->addButton(button);
-                p.layout->addChild(button);
-            }
+            p.items.push_back(value);
+            p.view->addItem(value);
         }
 
         void ListWidget::clearItems(Callback callback)
@@ -249,9 +549,9 @@ namespace djv
                     nextItem(Callback::Trigger);
                     break;
                 }
-                if (currentItem != p.currentItem && p.callback)
+                if (currentItem != p.currentItem)
                 {
-                    p.callback(p.currentItem);
+                    _scrollToCurrentItem();
                 }
             }
         }
@@ -259,30 +559,39 @@ namespace djv
         void ListWidget::_updateItems()
         {
             DJV_PRIVATE_PTR();
-            if (auto context = getContext().lock())
-            {
-                p.buttonGroup->clearButtons();
-                p.layout->clearChildren();
-                for (const auto& i : p.items)
-                {
-                    auto button = ListButton::create(context);
-                    button->setText(i);
-                    p.buttonGroup->addButton(button);
-                    p.layout->addChild(button);
-                }
-            }
+            p.view->setItems(p.items);
         }
 
         void ListWidget::_updateCurrentItem(Callback callback)
         {
             DJV_PRIVATE_PTR();
-            if (p.currentItem >= 0 && p.currentItem < p.items.size())
+            p.view->setCurrentItem(p.currentItem);
+            if (Callback::Trigger == callback && p.callback)
             {
-                p.buttonGroup->setChecked(p.currentItem, true, callback);
+                p.callback(p.currentItem);
             }
-            else
+        }
+
+        void ListWidget::_scrollToCurrentItem()
+        {
+            DJV_PRIVATE_PTR();
+            const float rowHeight = p.view->getRowHeight();
+            if (p.currentItem >= 0 && rowHeight > 0.F)
             {
-                p.buttonGroup->setChecked(-1, true, callback);
+                const BBox2f& g = p.view->getGeometry();
+                const BBox2f& clipRect = p.view->getClipRect();
+                const float y0 = g.min.y + rowHeight * p.currentItem;
+                const float y1 = y0 + rowHeight;
+                glm::vec2 scrollPos = p.scrollWidget->getScrollPos();
+                if (y0 < clipRect.min.y)
+                {
+                    scrollPos.y -= clipRect.min.y - y0;
+                }
+                else if (y1 > clipRect.max.y)
+                {
+                    scrollPos.y += y1 - clipRect.max.y;
+                }
+                p.scrollWidget->setScrollPos(scrollPos);
             }
         }
 
@@ -37,8 +37,10 @@ namespace djv
     {
         //! This class provides a list widget.
         //!
+        //! Only the visible rows are realized as widgets, so the list can hold
+        //! a very large number of items.
+        //!
         //! \todo Add support for icons. Should we use actions instead of items?
-        //! \todo Keep the current item visible in the scroll widget.
         class ListWidget : public Widget
         {
             DJV_NON_COPYABLE(ListWidget);
@@ -75,6 +77,7 @@ namespace djv
         private:
             void _updateItems();
             void _updateCurrentItem(Callback);
+            void _scrollToCurrentItem();
 
             DJV_PRIVATE();
         };
@@ -73,6 +73,7 @@ namespace djv
             protected:
                 void _preLayoutEvent(Event::PreLayout &) override;
                 void _layoutEvent(Event::Layout &) override;
+                void _clipEvent(Event::Clip &) override;
                 void _paintEvent(Event::Paint &) override;
                 void _pointerEnterEvent(Event::PointerEnter &) override;
                 void _pointerLeaveEvent(Event::PointerLeave &) override;
@@ -93,7 +94,6 @@ namespace djv
                     std::shared_ptr<AV::Image::Image> icon;
                     std::string text;
                     std::string font;
-                    AV::Font::Metrics fontMetrics;
                     glm::vec2 textSize = glm::vec2(0.F, 0.F);
                     std::vector<std::shared_ptr<AV::Font::Glyph> > textGlyphs;
                     std::string shortcutLabel;
@@ -105,8 +105,10 @@ namespace djv
                 };
 
                 std::shared_ptr<Item> _getItem(const glm::vec2 &) const;
+                AV::Font::Info _getFontInfo(const std::shared_ptr<Item>&) const;
                 void _itemsUpdate();
                 void _textUpdate();
+                void _glyphsUpdate(const BBox2f& clipRect);
 
                 std::shared_ptr<AV::Font::System> _fontSystem;
                 std::map<size_t, std::shared_ptr<Action> > _actions;
@@ -117,7 +119,13 @@ namespace djv
                 std::map<std::shared_ptr<Item>, std::shared_ptr<Action> > _itemToAction;
                 std::map<std::shared_ptr<Item>, bool> _hasIcon;
                 std::map<std::shared_ptr<Item>, std::future<std::shared_ptr<AV::Image::Image> > > _iconFutures;
-                std::map<std::shared_ptr<Item>, std::future<AV::Font::Metrics> > _fontMetricsFutures;
+                size_t _actionCount = 0;
+                size_t _dividerCount = 0;
+                glm::vec2 _textSizeMax = glm::vec2(0.F, 0.F);
+                glm::vec2 _shortcutSizeMax = glm::vec2(0.F, 0.F);
+                glm::vec2 _itemSize = glm::vec2(0.F, 0.F);
+                std::map<std::string, AV::Font::Metrics> _fontMetrics;
+                std::map<std::string, std::future<AV::Font::Metrics> > _fontMetricsFutures;
                 std::map<std::shared_ptr<Item>, std::future<glm::vec2> > _textSizeFutures;
                 std::map<std::shared_ptr<Item>, std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > > _textGlyphsFutures;
                 std::map<std::shared_ptr<Item>, std::future<glm::vec2> > _shortcutSizeFutures;
@@ -172,23 +180,10 @@ namespace djv
                 const float is = style->getMetric(MetricsRole::Icon);
                 const float iss = style->getMetric(MetricsRole::IconSmall);
 
-                glm::vec2 textSize(0.F, 0.F);
-                glm::vec2 shortcutSize(0.F, 0.F);
-                for (const auto & i : _items)
-                {
-                    const auto j = _itemToAction.find(i.second);
-                    if (j != _itemToAction.end() && j->second)
-                    {
-                        textSize.x = std::max(textSize.x, i.second->textSize.x);
-                        textSize.y = std::max(textSize.y, i.second->textSize.y);
-                    }
-                    if (!i.second->shortcutLabel.empty())
-                    {
-                        shortcutSize.x = std::max(shortcutSize.x, i.second->shortcutSize.x);
-                        shortcutSize.y = std::max(shortcutSize.y, i.second->shortcutSize.y);
-                    }
-                }
-
+                // The maximum text and shortcut sizes are updated as the sizes
+                // are measured, so the items are not visited here.
+                const glm::vec2& textSize = _textSizeMax;
+                const glm::vec2& shortcutSize = _shortcutSizeMax;
                 glm::vec2 itemSize(0.F, 0.F);
                 itemSize.x += iss + m * 2.F;
                 itemSize.y = std::max(itemSize.y, iss + m * 2.F);
@@ -205,38 +200,25 @@ namespace djv
                     itemSize.y = std::max(itemSize.y, shortcutSize.y + m * 2.F);
                 }
 
-                std::map<size_t, glm::vec2> sizes;
-                for (auto & i : _items)
-                {
-                    glm::vec2 size(0.F, 0.F);
-                    const auto j = _itemToAction.find(i.second);
-                    if (j != _itemToAction.end() && j->second)
-                    {
-                        size = itemSize + m * 2.F;
-                    }
-                    else
-                    {
-                        size = glm::vec2(b, b);
-                    }
-                    i.second->size = size;
-                    sizes[i.first] = size;
-                }
-
+                // The action items all have the same size and the dividers are
+                // the border width.
+                _itemSize = itemSize + m * 2.F;
                 glm::vec2 size(0.F, 0.F);
-                for (const auto & i : sizes)
-                {
-                    size.x = std::max(size.x, i.second.x);
-                    size.y += i.second.y;
-                }
+                size.x = _actionCount ? _itemSize.x : (_dividerCount ? b : 0.F);
+                size.y = _itemSize.y * _actionCount + b * _dividerCount;
                 _setMinimumSize(size);
             }
 
             void MenuWidget::_layoutEvent(Event::Layout &)
             {
                 const BBox2f & g = getGeometry();
+                const auto& style = _getStyle();
+                const float b = style->getMetric(MetricsRole::Border);
                 float y = g.min.y;
                 for (auto & i : _items)
                 {
+                    const auto j = _itemToAction.find(i.second);
+                    i.second->size = j != _itemToAction.end() && j->second ? _itemSize : glm::vec2(b, b);
                     i.second->geom.min.x = g.min.x;
                     i.second->geom.min.y = y;
                     i.second->geom.max.x = g.max.x;
@@ -245,6 +227,13 @@ namespace djv
                 }
             }
 
+            void MenuWidget::_clipEvent(Event::Clip & event)
+            {
+                if (isClipped())
+                    return;
+                _glyphsUpdate(event.getClipRect());
+            }
+
             void MenuWidget::_paintEvent(Event::Paint & event)
             {
                 Widget::_paintEvent(event);
@@ -256,9 +245,15 @@ namespace djv
                 const float is = style->getMetric(MetricsRole::Icon);
                 const float iss = style->getMetric(MetricsRole::IconSmall);
 
+                // Menus can have a large number of items (for example a combo
+                // box with many entries), so only draw the visible items.
+                const BBox2f& clipRect = event.getClipRect();
+
                 auto render = _getRender();
                 for (const auto & i : _items)
                 {
+                    if (!i.second->geom.intersects(clipRect))
+                        continue;
                     if (i.second->enabled)
                     {
                         if (i.second == _pressed.second)
@@ -283,6 +278,8 @@ namespace djv
 
                 for (const auto & i : _items)
                 {
+                    if (!i.second->geom.intersects(clipRect))
+                        continue;
                     float x = i.second->geom.min.x + m;
                     float y = 0.F;
 
@@ -324,11 +321,10 @@ namespace djv
                     const auto j = _itemToAction.find(i.second);
                     if (j != _itemToAction.end() && j->second)
                     {
-                        y = i.second->geom.min.y + ceilf(i.second->size.y / 2.F) - ceilf(i.second->fontMetrics.lineHeight / 2.F) + i.second->fontMetrics.ascender;
-                        const auto fontInfo = i.second->font.empty() ?
-                            style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium) :
-                            style->getFontInfo(i.second->font, AV::Font::faceDefault, MetricsRole::FontMedium);
-                        render->setCurrentFont(fontInfo);
+                        const auto k = _fontMetrics.find(i.second->font);
+                        const AV::Font::Metrics fontMetrics = k != _fontMetrics.end() ? k->second : AV::Font::Metrics();
+                        y = i.second->geom.min.y + ceilf(i.second->size.y / 2.F) - ceilf(fontMetrics.lineHeight / 2.F) + fontMetrics.ascender;
+                        render->setCurrentFont(_getFontInfo(i.second));
                         render->drawText(i.second->textGlyphs, glm::vec2(x + m, y));
                         x += i.second->textSize.x + m * 2.F;
 
@@ -510,81 +506,140 @@ namespace djv
                         }
                     }
                 }
-                for (auto& i : _fontMetricsFutures)
+                // The futures are removed when they are ready so that menus
+                // with many items do not poll them every update.
+                bool resize = false;
+                bool redraw = false;
                 {
-                    if (i.second.valid() &&
-                        i.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    auto i = _fontMetricsFutures.begin();
+                    while (i != _fontMetricsFutures.end())
                     {
-                        try
+                        if (i->second.valid() &&
+                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            i.first->fontMetrics = i.second.get();
+                            try
+                            {
+                                _fontMetrics[i->first] = i->second.get();
+                                redraw = true;
+                            }
+                            catch (const std::exception & e)
+                            {
+                                _log(e.what(), LogLevel::Error);
+                            }
+                            i = _fontMetricsFutures.erase(i);
                         }
-                        catch (const std::exception & e)
+                        else
                         {
-                            _log(e.what(), LogLevel::Error);
+                            ++i;
                         }
                     }
                 }
-                for (auto& i : _textSizeFutures)
                 {
-                    if (i.second.valid() &&
-                        i.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    auto i = _textSizeFutures.begin();
+                    while (i != _textSizeFutures.end())
                     {
-                        try
+                        if (i->second.valid() &&
+                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            i.first->textSize = i.second.get();
+                            try
+                            {
+                                i->first->textSize = i->second.get();
+                                _textSizeMax = glm::max(_textSizeMax, i->first->textSize);
+                                resize = true;
+                            }
+                            catch (const std::exception & e)
+                            {
+                                _log(e.what(), LogLevel::Error);
+                            }
+                            i = _textSizeFutures.erase(i);
                         }
-                        catch (const std::exception & e)
+                        else
                         {
-                            _log(e.what(), LogLevel::Error);
+                            ++i;
                         }
                     }
                 }
-                for (auto& i : _textGlyphsFutures)
                 {
-                    if (i.second.valid() &&
-                        i.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    auto i = _shortcutSizeFutures.begin();
+                    while (i != _shortcutSizeFutures.end())
                     {
-                        try
+                        if (i->second.valid() &&
+                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            i.first->textGlyphs = i.second.get();
+                            try
+                            {
+                                i->first->shortcutSize = i->second.get();
+                                _shortcutSizeMax = glm::max(_shortcutSizeMax, i->first->shortcutSize);
+                                resize = true;
+                            }
+                            catch (const std::exception & e)
+                            {
+                                _log(e.what(), LogLevel::Error);
+                            }
+                            i = _shortcutSizeFutures.erase(i);
                         }
-                        catch (const std::exception & e)
+                        else
                         {
-                            _log(e.what(), LogLevel::Error);
+                            ++i;
                         }
                     }
                 }
-                for (auto& i : _shortcutSizeFutures)
                 {
-                    if (i.second.valid() &&
-                        i.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    auto i = _textGlyphsFutures.begin();
+                    while (i != _textGlyphsFutures.end())
                     {
-                        try
+                        if (i->second.valid() &&
+                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            i.first->shortcutSize = i.second.get();
+                            try
+                            {
+                                i->first->textGlyphs = i->second.get();
+                                redraw = true;
+                            }
+                            catch (const std::exception & e)
+                            {
+                                _log(e.what(), LogLevel::Error);
+                            }
+                            i = _textGlyphsFutures.erase(i);
                         }
-                        catch (const std::exception & e)
+                        else
                         {
-                            _log(e.what(), LogLevel::Error);
+                            ++i;
                         }
                     }
                 }
-                for (auto& i : _shortcutGlyphsFutures)
                 {
-                    if (i.second.valid() &&
-                        i.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    auto i = _shortcutGlyphsFutures.begin();
+                    while (i != _shortcutGlyphsFutures.end())
                     {
-                        try
+                        if (i->second.valid() &&
+                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            i.first->shortcutGlyphs = i.second.get();
+                            try
+                            {
+                                i->first->shortcutGlyphs = i->second.get();
+                                redraw = true;
+                            }
+                            catch (const std::exception & e)
+                            {
+                                _log(e.what(), LogLevel::Error);
+                            }
+                            i = _shortcutGlyphsFutures.erase(i);
                         }
-                        catch (const std::exception & e)
+                        else
                         {
-                            _log(e.what(), LogLevel::Error);
+                            ++i;
                         }
                     }
                 }
+                if (resize)
+                {
+                    _resize();
+                }
+                else if (redraw)
+                {
+                    _redraw();
+                }
             }
 
             std::shared_ptr<MenuWidget::Item> MenuWidget::_getItem(const glm::vec2 & pos) const
@@ -611,6 +666,9 @@ namespace djv
                 _itemToAction.clear();
                 _hasIcon.clear();
                 _iconFutures.clear();
+                _actionCount = 0;
+                _dividerCount = 0;
+                _fontMetrics.clear();
                 _fontMetricsFutures.clear();
                 _textSizeFutures.clear();
                 _textGlyphsFutures.clear();
@@ -729,27 +787,85 @@ namespace djv
                     _items[i.first] = item;
                     _actionToItem[i.second] = item;
                     _itemToAction[item] = i.second;
+                    if (i.second)
+                    {
+                        ++_actionCount;
+                    }
+                    else
+                    {
+                        ++_dividerCount;
+                    }
                 }
                 _textUpdate();
             }
 
+            AV::Font::Info MenuWidget::_getFontInfo(const std::shared_ptr<Item>& item) const
+            {
+                const auto& style = _getStyle();
+                return item->font.empty() ?
+                    style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium) :
+                    style->getFontInfo(item->font, AV::Font::faceDefault, MetricsRole::FontMedium);
+            }
+
             void MenuWidget::_textUpdate()
             {
+                // The sizes of all the items are needed for the width of the
+                // menu, but the font metrics are only requested once for each
+                // font, and the glyphs only for the items that are visible.
                 _textUpdateRequest = false;
-                const auto& style = _getStyle();
-                auto textSystem = _getTextSystem();
                 _hasShortcuts = false;
+                _textSizeMax = glm::vec2(0.F, 0.F);
+                _shortcutSizeMax = glm::vec2(0.F, 0.F);
+                _fontMetrics.clear();
+                _fontMetricsFutures.clear();
+                _textSizeFutures.clear();
+                _textGlyphsFutures.clear();
+                _shortcutSizeFutures.clear();
+                _shortcutGlyphsFutures.clear();
+                for (const auto & i : _items)
+                {
+                    const auto fontInfo = _getFontInfo(i.second);
+                    if (_fontMetricsFutures.find(i.second->font) == _fontMetricsFutures.end())
+                    {
+                        _fontMetricsFutures[i.second->font] = _fontSystem->getMetrics(fontInfo);
+                    }
+                    i.second->textSize = glm::vec2(0.F, 0.F);
+                    i.second->textGlyphs.clear();
+                    i.second->shortcutSize = glm::vec2(0.F, 0.F);
+                    i.second->shortcutGlyphs.clear();
+                    if (!i.second->text.empty())
+                    {
+                        _textSizeFutures[i.second] = _fontSystem->measure(i.second->text, fontInfo);
+                    }
+                    if (!i.second->shortcutLabel.empty())
+                    {
+                        _shortcutSizeFutures[i.second] = _fontSystem->measure(i.second->shortcutLabel, fontInfo);
+                        _hasShortcuts = true;
+                    }
+                }
+                _glyphsUpdate(getClipRect());
+                _resize();
+            }
+
+            void MenuWidget::_glyphsUpdate(const BBox2f& clipRect)
+            {
                 for (const auto & i : _items)
                 {
-                    const auto fontInfo = i.second->font.empty() ?
-                        style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium) :
-                        style->getFontInfo(i.second->font, AV::Font::faceDefault, MetricsRole::FontMedium);
-                    _fontMetricsFutures[i.second] = _fontSystem->getMetrics(fontInfo);
-                    _textSizeFutures[i.second] = _fontSystem->measure(i.second->text, fontInfo);
-                    _textGlyphsFutures[i.second] = _fontSystem->getGlyphs(i.second->text, fontInfo);
-                    _shortcutSizeFutures[i.second] = _fontSystem->measure(i.second->shortcutLabel, fontInfo);
-                    _shortcutGlyphsFutures[i.second] = _fontSystem->getGlyphs(i.second->shortcutLabel, fontInfo);
-                    _hasShortcuts |= i.second->shortcutLabel.size() > 0;
+                    if (i.second->geom.intersects(clipRect))
+                    {
+                        if (!i.second->text.empty() &&
+                            i.second->textGlyphs.empty() &&
+                            _textGlyphsFutures.find(i.second) == _textGlyphsFutures.end())
+                        {
+                            _textGlyphsFutures[i.second] = _fontSystem->getGlyphs(i.second->text, _getFontInfo(i.second));
+                        }
+                        if (!i.second->shortcutLabel.empty() &&
+                            i.second->shortcutGlyphs.empty() &&
+                            _shortcutGlyphsFutures.find(i.second) == _shortcutGlyphsFutures.end())
+                        {
+                            _shortcutGlyphsFutures[i.second] = _fontSystem->getGlyphs(i.second->shortcutLabel, _getFontInfo(i.second));
+                        }
+                    }
                 }
             }
 
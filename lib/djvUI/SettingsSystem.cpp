@@ -37,7 +37,11 @@
 #include <djvCore/Error.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/Timer.h>
+
+#include <random>
 
 using namespace djv::Core;
 
@@ -51,8 +55,108 @@ namespace djv
             {
                 const size_t settingsVersion = 13;
 
+                //! \todo Should this be configurable?
+                const size_t saveTimeout = 2;
+
             } // namespace
 
+            void readSettingsFile(
+                const FileSystem::Path& path,
+                std::map<std::string, picojson::value>& out,
+                std::map<std::string, std::string>& errors)
+            {
+                if (FileSystem::FileInfo(path).doesExist())
+                {
+                    FileSystem::FileIO fileIO;
+                    fileIO.open(std::string(path), FileSystem::FileIO::Mode::Read);
+#if defined(DJV_MMAP)
+                    const char* bufP = reinterpret_cast<const char*>(fileIO.mmapP());
+                    const char* bufEnd = reinterpret_cast<const char*>(fileIO.mmapEnd());
+#else // DJV_MMAP
+                    std::vector<char> buf;
+                    const size_t fileSize = fileIO.getSize();
+                    buf.resize(fileSize);
+                    fileIO.read(buf.data(), fileSize);
+                    const char* bufP = buf.data();
+                    const char* bufEnd = bufP + fileSize;
+#endif // DJV_MMAP
+
+                    // Split the file into groups so that the version can be
+                    // checked before the rest of the file is parsed.
+                    std::map<std::string, std::string> groups;
+                    PicoJSON::split(bufP, bufEnd, groups);
+
+                    size_t readSettingsVersion = 0;
+                    const auto i = groups.find("SettingsVersion");
+                    if (i != groups.end())
+                    {
+                        picojson::value v;
+                        picojson::parse(v, i->second);
+                        fromJSON(v, readSettingsVersion);
+                    }
+                    if (readSettingsVersion >= settingsVersion)
+                    {
+                        for (const auto& j : groups)
+                        {
+                            picojson::value v;
+                            const std::string error = picojson::parse(v, j.second);
+                            if (error.empty())
+                            {
+                                out[j.first] = std::move(v);
+                            }
+                            else
+                            {
+                                errors[j.first] = error;
+                            }
+                        }
+                    }
+                }
+            }
+
+            void writeSettingsFile(const FileSystem::Path& path, const picojson::value& value)
+            {
+                // Write to a temporary file and then rename it so the
+                // settings are not lost if the write is interrupted. The
+                // temporary file name is unique so that multiple instances
+                // of the application do not write to the same file.
+                const std::string fileName = std::string(path);
+                std::string tmpFileName;
+                {
+                    std::random_device rd;
+                    std::stringstream ss;
+                    ss << fileName << "." << std::hex << rd() << rd() << ".tmp";
+                    tmpFileName = ss.str();
+                }
+                try
+                {
+                    {
+                        FileSystem::FileIO fileIO;
+                        fileIO.open(tmpFileName, FileSystem::FileIO::Mode::Write);
+                        PicoJSON::write(value, fileIO);
+                        fileIO.write("\n");
+                        std::string error;
+                        if (!fileIO.close(&error))
+                        {
+                            throw FileSystem::Error(error);
+                        }
+                    }
+                    FileSystem::rename(tmpFileName, fileName);
+                }
+                catch (const std::exception&)
+                {
+                    if (FileSystem::FileInfo(tmpFileName).doesExist())
+                    {
+                        try
+                        {
+                            FileSystem::remove(tmpFileName);
+                        }
+                        catch (const std::exception&)
+                        {}
+                    }
+                    throw;
+                }
+            }
+
             void System::_init(const std::shared_ptr<Core::Context>& context)
             {
                 ISystem::_init("djv::UI::Settings::System", context);
@@ -69,7 +173,32 @@ namespace djv
                 {
                     _settingsPath = resourceSystem->getPath(FileSystem::ResourcePath::SettingsFile);
                 }
-                _readSettingsFile(_settingsPath, _json);
+
+                if (_settingsIO)
+                {
+                    {
+                        std::stringstream ss;
+                        ss << "Reading settings: " << _settingsPath;
+                        _log(ss.str());
+                    }
+                    // The settings file is read and parsed while the other
+                    // systems are initialized, it is only waited on when the
+                    // first settings are loaded.
+                    const auto path = _settingsPath;
+                    _readFuture = std::async(
+                        std::launch::async,
+                        [path]
+                        {
+                            File out;
+                            readSettingsFile(path, out.groups, out.errors);
+                            return out;
+                        });
+
+                    // The timer is started by settings changes, and it repeats
+                    // while a previous write is still in progress.
+                    _saveTimer = Time::Timer::create(context);
+                    _saveTimer->setRepeating(true);
+                }
             }
 
             System::System()
@@ -77,6 +206,15 @@ namespace djv
 
             System::~System()
             {
+                if (_readFuture.valid())
+                {
+                    _readFuture.wait();
+                }
+                if (_writeFuture.valid())
+                {
+                    _writeFuture.wait();
+                    _writeFinished();
+                }
                 _saveSettings();
             }
 
@@ -106,14 +244,34 @@ namespace djv
                 if (!_settingsIO)
                     return;
 
+                if (_readFuture.valid())
+                {
+                    try
+                    {
+                        _file = _readFuture.get();
+                    }
+                    catch (const std::exception & e)
+                    {
+                        std::stringstream ss;
+                        ss << "Cannot read settings" << " '" << _settingsPath << "'. " << e.what();
+                        _log(ss.str(), LogLevel::Error);
+                    }
+                }
+
                 std::stringstream ss;
                 ss << "Loading settings: " << settings->getName();
                 _log(ss.str());
 
-                picojson::value json;
                 const auto & name = settings->getName();
-                auto i = _json.find(name);
-                if (i != _json.end())
+                const auto j = _file.errors.find(name);
+                if (j != _file.errors.end())
+                {
+                    std::stringstream ss;
+                    ss << "Cannot read settings" << " '" << name << "'. " << j->second;
+                    _log(ss.str(), LogLevel::Error);
+                }
+                auto i = _file.groups.find(name);
+                if (i != _file.groups.end())
                 {
                     try
                     {
@@ -128,103 +286,99 @@ namespace djv
                 }
             }
 
-            void System::_saveSettings()
+            picojson::value System::_getSettingsJSON() const
             {
-                if (!_settingsIO)
-                    return;
-
                 picojson::value object(picojson::object_type, true);
                 object.get<picojson::object>()["SettingsVersion"] = toJSON(settingsVersion);
-
-                // Serialize the settings.
                 for (const auto & settings : _settings)
                 {
                     object.get<picojson::object>()[settings->getName()] = settings->save();
                 }
-
-                // Write the JSON to disk.
-                _writeSettingsFile(_settingsPath, object);
+                return object;
             }
 
-            void System::_readSettingsFile(const FileSystem::Path & path, std::map<std::string, picojson::value> & out)
+            void System::_saveSettings()
             {
-                try
+                if (!_settingsIO)
+                    return;
+
+                auto json = _getSettingsJSON();
+                if (json != _savedJSON)
                 {
-                    if (FileSystem::FileInfo(path).doesExist())
+                    std::stringstream ss;
+                    ss << "Writing settings: " << _settingsPath;
+                    _log(ss.str());
+                    try
+                    {
+                        writeSettingsFile(_settingsPath, json);
+                        _savedJSON = std::move(json);
+                    }
+                    catch (const std::exception & e)
                     {
                         std::stringstream ss;
-                        ss << "Reading settings: " << path;
-                        _log(ss.str());
+                        ss << "Cannot write settings" << " '" << _settingsPath << "'. " << e.what();
+                        _log(ss.str(), LogLevel::Error);
+                    }
+                }
+            }
 
-                        FileSystem::FileIO fileIO;
-                        fileIO.open(std::string(path), FileSystem::FileIO::Mode::Read);
-#if defined(DJV_MMAP)
-                        const char * bufP = reinterpret_cast<const char *>(fileIO.mmapP());
-                        const char * bufEnd = reinterpret_cast<const char *>(fileIO.mmapEnd());
-#else // DJV_MMAP
-                        std::vector<char> buf;
-                        const size_t fileSize = fileIO.getSize();
-                        buf.resize(fileSize);
-                        fileIO.read(buf.data(), fileSize);
-                        const char* bufP = buf.data();
-                        const char* bufEnd = bufP + fileSize;
-#endif // DJV_MMAP
+            void System::_settingsChanged()
+            {
+                if (!_settingsIO || !_saveTimer)
+                    return;
 
-                        picojson::value v;
-                        std::string error;
-                        picojson::parse(v, bufP, bufEnd, &error);
-                        if (!error.empty())
-                        {
-                            throw std::invalid_argument(error);
-                        }
+                // Restart the timer on every change so that a burst of changes
+                // results in a single write.
+                _saveTimer->start(
+                    std::chrono::seconds(saveTimeout),
+                    [this](float)
+                    {
+                        _saveSettingsAsync();
+                    });
+            }
 
-                        if (v.is<picojson::object>())
-                        {
-                            const auto & object = v.get<picojson::object>();
-                            size_t readSettingsVersion = 0;
-                            for (const auto& value : object)
-                            {
-                                if ("SettingsVersion" == value.first)
-                                {
-                                    fromJSON(value.second, readSettingsVersion);
-                                    break;
-                                }
-                            }
-                            if (readSettingsVersion >= settingsVersion)
-                            {
-                                for (const auto& value : object)
-                                {
-                                    out[value.first] = value.second;
-                                }
-                            }
-                        }
+            void System::_saveSettingsAsync()
+            {
+                if (_writeFuture.valid())
+                {
+                    if (_writeFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    {
+                        return;
                     }
+                    _writeFinished();
                 }
-                catch (const std::exception & e)
+                _saveTimer->stop();
+
+                auto json = _getSettingsJSON();
+                if (json != _savedJSON)
                 {
                     std::stringstream ss;
-                    ss << "Cannot read settings" << " '" << path << "'. " << e.what();
-                    _log(ss.str(), LogLevel::Error);
+                    ss << "Writing settings: " << _settingsPath;
+                    _log(ss.str());
+                    _savedJSON = json;
+                    const auto path = _settingsPath;
+                    _writeFuture = std::async(
+                        std::launch::async,
+                        [path, json]
+                        {
+                            writeSettingsFile(path, json);
+                        });
                 }
             }
 
-            void System::_writeSettingsFile(const FileSystem::Path & path, const picojson::value & value)
+            void System::_writeFinished()
             {
                 try
                 {
-                    std::stringstream ss;
-                    ss << "Writing settings: " << path;
-                    _log(ss.str());
-
-                    FileSystem::FileIO fileIO;
-                    fileIO.open(std::string(path), FileSystem::FileIO::Mode::Write);
-                    PicoJSON::write(value, fileIO);
-                    fileIO.write("\n");
+                    _writeFuture.get();
                 }
                 catch (const std::exception & e)
                 {
+                    // Clear the saved settings so the write is retried on
+                    // the next change.
+                    _savedJSON = picojson::value();
                     std::stringstream ss;
-                    ss << "Cannot write settings" << " '" << path << "'. " << e.what();
+                    ss << "Cannot write settings" << " '" << _settingsPath << "'. " << e.what();
                     _log(ss.str(), LogLevel::Error);
                 }
             }
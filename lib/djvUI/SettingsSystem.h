@@ -34,16 +34,47 @@
 #include <djvCore/PicoJSON.h>
 #include <djvCore/Path.h>
 
+#include <future>
+#include <map>
+
 namespace djv
 {
+    namespace Core
+    {
+        namespace Time
+        {
+            class Timer;
+
+        } // namespace Time
+    } // namespace Core
+
     namespace UI
     {
         namespace Settings
         {
             class ISettings;
 
+            //! Read a settings file. Each group of settings is parsed separately
+            //! and the groups that cannot be parsed are returned in the errors.
+            //! Throws:
+            //! - std::exception
+            void readSettingsFile(
+                const Core::FileSystem::Path&,
+                std::map<std::string, picojson::value>&,
+                std::map<std::string, std::string>& errors);
+
+            //! Write a settings file. The settings are written to a uniquely named
+            //! temporary file which then replaces the settings file.
+            //! Throws:
+            //! - std::exception
+            void writeSettingsFile(const Core::FileSystem::Path&, const picojson::value&);
+
             //! This class provides a system for saving and restoring user settings.
             //!
+            //! The settings file is read and parsed in the background while the
+            //! application starts. When settings are changed they are written in
+            //! the background once the changes have stopped for a short time.
+            //!
             //! \bug How can we merge settings changes from multiple application instances?
             class System : public Core::ISystem
             {
@@ -69,13 +100,23 @@ namespace djv
                 void _removeSettings(const std::shared_ptr<ISettings> &);
 
                 void _loadSettings(const std::shared_ptr<ISettings> &);
+                picojson::value _getSettingsJSON() const;
                 void _saveSettings();
-
-                void _readSettingsFile(const Core::FileSystem::Path &, std::map<std::string, picojson::value> &);
-                void _writeSettingsFile(const Core::FileSystem::Path &, const picojson::value &);
-
-                std::map<std::string, picojson::value> _json;
+                void _settingsChanged();
+                void _saveSettingsAsync();
+                void _writeFinished();
+
+                struct File
+                {
+                    std::map<std::string, picojson::value> groups;
+                    std::map<std::string, std::string> errors;
+                };
+                std::future<File> _readFuture;
+                File _file;
                 std::vector<std::shared_ptr<ISettings> > _settings;
+                picojson::value _savedJSON;
+                std::future<void> _writeFuture;
+                std::shared_ptr<Core::Time::Timer> _saveTimer;
                 Core::FileSystem::Path _settingsPath;
                 bool _settingsIO = true;
 
@@ -46,7 +46,7 @@ namespace djv
         {
             Palette::Palette() 
             {
-                _colors =
+                const std::vector<std::pair<ColorRole, AV::Image::Color> > colors =
                 {
                     // These colors should be specified as RGBA F32.
                     { ColorRole::None, AV::Image::Color(0.F, 0.F, 0.F, 0.F) },
@@ -72,11 +72,16 @@ namespace djv
                     { ColorRole::Handle, AV::Image::Color(.58F, .32F, .18F, 1.F) },
                     { ColorRole::Cached, AV::Image::Color(.32F, .58F, .18F, 1.F) }
                 };
+                _colors.resize(static_cast<size_t>(ColorRole::Count));
+                for (const auto& i : colors)
+                {
+                    _colors[static_cast<size_t>(i.first)] = i.second;
+                }
             }
 
             void Palette::setColor(ColorRole role, const AV::Image::Color & value)
             {
-                _colors[role] = value.getType() != AV::Image::Type::None ?
+                _colors[static_cast<size_t>(role)] = value.getType() != AV::Image::Type::None ?
                     value.convert(AV::Image::Type::RGBA_F32) :
                     AV::Image::Color(AV::Image::Type::RGBA_F32);
             }
@@ -94,7 +99,7 @@ namespace djv
 
             Metrics::Metrics()
             {
-                _metrics =
+                const std::vector<std::pair<MetricsRole, float> > metrics =
                 {
                     { MetricsRole::None, 0.F },
                     { MetricsRole::Border, 1.F },
@@ -132,11 +137,16 @@ namespace djv
                     { MetricsRole::Move, 10.F },
                     { MetricsRole::Scrub, 10.F }
                 };
+                _metrics.resize(static_cast<size_t>(MetricsRole::Count), 0.F);
+                for (const auto& i : metrics)
+                {
+                    _metrics[static_cast<size_t>(i.first)] = i.second;
+                }
             }
 
             void Metrics::setMetric(MetricsRole role, float value)
             {
-                _metrics[role] = value;
+                _metrics[static_cast<size_t>(role)] = value;
             }
 
             bool Metrics::operator == (const Metrics & other) const
@@ -159,9 +169,10 @@ namespace djv
                             {
                                 style->_fontNameToId[i.second] = i.first;
                             }
-                            style->_dirty = true;
+                            style->_setLayoutDirty();
                         }
                     });
+                _metricsUpdate();
             }
 
             Style::Style()
@@ -187,7 +198,8 @@ namespace djv
                 if (value == _dpi)
                     return;
                 _dpi = value;
-                _dirty = true;
+                _metricsUpdate();
+                _setLayoutDirty();
             }
 
             void Style::setMetrics(const Metrics& value)
@@ -195,7 +207,10 @@ namespace djv
                 if (value == _metrics)
                     return;
                 _metrics = value;
-                _dirty = true;
+                if (_metricsUpdate())
+                {
+                    _setLayoutDirty();
+                }
             }
 
             void Style::setFont(const std::string & value)
@@ -203,7 +218,7 @@ namespace djv
                 if (value == _font)
                     return;
                 _font = value;
-                _dirty = true;
+                _setLayoutDirty();
             }
 
             AV::Font::Info Style::getFontInfo(const std::string & family, const std::string & face, MetricsRole role) const
@@ -229,6 +244,27 @@ namespace djv
             void Style::setClean()
             {
                 _dirty = false;
+                _layoutDirty = false;
+            }
+
+            bool Style::_metricsUpdate()
+            {
+                const float scale = getScale();
+                std::vector<float> scaledMetrics(static_cast<size_t>(MetricsRole::Count));
+                for (size_t i = 0; i < scaledMetrics.size(); ++i)
+                {
+                    scaledMetrics[i] = ceilf(_metrics.getMetric(static_cast<MetricsRole>(i)) * scale);
+                }
+                const bool out = scaledMetrics != _scaledMetrics;
+                _scaledMetrics = std::move(scaledMetrics);
+                return out;
+            }
+
+            void Style::_setLayoutDirty()
+            {
+                ++_generation;
+                _dirty = true;
+                _layoutDirty = true;
             }
 
         } // namespace Style
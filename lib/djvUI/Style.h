@@ -65,7 +65,7 @@ namespace djv
                 bool operator == (const Palette &) const;
 
             private:
-                std::map<ColorRole, AV::Image::Color> _colors;
+                std::vector<AV::Image::Color> _colors;
                 float _disabledMult = .65F;
             };
 
@@ -81,10 +81,16 @@ namespace djv
                 bool operator == (const Metrics &) const;
 
             private:
-                std::map<MetricsRole, float> _metrics;
+                std::vector<float> _metrics;
             };
 
             //! This class provides the UI style.
+            //!
+            //! The metrics are compiled into a table that is scaled by the DPI
+            //! when the style changes, so looking up a metric is an array index.
+            //! The generation number is incremented when a change affects the
+            //! layout (metrics, DPI, or font); palette changes only require
+            //! the widgets to be redrawn.
             class Style : public std::enable_shared_from_this<Style>
             {
                 DJV_NON_COPYABLE(Style);
@@ -129,18 +135,28 @@ namespace djv
 
                 ///@}
 
+                //! Get the generation number of the size metrics and fonts.
+                size_t getGeneration() const;
+
                 bool isDirty() const;
+                bool isLayoutDirty() const;
                 void setClean();
 
             private:
+                bool _metricsUpdate();
+                void _setLayoutDirty();
+
                 Palette _palette;
                 glm::vec2 _dpi = glm::vec2(AV::dpiDefault, AV::dpiDefault);
                 Metrics _metrics;
+                std::vector<float> _scaledMetrics;
+                size_t _generation = 0;
                 std::string _font = AV::Font::familyDefault;
                 std::map<AV::Font::FamilyID, std::string> _fontNames;
                 std::map<std::string, AV::Font::FamilyID> _fontNameToId;
                 std::shared_ptr<Core::MapObserver<AV::Font::FamilyID, std::string> > _fontNamesObserver;
                 bool _dirty = true;
+                bool _layoutDirty = true;
             };
 
         } // namespace Style
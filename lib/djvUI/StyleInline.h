@@ -35,7 +35,7 @@ namespace djv
         {
             inline const AV::Image::Color& Palette::getColor(ColorRole value) const
             {
-                return _colors.at(value);
+                return _colors[static_cast<size_t>(value)];
             }
 
             inline float Palette::getDisabledMult() const
@@ -45,7 +45,7 @@ namespace djv
 
             inline float Metrics::getMetric(MetricsRole role) const
             {
-                return _metrics.at(role);
+                return _metrics[static_cast<size_t>(role)];
             }
 
             inline const Palette& Style::getPalette() const
@@ -75,7 +75,7 @@ namespace djv
 
             inline float Style::getMetric(MetricsRole role) const
             {
-                return ceilf(_metrics.getMetric(role) * getScale());
+                return _scaledMetrics[static_cast<size_t>(role)];
             }
 
             inline const std::string Style::getFont() const
@@ -83,11 +83,21 @@ namespace djv
                 return _font;
             }
 
+            inline size_t Style::getGeneration() const
+            {
+                return _generation;
+            }
+
             inline bool Style::isDirty() const
             {
                 return _dirty;
             }
 
+            inline bool Style::isLayoutDirty() const
+            {
+                return _layoutDirty;
+            }
+
         } // namespace Style
     } // namespace UI
 } // namespace djv
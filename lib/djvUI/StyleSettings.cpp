@@ -188,6 +188,7 @@ namespace djv
                     const auto palette = p.palettes->getItem(name);
                     p.currentPalette->setIfChanged(palette);
                     p.currentPaletteName->setIfChanged(name);
+                    _changed();
                 }
             }
 
@@ -219,6 +220,7 @@ namespace djv
                     const auto metrics = p.metrics->getItem(name);
                     p.currentMetrics->setIfChanged(metrics);
                     p.currentMetricsName->setIfChanged(name);
+                    _changed();
                 }
             }
 
@@ -47,6 +47,25 @@ namespace djv
 {
     namespace UI
     {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t textCacheMax = 8;
+
+            //! \todo Should this be configurable?
+            const float textWidthBucket = 8.F;
+
+            //! Layouts probe several widths per pass, so the widths are rounded
+            //! down to a bucket. This keeps the number of line breaking requests
+            //! small, and lets text blocks with the same text and font share the
+            //! font system's line cache.
+            float getTextWidthBucket(float value)
+            {
+                return std::max(floorf(value / textWidthBucket) * textWidthBucket, textWidthBucket);
+            }
+
+        } // namespace
+
         struct TextBlock::Private
         {
             std::shared_ptr<AV::Font::System> fontSystem;
@@ -63,6 +82,7 @@ namespace djv
             typedef std::pair<AV::Font::Info, float> TextCacheKey;
             typedef std::pair<std::vector<AV::Font::TextLine>, glm::vec2> TextCacheValue;
             Memory::Cache<TextCacheKey, TextCacheValue> textCache;
+            size_t styleGeneration = std::numeric_limits<size_t>::max();
             BBox2f clipRect;
 
             TextCacheValue textLines(float);
@@ -74,7 +94,7 @@ namespace djv
             DJV_PRIVATE_PTR();
             setClassName("djv::UI::TextBlock");
             p.fontSystem = context->getSystemT<AV::Font::System>();
-            p.textCache.setMax(5);
+            p.textCache.setMax(textCacheMax);
         }
         
         TextBlock::TextBlock() :
@@ -241,7 +261,7 @@ namespace djv
             DJV_PRIVATE_PTR();
             const auto& style = _getStyle();
             const BBox2f& g = getMargin().bbox(getGeometry(), style);
-            const auto key = std::make_pair(p.fontInfo, g.w());
+            const auto key = std::make_pair(p.fontInfo, getTextWidthBucket(g.w()));
             Private::TextCacheValue cacheValue;
             if (p.textCache.get(key, cacheValue))
             {
@@ -279,7 +299,10 @@ namespace djv
         void TextBlock::_initEvent(Event::Init& event)
         {
             Widget::_initEvent(event);
-            _textUpdate();
+            if (_getStyle()->getGeneration() != _p->styleGeneration)
+            {
+                _textUpdate();
+            }
         }
 
         void TextBlock::_updateEvent(Event::Update& event)
@@ -305,6 +328,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             const auto& style = _getStyle();
+            p.styleGeneration = style->getGeneration();
             p.fontInfo = p.fontFamily.empty() ?
                 style->getFontInfo(p.fontFace, p.fontSizeRole) :
                 style->getFontInfo(p.fontFamily, p.fontFace, p.fontSizeRole);
@@ -317,10 +341,11 @@ namespace djv
         TextBlock::Private::TextCacheValue TextBlock::Private::textLines(float value)
         {
             Private::TextCacheValue out;
-            const auto key = std::make_pair(fontInfo, value);
+            const float width = getTextWidthBucket(value);
+            const auto key = std::make_pair(fontInfo, width);
             if (!textCache.get(key, out))
             {
-                auto textLines = fontSystem->textLines(text, value, fontInfo).get();
+                auto textLines = fontSystem->textLines(text, width, fontInfo).get();
                 glm::vec2 textSize = glm::vec2(0.F, 0.F);
                 for (const auto& i : textLines)
                 {
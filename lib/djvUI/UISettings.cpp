@@ -82,6 +82,7 @@ namespace djv
                 if (_p->tooltips->setIfChanged(value))
                 {
                     Widget::setTooltipsEnabled(value);
+                    _changed();
                 }
             }
 
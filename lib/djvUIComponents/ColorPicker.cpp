@@ -146,7 +146,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             p.comboBox->clearItems();
-            for (size_t i = static_cast<size_t>(AV::Image::Type::L_U8); i < static_cast<size_t>(AV::Image::Type::Count); ++i)
+            for (size_t i = static_cast<size_t>(AV::Image::Type::L_U8); i <= static_cast<size_t>(AV::Image::Type::RGBA_F32); ++i)
             {
                 std::stringstream ss;
                 ss << static_cast<AV::Image::Type>(i);
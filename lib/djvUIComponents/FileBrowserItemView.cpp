@@ -393,12 +393,13 @@ namespace djv
 
                 auto render = _getRender();
                 const float ut = _getUpdateTime();
+                const BBox2f& clipRect = event.getClipRect();
                 auto item = p.items.begin();
                 size_t index = 0;
                 for (; item != p.items.end(); ++item, ++index)
                 {
                     const auto i = p.itemGeometry.find(index);
-                    if (i != p.itemGeometry.end())
+                    if (i != p.itemGeometry.end() && i->second.intersects(clipRect))
                     {
                         BBox2f itemGeometry = i->second;
 
@@ -111,6 +111,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.shortcuts->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IListSubject<FileSystem::Path> > FileBrowser::observeRecentPaths() const
@@ -122,6 +123,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.recentPaths->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<ViewType> > FileBrowser::observeViewType() const
@@ -133,6 +135,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.viewType->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<AV::Image::Size> > FileBrowser::observeThumbnailSize() const
@@ -144,6 +147,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.thumbnailSize->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IListSubject<float> > FileBrowser::observeListViewHeaderSplit() const
@@ -155,6 +159,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.listViewHeaderSplit->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeFileSequences() const
@@ -166,6 +171,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.fileSequences->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeShowHidden() const
@@ -177,6 +183,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.showHidden->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<FileSystem::DirectoryListSort> > FileBrowser::observeSort() const
@@ -188,6 +195,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.sort->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeReverseSort() const
@@ -199,6 +207,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.reverseSort->setIfChanged(value);
+                _changed();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeSortDirectoriesFirst() const
@@ -210,6 +219,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.sortDirectoriesFirst->setIfChanged(value);
+                _changed();
             }
 
             void FileBrowser::load(const picojson::value & value)
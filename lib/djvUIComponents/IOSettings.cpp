@@ -83,6 +83,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.threadCount->setIfChanged(value);
+                _changed();
             }
 
             void IO::load(const picojson::value & value)
@@ -72,6 +72,7 @@ namespace djv
         void AnnotateSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void AnnotateSettings::load(const picojson::value & value)
@@ -85,16 +85,19 @@ namespace djv
         void ColorPickerSettings::setSampleSize(int value)
         {
             _p->sampleSize = value;
+            _changed();
         }
 
         void ColorPickerSettings::setTypeLock(AV::Image::Type value)
         {
             _p->typeLock = value;
+            _changed();
         }
 
         void ColorPickerSettings::setPickerPos(const glm::vec2& value)
         {
             _p->pickerPos = value;
+            _changed();
         }
 
         const std::map<std::string, BBox2f>& ColorPickerSettings::getWidgetGeom() const
@@ -105,6 +108,7 @@ namespace djv
         void ColorPickerSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void ColorPickerSettings::load(const picojson::value & value)
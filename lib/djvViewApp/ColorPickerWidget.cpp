@@ -49,6 +49,7 @@
 #include <djvUI/ToolButton.h>
 
 #include <djvAV/OCIOSystem.h>
+#include <djvAV/ImageScopes.h>
 #include <djvAV/ImageUtil.h>
 #include <djvAV/OpenGLOffscreenBuffer.h>
 #include <djvAV/Render2D.h>
@@ -59,6 +60,7 @@
 #endif // DJV_OPENGL_ES2
 
 #include <djvCore/Context.h>
+#include <djvCore/Timer.h>
 #if defined(DJV_OPENGL_ES2)
 #include <djvCore/ResourceSystem.h>
 #endif // DJV_OPENGL_ES2
@@ -66,6 +68,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_transform_2d.hpp>
 
+#include <future>
 #include <iomanip>
 
 using namespace djv::Core;
@@ -98,6 +101,10 @@ namespace djv
             ImageRotate imageRotate = ImageRotate::First;
             UI::ImageAspectRatio imageAspectRatio = UI::ImageAspectRatio::First;
             glm::vec2 pixelPos = glm::vec2(0.F, 0.F);
+            AV::Image::Stats stats;
+            Core::UID statsUID = 0;
+            std::future<AV::Image::Stats> statsFuture;
+            std::shared_ptr<Time::Timer> statsTimer;
             AV::OCIO::Config ocioConfig;
             std::string outputColorSpace;
             std::shared_ptr<MediaWidget> activeWidget;
@@ -106,6 +113,7 @@ namespace djv
             std::shared_ptr<UI::ColorSwatch> colorSwatch;
             std::shared_ptr<UI::Label> colorLabel;
             std::shared_ptr<UI::Label> pixelLabel;
+            std::map<std::string, std::shared_ptr<UI::Label> > statsLabels;
             std::shared_ptr<UI::IntSlider> sampleSizeSlider;
             std::shared_ptr<UI::ColorTypeWidget> typeWidget;
             std::shared_ptr<UI::ToolButton> copyButton;
@@ -155,6 +163,14 @@ namespace djv
             p.pixelLabel->setFont(AV::Font::familyMono);
             p.pixelLabel->setHAlign(UI::HAlign::Left);
 
+            for (const auto& i : { "Frame minimum", "Frame maximum", "Frame average" })
+            {
+                auto label = UI::Label::create(context);
+                label->setFont(AV::Font::familyMono);
+                label->setHAlign(UI::HAlign::Left);
+                p.statsLabels[i] = label;
+            }
+
             p.sampleSizeSlider = UI::IntSlider::create(context);
             p.sampleSizeSlider->setRange(IntRange(1, sampleSizeMax));
 
@@ -180,6 +196,9 @@ namespace djv
             p.formLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
             p.formLayout->addChild(p.colorLabel);
             p.formLayout->addChild(p.pixelLabel);
+            p.formLayout->addChild(p.statsLabels["Frame minimum"]);
+            p.formLayout->addChild(p.statsLabels["Frame maximum"]);
+            p.formLayout->addChild(p.statsLabels["Frame average"]);
             p.layout->addChild(p.formLayout);
             p.layout->addChild(p.sampleSizeSlider);
             auto hLayout = UI::HorizontalLayout::create(context);
@@ -193,16 +212,34 @@ namespace djv
 
 #if defined(DJV_OPENGL_ES2)
             auto resourceSystem = context->getSystemT<ResourceSystem>();
-            const Core::FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
             p.shader = AV::OpenGL::Shader::create(AV::Render::Shader::create(
-                Core::FileSystem::Path(shaderPath, "djvAVRender2DVertex.glsl"),
-                Core::FileSystem::Path(shaderPath, "djvAVRender2DFragment.glsl")));
+                resourceSystem,
+                "djvAVRender2DVertex.glsl",
+                "djvAVRender2DFragment.glsl"));
 #endif // DJV_OPENGL_ES2
 
             _sampleUpdate();
             _widgetUpdate();
 
             auto weak = std::weak_ptr<ColorPickerWidget>(std::dynamic_pointer_cast<ColorPickerWidget>(shared_from_this()));
+            p.statsTimer = Time::Timer::create(context);
+            p.statsTimer->setRepeating(true);
+            p.statsTimer->start(
+                Time::getMilliseconds(Time::TimerValue::Medium),
+                [weak](float)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        if (widget->_p->statsFuture.valid() &&
+                            widget->_p->statsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            widget->_p->stats = widget->_p->statsFuture.get();
+                            widget->_widgetUpdate();
+                            widget->_statsUpdate();
+                        }
+                    }
+                });
+
             p.copyButton->setClickedCallback(
                 [weak]
                 {
@@ -280,6 +317,7 @@ namespace djv
                                         {
                                             widget->_p->image = value;
                                             widget->_sampleUpdate();
+                                            widget->_statsUpdate();
                                             widget->_widgetUpdate();
                                         }
                                     });
@@ -478,6 +516,9 @@ namespace djv
             
             p.formLayout->setText(p.colorLabel, _getText(DJV_TEXT("Color")) + ":");
             p.formLayout->setText(p.pixelLabel, _getText(DJV_TEXT("Pixel")) + ":");
+            p.formLayout->setText(p.statsLabels["Frame minimum"], _getText(DJV_TEXT("Frame minimum")) + ":");
+            p.formLayout->setText(p.statsLabels["Frame maximum"], _getText(DJV_TEXT("Frame maximum")) + ":");
+            p.formLayout->setText(p.statsLabels["Frame average"], _getText(DJV_TEXT("Frame average")) + ":");
         }
         
         void ColorPickerWidget::_sampleUpdate()
@@ -492,7 +533,11 @@ namespace djv
                     const glm::mat3x3 pixelPosM = glm::translate(m, glm::vec2(-.5F, -.5F));
                     pixelPos = glm::inverse(pixelPosM) * pixelPos;
 
-                    const AV::Image::Type type = p.typeLock != AV::Image::Type::None ? p.typeLock : p.image->getType();
+                    AV::Image::Type type = p.typeLock != AV::Image::Type::None ? p.typeLock : p.image->getType();
+                    if (AV::Image::isYUVType(type))
+                    {
+                        type = AV::Image::getYUVConvertType(type);
+                    }
                     const size_t sampleSize = std::max(static_cast<size_t>(p.sampleSize), bufferSizeMin);
                     const AV::Image::Info info(sampleSize, sampleSize, type);
                     if (p.offscreenBuffer)
@@ -564,6 +609,36 @@ namespace djv
             p.pixelPos.y = pixelPos.y;
         }
 
+        void ColorPickerWidget::_statsUpdate()
+        {
+            DJV_PRIVATE_PTR();
+
+            // The statistics are computed from a subsample of the frame on a
+            // background thread, and only when the frame changes.
+            if (p.statsFuture.valid())
+                return;
+            if (p.image && p.image->isValid())
+            {
+                const UID uid = p.image->getUID();
+                if (uid != p.statsUID)
+                {
+                    p.statsUID = uid;
+                    const auto image = p.image;
+                    p.statsFuture = std::async(
+                        std::launch::async,
+                        [image]
+                        {
+                            return AV::Image::getStats(image);
+                        });
+                }
+            }
+            else if (p.statsUID)
+            {
+                p.statsUID = 0;
+                p.stats = AV::Image::Stats();
+            }
+        }
+
         void ColorPickerWidget::_widgetUpdate()
         {
             DJV_PRIVATE_PTR();
@@ -583,6 +658,22 @@ namespace djv
                 p.pixelLabel->setText(ss.str());
             }
             p.pixelLabel->setTooltip(_getText(DJV_TEXT("Pixel label tooltip")));
+            const glm::vec4* statsValues[] = { &p.stats.min, &p.stats.max, &p.stats.average };
+            const char* statsNames[] = { "Frame minimum", "Frame maximum", "Frame average" };
+            for (size_t i = 0; i < 3; ++i)
+            {
+                std::stringstream ss;
+                ss << std::fixed << std::setprecision(2);
+                for (uint8_t c = 0; c < p.stats.channelCount; ++c)
+                {
+                    if (c > 0)
+                    {
+                        ss << " ";
+                    }
+                    ss << (*statsValues[i])[c];
+                }
+                p.statsLabels[statsNames[i]]->setText(ss.str());
+            }
             p.sampleSizeSlider->setValue(p.sampleSize);
         }
 
@@ -67,6 +67,7 @@ namespace djv
 
         private:
             void _sampleUpdate();
+            void _statsUpdate();
             void _widgetUpdate();
 
             DJV_PRIVATE();
@@ -156,6 +156,11 @@ namespace djv
                 _labels["GlyphCacheValue"]->setFont(AV::Font::familyMono);
                 _thermometerWidgets["GlyphCache"] = UI::ThermometerWidget::create(context);
 
+                _labels["TextCache"] = UI::Label::create(context);
+                _labels["TextCacheValue"] = UI::Label::create(context);
+                _labels["TextCacheValue"]->setFont(AV::Font::familyMono);
+                _thermometerWidgets["TextCache"] = UI::ThermometerWidget::create(context);
+
                 _labels["ThumbnailInfoCache"] = UI::Label::create(context);
                 _labels["ThumbnailInfoCacheValue"] = UI::Label::create(context);
                 _labels["ThumbnailInfoCacheValue"]->setFont(AV::Font::familyMono);
@@ -213,6 +218,11 @@ namespace djv
                 _layout->addChild(hLayout);
                 _layout->addChild(_thermometerWidgets["GlyphCache"]);
                 hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["TextCache"]);
+                hLayout->addChild(_labels["TextCacheValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_thermometerWidgets["TextCache"]);
+                hLayout = UI::HorizontalLayout::create(context);
                 hLayout->addChild(_labels["ThumbnailInfoCache"]);
                 hLayout->addChild(_labels["ThumbnailInfoCacheValue"]);
                 _layout->addChild(hLayout);
@@ -277,6 +287,7 @@ namespace djv
                     auto eventSystem = context->getSystemT<UI::EventSystem>();
                     auto fontSystem = context->getSystemT<AV::Font::System>();
                     const float glyphCachePercentage = fontSystem->getGlyphCachePercentage();
+                    const float textCacheHitRate = fontSystem->getTextCacheHitRate();
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
                     const float thumbnailInfoCachePercentage = thumbnailSystem->getInfoCachePercentage();
                     const float thumbnailImageCachePercentage = thumbnailSystem->getImageCachePercentage();
@@ -292,6 +303,7 @@ namespace djv
                     _thermometerWidgets["ThumbnailImageCache"]->setPercentage(thumbnailImageCachePercentage);
                     _thermometerWidgets["IconCache"]->setPercentage(iconCachePercentage);
                     _thermometerWidgets["GlyphCache"]->setPercentage(glyphCachePercentage);
+                    _thermometerWidgets["TextCache"]->setPercentage(textCacheHitRate);
 
                     {
                         std::stringstream ss;
@@ -389,6 +401,17 @@ namespace djv
                         ss << std::fixed << glyphCachePercentage << "%";
                         _labels["GlyphCacheValue"]->setText(ss.str());
                     }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("Font system text cache hits")) << ":";
+                        _labels["TextCache"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss.precision(2);
+                        ss << std::fixed << textCacheHitRate << "%";
+                        _labels["TextCacheValue"]->setText(ss.str());
+                    }
                     {
                         std::stringstream ss;
                         ss << _getText(DJV_TEXT("Thumbnail system information cache")) << ":";
@@ -450,6 +473,12 @@ namespace djv
                 _labels["TextureAtlasValue"] = UI::Label::create(context);
                 _labels["TextureAtlasValue"]->setFont(AV::Font::familyMono);
                 _thermometerWidgets["TextureAtlas"] = UI::ThermometerWidget::create(context);
+                _labels["TextureAtlasEvictions"] = UI::Label::create(context);
+                _labels["TextureAtlasEvictionsValue"] = UI::Label::create(context);
+                _labels["TextureAtlasEvictionsValue"]->setFont(AV::Font::familyMono);
+                _labels["TextureAtlasDefragments"] = UI::Label::create(context);
+                _labels["TextureAtlasDefragmentsValue"] = UI::Label::create(context);
+                _labels["TextureAtlasDefragmentsValue"]->setFont(AV::Font::familyMono);
 
                 _labels["DynamicTextureCount"] = UI::Label::create(context);
                 _labels["DynamicTextureCountValue"] = UI::Label::create(context);
@@ -476,6 +505,14 @@ namespace djv
                 _layout->addChild(hLayout);
                 _layout->addChild(_thermometerWidgets["TextureAtlas"]);
                 hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["TextureAtlasEvictions"]);
+                hLayout->addChild(_labels["TextureAtlasEvictionsValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["TextureAtlasDefragments"]);
+                hLayout->addChild(_labels["TextureAtlasDefragmentsValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
                 hLayout->addChild(_labels["DynamicTextureCount"]);
                 hLayout->addChild(_labels["DynamicTextureCountValue"]);
                 _layout->addChild(hLayout);
@@ -515,6 +552,8 @@ namespace djv
             {
                 auto render = _getRender();
                 const float textureAtlasPercentage = render->getTextureAtlasPercentage();
+                const size_t textureAtlasEvictionCount = render->getTextureAtlasEvictionCount();
+                const size_t textureAtlasDefragmentCount = render->getTextureAtlasDefragmentCount();
                 const size_t dynamicTextureCount = render->getDynamicTextureCount();
                 const size_t vboSize = render->getVBOSize();
 
@@ -533,6 +572,26 @@ namespace djv
                     ss << std::fixed << textureAtlasPercentage << "%";
                     _labels["TextureAtlasValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("Texture atlas evictions")) << ":";
+                    _labels["TextureAtlasEvictions"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << textureAtlasEvictionCount;
+                    _labels["TextureAtlasEvictionsValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("Texture atlas defragments")) << ":";
+                    _labels["TextureAtlasDefragments"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << textureAtlasDefragmentCount;
+                    _labels["TextureAtlasDefragmentsValue"]->setText(ss.str());
+                }
                 {
                     std::stringstream ss;
                     ss << _getText(DJV_TEXT("Dynamic texture count")) << ":";
@@ -88,6 +88,7 @@ namespace djv
         void FileSettings::setOpenMax(size_t value)
         {
             _p->openMax->setIfChanged(value);
+            _changed();
         }
         
         std::shared_ptr<IListSubject<Core::FileSystem::FileInfo> > FileSettings::observeRecentFiles() const
@@ -98,6 +99,7 @@ namespace djv
         void FileSettings::setRecentFiles(const std::vector<Core::FileSystem::FileInfo> & value)
         {
             _p->recentFiles->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<bool> > FileSettings::observeAutoDetectSequences() const
@@ -108,6 +110,7 @@ namespace djv
         void FileSettings::setAutoDetectSequences(bool value)
         {
             _p->autoDetectSequences->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<bool> > FileSettings::observeCacheEnabled() const
@@ -123,11 +126,13 @@ namespace djv
         void FileSettings::setCacheEnabled(bool value)
         {
             _p->cacheEnabled->setIfChanged(value);
+            _changed();
         }
 
         void FileSettings::setCacheMaxGB(int value)
         {
             _p->cacheMaxGB->setIfChanged(value);
+            _changed();
         }
 
         const std::map<std::string, BBox2f>& FileSettings::getWidgetGeom() const
@@ -138,6 +143,7 @@ namespace djv
         void FileSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void FileSettings::load(const picojson::value & value)
@@ -29,21 +29,323 @@
 
 #include <djvViewApp/HistogramWidget.h>
 
+#include <djvViewApp/Media.h>
+#include <djvViewApp/MediaWidget.h>
+#include <djvViewApp/WindowSystem.h>
+
+#include <djvUI/ComboBox.h>
+#include <djvUI/FormLayout.h>
+#include <djvUI/Label.h>
+#include <djvUI/RowLayout.h>
+
+#include <djvAV/ImageScopes.h>
+#include <djvAV/Render2D.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Timer.h>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
+#include <future>
+#include <iomanip>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace ViewApp
     {
+        namespace
+        {
+            enum class ScopeMode
+            {
+                Histogram,
+                Waveform,
+                RGBParade,
+                Vectorscope,
+
+                Count,
+                First = Histogram
+            };
+
+            class ScopeWidget : public UI::Widget
+            {
+                DJV_NON_COPYABLE(ScopeWidget);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                ScopeWidget();
+
+            public:
+                virtual ~ScopeWidget();
+
+                static std::shared_ptr<ScopeWidget> create(const std::shared_ptr<Context>&);
+
+                void setScopes(const AV::Image::Scopes&);
+                void setMode(ScopeMode);
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _paintEvent(Event::Paint&) override;
+
+            private:
+                void _drawImage(const std::shared_ptr<AV::Image::Image>&, const BBox2f&);
+
+                AV::Image::Scopes _scopes;
+                ScopeMode _mode = ScopeMode::First;
+            };
+
+            void ScopeWidget::_init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::ScopeWidget");
+                setBackgroundRole(UI::ColorRole::Trough);
+            }
+
+            ScopeWidget::ScopeWidget()
+            {}
+
+            ScopeWidget::~ScopeWidget()
+            {}
+
+            std::shared_ptr<ScopeWidget> ScopeWidget::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<ScopeWidget>(new ScopeWidget);
+                out->_init(context);
+                return out;
+            }
+
+            void ScopeWidget::setScopes(const AV::Image::Scopes& value)
+            {
+                _scopes = value;
+                _redraw();
+            }
+
+            void ScopeWidget::setMode(ScopeMode value)
+            {
+                if (value == _mode)
+                    return;
+                _mode = value;
+                _redraw();
+            }
+
+            void ScopeWidget::_preLayoutEvent(Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                const float sw = style->getMetric(UI::MetricsRole::Swatch);
+                _setMinimumSize(glm::vec2(sw * 2.F, sw * 2.F));
+            }
+
+            void ScopeWidget::_paintEvent(Event::Paint&)
+            {
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                auto render = _getRender();
+                switch (_mode)
+                {
+                case ScopeMode::Histogram:
+                    if (_scopes.histogramMax > 0)
+                    {
+                        const AV::Image::Color colors[] =
+                        {
+                            AV::Image::Color(1.F, 0.F, 0.F, .5F),
+                            AV::Image::Color(0.F, 1.F, 0.F, .5F),
+                            AV::Image::Color(0.F, 0.F, 1.F, .5F),
+                            AV::Image::Color(1.F, 1.F, 1.F, .5F)
+                        };
+                        const float max = static_cast<float>(_scopes.histogramMax);
+                        std::vector<BBox2f> rects;
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            const auto& histogram = _scopes.histogram[c];
+                            const size_t bins = histogram.size();
+                            rects.clear();
+                            rects.reserve(bins);
+                            for (size_t i = 0; i < bins; ++i)
+                            {
+                                if (histogram[i])
+                                {
+                                    const float x0 = g.min.x + i * g.w() / bins;
+                                    const float x1 = g.min.x + (i + 1) * g.w() / bins;
+                                    const float h = ceilf(histogram[i] / max * g.h());
+                                    rects.push_back(BBox2f(x0, g.max.y - h, x1 - x0, h));
+                                }
+                            }
+                            render->setFillColor(colors[c]);
+                            render->drawRects(rects);
+                        }
+                    }
+                    break;
+                case ScopeMode::Waveform:
+                case ScopeMode::RGBParade:
+                    _drawImage(_scopes.waveform, g);
+                    break;
+                case ScopeMode::Vectorscope:
+                {
+                    const float size = std::min(g.w(), g.h());
+                    const BBox2f square(
+                        floorf(g.getCenter().x - size / 2.F),
+                        floorf(g.getCenter().y - size / 2.F),
+                        size,
+                        size);
+                    _drawImage(_scopes.vectorscope, square);
+                    render->setFillColor(style->getColor(UI::ColorRole::Border));
+                    render->drawRect(BBox2f(square.min.x, floorf(g.getCenter().y), size, 1.F));
+                    render->drawRect(BBox2f(floorf(g.getCenter().x), square.min.y, 1.F, size));
+                    break;
+                }
+                default: break;
+                }
+            }
+
+            void ScopeWidget::_drawImage(const std::shared_ptr<AV::Image::Image>& image, const BBox2f& g)
+            {
+                if (image && image->isValid())
+                {
+                    auto render = _getRender();
+                    render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F));
+                    glm::mat3x3 m(1.F);
+                    m = glm::translate(m, g.min);
+                    m = glm::scale(m, glm::vec2(
+                        g.w() / static_cast<float>(image->getWidth()),
+                        g.h() / static_cast<float>(image->getHeight())));
+                    render->pushTransform(m);
+                    AV::Render::ImageOptions options;
+                    options.cache = AV::Render::ImageCache::Dynamic;
+                    render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                    render->popTransform();
+                }
+            }
+
+        } // namespace
+
         struct HistogramWidget::Private
         {
+            ScopeMode mode = ScopeMode::First;
+            AV::Image::ScopesOptions options;
+            std::shared_ptr<AV::Image::Image> image;
+            AV::Image::Scopes scopes;
+            std::future<AV::Image::Scopes> future;
+            std::shared_ptr<MediaWidget> activeWidget;
 
+            std::shared_ptr<ScopeWidget> scopeWidget;
+            std::shared_ptr<UI::ComboBox> modeComboBox;
+            std::map<std::string, std::shared_ptr<UI::Label> > statsLabels;
+            std::shared_ptr<UI::FormLayout> formLayout;
+
+            std::shared_ptr<Time::Timer> timer;
+
+            std::shared_ptr<ValueObserver<std::shared_ptr<MediaWidget> > > activeWidgetObserver;
+            std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > imageObserver;
         };
 
         void HistogramWidget::_init(const std::shared_ptr<Core::Context>& context)
         {
             MDIWidget::_init(context);
+
+            DJV_PRIVATE_PTR();
             setClassName("djv::ViewApp::HistogramWidget");
+
+            p.scopeWidget = ScopeWidget::create(context);
+            p.scopeWidget->setShadowOverlay({ UI::Side::Top });
+
+            p.modeComboBox = UI::ComboBox::create(context);
+
+            p.formLayout = UI::FormLayout::create(context);
+            p.formLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            p.formLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            for (const auto& i : { "Minimum", "Maximum", "Average", "Samples" })
+            {
+                auto label = UI::Label::create(context);
+                label->setFont(AV::Font::familyMono);
+                label->setHAlign(UI::HAlign::Left);
+                p.statsLabels[i] = label;
+                p.formLayout->addChild(label);
+            }
+
+            auto layout = UI::VerticalLayout::create(context);
+            layout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
+            layout->setBackgroundRole(UI::ColorRole::Background);
+            layout->addChild(p.scopeWidget);
+            layout->setStretch(p.scopeWidget, UI::RowStretch::Expand);
+            layout->addChild(p.formLayout);
+            auto hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
+            hLayout->addChild(p.modeComboBox);
+            hLayout->addExpander();
+            layout->addChild(hLayout);
+            addChild(layout);
+
+            _widgetUpdate();
+
+            auto weak = std::weak_ptr<HistogramWidget>(std::dynamic_pointer_cast<HistogramWidget>(shared_from_this()));
+            p.modeComboBox->setCallback(
+                [weak](int value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->mode = static_cast<ScopeMode>(value);
+                        widget->_p->options.waveformMode = ScopeMode::RGBParade == widget->_p->mode ?
+                            AV::Image::WaveformMode::RGBParade :
+                            AV::Image::WaveformMode::Luma;
+                        widget->_p->scopeWidget->setMode(widget->_p->mode);
+                        widget->_scopesUpdate();
+                    }
+                });
+
+            p.timer = Time::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                Time::getMilliseconds(Time::TimerValue::Fast),
+                [weak](float)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        if (widget->_p->future.valid() &&
+                            widget->_p->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            widget->_p->scopes = widget->_p->future.get();
+                            widget->_widgetUpdate();
+
+                            // Pick up any image that arrived while the scopes were
+                            // being computed.
+                            widget->_scopesUpdate();
+                        }
+                    }
+                });
+
+            if (auto windowSystem = context->getSystemT<WindowSystem>())
+            {
+                p.activeWidgetObserver = ValueObserver<std::shared_ptr<MediaWidget> >::create(
+                    windowSystem->observeActiveWidget(),
+                    [weak](const std::shared_ptr<MediaWidget>& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->activeWidget = value;
+                            if (widget->_p->activeWidget)
+                            {
+                                widget->_p->imageObserver = ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                                    widget->_p->activeWidget->getMedia()->observeCurrentImage(),
+                                    [weak](const std::shared_ptr<AV::Image::Image>& value)
+                                    {
+                                        if (auto widget = weak.lock())
+                                        {
+                                            widget->_p->image = value;
+                                            widget->_scopesUpdate();
+                                        }
+                                    });
+                            }
+                            else
+                            {
+                                widget->_p->image.reset();
+                                widget->_p->imageObserver.reset();
+                                widget->_scopesUpdate();
+                            }
+                        }
+                    });
+            }
         }
 
         HistogramWidget::HistogramWidget() :
@@ -63,9 +365,81 @@ namespace djv
         void HistogramWidget::_initEvent(Event::Init & event)
         {
             MDIWidget::_initEvent(event);
+            DJV_PRIVATE_PTR();
             setTitle(_getText(DJV_TEXT("Histogram")));
+            p.modeComboBox->setItems(
+                {
+                    _getText(DJV_TEXT("Histogram")),
+                    _getText(DJV_TEXT("Waveform")),
+                    _getText(DJV_TEXT("RGB Parade")),
+                    _getText(DJV_TEXT("Vectorscope"))
+                });
+            p.modeComboBox->setTooltip(_getText(DJV_TEXT("Scope tooltip")));
+            for (const auto& i : p.statsLabels)
+            {
+                p.formLayout->setText(i.second, _getText(i.first) + ":");
+            }
+            _widgetUpdate();
+        }
+
+        void HistogramWidget::_scopesUpdate()
+        {
+            DJV_PRIVATE_PTR();
+
+            // Only one computation runs at a time; the timer calls back in here
+            // when it finishes so the latest image is always used.
+            if (p.future.valid())
+                return;
+            if (p.image)
+            {
+                if (p.image->getUID() != p.scopes.uid || p.options != p.scopes.options)
+                {
+                    const auto image = p.image;
+                    const auto options = p.options;
+                    p.future = std::async(
+                        std::launch::async,
+                        [image, options]
+                        {
+                            return AV::Image::getScopes(image, options);
+                        });
+                }
+            }
+            else if (p.scopes.uid)
+            {
+                p.scopes = AV::Image::Scopes();
+                _widgetUpdate();
+            }
+        }
+
+        void HistogramWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            p.scopeWidget->setScopes(p.scopes);
+            p.modeComboBox->setCurrentItem(static_cast<int>(p.mode));
+
+            const auto& stats = p.scopes.stats;
+            const glm::vec4* values[] = { &stats.min, &stats.max, &stats.average };
+            const char* names[] = { "Minimum", "Maximum", "Average" };
+            for (size_t i = 0; i < 3; ++i)
+            {
+                std::stringstream ss;
+                ss << std::fixed << std::setprecision(3);
+                for (uint8_t c = 0; c < stats.channelCount; ++c)
+                {
+                    if (c > 0)
+                    {
+                        ss << " ";
+                    }
+                    ss << (*values[i])[c];
+                }
+                p.statsLabels[names[i]]->setText(ss.str());
+            }
+            {
+                std::stringstream ss;
+                ss << stats.sampleCount;
+                p.statsLabels["Samples"]->setText(ss.str());
+            }
         }
 
     } // namespace ViewApp
 } // namespace djv
-
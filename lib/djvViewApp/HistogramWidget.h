@@ -35,7 +35,9 @@ namespace djv
 {
     namespace ViewApp
     {
-        //! This class provides the histogram widget.
+        //! This class provides the histogram widget. The histogram, waveform,
+        //! and vectorscope are computed from the current image on a background
+        //! thread.
         class HistogramWidget : public MDIWidget
         {
             DJV_NON_COPYABLE(HistogramWidget);
@@ -53,6 +55,9 @@ namespace djv
             void _initEvent(Core::Event::Init &) override;
 
         private:
+            void _scopesUpdate();
+            void _widgetUpdate();
+
             DJV_PRIVATE();
         };
 
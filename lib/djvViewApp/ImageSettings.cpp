@@ -86,11 +86,13 @@ namespace djv
         void ImageSettings::setColorSpaceCurrentTab(int value)
         {
             _p->colorSpaceCurrentTab = value;
+            _changed();
         }
 
         void ImageSettings::setColorCurrentTab(int value)
         {
             _p->colorCurrentTab = value;
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<ImageRotate> > ImageSettings::observeRotate() const
@@ -106,11 +108,13 @@ namespace djv
         void ImageSettings::setRotate(ImageRotate value)
         {
             _p->rotate->setIfChanged(value);
+            _changed();
         }
 
         void ImageSettings::setAspectRatio(UI::ImageAspectRatio value)
         {
             _p->aspectRatio->setIfChanged(value);
+            _changed();
         }
 
         const std::map<std::string, BBox2f>& ImageSettings::getWidgetGeom() const
@@ -121,6 +125,7 @@ namespace djv
         void ImageSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void ImageSettings::load(const picojson::value & value)
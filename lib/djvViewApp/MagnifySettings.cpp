@@ -74,6 +74,7 @@ namespace djv
         void MagnifySettings::setMagnify(int value)
         {
             _p->magnify = value;
+            _changed();
         }
 
         const glm::vec2& MagnifySettings::getMagnifyPos() const
@@ -84,6 +85,7 @@ namespace djv
         void MagnifySettings::setMagnifyPos(const glm::vec2& value)
         {
             _p->magnifyPos = value;
+            _changed();
         }
 
         const std::map<std::string, BBox2f>& MagnifySettings::getWidgetGeom() const
@@ -94,6 +96,7 @@ namespace djv
         void MagnifySettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void MagnifySettings::load(const picojson::value & value)
@@ -32,6 +32,7 @@
 #include <djvViewApp/Annotate.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/AudioMixer.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
@@ -50,6 +51,17 @@ namespace djv
             //! \todo Should this be configurable?
             const size_t bufferFrameCount = 256;
             const size_t videoQueueSize = 10;
+
+            struct AudioTrack
+            {
+                std::shared_ptr<AV::IO::IRead> read;
+                size_t track = 0;
+                AV::IO::AudioInfo info;
+                bool clip = false;
+                Math::Rational clipTimeBase;
+                float gain = 1.F;
+                std::vector<int8_t> channelMap;
+            };
             
         } // namespace
 
@@ -86,11 +98,12 @@ namespace djv
             std::shared_ptr<ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<ValueSubject<size_t> > audioQueueCount;
             std::shared_ptr<AV::IO::IRead> read;
+            std::vector<AudioTrack> audioTracks;
+            std::vector<Core::FileSystem::FileInfo> audioClips;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
             std::unique_ptr<RtAudio> rtAudio;
-            std::shared_ptr<AV::Audio::Data> audioData;
-            size_t audioDataSamplesOffset = 0;
+            std::shared_ptr<AV::Audio::Mixer> audioMixer;
             size_t audioDataSamplesCount = 0;
             std::chrono::high_resolution_clock::time_point audioDataSamplesTime;
             Frame::Index frameOffset = 0;
@@ -529,6 +542,52 @@ namespace djv
             _p->mute->setIfChanged(value);
         }
 
+        size_t Media::getAudioTrackCount() const
+        {
+            return _p->audioTracks.size();
+        }
+
+        void Media::addAudioTrack(const Core::FileSystem::FileInfo& value)
+        {
+            DJV_PRIVATE_PTR();
+            p.audioClips.push_back(value);
+            _stopAudioStream();
+            _openAudioClip(value);
+            _openAudioStream();
+            p.audioEnabled->setIfChanged(_isAudioEnabled());
+            _seek(p.currentFrame->get());
+            if (_hasAudioSyncPlayback())
+            {
+                _startAudioStream();
+            }
+        }
+
+        void Media::setAudioTrackGain(size_t index, float value)
+        {
+            DJV_PRIVATE_PTR();
+            if (index < p.audioTracks.size())
+            {
+                p.audioTracks[index].gain = value;
+                if (p.audioMixer)
+                {
+                    p.audioMixer->setGain(index, value);
+                }
+            }
+        }
+
+        void Media::setAudioTrackChannelMap(size_t index, const std::vector<int8_t>& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (index < p.audioTracks.size())
+            {
+                p.audioTracks[index].channelMap = value;
+                if (p.audioMixer)
+                {
+                    p.audioMixer->setChannelMap(index, value);
+                }
+            }
+        }
+
         std::shared_ptr<IValueSubject<size_t> > Media::observeThreadCount() const
         {
             return _p->threadCount;
@@ -655,9 +714,14 @@ namespace djv
             {
                 try
                 {
+                    _stopAudioStream();
+                    p.audioTracks.clear();
+                    p.audioInfo = AV::IO::AudioInfo();
+
                     AV::IO::ReadOptions options;
                     options.layer = p.layer->get();
                     options.videoQueueSize = videoQueueSize;
+                    options.allAudioTracks = true;
                     auto io = context->getSystemT<AV::IO::System>();
                     p.read = io->read(p.fileInfo, options);
                     p.read->setThreadCount(p.threadCount->get());
@@ -674,9 +738,15 @@ namespace djv
                         sequence = video[0].sequence;
                     }
                     const auto& audio = info.audio;
-                    if (audio.size())
+                    for (size_t i = 0; i < audio.size(); ++i)
+                    {
+                        // All of the tracks are decoded by the same reader, each
+                        // into its own queue.
+                        _addAudioTrack(p.read, info, i, false);
+                    }
+                    for (const auto& i : p.audioClips)
                     {
-                        p.audioInfo = audio[0];
+                        _openAudioClip(i);
                     }
                     {
                         std::stringstream ss;
@@ -701,37 +771,7 @@ namespace djv
                         frame = Math::clamp(currentFrame, static_cast<Frame::Index>(0), static_cast<Frame::Index>(sequenceSize) - 1);
                     }
                     p.currentFrame->setIfChanged(frame);
-                    if (_hasAudio())
-                    {
-                        if (p.rtAudio->isStreamOpen())
-                        {
-                            p.rtAudio->closeStream();
-                        }
-                        RtAudio::StreamParameters rtParameters;
-                        rtParameters.deviceId = p.rtAudio->getDefaultOutputDevice();
-                        rtParameters.nChannels = p.audioInfo.info.channelCount;
-                        unsigned int rtBufferFrames = bufferFrameCount;
-                        try
-                        {
-                            p.rtAudio->openStream(
-                                &rtParameters,
-                                nullptr,
-                                AV::Audio::toRtAudio(p.audioInfo.info.type),
-                                p.audioInfo.info.sampleRate,
-                                &rtBufferFrames,
-                                _rtAudioCallback,
-                                this,
-                                nullptr,
-                                _rtAudioErrorCallback);
-                        }
-                        catch (const std::exception& e)
-                        {
-                            std::stringstream ss;
-                            ss << DJV_TEXT("The audio stream cannot be opened") << ". " << e.what();
-                            auto logSystem = context->getSystemT<LogSystem>();
-                            logSystem->log("djv::ViewApp::Media", ss.str(), LogLevel::Error);
-                        }
-                    }
+                    _openAudioStream();
                     p.audioEnabled->setIfChanged(_isAudioEnabled());
 
                     auto weak = std::weak_ptr<Media>(std::dynamic_pointer_cast<Media>(shared_from_this()));
@@ -794,6 +834,128 @@ namespace djv
             }
         }
 
+        void Media::_openAudioStream()
+        {
+            DJV_PRIVATE_PTR();
+            if (auto context = p.context.lock())
+            {
+                if (p.rtAudio && p.rtAudio->isStreamOpen())
+                {
+                    p.rtAudio->closeStream();
+                }
+                p.audioMixer.reset();
+                if (_hasAudio())
+                {
+                    // The tracks are mixed as 32-bit float using the channel
+                    // layout and sample rate of the first track.
+                    const auto& info = p.audioInfo.info;
+                    p.audioMixer = AV::Audio::Mixer::create(info.channelCount, info.sampleRate);
+                    for (const auto& i : p.audioTracks)
+                    {
+                        const size_t index = p.audioMixer->addSource(i.read, i.track, i.info.info);
+                        p.audioMixer->setGain(index, i.gain);
+                        p.audioMixer->setChannelMap(index, i.channelMap);
+                    }
+
+                    RtAudio::StreamParameters rtParameters;
+                    rtParameters.deviceId = p.rtAudio->getDefaultOutputDevice();
+                    rtParameters.nChannels = info.channelCount;
+                    unsigned int rtBufferFrames = bufferFrameCount;
+                    try
+                    {
+                        p.rtAudio->openStream(
+                            &rtParameters,
+                            nullptr,
+                            RTAUDIO_FLOAT32,
+                            info.sampleRate,
+                            &rtBufferFrames,
+                            _rtAudioCallback,
+                            this,
+                            nullptr,
+                            _rtAudioErrorCallback);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The audio stream cannot be opened") << ". " << e.what();
+                        auto logSystem = context->getSystemT<LogSystem>();
+                        logSystem->log("djv::ViewApp::Media", ss.str(), LogLevel::Error);
+                    }
+                }
+            }
+        }
+
+        void Media::_openAudioClip(const Core::FileSystem::FileInfo& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (auto context = p.context.lock())
+            {
+                try
+                {
+                    AV::IO::ReadOptions options;
+                    options.videoEnabled = false;
+                    auto io = context->getSystemT<AV::IO::System>();
+                    auto read = io->read(value, options);
+                    const auto info = read->getInfo().get();
+                    if (info.audio.empty())
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The file") << " '" << value << "' " << DJV_TEXT("does not have any audio") << ".";
+                        throw std::runtime_error(ss.str());
+                    }
+                    _addAudioTrack(read, info, 0, true);
+                }
+                catch (const std::exception& e)
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The file") << " '" << value << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
+                    auto logSystem = context->getSystemT<LogSystem>();
+                    logSystem->log("djv::ViewApp::Media", ss.str(), LogLevel::Error);
+                }
+            }
+        }
+
+        bool Media::_addAudioTrack(
+            const std::shared_ptr<AV::IO::IRead>& read,
+            const AV::IO::Info& info,
+            size_t track,
+            bool clip)
+        {
+            DJV_PRIVATE_PTR();
+            bool out = false;
+            if (auto context = p.context.lock())
+            {
+                const auto& audioInfo = info.audio[track];
+                if (!p.audioInfo.info.isValid())
+                {
+                    p.audioInfo = audioInfo;
+                }
+                if (audioInfo.info.sampleRate == p.audioInfo.info.sampleRate)
+                {
+                    AudioTrack audioTrack;
+                    audioTrack.read = read;
+                    audioTrack.track = track;
+                    audioTrack.info = audioInfo;
+                    audioTrack.clip = clip;
+                    audioTrack.clipTimeBase = info.video.size() ?
+                        info.video[0].speed.swap() :
+                        Math::Rational(1, static_cast<int>(audioInfo.info.sampleRate));
+                    p.audioTracks.push_back(audioTrack);
+                    out = true;
+                }
+                else
+                {
+                    //! \todo Resample audio tracks that don't match the first track.
+                    std::stringstream ss;
+                    ss << info.fileName << " " << DJV_TEXT("audio track") << " " << track << ": " <<
+                        DJV_TEXT("the sample rate does not match the first track") << ".";
+                    auto logSystem = context->getSystemT<LogSystem>();
+                    logSystem->log("djv::ViewApp::Media", ss.str(), LogLevel::Warning);
+                }
+            }
+            return out;
+        }
+
         void Media::_setCurrentFrame(Frame::Index value)
         {
             DJV_PRIVATE_PTR();
@@ -879,12 +1041,24 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                _stopAudioStream();
                 if (p.read)
                 {
                     p.read->seek(value, p.ioDirection);
                 }
-                p.audioData.reset();
-                p.audioDataSamplesOffset = 0;
+                for (const auto& i : p.audioTracks)
+                {
+                    if (i.read != p.read)
+                    {
+                        i.read->seek(
+                            i.clip ? Time::scale(value, p.defaultSpeed->get().swap(), i.clipTimeBase) : value,
+                            p.ioDirection);
+                    }
+                }
+                if (p.audioMixer)
+                {
+                    p.audioMixer->reset();
+                }
                 p.audioDataSamplesCount = 0;
                 const auto now = std::chrono::high_resolution_clock::now();
                 p.audioDataSamplesTime = now;
@@ -893,7 +1067,6 @@ namespace djv
                 p.realSpeedTime = p.startTime;
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = now;
-                _stopAudioStream();
             }
         }
 
@@ -910,6 +1083,10 @@ namespace djv
                     {
                         p.read->setPlayback(false);
                     }
+                    for (const auto& i : p.audioTracks)
+                    {
+                        i.read->setPlayback(false);
+                    }
                     _stopAudioStream();
                     p.playbackTimer->stop();
                     p.realSpeedTimer->stop();
@@ -923,10 +1100,12 @@ namespace djv
                     {
                         p.read->setPlayback(true);
                     }
+                    for (const auto& i : p.audioTracks)
+                    {
+                        i.read->setPlayback(true);
+                    }
                     p.ioDirection = forward ? AV::IO::Direction::Forward : AV::IO::Direction::Reverse;
                     _seek(p.currentFrame->get());
-                    p.audioData.reset();
-                    p.audioDataSamplesOffset = 0;
                     p.audioDataSamplesCount = 0;
                     const auto now = std::chrono::high_resolution_clock::now();
                     p.audioDataSamplesTime = now;
@@ -1023,6 +1202,10 @@ namespace djv
             {
                 try
                 {
+                    if (p.audioMixer)
+                    {
+                        p.audioMixer->setActive(true);
+                    }
                     p.rtAudio->startStream();
                 }
                 catch (const std::exception& e)
@@ -1040,6 +1223,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                if (p.audioMixer)
+                {
+                    p.audioMixer->setActive(false);
+                }
                 if (_hasAudio() && p.rtAudio->isStreamRunning())
                 {
                     try
@@ -1114,11 +1301,14 @@ namespace djv
                 // Update the audio queue.
                 if (_hasAudio() && !_hasAudioSyncPlayback())
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
-                    auto& queue = p.read->getAudioQueue();
-                    while (queue.getCount() > queue.getMax())
+                    for (const auto& i : p.audioTracks)
                     {
-                        queue.popFrame();
+                        std::lock_guard<std::mutex> lock(i.read->getMutex());
+                        auto& queue = i.read->getAudioTrackQueue(i.track);
+                        while (queue.getCount() > queue.getMax())
+                        {
+                            queue.popFrame();
+                        }
                     }
                 }
             }
@@ -1133,90 +1323,21 @@ namespace djv
             void* userData)
         {
             Media* media = reinterpret_cast<Media*>(userData);
-            const auto& info = media->_p->audioInfo;
-
-            size_t outputSampleCount = static_cast<size_t>(nFrames);
-            size_t sampleCount = 0;
-            const size_t sampleByteCount = info.info.channelCount * AV::Audio::getByteCount(info.info.type);
+            const uint8_t channelCount = media->_p->audioInfo.info.channelCount;
             const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
 
-            if (media->_p->audioData)
-            {
-                sampleCount += media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset;
-            }
-
-            // Get audio frames from the read queue.
-            std::vector<AV::IO::AudioFrame> frames;
-            {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
-                auto& queue = media->_p->read->getAudioQueue();
-                while (!queue.isEmpty() && sampleCount < outputSampleCount)
-                {
-                    auto frame = queue.getFrame();
-                    frames.push_back(frame);
-                    queue.popFrame();
-                    sampleCount += frame.audio->getSampleCount();
-                }
-            }
-
-            // Use the remaining data from the frame.
-            uint8_t* p = reinterpret_cast<uint8_t*>(outputBuffer);
-            if (media->_p->audioData)
+            // The mixer never blocks, so any samples it is missing are
+            // filled with silence.
+            AV::Audio::F32_T* p = reinterpret_cast<AV::Audio::F32_T*>(outputBuffer);
+            const size_t size = media->_p->audioMixer->read(p, nFrames, volume);
+            if (size)
             {
-                const size_t size = std::min(
-                    media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset,
-                    outputSampleCount);
-                //memcpy(
-                //    p,
-                //    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                //    size * sampleByteCount);
-                AV::Audio::Data::volume(
-                    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                    p,
-                    volume,
-                    size,
-                    info.info.channelCount,
-                    info.info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset += size;
                 media->_p->audioDataSamplesCount += size;
                 media->_p->audioDataSamplesTime = std::chrono::high_resolution_clock::now();
-                outputSampleCount -= size;
-                if (media->_p->audioDataSamplesOffset >= media->_p->audioData->getSampleCount())
-                {
-                    media->_p->audioData.reset();
-                    media->_p->audioDataSamplesOffset = 0;
-                }
-            }
-
-            // Process the frames.
-            for (const auto& i : frames)
-            {
-                media->_p->audioData = i.audio;
-                size_t size = std::min(i.audio->getSampleCount(), outputSampleCount);
-                //memcpy(
-                //    p,
-                //    i.audio->getData(),
-                //    size * sampleByteCount);
-                AV::Audio::Data::volume(
-                    i.audio->getData(),
-                    p,
-                    volume,
-                    size,
-                    info.info.channelCount,
-                    info.info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset = size;
-                media->_p->audioDataSamplesCount += size;
-                media->_p->audioDataSamplesTime = std::chrono::high_resolution_clock::now();
-                outputSampleCount -= size;
             }
-
-            const size_t zero = (nFrames * sampleByteCount) - (p - reinterpret_cast<uint8_t*>(outputBuffer));
-            if (zero)
+            if (size < nFrames)
             {
-                //! \todo Is this the correct way to clear the audio data?
-                memset(p, 0, zero);
+                memset(p + size * channelCount, 0, (nFrames - size) * channelCount * sizeof(AV::Audio::F32_T));
             }
 
             return 0;
@@ -146,6 +146,16 @@ namespace djv
             void setVolume(float);
             void setMute(bool);
 
+            //! Get the number of audio tracks that are mixed together. This
+            //! includes the tracks in the file and any added audio clips.
+            size_t getAudioTrackCount() const;
+
+            //! Add an audio clip to be played with the media.
+            void addAudioTrack(const Core::FileSystem::FileInfo&);
+
+            void setAudioTrackGain(size_t, float);
+            void setAudioTrackChannelMap(size_t, const std::vector<int8_t>&);
+
             ///@}
 
             //! \name I/O
@@ -196,6 +206,13 @@ namespace djv
             bool _isAudioEnabled() const;
             bool _hasAudioSyncPlayback() const;
             void _open();
+            void _openAudioStream();
+            void _openAudioClip(const Core::FileSystem::FileInfo&);
+            bool _addAudioTrack(
+                const std::shared_ptr<AV::IO::IRead>&,
+                const AV::IO::Info&,
+                size_t track,
+                bool clip);
             void _setCurrentFrame(Core::Frame::Index);
             void _seek(Core::Frame::Index);
             void _playbackUpdate();
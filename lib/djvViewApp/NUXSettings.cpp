@@ -74,6 +74,7 @@ namespace djv
         void NUXSettings::setNUX(bool value)
         {
             _p->nux->setIfChanged(value);
+            _changed();
         }
 
         void NUXSettings::load(const picojson::value & value)
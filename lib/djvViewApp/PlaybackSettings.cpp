@@ -80,6 +80,7 @@ namespace djv
         void PlaybackSettings::setStartPlayback(bool value)
         {
             _p->startPlayback->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<bool> > PlaybackSettings::observePlayEveryFrame() const
@@ -90,6 +91,7 @@ namespace djv
         void PlaybackSettings::setPlayEveryFrame(bool value)
         {
             _p->playEveryFrame->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<PlaybackMode> > PlaybackSettings::observePlaybackMode() const
@@ -100,6 +102,7 @@ namespace djv
         void PlaybackSettings::setPlaybackMode(PlaybackMode value)
         {
             _p->playbackMode->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<bool> > PlaybackSettings::observePIP() const
@@ -110,6 +113,7 @@ namespace djv
         void PlaybackSettings::setPIP(bool value)
         {
             _p->pip->setIfChanged(value);
+            _changed();
         }
 
         void PlaybackSettings::load(const picojson::value & value)
@@ -29,24 +29,24 @@
 
 #include <djvViewApp/SystemLogWidget.h>
 
-#include <djvDesktopApp/GLFWSystem.h>
-
+#include <djvUI/ComboBox.h>
 #include <djvUI/EventSystem.h>
 #include <djvUI/PushButton.h>
 #include <djvUI/RowLayout.h>
 #include <djvUI/ScrollWidget.h>
-#include <djvUI/TextBlock.h>
 #include <djvUI/StackLayout.h>
-#include <djvUI/Window.h>
+
+#include <djvAV/FontSystem.h>
+#include <djvAV/Render2D.h>
 
 #include <djvCore/Context.h>
-#include <djvCore/FileIO.h>
-#include <djvCore/Path.h>
-#include <djvCore/ResourceSystem.h>
+#include <djvCore/LogSystem.h>
 #include <djvCore/String.h>
+#include <djvCore/Time.h>
+#include <djvCore/Timer.h>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
+#include <deque>
+#include <iomanip>
 
 using namespace djv::Core;
 
@@ -56,6 +56,9 @@ namespace djv
     {
         namespace
         {
+            //! \todo Should this be configurable?
+            const size_t linesMax = 10000;
+
             class SizeWidget : public UI::Widget
             {
                 DJV_NON_COPYABLE(SizeWidget);
@@ -86,17 +89,379 @@ namespace djv
                 const float s = style->getMetric(UI::MetricsRole::Dialog);
                 _setMinimumSize(glm::vec2(s * 2.F, s));
             }
-        
+
+            //! This widget keeps a ring of log lines and an index of the lines
+            //! that pass the current filter. Only the visible lines are drawn,
+            //! so the cost does not depend on the size of the log.
+            class LogView : public UI::Widget
+            {
+                DJV_NON_COPYABLE(LogView);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                LogView();
+
+            public:
+                static std::shared_ptr<LogView> create(const std::shared_ptr<Context>&);
+
+                //! Add records, returns true if new modules were found.
+                bool addRecords(const std::vector<LogSystem::Record>&);
+                void clear();
+
+                const std::vector<std::string>& getModules() const;
+                void setFilter(LogLevel, int module);
+
+                std::string getText() const;
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _clipEvent(Event::Clip&) override;
+                void _paintEvent(Event::Paint&) override;
+
+                void _initEvent(Event::Init&) override;
+                void _updateEvent(Event::Update&) override;
+
+            private:
+                struct Line
+                {
+                    uint64_t id = 0;
+                    LogLevel level = LogLevel::Information;
+                    size_t module = 0;
+                    std::string text;
+                };
+
+                bool _filter(const Line&) const;
+                const Line& _getLine(uint64_t id) const;
+                void _indexUpdate();
+                void _textUpdate();
+
+                std::shared_ptr<AV::Font::System> _fontSystem;
+                std::deque<Line> _lines;
+                uint64_t _lineID = 0;
+                size_t _lineLengthMax = 0;
+                std::vector<std::string> _modules;
+                std::map<std::string, size_t> _moduleIndex;
+                LogLevel _level = LogLevel::Information;
+                int _module = -1;
+                std::deque<uint64_t> _index;
+                std::pair<size_t, size_t> _visible = std::make_pair(0, 0);
+                AV::Font::Metrics _fontMetrics;
+                std::future<AV::Font::Metrics> _fontMetricsFuture;
+                float _charWidth = 0.F;
+                std::future<glm::vec2> _charWidthFuture;
+                std::map<uint64_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > _glyphs;
+                std::map<uint64_t, std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > > _glyphsFutures;
+            };
+
+            void LogView::_init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::LogView");
+                _fontSystem = context->getSystemT<AV::Font::System>();
+            }
+
+            LogView::LogView()
+            {}
+
+            std::shared_ptr<LogView> LogView::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<LogView>(new LogView);
+                out->_init(context);
+                return out;
+            }
+
+            bool LogView::addRecords(const std::vector<LogSystem::Record>& value)
+            {
+                const std::map<LogLevel, std::string> labels =
+                {
+                    { LogLevel::Information, std::string() },
+                    { LogLevel::Warning, "[Warning] " },
+                    { LogLevel::Error, "[ERROR] " }
+                };
+                bool out = false;
+                for (const auto& record : value)
+                {
+                    size_t module = 0;
+                    const auto i = _moduleIndex.find(record.prefix);
+                    if (i != _moduleIndex.end())
+                    {
+                        module = i->second;
+                    }
+                    else
+                    {
+                        module = _modules.size();
+                        _modules.push_back(record.prefix);
+                        _moduleIndex[record.prefix] = module;
+                        out = true;
+                    }
+
+                    std::tm tm;
+                    Time::localtime(&record.time, &tm);
+                    std::stringstream ss;
+                    ss << std::put_time(&tm, "%c") << " ";
+                    ss << record.prefix << " | ";
+                    const std::string prefix = ss.str() + labels.at(record.level);
+
+                    std::string text;
+                    std::stringstream s(record.text);
+                    while (std::getline(s, text))
+                    {
+                        Line line;
+                        line.id = _lineID++;
+                        line.level = record.level;
+                        line.module = module;
+                        line.text = prefix + text;
+                        _lineLengthMax = std::max(_lineLengthMax, line.text.size());
+                        if (_filter(line))
+                        {
+                            _index.push_back(line.id);
+                        }
+                        _lines.push_back(std::move(line));
+                    }
+                }
+
+                // Drop the oldest lines from the ring and the index.
+                while (_lines.size() > linesMax)
+                {
+                    _lines.pop_front();
+                }
+                while (_index.size() && _lines.size() && _index.front() < _lines.front().id)
+                {
+                    _index.pop_front();
+                }
+                _resize();
+                return out;
+            }
+
+            void LogView::clear()
+            {
+                _lines.clear();
+                _lineLengthMax = 0;
+                _index.clear();
+                _glyphs.clear();
+                _glyphsFutures.clear();
+                _resize();
+            }
+
+            const std::vector<std::string>& LogView::getModules() const
+            {
+                return _modules;
+            }
+
+            void LogView::setFilter(LogLevel level, int module)
+            {
+                if (level == _level && module == _module)
+                    return;
+                _level = level;
+                _module = module;
+                _indexUpdate();
+            }
+
+            std::string LogView::getText() const
+            {
+                std::vector<std::string> out;
+                for (const auto i : _index)
+                {
+                    out.push_back(_getLine(i).text);
+                }
+                return String::join(out, '\n');
+            }
+
+            void LogView::_preLayoutEvent(Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                const float m = style->getMetric(UI::MetricsRole::Margin);
+                _setMinimumSize(glm::vec2(
+                    _charWidth * _lineLengthMax + m * 2.F,
+                    _fontMetrics.lineHeight * _index.size() + m * 2.F));
+            }
+
+            void LogView::_clipEvent(Event::Clip& event)
+            {
+                if (isClipped())
+                {
+                    _visible = std::make_pair(0, 0);
+                    return;
+                }
+                const BBox2f& g = getGeometry();
+                const auto& style = _getStyle();
+                const float m = style->getMetric(UI::MetricsRole::Margin);
+                const BBox2f& clipRect = event.getClipRect();
+                const float lh = _fontMetrics.lineHeight;
+                if (lh > 0.F && _index.size())
+                {
+                    _visible.first = std::min(
+                        static_cast<size_t>(std::max((clipRect.min.y - g.min.y - m) / lh, 0.F)),
+                        _index.size());
+                    _visible.second = std::min(
+                        static_cast<size_t>(std::max(ceilf((clipRect.max.y - g.min.y - m) / lh), 0.F)),
+                        _index.size());
+                }
+                else
+                {
+                    _visible = std::make_pair(0, 0);
+                }
+
+                // Request glyphs for the visible lines and release the rest.
+                std::map<uint64_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > glyphs;
+                const auto fontInfo = style->getFontInfo(AV::Font::familyMono, AV::Font::faceDefault, UI::MetricsRole::FontSmall);
+                for (size_t i = _visible.first; i < _visible.second; ++i)
+                {
+                    const uint64_t id = _index[i];
+                    const auto j = _glyphs.find(id);
+                    if (j != _glyphs.end())
+                    {
+                        glyphs[id] = std::move(j->second);
+                    }
+                    else if (_glyphsFutures.find(id) == _glyphsFutures.end())
+                    {
+                        _glyphsFutures[id] = _fontSystem->getGlyphs(_getLine(id).text, fontInfo);
+                    }
+                }
+                _glyphs = std::move(glyphs);
+                auto i = _glyphsFutures.begin();
+                while (i != _glyphsFutures.end())
+                {
+                    if (_lines.empty() || i->first < _lines.front().id)
+                    {
+                        i = _glyphsFutures.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
+            void LogView::_paintEvent(Event::Paint& event)
+            {
+                Widget::_paintEvent(event);
+                const BBox2f& g = getGeometry();
+                const auto& style = _getStyle();
+                const float m = style->getMetric(UI::MetricsRole::Margin);
+                const float lh = _fontMetrics.lineHeight;
+                auto render = _getRender();
+                render->setCurrentFont(style->getFontInfo(AV::Font::familyMono, AV::Font::faceDefault, UI::MetricsRole::FontSmall));
+                render->setFillColor(style->getColor(UI::ColorRole::Foreground));
+                const size_t last = std::min(_visible.second, _index.size());
+                for (size_t i = _visible.first; i < last; ++i)
+                {
+                    const auto j = _glyphs.find(_index[i]);
+                    if (j != _glyphs.end())
+                    {
+                        render->drawText(
+                            j->second,
+                            glm::vec2(g.min.x + m, g.min.y + m + lh * i + _fontMetrics.ascender));
+                    }
+                }
+            }
+
+            void LogView::_initEvent(Event::Init& event)
+            {
+                Widget::_initEvent(event);
+                _textUpdate();
+            }
+
+            void LogView::_updateEvent(Event::Update& event)
+            {
+                Widget::_updateEvent(event);
+                if (_fontMetricsFuture.valid() &&
+                    _fontMetricsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    try
+                    {
+                        _fontMetrics = _fontMetricsFuture.get();
+                        _resize();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), LogLevel::Error);
+                    }
+                }
+                if (_charWidthFuture.valid() &&
+                    _charWidthFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    try
+                    {
+                        _charWidth = _charWidthFuture.get().x;
+                        _resize();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), LogLevel::Error);
+                    }
+                }
+                auto i = _glyphsFutures.begin();
+                while (i != _glyphsFutures.end())
+                {
+                    if (i->second.valid() &&
+                        i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        try
+                        {
+                            _glyphs[i->first] = i->second.get();
+                            _redraw();
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _log(e.what(), LogLevel::Error);
+                        }
+                        i = _glyphsFutures.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
+            bool LogView::_filter(const Line& value) const
+            {
+                return value.level >= _level && (-1 == _module || value.module == static_cast<size_t>(_module));
+            }
+
+            const LogView::Line& LogView::_getLine(uint64_t id) const
+            {
+                return _lines[id - _lines.front().id];
+            }
+
+            void LogView::_indexUpdate()
+            {
+                _index.clear();
+                for (const auto& i : _lines)
+                {
+                    if (_filter(i))
+                    {
+                        _index.push_back(i.id);
+                    }
+                }
+                _resize();
+            }
+
+            void LogView::_textUpdate()
+            {
+                const auto& style = _getStyle();
+                const auto fontInfo = style->getFontInfo(AV::Font::familyMono, AV::Font::faceDefault, UI::MetricsRole::FontSmall);
+                _fontMetricsFuture = _fontSystem->getMetrics(fontInfo);
+                _charWidthFuture = _fontSystem->measure("0", fontInfo);
+                _glyphs.clear();
+                _glyphsFutures.clear();
+                _resize();
+            }
+
         } // namespace
 
         struct SystemLogWidget::Private
         {
-            std::vector<std::string> log;
-            bool shown = false;
-            std::shared_ptr<UI::TextBlock> textBlock;
+            std::shared_ptr<LogSystem> logSystem;
+            uint64_t recordID = 0;
+            std::shared_ptr<LogView> logView;
+            std::shared_ptr<UI::ComboBox> levelComboBox;
+            std::shared_ptr<UI::ComboBox> moduleComboBox;
             std::shared_ptr<UI::PushButton> copyButton;
             std::shared_ptr<UI::PushButton> reloadButton;
             std::shared_ptr<UI::PushButton> clearButton;
+            std::shared_ptr<Time::Timer> timer;
         };
 
         void SystemLogWidget::_init(const std::shared_ptr<Core::Context>& context)
@@ -106,16 +471,17 @@ namespace djv
             DJV_PRIVATE_PTR();
             setClassName("djv::ViewApp::SystemLogWidget");
 
-            p.textBlock = UI::TextBlock::create(context);
-            p.textBlock->setFontFamily(AV::Font::familyMono);
-            p.textBlock->setFontSizeRole(UI::MetricsRole::FontSmall);
-            p.textBlock->setMargin(UI::Layout::Margin(UI::MetricsRole::Margin));
+            p.logSystem = context->getSystemT<LogSystem>();
 
-            auto scrollWidget = UI::ScrollWidget::create(UI::ScrollType::Vertical, context);
+            p.logView = LogView::create(context);
+
+            auto scrollWidget = UI::ScrollWidget::create(UI::ScrollType::Both, context);
             scrollWidget->setBorder(false);
             scrollWidget->setShadowOverlay({ UI::Side::Top });
-            scrollWidget->addChild(p.textBlock);
+            scrollWidget->addChild(p.logView);
 
+            p.levelComboBox = UI::ComboBox::create(context);
+            p.moduleComboBox = UI::ComboBox::create(context);
             p.copyButton = UI::PushButton::create(context);
             p.reloadButton = UI::PushButton::create(context);
             p.clearButton = UI::PushButton::create(context);
@@ -128,6 +494,8 @@ namespace djv
             auto hLayout = UI::HorizontalLayout::create(context);
             hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
             hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.levelComboBox);
+            hLayout->addChild(p.moduleComboBox);
             hLayout->addExpander();
             hLayout->addChild(p.copyButton);
             hLayout->addChild(p.reloadButton);
@@ -140,6 +508,23 @@ namespace djv
             addChild(stackLayout);
 
             auto weak = std::weak_ptr<SystemLogWidget>(std::dynamic_pointer_cast<SystemLogWidget>(shared_from_this()));
+            p.levelComboBox->setCallback(
+                [weak](int)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_filterUpdate();
+                    }
+                });
+            p.moduleComboBox->setCallback(
+                [weak](int)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_filterUpdate();
+                    }
+                });
+
             auto contextWeak = std::weak_ptr<Context>(context);
             p.copyButton->setClickedCallback(
                 [weak, contextWeak]
@@ -149,7 +534,7 @@ namespace djv
                         if (auto widget = weak.lock())
                         {
                             auto eventSystem = context->getSystemT<UI::EventSystem>();
-                            eventSystem->setClipboard(String::join(widget->_p->log, '\n'));
+                            eventSystem->setClipboard(widget->_p->logView->getText());
                         }
                     }
                 });
@@ -169,6 +554,18 @@ namespace djv
                     widget->clearLog();
                 }
             });
+
+            p.timer = Time::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                Time::getMilliseconds(Time::TimerValue::Medium),
+                [weak](float)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_recordsUpdate();
+                    }
+                });
         }
 
         SystemLogWidget::SystemLogWidget() :
@@ -188,23 +585,15 @@ namespace djv
         void SystemLogWidget::reloadLog()
         {
             DJV_PRIVATE_PTR();
-            try
-            {
-                p.log = FileSystem::FileIO::readLines(std::string(
-                    _getResourceSystem()->getPath(FileSystem::ResourcePath::LogFile)));
-                p.textBlock->setText(String::join(p.log, '\n'));
-            }
-            catch (const std::exception & e)
-            {
-                _log(e.what(), LogLevel::Error);
-            }
+            p.recordID = 0;
+            p.logView->clear();
+            _recordsUpdate();
         }
 
         void SystemLogWidget::clearLog()
         {
             DJV_PRIVATE_PTR();
-            p.log.clear();
-            p.textBlock->setText(std::string());
+            p.logView->clear();
         }
 
         void SystemLogWidget::_initEvent(Event::Init & event)
@@ -212,6 +601,17 @@ namespace djv
             MDIWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             setTitle(_getText(DJV_TEXT("System Log")));
+            const int level = p.levelComboBox->getCurrentItem();
+            p.levelComboBox->setItems(
+                {
+                    _getText(DJV_TEXT("System log all messages")),
+                    _getText(DJV_TEXT("System log warnings and errors")),
+                    _getText(DJV_TEXT("System log errors"))
+                });
+            p.levelComboBox->setCurrentItem(std::max(level, 0));
+            p.levelComboBox->setTooltip(_getText(DJV_TEXT("System log level tooltip")));
+            _modulesUpdate();
+            p.moduleComboBox->setTooltip(_getText(DJV_TEXT("System log module tooltip")));
             p.copyButton->setText(_getText(DJV_TEXT("Copy")));
             p.copyButton->setTooltip(_getText(DJV_TEXT("System log copy tooltip")));
             p.reloadButton->setText(_getText(DJV_TEXT("Reload")));
@@ -220,6 +620,46 @@ namespace djv
             p.clearButton->setTooltip(_getText(DJV_TEXT("System log clear tooltip")));
         }
 
+        void SystemLogWidget::_recordsUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            const auto records = p.logSystem->getRecords(p.recordID);
+            if (records.size())
+            {
+                p.recordID = records.back().id + 1;
+                if (p.logView->addRecords(records))
+                {
+                    _modulesUpdate();
+                }
+            }
+        }
+
+        void SystemLogWidget::_modulesUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            const int module = p.moduleComboBox->getCurrentItem();
+            std::vector<std::string> items;
+            items.push_back(_getText(DJV_TEXT("System log all modules")));
+            for (const auto& i : p.logView->getModules())
+            {
+                items.push_back(i);
+            }
+            p.moduleComboBox->setItems(items);
+            p.moduleComboBox->setCurrentItem(std::max(module, 0));
+        }
+
+        void SystemLogWidget::_filterUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            LogLevel level = LogLevel::Information;
+            switch (p.levelComboBox->getCurrentItem())
+            {
+            case 1: level = LogLevel::Warning; break;
+            case 2: level = LogLevel::Error; break;
+            default: break;
+            }
+            p.logView->setFilter(level, p.moduleComboBox->getCurrentItem() - 1);
+        }
+
     } // namespace ViewApp
 } // namespace djv
-
@@ -36,6 +36,9 @@ namespace djv
     namespace ViewApp
     {
         //! This class provides the system log widget.
+        //!
+        //! The log records are read incrementally from the log system rather
+        //! than from the log file.
         class SystemLogWidget : public MDIWidget
         {
             DJV_NON_COPYABLE(SystemLogWidget);
@@ -56,6 +59,10 @@ namespace djv
             void _initEvent(Core::Event::Init &) override;
 
         private:
+            void _recordsUpdate();
+            void _modulesUpdate();
+            void _filterUpdate();
+
             DJV_PRIVATE();
         };
 
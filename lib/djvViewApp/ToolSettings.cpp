@@ -78,6 +78,7 @@ namespace djv
         void ToolSettings::setErrorsPopup(bool value)
         {
             _p->errorsPopup->setIfChanged(value);
+            _changed();
         }
 
         std::map<std::string, bool> ToolSettings::getDebugBellowsState() const
@@ -88,6 +89,7 @@ namespace djv
         void ToolSettings::setDebugBellowsState(const std::map<std::string, bool>& value)
         {
             _p->debugBellowsState = value;
+            _changed();
         }
 
         const std::map<std::string, BBox2f>& ToolSettings::getWidgetGeom() const
@@ -98,6 +100,7 @@ namespace djv
         void ToolSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void ToolSettings::load(const picojson::value & value)
@@ -31,6 +31,7 @@
 
 #include <djvViewApp/DebugWidget.h>
 #include <djvViewApp/ErrorsWidget.h>
+#include <djvViewApp/HistogramWidget.h>
 #include <djvViewApp/IToolSystem.h>
 #include <djvViewApp/InfoWidget.h>
 #include <djvViewApp/SettingsSystem.h>
@@ -115,6 +116,8 @@ namespace djv
             p.actions["Info"] = UI::Action::create();
             p.actions["Info"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["Info"]->setShortcut(GLFW_KEY_I, UI::Shortcut::getSystemModifier());
+            p.actions["Histogram"] = UI::Action::create();
+            p.actions["Histogram"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["Errors"] = UI::Action::create();
             p.actions["Errors"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["SystemLog"] = UI::Action::create();
@@ -132,6 +135,7 @@ namespace djv
             }
             p.menu->addSeparator();
             p.menu->addAction(p.actions["Info"]);
+            p.menu->addAction(p.actions["Histogram"]);
             p.menu->addSeparator();
             p.menu->addAction(p.actions["Errors"]);
             p.menu->addAction(p.actions["SystemLog"]);
@@ -178,6 +182,26 @@ namespace djv
                     }
                 });
 
+            p.actionObservers["Histogram"] = ValueObserver<bool>::create(
+                p.actions["Histogram"]->observeChecked(),
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            if (value)
+                            {
+                                system->_openWidget("Histogram", HistogramWidget::create(context));
+                            }
+                            else
+                            {
+                                system->_closeWidget("Histogram");
+                            }
+                        }
+                    }
+                });
+
             p.actionObservers["Errors"] = ValueObserver<bool>::create(
                 p.actions["Errors"]->observeChecked(),
                 [weak, contextWeak](bool value)
@@ -337,6 +361,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             _closeWidget("Info");
+            _closeWidget("Histogram");
             _closeWidget("Errors");
             _closeWidget("SystemLog");
             _closeWidget("Debug");
@@ -395,6 +420,8 @@ namespace djv
             {
                 p.actions["Info"]->setText(_getText(DJV_TEXT("Information")));
                 p.actions["Info"]->setTooltip(_getText(DJV_TEXT("Information widget tooltip")));
+                p.actions["Histogram"]->setText(_getText(DJV_TEXT("Histogram")));
+                p.actions["Histogram"]->setTooltip(_getText(DJV_TEXT("Histogram widget tooltip")));
                 p.actions["Errors"]->setText(_getText(DJV_TEXT("Errors")));
                 p.actions["Errors"]->setTooltip(_getText(DJV_TEXT("Errors widget tooltip")));
                 p.actions["SystemLog"]->setText(_getText(DJV_TEXT("System Log")));
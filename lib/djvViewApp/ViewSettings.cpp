@@ -82,6 +82,7 @@ namespace djv
         void ViewSettings::setWidgetCurrentTab(int value)
         {
             _p->widgetCurrentTab = value;
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<ImageViewLock> > ViewSettings::observeLock() const
@@ -92,6 +93,7 @@ namespace djv
         void ViewSettings::setLock(ImageViewLock value)
         {
             _p->lock->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<Core::IValueSubject<GridOptions> > ViewSettings::observeGridOptions() const
@@ -102,6 +104,7 @@ namespace djv
         void ViewSettings::setGridOptions(const GridOptions& value)
         {
             _p->gridOptions->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<AV::Image::Color> > ViewSettings::observeBackgroundColor() const
@@ -112,6 +115,7 @@ namespace djv
         void ViewSettings::setBackgroundColor(const AV::Image::Color& value)
         {
             _p->backgroundColor->setIfChanged(value);
+            _changed();
         }
 
         const std::map<std::string, BBox2f>& ViewSettings::getWidgetGeom() const
@@ -122,6 +126,7 @@ namespace djv
         void ViewSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _changed();
         }
 
         void ViewSettings::load(const picojson::value & value)
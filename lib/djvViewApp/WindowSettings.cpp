@@ -94,6 +94,7 @@ namespace djv
         void WindowSettings::setWindowSize(const glm::ivec2& value)
         {
             _p->windowSize = value;
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<int> > WindowSettings::observeFullscreenMonitor() const
@@ -104,6 +105,7 @@ namespace djv
         void WindowSettings::setFullscreenMonitor(int value)
         {
             _p->fullscreenMonitor->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<bool> > WindowSettings::observeMaximize() const
@@ -114,6 +116,7 @@ namespace djv
         void WindowSettings::setMaximize(bool value)
         {
             _p->maximize->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<bool> > WindowSettings::observeAutoHide() const
@@ -124,6 +127,7 @@ namespace djv
         void WindowSettings::setAutoHide(bool value)
         {
             _p->autoHide->setIfChanged(value);
+            _changed();
         }
 
         std::shared_ptr<IValueSubject<std::string> > WindowSettings::observeBackgroundImage() const
@@ -144,16 +148,19 @@ namespace djv
         void WindowSettings::setBackgroundImageScale(bool value)
         {
             _p->backgroundImageScale->setIfChanged(value);
+            _changed();
         }
 
         void WindowSettings::setBackgroundImageColorize(bool value)
         {
             _p->backgroundImageColorize->setIfChanged(value);
+            _changed();
         }
 
         void WindowSettings::setBackgroundImage(const std::string& value)
         {
             _p->backgroundImage->setIfChanged(value);
+            _changed();
         }
 
         void WindowSettings::load(const picojson::value & value)
@@ -0,0 +1,249 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/AudioData.h>
+
+#include <djvCore/Error.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace djv;
+using namespace djv::AV;
+
+namespace
+{
+    template<typename T>
+    void randomData(T* data, size_t size, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<int64_t> dist(
+            std::numeric_limits<T>::min(),
+            std::numeric_limits<T>::max());
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<T>(dist(rng));
+        }
+    }
+
+    template<>
+    void randomData(Audio::F32_T* data, size_t size, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<Audio::F32_T> dist(-1.1F, 1.1F);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = dist(rng);
+        }
+    }
+
+    template<>
+    void randomData(Audio::F64_T* data, size_t size, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<Audio::F64_T> dist(-1.1, 1.1);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = dist(rng);
+        }
+    }
+
+    void randomData(const std::shared_ptr<Audio::Data>& data, std::mt19937& rng)
+    {
+        const size_t size = data->getSampleCount() * data->getChannelCount();
+        switch (data->getType())
+        {
+        case Audio::Type::S8:  randomData(reinterpret_cast<Audio::S8_T*> (data->getData()), size, rng); break;
+        case Audio::Type::S16: randomData(reinterpret_cast<Audio::S16_T*>(data->getData()), size, rng); break;
+        case Audio::Type::S32: randomData(reinterpret_cast<Audio::S32_T*>(data->getData()), size, rng); break;
+        case Audio::Type::F32: randomData(reinterpret_cast<Audio::F32_T*>(data->getData()), size, rng); break;
+        case Audio::Type::F64: randomData(reinterpret_cast<Audio::F64_T*>(data->getData()), size, rng); break;
+        default: break;
+        }
+    }
+
+    template<typename A, typename B>
+    void convertSamples(const A* in, B* out, size_t size, void (*convert)(A, B&))
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            convert(in[i], out[i]);
+        }
+    }
+
+    //! Convert the samples one at a time with the per-sample functions.
+    std::shared_ptr<Audio::Data> convertSamples(const std::shared_ptr<Audio::Data>& data, Audio::Type type)
+    {
+        const Audio::Info& info = data->getInfo();
+        auto out = Audio::Data::create(Audio::Info(info.channelCount, type, info.sampleRate, info.sampleCount));
+        const size_t size = info.sampleCount * info.channelCount;
+        const uint8_t* in = data->getData();
+        uint8_t* outP = out->getData();
+
+#define _CONVERT_SAMPLES(a, b) \
+    if (Audio::Type::a == info.type && Audio::Type::b == type) \
+    { \
+convertSamples( \
+    reinterpret_cast<const Audio::a##_T*>(in), \
+    reinterpret_cast<Audio::b##_T*>(outP), \
+    size, \
+    Audio::a##To##b); \
+    }
+        _CONVERT_SAMPLES(S8, S16);
+        _CONVERT_SAMPLES(S8, S32);
+        _CONVERT_SAMPLES(S8, F32);
+        _CONVERT_SAMPLES(S8, F64);
+        _CONVERT_SAMPLES(S16, S8);
+        _CONVERT_SAMPLES(S16, S32);
+        _CONVERT_SAMPLES(S16, F32);
+        _CONVERT_SAMPLES(S16, F64);
+        _CONVERT_SAMPLES(S32, S8);
+        _CONVERT_SAMPLES(S32, S16);
+        _CONVERT_SAMPLES(S32, F32);
+        _CONVERT_SAMPLES(S32, F64);
+        _CONVERT_SAMPLES(F32, S8);
+        _CONVERT_SAMPLES(F32, S16);
+        _CONVERT_SAMPLES(F32, S32);
+        _CONVERT_SAMPLES(F32, F64);
+        _CONVERT_SAMPLES(F64, S8);
+        _CONVERT_SAMPLES(F64, S16);
+        _CONVERT_SAMPLES(F64, S32);
+        _CONVERT_SAMPLES(F64, F32);
+#undef _CONVERT_SAMPLES
+
+        if (info.type == type)
+        {
+            memcpy(outP, in, out->getByteCount());
+        }
+        return out;
+    }
+
+    void benchmark()
+    {
+        const size_t sampleCount = 48000 * 10;
+        const uint8_t channelCount = 2;
+        const size_t iterations = 10;
+        std::mt19937 rng(1);
+        for (auto i : { Audio::Type::S16, Audio::Type::S32, Audio::Type::F32 })
+        {
+            auto data = Audio::Data::create(Audio::Info(channelCount, i, 48000, sampleCount));
+            randomData(data, rng);
+            for (auto j : { Audio::Type::S16, Audio::Type::F32 })
+            {
+                if (i == j)
+                    continue;
+                auto t = std::chrono::steady_clock::now();
+                for (size_t k = 0; k < iterations; ++k)
+                {
+                    convertSamples(data, j);
+                }
+                const auto samplesTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t);
+
+                t = std::chrono::steady_clock::now();
+                for (size_t k = 0; k < iterations; ++k)
+                {
+                    Audio::Data::convert(data, j);
+                }
+                const auto convertTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t);
+
+                std::stringstream ss;
+                ss << "convert " << i << " to " << j << ": " <<
+                    convertTime.count() << "us (per-sample: " << samplesTime.count() << "us)";
+                std::cout << ss.str() << std::endl;
+            }
+
+            {
+                auto data2 = Audio::Data::create(data->getInfo());
+                const auto t = std::chrono::steady_clock::now();
+                for (size_t k = 0; k < iterations; ++k)
+                {
+                    Audio::Data::volume(data->getData(), data2->getData(), .5F, sampleCount, channelCount, i);
+                }
+                const auto volumeTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t);
+                std::stringstream ss;
+                ss << "volume " << i << ": " << volumeTime.count() << "us";
+                std::cout << ss.str() << std::endl;
+            }
+
+            {
+                auto data2 = Audio::Data::create(data->getInfo());
+                const auto t = std::chrono::steady_clock::now();
+                for (size_t k = 0; k < iterations; ++k)
+                {
+                    Audio::Data::planarDeinterleave(data);
+                }
+                const auto shuffleTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t);
+                std::stringstream ss;
+                ss << "planar deinterleave " << i << ": " << shuffleTime.count() << "us";
+                std::cout << ss.str() << std::endl;
+            }
+        }
+
+        {
+            auto data = Audio::Data::create(Audio::Info(6, Audio::Type::S16, 48000, sampleCount));
+            randomData(data, rng);
+            auto data2 = Audio::Data::create(Audio::Info(channelCount, Audio::Type::F32, 48000, sampleCount));
+            const auto t = std::chrono::steady_clock::now();
+            for (size_t k = 0; k < iterations; ++k)
+            {
+                Audio::Data::convert(
+                    data->getData(), Audio::Type::S16, 6,
+                    data2->getData(), Audio::Type::F32, channelCount,
+                    sampleCount,
+                    .5F,
+                    { 0, 1 });
+            }
+            const auto remapTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t);
+            std::stringstream ss;
+            ss << "convert S16 5.1 to F32 stereo with volume: " << remapTime.count() << "us";
+            std::cout << ss.str() << std::endl;
+        }
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 0;
+    try
+    {
+        benchmark();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+        r = 1;
+    }
+    return r;
+}
@@ -0,0 +1,736 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/IO.h>
+#if defined(TIFF_FOUND)
+#include <djvAV/TIFF.h>
+#endif // TIFF_FOUND
+
+#include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+using namespace djv;
+
+namespace
+{
+    void write(
+        const std::shared_ptr<AV::IO::System>& io,
+        const Core::FileSystem::Path& path,
+        const std::shared_ptr<AV::Image::Image>& image)
+    {
+        AV::IO::Info info;
+        info.video.push_back(image->getInfo());
+        auto write = io->write(Core::FileSystem::FileInfo(path), info);
+        {
+            std::lock_guard<std::mutex> lock(write->getMutex());
+            auto& writeQueue = write->getVideoQueue();
+            writeQueue.addFrame(AV::IO::VideoFrame(0, image));
+            writeQueue.setFinished(true);
+        }
+        while (write->isRunning())
+        {
+            std::this_thread::sleep_for(Core::Time::getMilliseconds(Core::Time::TimerValue::Fast));
+        }
+    }
+
+    std::shared_ptr<AV::Image::Image> read(
+        const std::shared_ptr<AV::IO::System>& io,
+        const Core::FileSystem::Path& path)
+    {
+        std::shared_ptr<AV::Image::Image> out;
+        auto read = io->read(Core::FileSystem::FileInfo(path));
+        bool running = true;
+        while (running)
+        {
+            bool sleep = false;
+            {
+                std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
+                if (lock.owns_lock())
+                {
+                    auto& readQueue = read->getVideoQueue();
+                    if (!readQueue.isEmpty())
+                    {
+                        out = readQueue.popFrame().image;
+                    }
+                    else if (readQueue.isFinished())
+                    {
+                        running = false;
+                    }
+                    else
+                    {
+                        sleep = true;
+                    }
+                }
+                else
+                {
+                    sleep = true;
+                }
+            }
+            if (sleep)
+            {
+                std::this_thread::sleep_for(Core::Time::getMilliseconds(Core::Time::TimerValue::Fast));
+            }
+        }
+        return out;
+    }
+
+    std::shared_ptr<AV::Image::Image> createImage(const AV::Image::Info& info)
+    {
+        auto out = AV::Image::Image::create(info);
+        uint8_t* p = out->getData();
+        const size_t dataByteCount = out->getDataByteCount();
+        for (size_t i = 0; i < dataByteCount; ++i)
+        {
+            // Use a pattern with some redundancy so that it compresses.
+            p[i] = static_cast<uint8_t>((i / 64) ^ (i % 7));
+        }
+        return out;
+    }
+
+    void benchmarkTIFF(const std::shared_ptr<AV::IO::System>& io)
+    {
+#if defined(TIFF_FOUND)
+        const AV::Image::Info info(3840, 2160, AV::Image::Type::RGB_U16);
+        auto image = createImage(info);
+        for (auto compression : { AV::IO::TIFF::Compression::LZW, AV::IO::TIFF::Compression::ZIP })
+        {
+            AV::IO::TIFF::Options options;
+            options.compression = compression;
+            io->setOptions(AV::IO::TIFF::pluginName, toJSON(options));
+            std::stringstream ss;
+            ss << "IOStressTest_" << compression << ".tif";
+            const Core::FileSystem::Path path(ss.str());
+
+            auto t = std::chrono::steady_clock::now();
+            write(io, path, image);
+            const auto writeTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - t);
+
+            t = std::chrono::steady_clock::now();
+            auto image2 = read(io, path);
+            const auto readTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - t);
+            Core::FileSystem::remove(path.get());
+
+            std::cout << "TIFF " << compression << " write: " << writeTime.count() << "ms" << std::endl;
+            std::cout << "TIFF " << compression << " read: " << readTime.count() << "ms" << std::endl;
+        }
+        io->setOptions(AV::IO::TIFF::pluginName, toJSON(AV::IO::TIFF::Options()));
+#endif // TIFF_FOUND
+    }
+
+    //! Encode bytes with the packets used by RLA: a count followed by either
+    //! a single value to repeat, or a number of literal values. The bytes are
+    //! read with the given stride.
+    void encode(
+        const uint8_t*        in,
+        size_t                size,
+        size_t                stride,
+        std::vector<uint8_t>& out)
+    {
+        size_t i = 0;
+        while (i < size)
+        {
+            size_t count = 1;
+            while (i + count < size && count < 128 && in[i * stride] == in[(i + count) * stride])
+            {
+                ++count;
+            }
+            if (count > 1)
+            {
+                out.push_back(static_cast<uint8_t>(count - 1));
+                out.push_back(in[i * stride]);
+            }
+            else
+            {
+                while (i + count < size && count < 128 &&
+                    !(i + count + 1 < size && in[(i + count) * stride] == in[(i + count + 1) * stride]))
+                {
+                    ++count;
+                }
+                out.push_back(static_cast<uint8_t>(-static_cast<int>(count)));
+                for (size_t j = 0; j < count; ++j)
+                {
+                    out.push_back(in[(i + j) * stride]);
+                }
+            }
+            i += count;
+        }
+    }
+
+    void writeSGI(const std::string& fileName, const std::shared_ptr<AV::Image::Image>& image)
+    {
+        const uint16_t w = image->getWidth();
+        const uint16_t h = image->getHeight();
+        const uint16_t channels = 4;
+        std::vector<std::vector<uint8_t> > rle(h * channels);
+        for (uint16_t c = 0; c < channels; ++c)
+        {
+            for (uint16_t y = 0; y < h; ++y)
+            {
+                const uint8_t* p = image->getData(y) + c;
+                auto& data = rle[y + h * c];
+                for (uint16_t x = 0; x < w;)
+                {
+                    const uint16_t count = std::min(w - x, 127);
+                    data.push_back(static_cast<uint8_t>(0x80 | count));
+                    for (uint16_t i = 0; i < count; ++i, ++x)
+                    {
+                        data.push_back(p[x * channels]);
+                    }
+                }
+                data.push_back(0);
+            }
+        }
+
+        Core::FileSystem::FileIO io;
+        io.setEndianConversion(Core::Memory::getEndian() != Core::Memory::Endian::MSB);
+        io.open(fileName, Core::FileSystem::FileIO::Mode::Write);
+        io.writeU16(474);
+        io.writeU8(1);
+        io.writeU8(1);
+        io.writeU16(3);
+        io.writeU16(w);
+        io.writeU16(h);
+        io.writeU16(channels);
+        io.writeU32(0);
+        io.writeU32(255);
+        const std::vector<uint8_t> pad(512 - io.getPos(), 0);
+        io.write(pad.data(), pad.size());
+        uint32_t offset = static_cast<uint32_t>(512 + rle.size() * 8);
+        for (const auto& i : rle)
+        {
+            io.writeU32(offset);
+            offset += static_cast<uint32_t>(i.size());
+        }
+        for (const auto& i : rle)
+        {
+            io.writeU32(static_cast<uint32_t>(i.size()));
+        }
+        for (const auto& i : rle)
+        {
+            io.write(i.data(), i.size());
+        }
+    }
+
+    void writeTarga(const std::string& fileName, const std::shared_ptr<AV::Image::Image>& image)
+    {
+        const uint16_t w = image->getWidth();
+        const uint16_t h = image->getHeight();
+        std::vector<uint8_t> bgra(image->getDataByteCount());
+        memcpy(bgra.data(), image->getData(), bgra.size());
+        for (size_t i = 0; i < bgra.size(); i += 4)
+        {
+            std::swap(bgra[i], bgra[i + 2]);
+        }
+
+        // Encode whole pixels, comparing them as 32-bit words. The packets
+        // don't cross scanlines so the serial decoder can read them.
+        std::vector<uint8_t> rle;
+        auto pixel = [&bgra](size_t i)
+        {
+            uint32_t out = 0;
+            memcpy(&out, bgra.data() + i * 4, 4);
+            return out;
+        };
+        for (size_t y = 0; y < h; ++y)
+        {
+            size_t i = y * w;
+            const size_t end = i + w;
+            while (i < end)
+            {
+                size_t count = 1;
+                while (i + count < end && count < 128 && pixel(i) == pixel(i + count))
+                {
+                    ++count;
+                }
+                if (count > 1)
+                {
+                    rle.push_back(static_cast<uint8_t>(0x80 | (count - 1)));
+                    rle.insert(rle.end(), bgra.begin() + i * 4, bgra.begin() + i * 4 + 4);
+                }
+                else
+                {
+                    while (i + count < end && count < 128 && !(i + count + 1 < end && pixel(i + count) == pixel(i + count + 1)))
+                    {
+                        ++count;
+                    }
+                    rle.push_back(static_cast<uint8_t>(count - 1));
+                    rle.insert(rle.end(), bgra.begin() + i * 4, bgra.begin() + (i + count) * 4);
+                }
+                i += count;
+            }
+        }
+
+        Core::FileSystem::FileIO io;
+        io.setEndianConversion(Core::Memory::getEndian() != Core::Memory::Endian::LSB);
+        io.open(fileName, Core::FileSystem::FileIO::Mode::Write);
+        io.writeU8(0);
+        io.writeU8(0);
+        io.writeU8(10);
+        io.writeU16(0);
+        io.writeU16(0);
+        io.writeU8(0);
+        io.writeU16(0);
+        io.writeU16(0);
+        io.writeU16(w);
+        io.writeU16(h);
+        io.writeU8(32);
+        io.writeU8(8);
+        io.write(rle.data(), rle.size());
+    }
+
+    //! This struct provides the RLA header, matching the layout read by the
+    //! RLA plugin.
+    struct RLAHeader
+    {
+        int16_t dimensions[4];
+        int16_t active[4];
+        int16_t frame;
+        int16_t colorChannelType;
+        int16_t colorChannels;
+        int16_t matteChannels;
+        int16_t auxChannels;
+        int16_t version;
+        char    gamma[16];
+        char    chroma[3][24];
+        char    whitepoint[24];
+        int32_t job;
+        char    fileName[128];
+        char    description[128];
+        char    progam[64];
+        char    machine[32];
+        char    user[32];
+        char    date[20];
+        char    aspect[24];
+        char    aspectRatio[8];
+        char    colorFormat[32];
+        int16_t field;
+        char    renderTime[12];
+        char    filter[32];
+        int16_t colorBitDepth;
+        int16_t matteChannelType;
+        int16_t matteBitDepth;
+        int16_t auxChannelType;
+        int16_t auxBitDepth;
+        char    auxFormat[32];
+        char    pad[36];
+        int32_t offset;
+    };
+
+    void writeRLA(const std::string& fileName, const std::shared_ptr<AV::Image::Image>& image)
+    {
+        const uint16_t w = image->getWidth();
+        const uint16_t h = image->getHeight();
+        const bool endian = Core::Memory::getEndian() != Core::Memory::Endian::MSB;
+
+        RLAHeader header;
+        memset(&header, 0, sizeof(RLAHeader));
+        header.active[1] = w - 1;
+        header.active[3] = h - 1;
+        header.colorChannels = 3;
+        header.matteChannels = 1;
+        header.colorBitDepth = 8;
+        header.matteBitDepth = 8;
+        if (endian)
+        {
+            Core::Memory::endian(&header.active, 4, 2);
+            Core::Memory::endian(&header.colorChannels, 1, 2);
+            Core::Memory::endian(&header.matteChannels, 1, 2);
+            Core::Memory::endian(&header.colorBitDepth, 1, 2);
+            Core::Memory::endian(&header.matteBitDepth, 1, 2);
+        }
+
+        std::vector<std::vector<uint8_t> > scanlines(h);
+        for (uint16_t y = 0; y < h; ++y)
+        {
+            auto& scanline = scanlines[y];
+            for (size_t c = 0; c < 4; ++c)
+            {
+                std::vector<uint8_t> rle;
+                encode(image->getData(y) + c, w, 4, rle);
+                scanline.push_back(static_cast<uint8_t>(rle.size() >> 8));
+                scanline.push_back(static_cast<uint8_t>(rle.size() & 0xff));
+                scanline.insert(scanline.end(), rle.begin(), rle.end());
+            }
+        }
+
+        Core::FileSystem::FileIO io;
+        io.setEndianConversion(endian);
+        io.open(fileName, Core::FileSystem::FileIO::Mode::Write);
+        io.write(&header, sizeof(RLAHeader));
+        int32_t offset = static_cast<int32_t>(sizeof(RLAHeader) + h * 4);
+        for (const auto& i : scanlines)
+        {
+            io.write32(offset);
+            offset += static_cast<int32_t>(i.size());
+        }
+        for (const auto& i : scanlines)
+        {
+            io.write(i.data(), i.size());
+        }
+    }
+
+    //! The serial SGI decoder used before the scanlines were decoded in
+    //! parallel: each channel is decoded into a planar image which is then
+    //! interleaved.
+    std::shared_ptr<AV::Image::Image> readSGISerial(const std::string& fileName, const AV::Image::Info& info)
+    {
+        Core::FileSystem::FileIO io;
+        io.setEndianConversion(Core::Memory::getEndian() != Core::Memory::Endian::MSB);
+        io.open(fileName, Core::FileSystem::FileIO::Mode::Read);
+        const size_t w = info.size.w;
+        const size_t h = info.size.h;
+        const size_t channels = 4;
+        io.setPos(512);
+        std::vector<uint32_t> rleOffset(h * channels);
+        io.readU32(rleOffset.data(), rleOffset.size());
+        io.seek(rleOffset.size() * 4);
+        const size_t pos = io.getPos();
+        const size_t size = io.getSize() - pos;
+        std::vector<uint8_t> rleData(size);
+        io.read(rleData.data(), size);
+        std::vector<uint8_t> tmp(w * h * channels);
+        uint8_t* outP = tmp.data();
+        for (size_t c = 0; c < channels; ++c)
+        {
+            for (size_t y = 0; y < h; ++y, outP += w)
+            {
+                const uint8_t* inP = rleData.data() + rleOffset[y + h * c] - pos;
+                uint8_t* p = outP;
+                const uint8_t* const pEnd = p + w;
+                while (p < pEnd)
+                {
+                    const size_t count = *inP & 0x7f;
+                    const bool run = !(*inP & 0x80);
+                    ++inP;
+                    if (run)
+                    {
+                        for (size_t j = 0; j < count; ++j, ++p)
+                        {
+                            *p = *inP;
+                        }
+                        ++inP;
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < count; ++j, ++inP, ++p)
+                        {
+                            *p = *inP;
+                        }
+                    }
+                }
+            }
+        }
+        auto out = AV::Image::Image::create(info);
+        for (size_t c = 0; c < channels; ++c)
+        {
+            for (size_t y = 0; y < h; ++y)
+            {
+                const uint8_t* inP = tmp.data() + (c * h + y) * w;
+                uint8_t* p = out->getData(0, y) + c;
+                for (size_t x = 0; x < w; ++x, ++inP, p += channels)
+                {
+                    *p = *inP;
+                }
+            }
+        }
+        return out;
+    }
+
+    //! The serial Targa decoder used before the packets were unpacked in one
+    //! pass: each scanline is decoded separately and then swizzled.
+    std::shared_ptr<AV::Image::Image> readTargaSerial(const std::string& fileName, const AV::Image::Info& info)
+    {
+        Core::FileSystem::FileIO io;
+        io.open(fileName, Core::FileSystem::FileIO::Mode::Read);
+        io.setPos(18);
+        const size_t size = io.getSize() - io.getPos();
+        std::vector<uint8_t> tmp(size);
+        io.read(tmp.data(), size);
+        auto out = AV::Image::Image::create(info);
+        const size_t channels = 4;
+        const uint8_t* in = tmp.data();
+        for (uint16_t y = 0; y < info.size.h; ++y)
+        {
+            uint8_t* p = out->getData(0, y);
+            const uint8_t* const pEnd = p + info.size.w * channels;
+            while (p < pEnd)
+            {
+                const uint8_t count = (*in & 0x7f) + 1;
+                const bool run = (*in & 0x80) ? true : false;
+                ++in;
+                if (run)
+                {
+                    for (size_t j = 0; j < count; ++j, p += channels)
+                    {
+                        p[3] = in[3];
+                        p[2] = in[2];
+                        p[1] = in[1];
+                        p[0] = in[0];
+                    }
+                    in += channels;
+                }
+                else
+                {
+                    for (size_t j = 0; j < count; ++j, in += channels, p += channels)
+                    {
+                        p[3] = in[3];
+                        p[2] = in[2];
+                        p[1] = in[1];
+                        p[0] = in[0];
+                    }
+                }
+            }
+        }
+        for (uint16_t y = 0; y < info.size.h; ++y)
+        {
+            uint8_t* p = out->getData(0, y);
+            for (uint16_t x = 0; x < info.size.w; ++x, p += channels)
+            {
+                std::swap(p[0], p[2]);
+            }
+        }
+        return out;
+    }
+
+    //! The serial RLA decoder used before the scanlines were decoded in
+    //! parallel: each channel is read from the file separately.
+    std::shared_ptr<AV::Image::Image> readRLASerial(const std::string& fileName, const AV::Image::Info& info)
+    {
+        Core::FileSystem::FileIO io;
+        io.setEndianConversion(Core::Memory::getEndian() != Core::Memory::Endian::MSB);
+        io.open(fileName, Core::FileSystem::FileIO::Mode::Read);
+        const size_t w = info.size.w;
+        const size_t h = info.size.h;
+        const size_t channels = 4;
+        io.setPos(sizeof(RLAHeader));
+        std::vector<int32_t> rleOffset(h);
+        io.read32(rleOffset.data(), h);
+        auto out = AV::Image::Image::create(info);
+        for (uint16_t y = 0; y < h; ++y)
+        {
+            io.setPos(rleOffset[y]);
+            for (size_t c = 0; c < channels; ++c)
+            {
+                int16_t size = 0;
+                io.read16(&size);
+                std::vector<uint8_t> buf(size);
+                io.read(buf.data(), size);
+                const uint8_t* p = buf.data();
+                uint8_t* outP = out->getData(0, y) + c;
+                for (size_t i = 0; i < w;)
+                {
+                    int count = *reinterpret_cast<const int8_t*>(p);
+                    ++p;
+                    if (count >= 0)
+                    {
+                        ++count;
+                        for (int j = 0; j < count; ++j, outP += channels)
+                        {
+                            *outP = *p;
+                        }
+                        ++p;
+                    }
+                    else
+                    {
+                        count = -count;
+                        for (int j = 0; j < count; ++j, ++p, outP += channels)
+                        {
+                            *outP = *p;
+                        }
+                    }
+                    i += count;
+                }
+            }
+        }
+        return out;
+    }
+
+    bool compare(const std::shared_ptr<AV::Image::Image>& a, const std::shared_ptr<AV::Image::Image>& b)
+    {
+        bool out = a && b && a->getSize() == b->getSize() && a->getType() == b->getType();
+        for (uint16_t y = 0; out && y < a->getHeight(); ++y)
+        {
+            out = 0 == memcmp(a->getData(y), b->getData(y), a->getScanlineByteCount());
+        }
+        return out;
+    }
+
+    void benchmarkRLE(const std::shared_ptr<AV::IO::System>& io)
+    {
+        // Compare the serial decoders with the current readers, which decode
+        // in parallel where the format allows it.
+        const AV::Image::Info info(3840, 2160, AV::Image::Type::RGBA_U8);
+        auto image = createImage(info);
+        struct Format
+        {
+            std::string name;
+            std::string extension;
+            std::function<void(const std::string&, const std::shared_ptr<AV::Image::Image>&)> write;
+            std::function<std::shared_ptr<AV::Image::Image>(const std::string&, const AV::Image::Info&)> readSerial;
+        };
+        const std::vector<Format> formats =
+        {
+            { "SGI", ".sgi", writeSGI, readSGISerial },
+            { "Targa", ".tga", writeTarga, readTargaSerial },
+            { "RLA", ".rla", writeRLA, readRLASerial }
+        };
+        for (const auto& i : formats)
+        {
+            const std::string fileName = "IOStressTest_RLE" + i.extension;
+            i.write(fileName, image);
+
+            auto t = std::chrono::steady_clock::now();
+            auto serialImage = i.readSerial(fileName, info);
+            const auto serialTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - t);
+
+            t = std::chrono::steady_clock::now();
+            auto currentImage = read(io, Core::FileSystem::Path(fileName));
+            const auto currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - t);
+            Core::FileSystem::remove(fileName);
+
+            std::cout << i.name << " serial read: " << serialTime.count() << "ms" << std::endl;
+            std::cout << i.name << " current read: " << currentTime.count() << "ms" << std::endl;
+            if (!compare(serialImage, currentImage))
+            {
+                std::cout << i.name << " images do not match" << std::endl;
+            }
+        }
+    }
+
+    void benchmarkCanRead(const std::shared_ptr<AV::IO::System>& io)
+    {
+        // Files without an extension are identified by opening them and
+        // reading the magic number.
+        const std::string magicFileName = "IOStressTest_magic";
+        const AV::Image::Info info(16, 16, AV::Image::Type::RGB_U8);
+        write(io, Core::FileSystem::Path(magicFileName + ".ppm"), createImage(info));
+        Core::FileSystem::rename(magicFileName + ".ppm", magicFileName);
+
+        const std::vector<std::string> extensions =
+        {
+            ".cin",
+            ".DPX",
+            ".exr",
+            ".jpg",
+            ".png",
+            ".ppm",
+            ".tif",
+            ".TGA",
+            ".mov",
+            ".txt",
+            ".json",
+            ".0001",
+            std::string()
+        };
+        const size_t count = 100000;
+        std::vector<Core::FileSystem::FileInfo> fileInfos;
+        fileInfos.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto& extension = extensions[i % extensions.size()];
+            std::stringstream ss;
+            if (extension.empty())
+            {
+                ss << magicFileName;
+            }
+            else
+            {
+                ss << "IOStressTest_canRead" << i << extension;
+            }
+            fileInfos.push_back(Core::FileSystem::FileInfo(ss.str(), false));
+        }
+
+        size_t extensionCount = 0;
+        auto t = std::chrono::steady_clock::now();
+        for (const auto& i : fileInfos)
+        {
+            if (!i.getPath().getExtension().empty() && io->canRead(i))
+            {
+                ++extensionCount;
+            }
+        }
+        const auto extensionTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t);
+
+        size_t magicNumberCount = 0;
+        t = std::chrono::steady_clock::now();
+        for (const auto& i : fileInfos)
+        {
+            if (i.getPath().getExtension().empty() && io->canRead(i))
+            {
+                ++magicNumberCount;
+            }
+        }
+        const auto magicNumberTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t);
+        Core::FileSystem::remove(magicFileName);
+
+        std::cout << "Extension lookups: " << extensionCount << " (" << extensionTime.count() << "us)" << std::endl;
+        std::cout << "Magic number lookups: " << magicNumberCount << " (" << magicNumberTime.count() << "us)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 0;
+    try
+    {
+        std::vector<std::string> args;
+        for (int i = 0; i < argc; ++i)
+        {
+            args.push_back(argv[i]);
+        }
+        auto app = CmdLine::Application::create(args);
+        auto io = app->getSystemT<AV::IO::System>();
+        benchmarkTIFF(io);
+        benchmarkRLE(io);
+        benchmarkCanRead(io);
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+        r = 1;
+    }
+    return r;
+}
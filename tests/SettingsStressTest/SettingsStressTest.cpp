@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvUI/SettingsSystem.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace djv;
+
+namespace
+{
+    //! Create settings with large lists of recent files and keyboard shortcuts.
+    picojson::value createSettings()
+    {
+        picojson::value out(picojson::object_type, true);
+        auto& object = out.get<picojson::object>();
+        object["SettingsVersion"] = toJSON(size_t(1000));
+        for (size_t i = 0; i < 20; ++i)
+        {
+            picojson::value group(picojson::object_type, true);
+            for (size_t j = 0; j < 20; ++j)
+            {
+                std::stringstream ss;
+                ss << "Value" << j;
+                group.get<picojson::object>()[ss.str()] = toJSON(j);
+            }
+            std::stringstream ss;
+            ss << "Settings" << i;
+            object[ss.str()] = group;
+        }
+        {
+            picojson::value group(picojson::object_type, true);
+            picojson::value array(picojson::array_type, true);
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                std::stringstream ss;
+                ss << "/home/user/projects/show/sequence/shot" << i << "/render/shot" << i << ".0001-0100.exr";
+                array.get<picojson::array>().push_back(toJSON(ss.str()));
+            }
+            group.get<picojson::object>()["RecentFiles"] = array;
+            object["File"] = group;
+        }
+        {
+            picojson::value group(picojson::object_type, true);
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                std::stringstream ss;
+                ss << "Shortcut" << i;
+                picojson::value shortcut(picojson::array_type, true);
+                shortcut.get<picojson::array>().push_back(toJSON(static_cast<int>(i)));
+                shortcut.get<picojson::array>().push_back(toJSON(2));
+                group.get<picojson::object>()[ss.str()] = shortcut;
+            }
+            object["Shortcuts"] = group;
+        }
+        return out;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 0;
+    const std::string fileName = "SettingsStressTest.json";
+    try
+    {
+        const auto json = createSettings();
+        const Core::FileSystem::Path path(fileName);
+
+        auto t = std::chrono::steady_clock::now();
+        UI::Settings::writeSettingsFile(path, json);
+        const auto writeTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t);
+
+        // Parse the whole file at once.
+        t = std::chrono::steady_clock::now();
+        {
+            Core::FileSystem::FileIO io;
+            io.open(fileName, Core::FileSystem::FileIO::Mode::Read);
+            const std::string contents = Core::FileSystem::FileIO::readContents(io);
+            picojson::value value;
+            const std::string error = picojson::parse(value, contents);
+            if (!error.empty() || value != json)
+            {
+                throw std::runtime_error("Cannot parse the settings");
+            }
+        }
+        const auto parseTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t);
+
+        // Read the file the way the settings system does, splitting it into
+        // groups and parsing all of them including the large ones.
+        t = std::chrono::steady_clock::now();
+        std::map<std::string, picojson::value> groups;
+        std::map<std::string, std::string> errors;
+        UI::Settings::readSettingsFile(path, groups, errors);
+        const auto readTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t);
+        if (!errors.empty() ||
+            groups.size() != json.get<picojson::object>().size() ||
+            groups["File"] != json.get<picojson::object>().at("File") ||
+            groups["Shortcuts"] != json.get<picojson::object>().at("Shortcuts"))
+        {
+            throw std::runtime_error("Cannot read the settings");
+        }
+
+        std::cout << "Groups: " << groups.size() << std::endl;
+        std::cout << "Write: " << writeTime.count() << "us" << std::endl;
+        std::cout << "Parse: " << parseTime.count() << "us" << std::endl;
+        std::cout << "Read: " << readTime.count() << "us" << std::endl;
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+        r = 1;
+    }
+    try
+    {
+        Core::FileSystem::remove(fileName);
+    }
+    catch (const std::exception&)
+    {}
+    return r;
+}
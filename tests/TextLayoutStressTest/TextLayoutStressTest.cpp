@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvDesktopApp/Application.h>
+
+#include <djvUI/Label.h>
+#include <djvUI/RowLayout.h>
+#include <djvUI/ScrollWidget.h>
+#include <djvUI/TextBlock.h>
+#include <djvUI/Window.h>
+
+#include <djvAV/FontSystem.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/String.h>
+#include <djvCore/Timer.h>
+
+using namespace djv;
+
+const size_t textBlockCount = 500;
+const size_t frameCount = 200;
+const float widthMin = 200.f;
+const float widthMax = 1200.f;
+const float widthStep = 7.f;
+
+void preLayoutRecursive(const std::shared_ptr<UI::Widget>& widget, Core::Event::PreLayout& event)
+{
+    for (const auto& child : widget->getChildWidgets())
+    {
+        preLayoutRecursive(child, event);
+    }
+    widget->event(event);
+}
+
+void layoutRecursive(const std::shared_ptr<UI::Widget>& widget, Core::Event::Layout& event)
+{
+    if (widget->isVisible())
+    {
+        widget->event(event);
+        for (const auto& child : widget->getChildWidgets())
+        {
+            layoutRecursive(child, event);
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int r = 0;
+    try
+    {
+        std::vector<std::string> args;
+        for (int i = 0; i < argc; ++i)
+        {
+            args.push_back(argv[i]);
+        }
+        auto app = Desktop::Application::create(args);
+
+        // Create a settings dialog like layout with many text blocks.
+        auto layout = UI::VerticalLayout::create(app);
+        layout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginDialog));
+        for (size_t i = 0; i < textBlockCount; ++i)
+        {
+            auto label = UI::Label::create(app);
+            label->setText(Core::String::getRandomName());
+            label->setTextHAlign(UI::TextHAlign::Left);
+            label->setFontSizeRole(UI::MetricsRole::FontHeader);
+            layout->addChild(label);
+            auto textBlock = UI::TextBlock::create(app);
+            textBlock->setText(Core::String::getRandomText(3));
+            layout->addChild(textBlock);
+        }
+        auto scrollWidget = UI::ScrollWidget::create(UI::ScrollType::Vertical, app);
+        scrollWidget->addChild(layout);
+
+        auto window = UI::Window::create(app);
+        window->addChild(scrollWidget);
+        window->show();
+
+        // Resize the layout every frame and time the layout passes. The
+        // layout is driven directly so that the time does not include
+        // drawing.
+        auto fontSystem = app->getSystemT<AV::Font::System>();
+        size_t frame = 0;
+        float width = widthMin;
+        float widthInc = widthStep;
+        float total = 0.f;
+        auto timer = Core::Time::Timer::create(app);
+        timer->setRepeating(true);
+        timer->start(
+            std::chrono::milliseconds(10),
+            [app, layout, fontSystem, &frame, &width, &widthInc, &total](float)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            Core::Event::PreLayout preLayout;
+            preLayoutRecursive(layout, preLayout);
+            const float height = layout->getHeightForWidth(width);
+            layout->setGeometry(Core::BBox2f(0.f, 0.f, width, height));
+            Core::Event::Layout layoutEvent;
+            layoutRecursive(layout, layoutEvent);
+            const auto end = std::chrono::steady_clock::now();
+            const std::chrono::duration<float, std::milli> delta = end - start;
+            total += delta.count();
+
+            std::cout << "Width: " << width << ", layout: " << delta.count() << "ms, text cache: " <<
+                fontSystem->getTextCacheHitRate() << "% hits" << std::endl;
+
+            width += widthInc;
+            if (width > widthMax || width < widthMin)
+            {
+                widthInc = -widthInc;
+                width += widthInc * 2.f;
+            }
+            ++frame;
+            if (frameCount == frame)
+            {
+                std::cout << "Average layout: " << total / frameCount << "ms" << std::endl;
+                app->exit();
+            }
+        });
+
+        r = app->run();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
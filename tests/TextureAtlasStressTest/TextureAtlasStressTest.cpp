@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAV/TextureAtlas.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/Math.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    int r = 0;
+    try
+    {
+        AV::Render::TextureAtlasPacker packer(4, 1024);
+        const size_t count = 1000000;
+        const size_t frameItems = 1000;
+        std::vector<std::pair<uint16_t, uint16_t> > sizes;
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            sizes.push_back(std::make_pair(
+                static_cast<uint16_t>(Core::Math::getRandom(4, 48)),
+                static_cast<uint16_t>(Core::Math::getRandom(8, 48))));
+        }
+        size_t failed = 0;
+        const auto t = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (0 == i % frameItems)
+            {
+                packer.nextFrame();
+            }
+
+            // Look up a recently added item and then add a new one, similar to
+            // drawing text with a glyph cache.
+            AV::Render::TextureAtlasRect rect;
+            if (i > 100)
+            {
+                packer.getItem(i - Core::Math::getRandom(100), rect);
+            }
+            const auto& size = sizes[i % sizes.size()];
+            if (!packer.addItem(i + 1, size.first, size.second, rect))
+            {
+                ++failed;
+            }
+        }
+        const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - t);
+        std::cout << "Items: " << count << std::endl;
+        std::cout << "Time: " << time.count() << "ms" << std::endl;
+        std::cout << "Failed: " << failed << std::endl;
+        std::cout << "Percentage used: " << packer.getPercentageUsed() << std::endl;
+        std::cout << "Evictions: " << packer.getEvictionCount() << std::endl;
+        std::cout << "Defragments: " << packer.getDefragmentCount() << std::endl;
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+        r = 1;
+    }
+    return r;
+}
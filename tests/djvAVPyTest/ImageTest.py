@@ -0,0 +1,39 @@
+import djvAVPy.Image as i
+
+import unittest
+
+class ImageTest(unittest.TestCase):
+
+    def test_info(self):
+        info = i.Info(i.Size(2, 3), i.Type.RGB_U16)
+        self.assertEqual(info.size.w, 2)
+        self.assertEqual(info.size.h, 3)
+        self.assertEqual(info.type, i.Type.RGB_U16)
+        self.assertTrue(info.isValid())
+        self.assertEqual(info.getPixelByteCount(), 6)
+
+    def test_buffer(self):
+        data = i.Data.create(i.Info(i.Size(2, 3), i.Type.RGB_U16))
+        data.zero()
+        m = memoryview(data)
+        self.assertEqual(m.format, "H")
+        self.assertEqual(m.shape, (3, 2, 3))
+        self.assertEqual(m.strides, (12, 6, 2))
+        self.assertEqual(m[0, 0, 0], 0)
+        
+    def test_mirror(self):
+        layout = i.Layout(i.Mirror(True, True))
+        data = i.Image.create(i.Info(i.Size(2, 3), i.Type.L_U8, layout))
+        m = memoryview(data)
+        self.assertEqual(m.shape, (3, 2, 1))
+        self.assertEqual(m.strides, (-2, -1, 1))
+        
+    def test_stats(self):
+        data = i.Data.create(i.Info(i.Size(2, 3), i.Type.RGBA_F32))
+        data.zero()
+        stats = i.getStats(data)
+        self.assertEqual(stats.channelCount, 4)
+        self.assertEqual(stats.max, (0.0, 0.0, 0.0, 0.0))
+    
+if __name__ == '__main__':
+    unittest.main()
@@ -31,6 +31,8 @@
 
 #include <djvAV/AudioData.h>
 
+#include <random>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -47,6 +49,9 @@ namespace djv
             _info();
             _data();
             _util();
+            _convert();
+            _shuffle();
+            _remap();
             _operators();
         }
 
@@ -90,6 +95,7 @@ namespace djv
                 DJV_ASSERT(info.getByteCount() == data->getByteCount());
                 DJV_ASSERT(data->getData());
                 DJV_ASSERT(data->getData(0));
+                DJV_ASSERT(data->getData(1) == data->getData() + 2 * sizeof(Audio::S16_T));
             }
         }
         
@@ -140,6 +146,212 @@ namespace djv
             }
         }
         
+        namespace
+        {
+            template<typename T>
+            void randomData(T* data, size_t size, std::mt19937& rng)
+            {
+                std::uniform_int_distribution<int64_t> dist(
+                    std::numeric_limits<T>::min(),
+                    std::numeric_limits<T>::max());
+                for (size_t i = 0; i < size; ++i)
+                {
+                    data[i] = static_cast<T>(dist(rng));
+                }
+            }
+
+            template<>
+            void randomData(Audio::F32_T* data, size_t size, std::mt19937& rng)
+            {
+                std::uniform_real_distribution<Audio::F32_T> dist(-1.1F, 1.1F);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    data[i] = dist(rng);
+                }
+            }
+
+            template<>
+            void randomData(Audio::F64_T* data, size_t size, std::mt19937& rng)
+            {
+                std::uniform_real_distribution<Audio::F64_T> dist(-1.1, 1.1);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    data[i] = dist(rng);
+                }
+            }
+
+            void randomData(const std::shared_ptr<Audio::Data>& data, std::mt19937& rng)
+            {
+                const size_t size = data->getSampleCount() * data->getChannelCount();
+                switch (data->getType())
+                {
+                case Audio::Type::S8:  randomData(reinterpret_cast<Audio::S8_T*> (data->getData()), size, rng); break;
+                case Audio::Type::S16: randomData(reinterpret_cast<Audio::S16_T*>(data->getData()), size, rng); break;
+                case Audio::Type::S32: randomData(reinterpret_cast<Audio::S32_T*>(data->getData()), size, rng); break;
+                case Audio::Type::F32: randomData(reinterpret_cast<Audio::F32_T*>(data->getData()), size, rng); break;
+                case Audio::Type::F64: randomData(reinterpret_cast<Audio::F64_T*>(data->getData()), size, rng); break;
+                default: break;
+                }
+            }
+
+            template<typename A, typename B>
+            void convertSamples(const A* in, B* out, size_t size, void (*convert)(A, B&))
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    convert(in[i], out[i]);
+                }
+            }
+
+            //! Convert the samples one at a time with the per-sample functions.
+            std::shared_ptr<Audio::Data> convertSamples(const std::shared_ptr<Audio::Data>& data, Audio::Type type)
+            {
+                const Audio::Info& info = data->getInfo();
+                auto out = Audio::Data::create(Audio::Info(info.channelCount, type, info.sampleRate, info.sampleCount));
+                const size_t size = info.sampleCount * info.channelCount;
+                const uint8_t* in = data->getData();
+                uint8_t* outP = out->getData();
+
+#define _CONVERT_SAMPLES(a, b) \
+    if (Audio::Type::a == info.type && Audio::Type::b == type) \
+    { \
+        convertSamples( \
+            reinterpret_cast<const Audio::a##_T*>(in), \
+            reinterpret_cast<Audio::b##_T*>(outP), \
+            size, \
+            Audio::a##To##b); \
+    }
+                _CONVERT_SAMPLES(S8, S16);
+                _CONVERT_SAMPLES(S8, S32);
+                _CONVERT_SAMPLES(S8, F32);
+                _CONVERT_SAMPLES(S8, F64);
+                _CONVERT_SAMPLES(S16, S8);
+                _CONVERT_SAMPLES(S16, S32);
+                _CONVERT_SAMPLES(S16, F32);
+                _CONVERT_SAMPLES(S16, F64);
+                _CONVERT_SAMPLES(S32, S8);
+                _CONVERT_SAMPLES(S32, S16);
+                _CONVERT_SAMPLES(S32, F32);
+                _CONVERT_SAMPLES(S32, F64);
+                _CONVERT_SAMPLES(F32, S8);
+                _CONVERT_SAMPLES(F32, S16);
+                _CONVERT_SAMPLES(F32, S32);
+                _CONVERT_SAMPLES(F32, F64);
+                _CONVERT_SAMPLES(F64, S8);
+                _CONVERT_SAMPLES(F64, S16);
+                _CONVERT_SAMPLES(F64, S32);
+                _CONVERT_SAMPLES(F64, F32);
+#undef _CONVERT_SAMPLES
+
+                if (info.type == type)
+                {
+                    memcpy(outP, in, out->getByteCount());
+                }
+                return out;
+            }
+
+        } // namespace
+
+        void AudioDataTest::_convert()
+        {
+            std::mt19937 rng(1);
+            for (auto i : Audio::getTypeEnums())
+            {
+                if (Audio::Type::None == i)
+                    continue;
+                for (auto j : Audio::getTypeEnums())
+                {
+                    if (Audio::Type::None == j)
+                        continue;
+                    // Use an odd sample count to check the remainder after the vector loop.
+                    const Audio::Info info(2, i, 44100, 1001);
+                    auto data = Audio::Data::create(info);
+                    randomData(data, rng);
+                    auto data2 = Audio::Data::convert(data, j);
+                    auto data3 = convertSamples(data, j);
+                    DJV_ASSERT(*data2 == *data3);
+                }
+            }
+        }
+
+        void AudioDataTest::_shuffle()
+        {
+            std::mt19937 rng(1);
+            for (auto i : Audio::getTypeEnums())
+            {
+                if (Audio::Type::None == i)
+                    continue;
+                for (uint8_t channelCount : { 1, 2, 3, 6 })
+                {
+                    const Audio::Info info(channelCount, i, 44100, 1001);
+                    auto data = Audio::Data::create(info);
+                    randomData(data, rng);
+                    auto data2 = Audio::Data::planarInterleave(data);
+                    const size_t byteCount = Audio::getByteCount(i);
+                    for (size_t j = 0; j < info.sampleCount; j += 100)
+                    {
+                        for (uint8_t c = 0; c < channelCount; ++c)
+                        {
+                            DJV_ASSERT(0 == memcmp(
+                                data->getData() + (c * info.sampleCount + j) * byteCount,
+                                data2->getData() + (j * channelCount + c) * byteCount,
+                                byteCount));
+                        }
+                    }
+                    auto data3 = Audio::Data::planarDeinterleave(data2);
+                    DJV_ASSERT(*data == *data3);
+                }
+            }
+        }
+
+        void AudioDataTest::_remap()
+        {
+            {
+                const Audio::Info info(2, Audio::Type::S16, 44100, 1001);
+                auto data = Audio::Data::create(info);
+                std::mt19937 rng(1);
+                randomData(data, rng);
+                const Audio::Info info2(3, Audio::Type::F32, 44100, 1001);
+                auto data2 = Audio::Data::create(info2);
+                Audio::Data::convert(
+                    data->getData(), info.type, info.channelCount,
+                    data2->getData(), info2.type, info2.channelCount,
+                    info.sampleCount,
+                    .5F,
+                    { 1, 0, -1 });
+                const Audio::S16_T* p = reinterpret_cast<const Audio::S16_T*>(data->getData());
+                const Audio::F32_T* p2 = reinterpret_cast<const Audio::F32_T*>(data2->getData());
+                for (size_t i = 0; i < info.sampleCount; ++i, p += 2, p2 += 3)
+                {
+                    DJV_ASSERT(fuzzyCompare(p2[0], p[1] / static_cast<float>(Audio::S16Range.max) * .5F, .0001F));
+                    DJV_ASSERT(fuzzyCompare(p2[1], p[0] / static_cast<float>(Audio::S16Range.max) * .5F, .0001F));
+                    DJV_ASSERT(0.F == p2[2]);
+                }
+            }
+
+            for (auto i : Audio::getTypeEnums())
+            {
+                if (Audio::Type::None == i)
+                    continue;
+                for (auto j : Audio::getTypeEnums())
+                {
+                    if (Audio::Type::None == j)
+                        continue;
+                    const Audio::Info info(2, i, 44100, 1001);
+                    auto data = Audio::Data::create(info);
+                    std::mt19937 rng(1);
+                    randomData(data, rng);
+                    auto data2 = Audio::Data::create(Audio::Info(2, j, 44100, 1001));
+                    auto data3 = Audio::Data::create(Audio::Info(2, j, 44100, 1001));
+
+                    // The contiguous and channel mapped paths should match.
+                    Audio::Data::convert(data->getData(), i, 2, data2->getData(), j, 2, info.sampleCount, .5F);
+                    Audio::Data::convert(data->getData(), i, 2, data3->getData(), j, 2, info.sampleCount, .5F, { 0, 1 });
+                    DJV_ASSERT(*data2 == *data3);
+                }
+            }
+        }
+
         void AudioDataTest::_operators()
         {
             {
@@ -45,6 +45,9 @@ namespace djv
             void _info();
             void _data();
             void _util();
+            void _convert();
+            void _shuffle();
+            void _remap();
             void _operators();
         };
         
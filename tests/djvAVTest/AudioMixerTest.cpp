@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/AudioMixerTest.h>
+
+#include <djvAV/AudioMixer.h>
+#include <djvAV/IO.h>
+
+#include <djvCore/Timer.h>
+
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            class Read : public IO::IRead
+            {
+            protected:
+                Read()
+                {}
+
+            public:
+                static std::shared_ptr<Read> create()
+                {
+                    auto out = std::shared_ptr<Read>(new Read);
+                    out->_init(FileSystem::FileInfo(), IO::ReadOptions(), nullptr, nullptr);
+                    return out;
+                }
+
+                bool isRunning() const override
+                {
+                    return true;
+                }
+
+                std::future<IO::Info> getInfo() override
+                {
+                    std::promise<IO::Info> promise;
+                    promise.set_value(IO::Info());
+                    return promise.get_future();
+                }
+
+                void seek(int64_t, IO::Direction) override
+                {}
+
+                void addAudio(const std::shared_ptr<Audio::Data>& value, size_t track = 0)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    getAudioTrackQueue(track).addFrame(IO::AudioFrame(value));
+                }
+
+                void setFinished(size_t track = 0)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    getAudioTrackQueue(track).setFinished(true);
+                }
+            };
+
+            std::vector<Audio::F32_T> readAll(const std::shared_ptr<Audio::Mixer>& mixer, size_t sampleCount, float volume = 1.F)
+            {
+                const uint8_t channelCount = mixer->getInfo().channelCount;
+                std::vector<Audio::F32_T> out(sampleCount * channelCount);
+                size_t size = 0;
+                for (size_t i = 0; i < 1000 && size < sampleCount; ++i)
+                {
+                    size += mixer->read(out.data() + size * channelCount, sampleCount - size, volume);
+                    if (size < sampleCount)
+                    {
+                        std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::VeryFast));
+                    }
+                }
+                out.resize(size * channelCount);
+                return out;
+            }
+
+        } // namespace
+
+        AudioMixerTest::AudioMixerTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::AudioMixerTest", context)
+        {}
+        
+        void AudioMixerTest::run(const std::vector<std::string>& args)
+        {
+            _sources();
+            _mix();
+            _tracks();
+            _reset();
+        }
+
+        void AudioMixerTest::_sources()
+        {
+            auto mixer = Audio::Mixer::create(2, 48000);
+            DJV_ASSERT(Audio::Info(2, Audio::Type::F32, 48000, 0) == mixer->getInfo());
+            DJV_ASSERT(0 == mixer->getSourceCount());
+            DJV_ASSERT(!mixer->isActive());
+
+            const size_t index = mixer->addSource(Read::create(), 0, Audio::Info(1, Audio::Type::S16, 48000, 0));
+            DJV_ASSERT(0 == index);
+            DJV_ASSERT(1 == mixer->getSourceCount());
+            DJV_ASSERT(1.F == mixer->getGain(index));
+            DJV_ASSERT(mixer->getChannelMap(index).empty());
+
+            mixer->setGain(index, .5F);
+            DJV_ASSERT(.5F == mixer->getGain(index));
+            const std::vector<int8_t> channelMap = { 0, 0 };
+            mixer->setChannelMap(index, channelMap);
+            DJV_ASSERT(channelMap == mixer->getChannelMap(index));
+
+            try
+            {
+                mixer->addSource(Read::create(), 0, Audio::Info(2, Audio::Type::S16, 44100, 0));
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+            DJV_ASSERT(1 == mixer->getSourceCount());
+
+            mixer->clearSources();
+            DJV_ASSERT(0 == mixer->getSourceCount());
+        }
+
+        void AudioMixerTest::_mix()
+        {
+            // Mix a stereo track with a shorter mono track that is routed to
+            // both output channels.
+            const size_t sampleCount = 1024;
+            const size_t monoSampleCount = 300;
+            auto stereoRead = Read::create();
+            auto stereo = Audio::Data::create(Audio::Info(2, Audio::Type::F32, 48000, sampleCount));
+            auto stereoData = reinterpret_cast<Audio::F32_T*>(stereo->getData());
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                stereoData[i * 2]     = .25F;
+                stereoData[i * 2 + 1] = -.25F;
+            }
+            stereoRead->addAudio(stereo);
+            stereoRead->setFinished();
+
+            auto monoRead = Read::create();
+            for (size_t i = 0; i < monoSampleCount; i += 100)
+            {
+                auto mono = Audio::Data::create(Audio::Info(1, Audio::Type::F32, 48000, 100));
+                auto monoData = reinterpret_cast<Audio::F32_T*>(mono->getData());
+                for (size_t j = 0; j < 100; ++j)
+                {
+                    monoData[j] = .5F;
+                }
+                monoRead->addAudio(mono);
+            }
+            monoRead->setFinished();
+
+            auto mixer = Audio::Mixer::create(2, 48000);
+            mixer->addSource(stereoRead, 0, stereo->getInfo());
+            const size_t monoIndex = mixer->addSource(monoRead, 0, Audio::Info(1, Audio::Type::F32, 48000, 0));
+            mixer->setGain(monoIndex, .5F);
+            mixer->setChannelMap(monoIndex, { 0, 0 });
+            mixer->setActive(true);
+
+            const auto out = readAll(mixer, sampleCount, .5F);
+            DJV_ASSERT(sampleCount * 2 == out.size());
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                const float mono = i < monoSampleCount ? .25F : 0.F;
+                DJV_ASSERT(fuzzyCompare(out[i * 2],     (.25F + mono) * .5F, .0001F));
+                DJV_ASSERT(fuzzyCompare(out[i * 2 + 1], (-.25F + mono) * .5F, .0001F));
+            }
+
+            // All of the sources are finished so nothing else is mixed.
+            std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+            DJV_ASSERT(0 == mixer->getAvailable());
+        }
+
+        void AudioMixerTest::_tracks()
+        {
+            // Mix two audio tracks from the same reader.
+            const size_t sampleCount = 512;
+            auto read = Read::create();
+            {
+                std::lock_guard<std::mutex> lock(read->getMutex());
+                DJV_ASSERT(&read->getAudioQueue() == &read->getAudioTrackQueue(0));
+                DJV_ASSERT(&read->getAudioQueue() != &read->getAudioTrackQueue(1));
+                DJV_ASSERT(read->getAudioQueue().getMax() == read->getAudioTrackQueue(1).getMax());
+            }
+            for (size_t track = 0; track < 2; ++track)
+            {
+                auto data = Audio::Data::create(Audio::Info(1, Audio::Type::F32, 48000, sampleCount));
+                auto p = reinterpret_cast<Audio::F32_T*>(data->getData());
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    p[i] = 0 == track ? .25F : .5F;
+                }
+                read->addAudio(data, track);
+                read->setFinished(track);
+            }
+
+            auto mixer = Audio::Mixer::create(1, 48000);
+            mixer->addSource(read, 0, Audio::Info(1, Audio::Type::F32, 48000, 0));
+            mixer->addSource(read, 1, Audio::Info(1, Audio::Type::F32, 48000, 0));
+            mixer->setActive(true);
+
+            const auto out = readAll(mixer, sampleCount);
+            DJV_ASSERT(sampleCount == out.size());
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                DJV_ASSERT(fuzzyCompare(out[i], .75F, .0001F));
+            }
+        }
+
+        void AudioMixerTest::_reset()
+        {
+            auto read = Read::create();
+            auto data = Audio::Data::create(Audio::Info(1, Audio::Type::S16, 48000, 2048));
+            data->zero();
+            read->addAudio(data);
+
+            auto mixer = Audio::Mixer::create(1, 48000);
+            mixer->addSource(read, 0, data->getInfo());
+            mixer->setActive(true);
+            while (mixer->getAvailable() < 2048)
+            {
+                std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::VeryFast));
+            }
+            mixer->setActive(false);
+            mixer->reset();
+            DJV_ASSERT(0 == mixer->getAvailable());
+            std::vector<Audio::F32_T> out(256);
+            DJV_ASSERT(0 == mixer->read(out.data(), out.size()));
+        }
+        
+    } // namespace AVTest
+} // namespace djv
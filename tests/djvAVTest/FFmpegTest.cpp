@@ -0,0 +1,469 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/FFmpegTest.h>
+
+#include <djvAV/IO.h>
+#include <djvAV/ImageUtil.h>
+#if defined(FFmpeg_FOUND)
+#include <djvAV/FFmpeg.h>
+#endif // FFmpeg_FOUND
+
+#if defined(FFmpeg_FOUND)
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavutil/pixdesc.h>
+
+} // extern "C"
+#endif // FFmpeg_FOUND
+
+#include <djvCore/Context.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Timer.h>
+
+#include <functional>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            const size_t frameCount = 30;
+
+            std::shared_ptr<Image::Image> createImage(const Image::Info& info, Frame::Number frame)
+            {
+                auto out = Image::Image::create(info);
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    uint8_t* p = out->getData(y);
+                    for (uint16_t x = 0; x < info.size.w; ++x, p += 4)
+                    {
+                        p[0] = static_cast<uint8_t>(x * 4 + frame);
+                        p[1] = static_cast<uint8_t>(y * 4);
+                        p[2] = static_cast<uint8_t>(frame * 8);
+                        p[3] = 255;
+                    }
+                }
+                return out;
+            }
+
+            //! Create an image with a flat color that identifies the frame after
+            //! lossy compression.
+            std::shared_ptr<Image::Image> createFlatImage(const Image::Info& info, Frame::Number frame)
+            {
+                auto out = Image::Image::create(info);
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    uint8_t* p = out->getData(y);
+                    for (uint16_t x = 0; x < info.size.w; ++x, p += 4)
+                    {
+                        p[0] = static_cast<uint8_t>(frame * 8);
+                        p[1] = static_cast<uint8_t>(255 - frame * 8);
+                        p[2] = 128;
+                        p[3] = 255;
+                    }
+                }
+                return out;
+            }
+
+            Frame::Number getFlatFrame(const std::shared_ptr<Image::Image>& image)
+            {
+                const auto rgba = Image::convertYUV(image);
+                const uint8_t* p = rgba->getData(rgba->getWidth() / 2, rgba->getHeight() / 2);
+                const int r = Image::Type::RGBA_U16 == rgba->getType() ?
+                    (reinterpret_cast<const uint16_t*>(p)[0] >> 8) :
+                    p[0];
+                return (r + 4) / 8;
+            }
+
+            bool compare(const std::shared_ptr<Image::Image>& a, const std::shared_ptr<Image::Image>& b)
+            {
+                if (a->getSize() != b->getSize())
+                {
+                    return false;
+                }
+                for (uint16_t y = 0; y < a->getHeight(); ++y)
+                {
+                    const uint8_t* aP = a->getData(y);
+                    const uint8_t* bP = b->getData(y);
+                    for (uint16_t x = 0; x < a->getWidth(); ++x, aP += 4, bP += 4)
+                    {
+                        if (aP[0] != bP[0] || aP[1] != bP[1] || aP[2] != bP[2])
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            void write(
+                const std::shared_ptr<IO::System>& io,
+                const FileSystem::Path& path,
+                const Image::Info& info,
+                const std::function<std::shared_ptr<Image::Image>(const Image::Info&, Frame::Number)>& create,
+                bool wait = true)
+            {
+                IO::Info ioInfo;
+                ioInfo.video.push_back(IO::VideoInfo(
+                    info,
+                    Time::Speed(24),
+                    Frame::Sequence(0, frameCount - 1)));
+                auto write = io->write(FileSystem::FileInfo(path), ioInfo);
+                for (size_t i = 0; i < frameCount; ++i)
+                {
+                    std::lock_guard<std::mutex> lock(write->getMutex());
+                    write->getVideoQueue().addFrame(IO::VideoFrame(i, create(info, i)));
+                }
+                if (!wait)
+                {
+                    // Destroying the writer must finish writing the file.
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(write->getMutex());
+                    write->getVideoQueue().setFinished(true);
+                }
+                while (write->isRunning())
+                {
+                    std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                }
+            }
+
+            //! Read frames until the queue is finished or the maximum is reached.
+            std::vector<IO::VideoFrame> read(const std::shared_ptr<IO::IRead>& read, size_t max)
+            {
+                std::vector<IO::VideoFrame> out;
+                bool running = true;
+                while (running && out.size() < max)
+                {
+                    bool sleep = false;
+                    {
+                        std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
+                        if (lock.owns_lock())
+                        {
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                out.push_back(readQueue.popFrame());
+                            }
+                            else if (readQueue.isFinished())
+                            {
+                                running = false;
+                            }
+                            else
+                            {
+                                sleep = true;
+                            }
+                        }
+                        else
+                        {
+                            sleep = true;
+                        }
+                    }
+                    if (sleep)
+                    {
+                        std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                    }
+                }
+                return out;
+            }
+
+#if defined(FFmpeg_FOUND)
+            //! Get the pixel format and the key frame flags of the video stream
+            //! directly from the file.
+            struct StreamInfo
+            {
+                AVPixelFormat pixelFormat = AV_PIX_FMT_NONE;
+                std::vector<bool> keyFrames;
+            };
+
+            StreamInfo getStreamInfo(const FileSystem::Path& path)
+            {
+                StreamInfo out;
+                AVFormatContext* avFormatContext = nullptr;
+                if (avformat_open_input(&avFormatContext, path.get().c_str(), nullptr, nullptr) < 0)
+                {
+                    return out;
+                }
+                if (avformat_find_stream_info(avFormatContext, nullptr) >= 0)
+                {
+                    const int stream = av_find_best_stream(avFormatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+                    if (stream >= 0)
+                    {
+                        out.pixelFormat = static_cast<AVPixelFormat>(avFormatContext->streams[stream]->codecpar->format);
+                        AVPacket packet;
+                        av_init_packet(&packet);
+                        packet.data = nullptr;
+                        packet.size = 0;
+                        while (av_read_frame(avFormatContext, &packet) >= 0)
+                        {
+                            if (stream == packet.stream_index)
+                            {
+                                out.keyFrames.push_back(packet.flags & AV_PKT_FLAG_KEY);
+                            }
+                            av_packet_unref(&packet);
+                        }
+                    }
+                }
+                avformat_close_input(&avFormatContext);
+                return out;
+            }
+#endif // FFmpeg_FOUND
+
+        } // namespace
+        
+        FFmpegTest::FFmpegTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::FFmpegTest", context)
+        {}
+        
+        void FFmpegTest::run(const std::vector<std::string>& args)
+        {
+            _read();
+            _reverse();
+            _roundTrip();
+        }
+        
+        void FFmpegTest::_read()
+        {
+#if defined(FFmpeg_FOUND)
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+
+                // Use a lossless codec and an RGB pixel format so that the frames
+                // go through the software scaler and can be compared exactly.
+                IO::FFmpeg::Options options;
+                options.codec = "ffv1";
+                options.pixelFormat = "bgr0";
+                io->setOptions(IO::FFmpeg::pluginName, toJSON(options));
+                const Image::Info info(Image::Size(64, 48), Image::Type::RGBA_U8);
+                const FileSystem::Path path("FFmpegTest.mkv");
+                write(io, path, info, createImage);
+
+                {
+                    _print("Forward");
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    const auto ioInfo = read->getInfo().get();
+                    DJV_ASSERT(1 == ioInfo.video.size());
+                    DJV_ASSERT(info.size == ioInfo.video[0].info.size);
+                    const auto frames = AVTest::read(read, frameCount + 1);
+                    DJV_ASSERT(frameCount == frames.size());
+                    for (size_t i = 0; i < frames.size(); ++i)
+                    {
+                        DJV_ASSERT(static_cast<Frame::Number>(i) == frames[i].frame);
+                        DJV_ASSERT(compare(createImage(info, i), frames[i].image));
+                    }
+                    std::lock_guard<std::mutex> lock(read->getMutex());
+                    DJV_ASSERT(read->getVideoQueue().isFinished());
+                }
+
+                {
+                    _print("Seek");
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    read->seek(15, IO::Direction::Forward);
+                    const auto frames = AVTest::read(read, frameCount);
+                    DJV_ASSERT(frameCount - 15 == frames.size());
+                    for (size_t i = 0; i < frames.size(); ++i)
+                    {
+                        DJV_ASSERT(static_cast<Frame::Number>(15 + i) == frames[i].frame);
+                        DJV_ASSERT(compare(createImage(info, 15 + i), frames[i].image));
+                    }
+                }
+
+                {
+                    // Frames that were in flight for the first seek must be
+                    // discarded by the pipeline.
+                    _print("Seek flush");
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    read->seek(5, IO::Direction::Forward);
+                    read->seek(20, IO::Direction::Forward);
+                    const auto frames = AVTest::read(read, frameCount);
+                    DJV_ASSERT(frameCount - 20 == frames.size());
+                    DJV_ASSERT(20 == frames[0].frame);
+                    DJV_ASSERT(compare(createImage(info, 20), frames[0].image));
+                }
+
+                FileSystem::remove(path.get());
+                io->setOptions(IO::FFmpeg::pluginName, toJSON(IO::FFmpeg::Options()));
+            }
+#endif // FFmpeg_FOUND
+        }
+        
+        void FFmpegTest::_reverse()
+        {
+#if defined(FFmpeg_FOUND)
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+
+                // Use a codec with inter frames and a GOP that does not divide
+                // the frame count, so the first GOP read in reverse is short.
+                IO::FFmpeg::Options options;
+                options.codec = "mpeg4";
+                options.pixelFormat = "yuv420p";
+                options.gopSize = 12;
+                io->setOptions(IO::FFmpeg::pluginName, toJSON(options));
+                const Image::Info info(Image::Size(64, 48), Image::Type::RGBA_U8);
+                const FileSystem::Path path("FFmpegTest_reverse.mkv");
+                write(io, path, info, createFlatImage);
+
+                {
+                    _print("Reverse");
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    read->seek(frameCount - 1, IO::Direction::Reverse);
+                    const auto frames = AVTest::read(read, frameCount + 1);
+                    DJV_ASSERT(frameCount == frames.size());
+                    for (size_t i = 0; i < frames.size(); ++i)
+                    {
+                        const Frame::Number frame = frameCount - 1 - i;
+                        DJV_ASSERT(frame == frames[i].frame);
+                        DJV_ASSERT(frame == getFlatFrame(frames[i].image));
+                    }
+                    std::lock_guard<std::mutex> lock(read->getMutex());
+                    DJV_ASSERT(read->getVideoQueue().isFinished());
+                }
+
+                {
+                    // A seek in the middle of a GOP, followed by a seek into
+                    // another GOP while the first one is in flight.
+                    _print("Reverse seek");
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    read->seek(20, IO::Direction::Reverse);
+                    read->seek(8, IO::Direction::Reverse);
+                    const auto frames = AVTest::read(read, frameCount);
+                    DJV_ASSERT(9 == frames.size());
+                    for (size_t i = 0; i < frames.size(); ++i)
+                    {
+                        const Frame::Number frame = 8 - i;
+                        DJV_ASSERT(frame == frames[i].frame);
+                        DJV_ASSERT(frame == getFlatFrame(frames[i].image));
+                    }
+                }
+
+                {
+                    // Change direction after reading part of a GOP in reverse.
+                    _print("Reverse to forward");
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    read->seek(15, IO::Direction::Reverse);
+                    auto frames = AVTest::read(read, 2);
+                    DJV_ASSERT(2 == frames.size());
+                    DJV_ASSERT(15 == frames[0].frame);
+                    DJV_ASSERT(14 == frames[1].frame);
+                    read->seek(14, IO::Direction::Forward);
+                    frames = AVTest::read(read, frameCount);
+                    DJV_ASSERT(frameCount - 14 == frames.size());
+                    for (size_t i = 0; i < frames.size(); ++i)
+                    {
+                        DJV_ASSERT(static_cast<Frame::Number>(14 + i) == frames[i].frame);
+                    }
+                }
+
+                FileSystem::remove(path.get());
+                io->setOptions(IO::FFmpeg::pluginName, toJSON(IO::FFmpeg::Options()));
+            }
+#endif // FFmpeg_FOUND
+        }
+        
+        void FFmpegTest::_roundTrip()
+        {
+#if defined(FFmpeg_FOUND)
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                struct Data
+                {
+                    std::string codec;
+                    std::string pixelFormat;
+                    size_t gopSize;
+                    Image::Type type;
+                    bool wait;
+                };
+                const std::vector<Data> data =
+                {
+                    { "ffv1", "bgr0", 1, Image::Type::RGBA_U8, true },
+                    { "ffv1", "yuv444p10le", 1, Image::Type::YUV_444P_U10, true },
+                    { "mjpeg", "yuvj422p", 1, Image::Type::YUV_422P_U8, true },
+                    { "mpeg4", "yuv420p", 12, Image::Type::YUV_420P_U8, true },
+                    { "mpeg4", "yuv420p", 8, Image::Type::YUV_420P_U8, false }
+                };
+                for (const auto& i : data)
+                {
+                    std::stringstream ss;
+                    ss << "Round trip: " << i.codec << " " << i.pixelFormat << " " << i.gopSize;
+                    _print(ss.str());
+
+                    IO::FFmpeg::Options options;
+                    options.codec = i.codec;
+                    options.pixelFormat = i.pixelFormat;
+                    options.gopSize = i.gopSize;
+                    io->setOptions(IO::FFmpeg::pluginName, toJSON(options));
+                    const Image::Info info(Image::Size(64, 48), Image::Type::RGBA_U8);
+                    const FileSystem::Path path("FFmpegTest_roundTrip.mkv");
+                    write(io, path, info, createFlatImage, i.wait);
+
+                    const auto streamInfo = getStreamInfo(path);
+                    DJV_ASSERT(av_get_pix_fmt(i.pixelFormat.c_str()) == streamInfo.pixelFormat);
+                    DJV_ASSERT(frameCount == streamInfo.keyFrames.size());
+                    for (size_t j = 0; j < streamInfo.keyFrames.size(); j += i.gopSize)
+                    {
+                        DJV_ASSERT(streamInfo.keyFrames[j]);
+                    }
+
+                    auto read = io->read(FileSystem::FileInfo(path));
+                    const auto ioInfo = read->getInfo().get();
+                    DJV_ASSERT(1 == ioInfo.video.size());
+                    DJV_ASSERT(avcodec_find_decoder_by_name(i.codec.c_str())->long_name == ioInfo.video[0].codec);
+                    DJV_ASSERT(info.size == ioInfo.video[0].info.size);
+                    DJV_ASSERT(i.type == ioInfo.video[0].info.type);
+                    const auto frames = AVTest::read(read, frameCount + 1);
+                    DJV_ASSERT(frameCount == frames.size());
+                    for (size_t j = 0; j < frames.size(); ++j)
+                    {
+                        DJV_ASSERT(static_cast<Frame::Number>(j) == frames[j].frame);
+                        DJV_ASSERT(static_cast<Frame::Number>(j) == getFlatFrame(frames[j].image));
+                    }
+
+                    read.reset();
+                    FileSystem::remove(path.get());
+                }
+                io->setOptions(IO::FFmpeg::pluginName, toJSON(IO::FFmpeg::Options()));
+            }
+#endif // FFmpeg_FOUND
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
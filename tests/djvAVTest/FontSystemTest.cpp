@@ -245,6 +245,28 @@ namespace djv
                     ss << "glyph cache percentage: " << system->getGlyphCachePercentage();
                     _print(ss.str());
                 }
+
+                {
+                    auto future = system->measure(text, info);
+                    DJV_ASSERT(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                    DJV_ASSERT(measure == future.get());
+                }
+                {
+                    auto future = system->textLines(text, 100, info);
+                    DJV_ASSERT(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                    DJV_ASSERT(textLines.size() == future.get().size());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "text cache size: " << system->getTextCacheSize();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "text cache hit rate: " << system->getTextCacheHitRate();
+                    _print(ss.str());
+                }
+                DJV_ASSERT(system->getTextCacheHitRate() > 0.F);
             }
         }
 
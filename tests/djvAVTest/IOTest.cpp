@@ -32,9 +32,12 @@
 #include <djvAV/IO.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileSystem.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -57,6 +60,7 @@ namespace djv
             _audioQueue();
             _cache();
             _io();
+            _magicNumbers();
             _system();
             _operators();
         }
@@ -380,6 +384,67 @@ namespace djv
             }
         }
         
+        void IOTest::_magicNumbers()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<AV::IO::System>();
+                const Image::Info imageInfo(16, 16, Image::Type::RGB_U8);
+                auto image = Image::Image::create(imageInfo);
+                image->zero();
+                {
+                    IO::Info info;
+                    info.video.push_back(imageInfo);
+                    auto write = io->write(FileSystem::FileInfo("IOTest_magic.ppm"), info);
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        auto& writeQueue = write->getVideoQueue();
+                        writeQueue.addFrame(IO::VideoFrame(0, image));
+                        writeQueue.setFinished(true);
+                    }
+                    while (write->isRunning())
+                    {}
+                }
+
+                // A file without an extension.
+                FileSystem::rename("IOTest_magic.ppm", "IOTest_magic");
+                {
+                    const FileSystem::FileInfo fileInfo("IOTest_magic");
+                    DJV_ASSERT(io->canRead(fileInfo));
+                    auto read = io->read(fileInfo);
+                    const auto info = read->getInfo().get();
+                    DJV_ASSERT(1 == info.video.size());
+                    DJV_ASSERT(imageInfo.size == info.video[0].info.size);
+                }
+
+                // A file with the wrong extension.
+                FileSystem::rename("IOTest_magic", "IOTest_magic.dpx");
+                {
+                    const FileSystem::FileInfo fileInfo("IOTest_magic.dpx");
+                    DJV_ASSERT(io->canRead(fileInfo));
+                    auto read = io->read(fileInfo);
+                    const auto info = read->getInfo().get();
+                    DJV_ASSERT(1 == info.video.size());
+                    DJV_ASSERT(imageInfo.size == info.video[0].info.size);
+                }
+
+                // A file with an unknown extension is not opened.
+                FileSystem::rename("IOTest_magic.dpx", "IOTest_magic.txt");
+                {
+                    const FileSystem::FileInfo fileInfo("IOTest_magic.txt");
+                    DJV_ASSERT(!io->canRead(fileInfo));
+                    try
+                    {
+                        io->read(fileInfo);
+                        DJV_ASSERT(false);
+                    }
+                    catch (const std::exception&)
+                    {}
+                }
+                FileSystem::remove("IOTest_magic.txt");
+            }
+        }
+
         void IOTest::_system()
         {
             if (auto context = getContext().lock())
@@ -30,7 +30,10 @@
 #include <djvAVTest/ImageDataTest.h>
 
 #include <djvAV/ImageData.h>
+#include <djvAV/ImageUtil.h>
 
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
 #include <djvCore/Memory.h>
 
 using namespace djv::Core;
@@ -51,6 +54,8 @@ namespace djv
             _size();
             _info();
             _data();
+            _mmap();
+            _yuv();
             _operators();
             _serialize();
         }
@@ -225,12 +230,72 @@ namespace djv
                 DJV_ASSERT(data->getData());
                 DJV_ASSERT(data->getData(0));
                 DJV_ASSERT(data->getData(0, 0));
+                DJV_ASSERT(!data->isMemoryMapped());
 
                 auto data2 = Image::Data::create(info);
                 DJV_ASSERT(data->getUID() != data2->getUID());
             }
         }
         
+        void ImageDataTest::_mmap()
+        {
+#if defined(DJV_MMAP)
+            const std::string fileName = "ImageDataTest_mmap.raw";
+            const Image::Info info(4, 2, Image::Type::RGB_U8);
+            const size_t byteCount = info.getDataByteCount();
+            {
+                std::vector<uint8_t> bytes(byteCount);
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    bytes[i] = static_cast<uint8_t>(i);
+                }
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.write(bytes.data(), byteCount);
+            }
+
+            {
+                // The data is used directly from the memory-map.
+                auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->isMemoryMapped());
+                const auto& constData = *data;
+                DJV_ASSERT(io->mmapP() == constData.getData());
+                DJV_ASSERT(byteCount == data->getDataByteCount());
+                data->readAhead();
+
+                // Writing to the data detaches it from the file.
+                uint8_t* p = data->getData();
+                DJV_ASSERT(!data->isMemoryMapped());
+                DJV_ASSERT(io->mmapP() != p);
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    DJV_ASSERT(static_cast<uint8_t>(i) == p[i]);
+                }
+                p[0] = 255;
+                DJV_ASSERT(0 == io->mmapP()[0]);
+            }
+
+            {
+                // Files that are shorter than the image are copied and the
+                // missing data is zeroed.
+                auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                const Image::Info bigInfo(4, 4, Image::Type::RGB_U8);
+                auto data = Image::Data::create(bigInfo, io);
+                DJV_ASSERT(!data->isMemoryMapped());
+                const auto& constData = *data;
+                for (size_t i = 0; i < bigInfo.getDataByteCount(); ++i)
+                {
+                    DJV_ASSERT((i < byteCount ? static_cast<uint8_t>(i) : 0) == constData.getData()[i]);
+                }
+            }
+
+            FileSystem::remove(fileName);
+#endif // DJV_MMAP
+        }
+
         void ImageDataTest::_util()
         {
             {
@@ -241,6 +306,98 @@ namespace djv
             }
         }
         
+        void ImageDataTest::_yuv()
+        {
+            {
+                const Image::Info info(5, 3, Image::Type::YUV_420P_U8);
+                DJV_ASSERT(3 == info.getPlaneCount());
+                DJV_ASSERT(Image::Size(5, 3) == info.getPlaneSize(0));
+                DJV_ASSERT(Image::Size(3, 2) == info.getPlaneSize(1));
+                DJV_ASSERT(Image::Size(3, 2) == info.getPlaneSize(2));
+                DJV_ASSERT(15 + 6 + 6 == info.getDataByteCount());
+                auto data = Image::Data::create(info);
+                DJV_ASSERT(data->getPlaneData(0) == data->getData());
+                DJV_ASSERT(data->getPlaneData(1) == data->getData() + 15);
+                DJV_ASSERT(data->getPlaneData(2) == data->getData() + 21);
+            }
+
+            {
+                const Image::Info info(5, 3, Image::Type::YUV_422P_U16);
+                DJV_ASSERT(Image::Size(3, 3) == info.getPlaneSize(1));
+                DJV_ASSERT((15 + 9 + 9) * 2 == info.getDataByteCount());
+            }
+
+            {
+                const Image::Info info(5, 3, Image::Type::YUV_444P_U10);
+                DJV_ASSERT(Image::Size(5, 3) == info.getPlaneSize(2));
+                DJV_ASSERT(Image::DataType::U16 == Image::getDataType(info.type));
+                DJV_ASSERT(10 == Image::getBitDepth(info.type));
+                DJV_ASSERT(Image::Type::RGBA_U16 == Image::getYUVConvertType(info.type));
+            }
+
+            {
+                // Video range white and black should convert to the full range.
+                const Image::Info info(5, 3, Image::Type::YUV_420P_U8);
+                auto data = Image::Data::create(info);
+                memset(data->getPlaneData(0), 235, info.getPlaneByteCount(0));
+                data->getPlaneData(0)[4] = 16;
+                memset(data->getPlaneData(1), 128, info.getPlaneByteCount(1));
+                memset(data->getPlaneData(2), 128, info.getPlaneByteCount(2));
+                auto rgba = Image::convertYUV(data);
+                DJV_ASSERT(Image::Type::RGBA_U8 == rgba->getType());
+                DJV_ASSERT(info.size == rgba->getSize());
+                const uint8_t* p = rgba->getData(0, 0);
+                DJV_ASSERT(255 == p[0] && 255 == p[1] && 255 == p[2] && 255 == p[3]);
+                p = rgba->getData(4, 0);
+                DJV_ASSERT(0 == p[0] && 0 == p[1] && 0 == p[2] && 255 == p[3]);
+                p = rgba->getData(4, 2);
+                DJV_ASSERT(255 == p[0] && 255 == p[1] && 255 == p[2] && 255 == p[3]);
+            }
+
+            for (auto type : { Image::Type::YUV_420P_U8, Image::Type::YUV_422P_U10, Image::Type::YUV_444P_U16 })
+            {
+                // Converting RGB to YUV and back should be close to the original.
+                const Image::Info info(9, 5, type);
+                const Image::Info rgbInfo(info.size, Image::getYUVConvertType(type));
+                auto rgb = Image::Data::create(rgbInfo);
+                const bool u8 = Image::Type::RGBA_U8 == rgbInfo.type;
+                const uint16_t max = u8 ? 255 : 65535;
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < info.size.w; ++x)
+                    {
+                        const uint16_t c[4] = { max, static_cast<uint16_t>(max / 2), static_cast<uint16_t>(max / 4), max };
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            if (u8)
+                            {
+                                rgb->getData(x, y)[i] = static_cast<uint8_t>(c[i]);
+                            }
+                            else
+                            {
+                                reinterpret_cast<uint16_t*>(rgb->getData(x, y))[i] = c[i];
+                            }
+                        }
+                    }
+                }
+                auto yuv = Image::Data::create(info);
+                Image::convertRGBToYUV(*rgb, *yuv, 2);
+                auto rgb2 = Image::convertYUV(yuv);
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < info.size.w; ++x)
+                    {
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            const int a = u8 ? rgb->getData(x, y)[i] : reinterpret_cast<const uint16_t*>(rgb->getData(x, y))[i];
+                            const int b = u8 ? rgb2->getData(x, y)[i] : reinterpret_cast<const uint16_t*>(rgb2->getData(x, y))[i];
+                            DJV_ASSERT(std::abs(a - b) <= max / 100);
+                        }
+                    }
+                }
+            }
+        }
+        
         void ImageDataTest::_operators()
         {
             {
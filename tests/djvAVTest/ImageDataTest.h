@@ -46,7 +46,9 @@ namespace djv
             void _size();
             void _info();
             void _data();
+            void _mmap();
             void _util();
+            void _yuv();
             void _operators();
             void _serialize();
         };
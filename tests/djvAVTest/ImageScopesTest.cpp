@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImageScopesTest.h>
+
+#include <djvAV/ImageScopes.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageScopesTest::ImageScopesTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageScopesTest", context)
+        {}
+        
+        void ImageScopesTest::run(const std::vector<std::string>& args)
+        {
+            {
+                const Image::Stats stats;
+                DJV_ASSERT(0 == stats.channelCount);
+                DJV_ASSERT(0 == stats.sampleCount);
+                DJV_ASSERT(stats == Image::getStats(nullptr));
+            }
+            
+            {
+                auto data = Image::Data::create(Image::Info(4, 2, Image::Type::L_U8));
+                uint8_t* p = data->getData();
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    p[i] = i < 4 ? 0 : 255;
+                }
+                const auto stats = Image::getStats(data);
+                DJV_ASSERT(1 == stats.channelCount);
+                DJV_ASSERT(8 == stats.sampleCount);
+                DJV_ASSERT(0.F == stats.min[0]);
+                DJV_ASSERT(1.F == stats.max[0]);
+                DJV_ASSERT(.5F == stats.average[0]);
+            }
+            
+            for (const auto type : Image::getTypeEnums())
+            {
+                if (type != Image::Type::None)
+                {
+                    auto data = Image::Data::create(Image::Info(1000, 500, type));
+                    data->zero();
+                    Image::ScopesOptions options;
+                    options.sampleCountMax = 100 * 100;
+                    for (auto mode : { Image::WaveformMode::Luma, Image::WaveformMode::RGBParade })
+                    {
+                        options.waveformMode = mode;
+                        const auto scopes = Image::getScopes(data, options);
+                        std::stringstream ss;
+                        ss << type << " samples: " << scopes.stats.sampleCount;
+                        _print(ss.str());
+                        DJV_ASSERT(data->getUID() == scopes.uid);
+                        DJV_ASSERT(scopes.stats.sampleCount <= options.sampleCountMax);
+                        DJV_ASSERT(scopes.stats.sampleCount > 0);
+                        DJV_ASSERT(scopes.histogram[3].size() == options.histogramBins);
+                        DJV_ASSERT(scopes.histogram[3][0] == scopes.stats.sampleCount);
+                        DJV_ASSERT(scopes.histogramMax == scopes.stats.sampleCount);
+                        DJV_ASSERT(scopes.waveform);
+                        DJV_ASSERT(scopes.vectorscope);
+                        DJV_ASSERT(scopes.vectorscope->getWidth() == options.vectorscopeSize);
+                        const size_t c = options.vectorscopeSize / 2;
+                        DJV_ASSERT(255 == scopes.vectorscope->getData(
+                            static_cast<uint16_t>(options.vectorscopeSize - 1 - c))[c]);
+                    }
+                }
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -29,7 +29,9 @@
 
 #include <djvAVTest/OCIOTest.h>
 
+#include <djvAV/Image.h>
 #include <djvAV/OCIO.h>
+#include <djvAV/OCIOLUT3D.h>
 
 using namespace djv::Core;
 using namespace djv::AV;
@@ -47,6 +49,7 @@ namespace djv
             _convert();
             _view();
             _display();
+            _lut3D();
             _operators();
         }
 
@@ -89,6 +92,113 @@ namespace djv
             }
         }
         
+        void OCIOTest::_lut3D()
+        {
+            {
+                auto lut = OCIO::LUT3D::create(9);
+                DJV_ASSERT(9 == lut->getEdgeLen());
+                DJV_ASSERT(9 * 9 * 9 * 3 == lut->getData().size());
+                std::vector<float> data =
+                {
+                    0.F, 0.F, 0.F,
+                    1.F, 1.F, 1.F,
+                    .1F, .5F, .9F,
+                    .7F, .3F, .2F,
+                    .25F, .8F, .6F
+                };
+                const auto tmp = data;
+                lut->apply(data.data(), data.size() / 3, 3);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    DJV_ASSERT(fabs(data[i] - tmp[i]) < .0001F);
+                }
+            }
+
+            {
+                auto lut = OCIO::LUT3D::create();
+                auto lutData = lut->getData();
+                for (auto& i : lutData)
+                {
+                    i = 1.F - i;
+                }
+                lut->setData(lutData);
+                auto image = Image::Image::create(Image::Info(16, 7, Image::Type::RGBA_U8));
+                uint8_t* p = image->getData();
+                for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                {
+                    p[i] = static_cast<uint8_t>(i);
+                }
+                auto out = lut->apply(image, 3);
+                DJV_ASSERT(out->getInfo() == image->getInfo());
+                const uint8_t* outP = out->getData();
+                for (size_t i = 0; i < image->getDataByteCount(); i += 4)
+                {
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        DJV_ASSERT(abs((255 - p[i + c]) - outP[i + c]) <= 1);
+                    }
+                    DJV_ASSERT(p[i + 3] == outP[i + 3]);
+                }
+            }
+
+            {
+                // Values above 1.0 are kept when the shaper covers them.
+                auto lut = OCIO::LUT3D::create(17);
+                lut->setShaper(OCIO::LUT3DShaper::Uniform, 0.F, 4.F);
+                auto lutData = lut->getData();
+                for (auto& i : lutData)
+                {
+                    i *= 4.F;
+                }
+                lut->setData(lutData);
+                std::vector<float> data =
+                {
+                    0.F, .5F, 1.F, 1.F,
+                    2.5F, 3.F, 3.9F, 1.F,
+                    5.F, -1.F, 2.F, 1.F
+                };
+                lut->apply(data.data(), data.size() / 4, 4);
+                const std::vector<float> result =
+                {
+                    0.F, .5F, 1.F, 1.F,
+                    2.5F, 3.F, 3.9F, 1.F,
+                    4.F, 0.F, 2.F, 1.F
+                };
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    DJV_ASSERT(fabs(data[i] - result[i]) < .0001F);
+                }
+            }
+
+            {
+                auto lut = OCIO::LUT3D::create();
+                lut->setShaper(OCIO::LUT3DShaper::Log2, -8.F, 8.F);
+                DJV_ASSERT(OCIO::LUT3DShaper::Log2 == lut->getShaper());
+                DJV_ASSERT(-8.F == lut->getShaperMin());
+                DJV_ASSERT(8.F == lut->getShaperMax());
+                auto lutData = lut->getData();
+                for (auto& i : lutData)
+                {
+                    i = powf(2.F, -8.F + i * 16.F);
+                }
+                lut->setData(lutData);
+                std::vector<float> data =
+                {
+                    .01F, .18F, 1.F,
+                    4.F, 16.F, 100.F,
+                    .5F, .5F, .5F,
+                    200.F, 64.F, .02F,
+                    1.5F, 7.F, 30.F
+                };
+                const auto tmp = data;
+                lut->apply(data.data(), data.size() / 3, 3);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    DJV_ASSERT(fabs(data[i] - tmp[i]) / tmp[i] < .02F);
+                }
+            }
+        }
+
         void OCIOTest::_operators()
         {
             {
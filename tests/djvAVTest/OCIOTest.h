@@ -44,6 +44,7 @@ namespace djv
             void _convert();
             void _view();
             void _display();
+            void _lut3D();
             void _operators();
         };
         
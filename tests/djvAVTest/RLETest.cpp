@@ -0,0 +1,417 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/RLETest.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Timer.h>
+
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            std::shared_ptr<Image::Image> read(
+                const std::shared_ptr<IO::System>& io,
+                const FileSystem::Path& path)
+            {
+                std::shared_ptr<Image::Image> out;
+                auto read = io->read(FileSystem::FileInfo(path));
+                bool running = true;
+                while (running)
+                {
+                    bool sleep = false;
+                    {
+                        std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
+                        if (lock.owns_lock())
+                        {
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                out = readQueue.popFrame().image;
+                            }
+                            else if (readQueue.isFinished())
+                            {
+                                running = false;
+                            }
+                            else
+                            {
+                                sleep = true;
+                            }
+                        }
+                        else
+                        {
+                            sleep = true;
+                        }
+                    }
+                    if (sleep)
+                    {
+                        std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Image> createImage(const Image::Size& size)
+            {
+                auto out = Image::Image::create(Image::Info(size, Image::Type::RGBA_U8));
+                uint8_t* p = out->getData();
+                const size_t dataByteCount = out->getDataByteCount();
+                for (size_t i = 0; i < dataByteCount; ++i)
+                {
+                    // Use a pattern with runs and literals.
+                    p[i] = static_cast<uint8_t>(i % 7 ? (i / 64) : i);
+                }
+                return out;
+            }
+
+            bool compare(const std::shared_ptr<Image::Image>& a, const std::shared_ptr<Image::Image>& b)
+            {
+                bool out = a && b && a->getSize() == b->getSize() && a->getType() == b->getType();
+                for (uint16_t y = 0; out && y < a->getHeight(); ++y)
+                {
+                    out = 0 == memcmp(a->getData(y), b->getData(y), a->getScanlineByteCount());
+                }
+                return out;
+            }
+
+            //! Encode bytes with the packets used by Targa and RLA: a count
+            //! followed by either a single value to repeat, or a number of
+            //! literal values. The size is in values of "bytes" each, read with
+            //! the given stride.
+            void encode(
+                const uint8_t*        in,
+                size_t                size,
+                size_t                bytes,
+                size_t                stride,
+                bool                  rla,
+                std::vector<uint8_t>& out)
+            {
+                auto equal = [in, bytes, stride](size_t a, size_t b)
+                {
+                    return 0 == memcmp(in + a * stride, in + b * stride, bytes);
+                };
+                size_t i = 0;
+                while (i < size)
+                {
+                    size_t count = 1;
+                    while (i + count < size && count < 128 && equal(i, i + count))
+                    {
+                        ++count;
+                    }
+                    if (count > 1)
+                    {
+                        out.push_back(static_cast<uint8_t>(rla ? (count - 1) : (0x80 | (count - 1))));
+                        out.insert(out.end(), in + i * stride, in + i * stride + bytes);
+                    }
+                    else
+                    {
+                        while (i + count < size && count < 128 && !(i + count + 1 < size && equal(i + count, i + count + 1)))
+                        {
+                            ++count;
+                        }
+                        out.push_back(static_cast<uint8_t>(rla ? -static_cast<int>(count) : (count - 1)));
+                        for (size_t j = 0; j < count; ++j)
+                        {
+                            out.insert(out.end(), in + (i + j) * stride, in + (i + j) * stride + bytes);
+                        }
+                    }
+                    i += count;
+                }
+            }
+
+            void writeSGI(const std::string& fileName, const std::shared_ptr<Image::Image>& image)
+            {
+                const uint16_t w = image->getWidth();
+                const uint16_t h = image->getHeight();
+                const uint16_t channels = 4;
+                std::vector<std::vector<uint8_t> > rle(h * channels);
+                for (uint16_t c = 0; c < channels; ++c)
+                {
+                    for (uint16_t y = 0; y < h; ++y)
+                    {
+                        // SGI packets have the high bit set for literals, and are
+                        // terminated with a zero.
+                        const uint8_t* p = image->getData(y) + c;
+                        auto& data = rle[y + h * c];
+                        for (uint16_t x = 0; x < w;)
+                        {
+                            const uint16_t count = std::min(w - x, 127);
+                            data.push_back(static_cast<uint8_t>(0x80 | count));
+                            for (uint16_t i = 0; i < count; ++i, ++x)
+                            {
+                                data.push_back(p[x * channels]);
+                            }
+                        }
+                        data.push_back(0);
+                    }
+                }
+
+                FileSystem::FileIO io;
+                io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.writeU16(474);
+                io.writeU8(1);
+                io.writeU8(1);
+                io.writeU16(3);
+                io.writeU16(w);
+                io.writeU16(h);
+                io.writeU16(channels);
+                io.writeU32(0);
+                io.writeU32(255);
+                const std::vector<uint8_t> pad(512 - io.getPos(), 0);
+                io.write(pad.data(), pad.size());
+                uint32_t offset = static_cast<uint32_t>(512 + rle.size() * 8);
+                for (const auto& i : rle)
+                {
+                    io.writeU32(offset);
+                    offset += static_cast<uint32_t>(i.size());
+                }
+                for (const auto& i : rle)
+                {
+                    io.writeU32(static_cast<uint32_t>(i.size()));
+                }
+                for (const auto& i : rle)
+                {
+                    io.write(i.data(), i.size());
+                }
+            }
+
+            void writeTarga(const std::string& fileName, const std::shared_ptr<Image::Image>& image)
+            {
+                const uint16_t w = image->getWidth();
+                const uint16_t h = image->getHeight();
+                std::vector<uint8_t> bgra(image->getDataByteCount());
+                memcpy(bgra.data(), image->getData(), bgra.size());
+                for (size_t i = 0; i < bgra.size(); i += 4)
+                {
+                    std::swap(bgra[i], bgra[i + 2]);
+                }
+                std::vector<uint8_t> rle;
+                encode(bgra.data(), static_cast<size_t>(w) * h, 4, 4, false, rle);
+
+                FileSystem::FileIO io;
+                io.setEndianConversion(Memory::getEndian() != Memory::Endian::LSB);
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.writeU8(0);
+                io.writeU8(0);
+                io.writeU8(10);
+                io.writeU16(0);
+                io.writeU16(0);
+                io.writeU8(0);
+                io.writeU16(0);
+                io.writeU16(0);
+                io.writeU16(w);
+                io.writeU16(h);
+                io.writeU8(32);
+                io.writeU8(8);
+                io.write(rle.data(), rle.size());
+            }
+
+            //! This struct provides the RLA header, matching the layout read by
+            //! the RLA plugin.
+            struct RLAHeader
+            {
+                int16_t dimensions[4];
+                int16_t active[4];
+                int16_t frame;
+                int16_t colorChannelType;
+                int16_t colorChannels;
+                int16_t matteChannels;
+                int16_t auxChannels;
+                int16_t version;
+                char    gamma[16];
+                char    chroma[3][24];
+                char    whitepoint[24];
+                int32_t job;
+                char    fileName[128];
+                char    description[128];
+                char    progam[64];
+                char    machine[32];
+                char    user[32];
+                char    date[20];
+                char    aspect[24];
+                char    aspectRatio[8];
+                char    colorFormat[32];
+                int16_t field;
+                char    renderTime[12];
+                char    filter[32];
+                int16_t colorBitDepth;
+                int16_t matteChannelType;
+                int16_t matteBitDepth;
+                int16_t auxChannelType;
+                int16_t auxBitDepth;
+                char    auxFormat[32];
+                char    pad[36];
+                int32_t offset;
+            };
+
+            void writeRLA(const std::string& fileName, const std::shared_ptr<Image::Image>& image)
+            {
+                const uint16_t w = image->getWidth();
+                const uint16_t h = image->getHeight();
+                const bool endian = Memory::getEndian() != Memory::Endian::MSB;
+
+                RLAHeader header;
+                memset(&header, 0, sizeof(RLAHeader));
+                header.active[1] = w - 1;
+                header.active[3] = h - 1;
+                header.colorChannels = 3;
+                header.matteChannels = 1;
+                header.colorBitDepth = 8;
+                header.matteBitDepth = 8;
+                if (endian)
+                {
+                    Memory::endian(&header.active, 4, 2);
+                    Memory::endian(&header.colorChannels, 1, 2);
+                    Memory::endian(&header.matteChannels, 1, 2);
+                    Memory::endian(&header.colorBitDepth, 1, 2);
+                    Memory::endian(&header.matteBitDepth, 1, 2);
+                }
+
+                // Each scanline stores the channels as a 16-bit size followed
+                // by the packets.
+                std::vector<std::vector<uint8_t> > scanlines(h);
+                for (uint16_t y = 0; y < h; ++y)
+                {
+                    auto& scanline = scanlines[y];
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        std::vector<uint8_t> rle;
+                        encode(image->getData(y) + c, w, 1, 4, true, rle);
+                        scanline.push_back(static_cast<uint8_t>(rle.size() >> 8));
+                        scanline.push_back(static_cast<uint8_t>(rle.size() & 0xff));
+                        scanline.insert(scanline.end(), rle.begin(), rle.end());
+                    }
+                }
+
+                FileSystem::FileIO io;
+                io.setEndianConversion(endian);
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.write(&header, sizeof(RLAHeader));
+                int32_t offset = static_cast<int32_t>(sizeof(RLAHeader) + h * 4);
+                for (const auto& i : scanlines)
+                {
+                    io.write32(offset);
+                    offset += static_cast<int32_t>(i.size());
+                }
+                for (const auto& i : scanlines)
+                {
+                    io.write(i.data(), i.size());
+                }
+            }
+
+            const std::vector<Image::Size> sizes =
+            {
+                Image::Size(1, 1),
+                Image::Size(11, 100),
+                Image::Size(333, 333)
+            };
+
+        } // namespace
+        
+        RLETest::RLETest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::RLETest", context)
+        {}
+        
+        void RLETest::run(const std::vector<std::string>& args)
+        {
+            _sgi();
+            _targa();
+            _rla();
+        }
+        
+        void RLETest::_sgi()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                for (const auto& size : sizes)
+                {
+                    auto image = createImage(size);
+                    std::stringstream ss;
+                    ss << "RLETest_" << size.w << "x" << size.h << ".sgi";
+                    _print(ss.str());
+                    writeSGI(ss.str(), image);
+                    DJV_ASSERT(compare(image, read(io, FileSystem::Path(ss.str()))));
+                    FileSystem::remove(ss.str());
+                }
+            }
+        }
+        
+        void RLETest::_targa()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                for (const auto& size : sizes)
+                {
+                    auto image = createImage(size);
+                    std::stringstream ss;
+                    ss << "RLETest_" << size.w << "x" << size.h << ".tga";
+                    _print(ss.str());
+                    writeTarga(ss.str(), image);
+                    DJV_ASSERT(compare(image, read(io, FileSystem::Path(ss.str()))));
+                    FileSystem::remove(ss.str());
+                }
+            }
+        }
+        
+        void RLETest::_rla()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                for (const auto& size : sizes)
+                {
+                    auto image = createImage(size);
+                    std::stringstream ss;
+                    ss << "RLETest_" << size.w << "x" << size.h << ".rla";
+                    _print(ss.str());
+                    writeRLA(ss.str(), image);
+                    DJV_ASSERT(compare(image, read(io, FileSystem::Path(ss.str()))));
+                    FileSystem::remove(ss.str());
+                }
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/TIFFTest.h>
+
+#include <djvAV/IO.h>
+#if defined(TIFF_FOUND)
+#include <djvAV/TIFF.h>
+#endif // TIFF_FOUND
+
+#include <djvCore/Context.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Timer.h>
+
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            void write(
+                const std::shared_ptr<IO::System>& io,
+                const FileSystem::Path& path,
+                const std::shared_ptr<Image::Image>& image)
+            {
+                IO::Info info;
+                info.video.push_back(image->getInfo());
+                auto write = io->write(FileSystem::FileInfo(path), info);
+                {
+                    std::lock_guard<std::mutex> lock(write->getMutex());
+                    auto& writeQueue = write->getVideoQueue();
+                    writeQueue.addFrame(IO::VideoFrame(0, image));
+                    writeQueue.setFinished(true);
+                }
+                while (write->isRunning())
+                {
+                    std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                }
+            }
+
+            std::shared_ptr<Image::Image> read(
+                const std::shared_ptr<IO::System>& io,
+                const FileSystem::Path& path)
+            {
+                std::shared_ptr<Image::Image> out;
+                auto read = io->read(FileSystem::FileInfo(path));
+                bool running = true;
+                while (running)
+                {
+                    bool sleep = false;
+                    {
+                        std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
+                        if (lock.owns_lock())
+                        {
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                out = readQueue.popFrame().image;
+                            }
+                            else if (readQueue.isFinished())
+                            {
+                                running = false;
+                            }
+                            else
+                            {
+                                sleep = true;
+                            }
+                        }
+                        else
+                        {
+                            sleep = true;
+                        }
+                    }
+                    if (sleep)
+                    {
+                        std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Image> createImage(const Image::Info& info)
+            {
+                auto out = Image::Image::create(info);
+                uint8_t* p = out->getData();
+                const size_t dataByteCount = out->getDataByteCount();
+                for (size_t i = 0; i < dataByteCount; ++i)
+                {
+                    // Use a pattern with some redundancy so that it compresses.
+                    p[i] = static_cast<uint8_t>((i / 64) ^ (i % 7));
+                }
+                return out;
+            }
+
+        } // namespace
+        
+        TIFFTest::TIFFTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::TIFFTest", context)
+        {}
+        
+        void TIFFTest::run(const std::vector<std::string>& args)
+        {
+            _io();
+        }
+        
+        void TIFFTest::_io()
+        {
+#if defined(TIFF_FOUND)
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                const std::vector<Image::Size> sizes =
+                {
+                    Image::Size(1, 1),
+                    Image::Size(11, 1000),
+                    Image::Size(333, 333)
+                };
+                const std::vector<Image::Type> types =
+                {
+                    Image::Type::L_U8,
+                    Image::Type::RGB_U16,
+                    Image::Type::RGBA_F32
+                };
+                for (auto compression : IO::TIFF::getCompressionEnums())
+                {
+                    IO::TIFF::Options options;
+                    options.compression = compression;
+                    io->setOptions(IO::TIFF::pluginName, toJSON(options));
+                    for (const auto& size : sizes)
+                    {
+                        for (const auto& type : types)
+                        {
+                            const Image::Info info(size, type);
+                            auto image = createImage(info);
+                            std::stringstream ss;
+                            ss << "TIFFTest_" << compression << "_" << size.w << "x" << size.h << "_" << type << ".tif";
+                            _print(ss.str());
+                            const FileSystem::Path path(ss.str());
+                            write(io, path, image);
+                            auto image2 = read(io, path);
+                            DJV_ASSERT(image2);
+                            DJV_ASSERT(info.size == image2->getSize());
+                            DJV_ASSERT(type == image2->getType());
+                            const size_t scanlineByteCount = info.getScanlineByteCount();
+                            for (uint16_t y = 0; y < size.h; ++y)
+                            {
+                                DJV_ASSERT(0 == memcmp(image->getData(y), image2->getData(y), scanlineByteCount));
+                            }
+                            FileSystem::remove(path.get());
+                        }
+                    }
+                }
+                io->setOptions(IO::TIFF::pluginName, toJSON(IO::TIFF::Options()));
+            }
+#endif // TIFF_FOUND
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvAVTest/TextureAtlasTest.h>
+
+#include <djvAV/TextureAtlas.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            bool intersects(const Render::TextureAtlasRect& a, const Render::TextureAtlasRect& b)
+            {
+                return
+                    a.page == b.page &&
+                    a.x < b.x + b.w && b.x < a.x + a.w &&
+                    a.y < b.y + b.h && b.y < a.y + a.h;
+            }
+
+        } // namespace
+
+        TextureAtlasTest::TextureAtlasTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::TextureAtlasTest", context)
+        {}
+        
+        void TextureAtlasTest::run(const std::vector<std::string>& args)
+        {
+            _packer();
+            _eviction();
+        }
+
+        void TextureAtlasTest::_packer()
+        {
+            {
+                Render::TextureAtlasPacker packer(2, 64);
+                DJV_ASSERT(2 == packer.getPageCount());
+                DJV_ASSERT(64 == packer.getPageSize());
+                DJV_ASSERT(0 == packer.getItemCount());
+                DJV_ASSERT(0.F == packer.getPercentageUsed());
+                Render::TextureAtlasRect rect;
+                DJV_ASSERT(!packer.getItem(1, rect));
+                DJV_ASSERT(!packer.addItem(1, 65, 1, rect));
+            }
+
+            {
+                Render::TextureAtlasPacker packer(2, 64);
+                std::vector<Render::TextureAtlasRect> rects;
+                for (UID uid = 1; uid <= 32; ++uid)
+                {
+                    Render::TextureAtlasRect rect;
+                    DJV_ASSERT(packer.addItem(uid, 16, 8 + uid % 4, rect));
+                    DJV_ASSERT(rect.page < 2);
+                    DJV_ASSERT(rect.x + rect.w <= 64);
+                    DJV_ASSERT(rect.y + rect.h <= 64);
+                    for (const auto& i : rects)
+                    {
+                        DJV_ASSERT(!intersects(i, rect));
+                    }
+                    rects.push_back(rect);
+                }
+                DJV_ASSERT(32 == packer.getItemCount());
+                DJV_ASSERT(packer.getPercentageUsed() > 0.F);
+                DJV_ASSERT(0 == packer.getEvictionCount());
+                for (UID uid = 1; uid <= 32; ++uid)
+                {
+                    Render::TextureAtlasRect rect;
+                    DJV_ASSERT(packer.getItem(uid, rect));
+                    DJV_ASSERT(rects[uid - 1].page == rect.page);
+                    DJV_ASSERT(rects[uid - 1].x == rect.x);
+                    DJV_ASSERT(rects[uid - 1].y == rect.y);
+                }
+                std::stringstream ss;
+                ss << "percentage used: " << packer.getPercentageUsed();
+                _print(ss.str());
+            }
+        }
+
+        void TextureAtlasTest::_eviction()
+        {
+            {
+                // Fill the page with four shelves of four items.
+                Render::TextureAtlasPacker packer(1, 64);
+                Render::TextureAtlasRect rect;
+                for (UID uid = 1; uid <= 16; ++uid)
+                {
+                    DJV_ASSERT(packer.addItem(uid, 16, 16, rect));
+                }
+                DJV_ASSERT(100.F == packer.getPercentageUsed());
+
+                // Items used in the current frame are not evicted.
+                DJV_ASSERT(!packer.addItem(17, 16, 16, rect));
+                DJV_ASSERT(16 == packer.getItemCount());
+                DJV_ASSERT(0 == packer.getEvictionCount());
+
+                // Touch the first shelf so that the second one is evicted.
+                packer.nextFrame();
+                for (UID uid = 1; uid <= 4; ++uid)
+                {
+                    DJV_ASSERT(packer.getItem(uid, rect));
+                }
+                DJV_ASSERT(packer.addItem(17, 16, 16, rect));
+                DJV_ASSERT(0 == rect.x);
+                DJV_ASSERT(16 == rect.y);
+                DJV_ASSERT(4 == packer.getEvictionCount());
+                DJV_ASSERT(13 == packer.getItemCount());
+                for (UID uid = 1; uid <= 17; ++uid)
+                {
+                    DJV_ASSERT((uid < 5 || uid > 8) == packer.getItem(uid, rect));
+                }
+            }
+
+            {
+                // Evicting all of the shelves merges them for a larger item.
+                Render::TextureAtlasPacker packer(1, 64);
+                Render::TextureAtlasRect rect;
+                for (UID uid = 1; uid <= 16; ++uid)
+                {
+                    DJV_ASSERT(packer.addItem(uid, 16, 16, rect));
+                }
+                packer.nextFrame();
+                DJV_ASSERT(packer.addItem(100, 64, 64, rect));
+                DJV_ASSERT(0 == rect.x);
+                DJV_ASSERT(0 == rect.y);
+                DJV_ASSERT(1 == packer.getItemCount());
+                DJV_ASSERT(16 == packer.getEvictionCount());
+                DJV_ASSERT(packer.getDefragmentCount() > 0);
+                DJV_ASSERT(packer.getItem(100, rect));
+            }
+
+            {
+                // An empty shelf is split for a shorter item, and the rest of it is
+                // reused.
+                Render::TextureAtlasPacker packer(1, 64);
+                Render::TextureAtlasRect rect;
+                DJV_ASSERT(packer.addItem(1, 64, 32, rect));
+                DJV_ASSERT(packer.addItem(2, 64, 32, rect));
+                packer.nextFrame();
+                DJV_ASSERT(packer.getItem(2, rect));
+                DJV_ASSERT(packer.addItem(3, 16, 8, rect));
+                DJV_ASSERT(0 == rect.x);
+                DJV_ASSERT(0 == rect.y);
+                DJV_ASSERT(packer.addItem(4, 16, 24, rect));
+                DJV_ASSERT(0 == rect.x);
+                DJV_ASSERT(8 == rect.y);
+                DJV_ASSERT(3 == packer.getItemCount());
+                DJV_ASSERT(!packer.getItem(1, rect));
+                DJV_ASSERT(packer.getItem(2, rect));
+                DJV_ASSERT(packer.getItem(3, rect));
+                DJV_ASSERT(packer.getItem(4, rect));
+            }
+
+            {
+                // Replacing an item releases its space on the shelf.
+                Render::TextureAtlasPacker packer(1, 64);
+                Render::TextureAtlasRect rect;
+                DJV_ASSERT(packer.addItem(1, 16, 16, rect));
+                DJV_ASSERT(packer.addItem(2, 16, 16, rect));
+                DJV_ASSERT(packer.addItem(2, 32, 16, rect));
+                DJV_ASSERT(16 == rect.x);
+                DJV_ASSERT(0 == rect.y);
+                DJV_ASSERT(2 == packer.getItemCount());
+                DJV_ASSERT(0 == packer.getEvictionCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
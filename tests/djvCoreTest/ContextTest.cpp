@@ -46,6 +46,21 @@ namespace djv
         namespace
         {
             class System : public ISystem {};
+
+            class LazySystem : public ISystem
+            {
+                DJV_NON_COPYABLE(LazySystem);
+                LazySystem()
+                {}
+
+            public:
+                static std::shared_ptr<LazySystem> create(const std::shared_ptr<Context>& context)
+                {
+                    auto out = std::shared_ptr<LazySystem>(new LazySystem);
+                    out->_init("LazySystem", context);
+                    return out;
+                }
+            };
         
         } // namespace
         
@@ -80,6 +95,17 @@ namespace djv
                 {
                     DJV_ASSERT(!context->getSystemT<System>());
                 }
+
+                {
+                    context->addSystemFactory<LazySystem>();
+                    DJV_ASSERT(context->getSystemsT<LazySystem>().empty());
+                    auto system = context->getSystemT<LazySystem>();
+                    DJV_ASSERT(system);
+                    DJV_ASSERT(system == context->getSystemT<LazySystem>());
+                    DJV_ASSERT(1 == context->getSystemsT<LazySystem>().size());
+                    context->removeSystem(system);
+                    DJV_ASSERT(!context->getSystemT<LazySystem>());
+                }
                 
                 for (size_t i = 0; i < 100; ++i)
                 {
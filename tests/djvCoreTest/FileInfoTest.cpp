@@ -277,6 +277,40 @@ namespace djv
                 const FileSystem::FileInfo fileInfo = FileSystem::FileInfo::getFileSequence(path, {});
                 DJV_ASSERT(fileInfo.getPath() == path);
             }
+
+            {
+                const std::vector<std::string> fileNames =
+                {
+                    "FileInfoTestSort2.txt",
+                    "FileInfoTestSort10.txt",
+                    "FileInfoTestSort1.txt"
+                };
+                for (const auto& i : fileNames)
+                {
+                    FileSystem::FileIO io;
+                    io.open(i, FileSystem::FileIO::Mode::Write);
+                }
+                auto getFileNames = [](FileSystem::DirectoryListSort sort, bool reverse)
+                {
+                    FileSystem::DirectoryListOptions options;
+                    options.sort = sort;
+                    options.reverseSort = reverse;
+                    options.filter = "FileInfoTestSort";
+                    std::vector<std::string> out;
+                    for (const auto& i : FileSystem::FileInfo::directoryList(FileSystem::Path("."), options))
+                    {
+                        out.push_back(i.getFileName(Frame::invalid, false));
+                    }
+                    return out;
+                };
+                DJV_ASSERT(getFileNames(FileSystem::DirectoryListSort::Name, false) == std::vector<std::string>(
+                    { "FileInfoTestSort1.txt", "FileInfoTestSort10.txt", "FileInfoTestSort2.txt" }));
+                DJV_ASSERT(getFileNames(FileSystem::DirectoryListSort::Natural, false) == std::vector<std::string>(
+                    { "FileInfoTestSort1.txt", "FileInfoTestSort2.txt", "FileInfoTestSort10.txt" }));
+                DJV_ASSERT(getFileNames(FileSystem::DirectoryListSort::Natural, true) == std::vector<std::string>(
+                    { "FileInfoTestSort10.txt", "FileInfoTestSort2.txt", "FileInfoTestSort1.txt" }));
+                DJV_ASSERT(3 == getFileNames(FileSystem::DirectoryListSort::Permissions, false).size());
+            }
         }
 
         void FileInfoTest::_operators()
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCoreTest/FileSystemTest.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        FileSystemTest::FileSystemTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::CoreTest::FileSystemTest", context)
+        {}
+        
+        void FileSystemTest::run(const std::vector<std::string>& args)
+        {
+            _rename();
+            _remove();
+        }
+
+        void FileSystemTest::_rename()
+        {
+            const std::string fileName = "FileSystemTest_rename";
+            const std::string fileName2 = "FileSystemTest_rename2";
+
+            {
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.write("Hello");
+            }
+            FileSystem::rename(fileName, fileName2);
+            DJV_ASSERT(!FileSystem::FileInfo(fileName).doesExist());
+            DJV_ASSERT(FileSystem::FileInfo(fileName2).doesExist());
+
+            // Renaming replaces an existing file.
+            {
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.write("world!");
+            }
+            FileSystem::rename(fileName, fileName2);
+            DJV_ASSERT(!FileSystem::FileInfo(fileName).doesExist());
+            {
+                FileSystem::FileIO io;
+                io.open(fileName2, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT("world!" == FileSystem::FileIO::readContents(io));
+            }
+
+            try
+            {
+                FileSystem::rename(fileName, fileName2);
+                DJV_ASSERT(false);
+            }
+            catch (const FileSystem::Error& e)
+            {
+                _print(e.what());
+            }
+
+            FileSystem::remove(fileName2);
+        }
+
+        void FileSystemTest::_remove()
+        {
+            const std::string fileName = "FileSystemTest_remove";
+
+            {
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                io.write("Hello");
+            }
+            DJV_ASSERT(FileSystem::FileInfo(fileName).doesExist());
+            FileSystem::remove(fileName);
+            DJV_ASSERT(!FileSystem::FileInfo(fileName).doesExist());
+
+            try
+            {
+                FileSystem::remove(fileName);
+                DJV_ASSERT(false);
+            }
+            catch (const FileSystem::Error& e)
+            {
+                _print(e.what());
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
+
@@ -56,7 +56,7 @@ namespace djv
         {
             {
                 const Frame::Sequence sequence;
-                DJV_ASSERT(0 == sequence.ranges.size());
+                DJV_ASSERT(0 == sequence.getRanges().size());
                 DJV_ASSERT(0 == sequence.pad);
                 DJV_ASSERT(!sequence.isValid());
                 DJV_ASSERT(!sequence.contains(0));
@@ -67,7 +67,7 @@ namespace djv
             
             {
                 const Frame::Sequence sequence(Frame::Range(0, 99), 4);
-                DJV_ASSERT(1 == sequence.ranges.size());
+                DJV_ASSERT(1 == sequence.getRanges().size());
                 DJV_ASSERT(4 == sequence.pad);
                 DJV_ASSERT(sequence.isValid());
                 DJV_ASSERT(sequence.contains(0));
@@ -78,7 +78,7 @@ namespace djv
             
             {
                 const Frame::Sequence sequence({ Frame::Range(0, 9), Frame::Range(10, 99) }, 4);
-                DJV_ASSERT(2 == sequence.ranges.size());
+                DJV_ASSERT(2 == sequence.getRanges().size());
                 DJV_ASSERT(4 == sequence.pad);
                 DJV_ASSERT(sequence.isValid());
                 DJV_ASSERT(sequence.contains(0));
@@ -90,16 +90,107 @@ namespace djv
             {
                 Frame::Sequence sequence({ Frame::Range(10, 9), Frame::Range(3, 1) });
                 sequence.sort();
-                DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 3));
-                DJV_ASSERT(sequence.ranges[1] == Frame::Range(9, 10));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 3));
+                DJV_ASSERT(sequence.getRanges()[1] == Frame::Range(9, 10));
             }
             
             {
                 Frame::Sequence sequence(Frame::Range(1, 3));
                 sequence.merge(Frame::Range(3, 10));
-                DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 10));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
                 sequence.merge(Frame::Range(12, 100));
-                DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 10));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
+            }
+
+            {
+                Frame::Sequence sequence({ Frame::Range(1, 3), Frame::Range(10, 12) });
+                DJV_ASSERT(sequence.merge(Frame::Range(4, 5)));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 5));
+                DJV_ASSERT(sequence.merge(Frame::Range(8, 9)));
+                DJV_ASSERT(sequence.getRanges()[1] == Frame::Range(8, 12));
+                DJV_ASSERT(!sequence.merge(Frame::Range(20, 30)));
+                DJV_ASSERT(10 == sequence.getSize());
+                DJV_ASSERT(8 == sequence.getFrame(5));
+            }
+
+            {
+                Frame::Sequence sequence;
+                sequence.add(Frame::Range(1, 3));
+                sequence.add(Frame::Range(4, 5));
+                sequence.add(Frame::Range(10));
+                sequence.add(Frame::Range(7));
+                sequence.add(Frame::Range(6));
+                DJV_ASSERT(3 == sequence.getRanges().size());
+                DJV_ASSERT(10 == sequence.getFrame(5));
+                sequence.sort();
+                DJV_ASSERT(2 == sequence.getRanges().size());
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 7));
+                DJV_ASSERT(sequence.getRanges()[1] == Frame::Range(10, 10));
+            }
+
+            {
+                // Sequences with many ranges use the index for lookups.
+                Frame::Sequence sequence;
+                std::vector<Frame::Number> frames;
+                for (Frame::Number i = 0; i < 10000; i += 3)
+                {
+                    sequence.add(Frame::Range(i, i + 1));
+                    frames.push_back(i);
+                    frames.push_back(i + 1);
+                }
+                sequence.updateIndex();
+                DJV_ASSERT(frames.size() == sequence.getSize());
+                for (size_t i = 0; i < frames.size(); ++i)
+                {
+                    DJV_ASSERT(frames[i] == sequence.getFrame(i));
+                    DJV_ASSERT(static_cast<Frame::Index>(i) == sequence.getIndex(frames[i]));
+                    DJV_ASSERT(sequence.contains(frames[i]));
+                }
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(-1));
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(frames.size()));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(2));
+                DJV_ASSERT(!sequence.contains(2));
+                DJV_ASSERT(!sequence.contains(-1));
+
+                const auto batch = sequence.getFrames(frames.size() - 5, 10);
+                DJV_ASSERT(5 == batch.size());
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    DJV_ASSERT(frames[frames.size() - 5 + i] == batch[i]);
+                }
+                DJV_ASSERT(std::vector<Frame::Number>({ 0, 1, 3 }) == sequence.getFrames(-1, 4));
+
+                // Lookups fall back to a linear search until the index is updated.
+                sequence.add(Frame::Range(20000));
+                DJV_ASSERT(frames.size() + 1 == sequence.getSize());
+                DJV_ASSERT(20000 == sequence.getFrame(frames.size()));
+                sequence.updateIndex();
+                DJV_ASSERT(static_cast<Frame::Index>(frames.size()) == sequence.getIndex(20000));
+            }
+
+            {
+                // Changing a range without changing the number of ranges must
+                // not leave a stale index.
+                Frame::Sequence sequence(Frame::Range(1, 10));
+                DJV_ASSERT(10 == sequence.getSize());
+                sequence.setRanges({ Frame::Range(1, 20) });
+                DJV_ASSERT(20 == sequence.getSize());
+                DJV_ASSERT(20 == sequence.getFrame(19));
+                DJV_ASSERT(sequence.contains(15));
+                sequence.add(Frame::Range(21, 30));
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(30 == sequence.getSize());
+                DJV_ASSERT(29 == sequence.getIndex(30));
+                DJV_ASSERT(30 == sequence.getFrame(29));
+                DJV_ASSERT(sequence.contains(25));
+            }
+
+            {
+                const Frame::Sequence sequence({ Frame::Range(10, 12), Frame::Range(1, 3) });
+                DJV_ASSERT(6 == sequence.getSize());
+                DJV_ASSERT(1 == sequence.getFrame(3));
+                DJV_ASSERT(3 == sequence.getIndex(1));
+                DJV_ASSERT(sequence.contains(2));
             }
         }
         
@@ -129,7 +220,7 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(0 == sequence.ranges.size());
+                DJV_ASSERT(0 == sequence.getRanges().size());
             }
             
             {
@@ -140,9 +231,9 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(1 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(1 == sequence.ranges[0].max);
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(1 == sequence.getRanges()[0].max);
             }
             
             {
@@ -153,9 +244,9 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(1 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(3 == sequence.ranges[0].max);
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(3 == sequence.getRanges()[0].max);
             }
             
             {
@@ -166,11 +257,11 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(2 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(1 == sequence.ranges[0].max);
-                DJV_ASSERT(3 == sequence.ranges[1].min);
-                DJV_ASSERT(3 == sequence.ranges[1].max);
+                DJV_ASSERT(2 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(1 == sequence.getRanges()[0].max);
+                DJV_ASSERT(3 == sequence.getRanges()[1].min);
+                DJV_ASSERT(3 == sequence.getRanges()[1].max);
             }
             
             {
@@ -181,13 +272,13 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(3 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(3 == sequence.ranges[0].max);
-                DJV_ASSERT(5 == sequence.ranges[1].min);
-                DJV_ASSERT(6 == sequence.ranges[1].max);
-                DJV_ASSERT(8 == sequence.ranges[2].min);
-                DJV_ASSERT(8 == sequence.ranges[2].max);
+                DJV_ASSERT(3 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(3 == sequence.getRanges()[0].max);
+                DJV_ASSERT(5 == sequence.getRanges()[1].min);
+                DJV_ASSERT(6 == sequence.getRanges()[1].max);
+                DJV_ASSERT(8 == sequence.getRanges()[2].min);
+                DJV_ASSERT(8 == sequence.getRanges()[2].max);
             }
             
             {
@@ -78,6 +78,19 @@ namespace djv
 
                 _tickFor(std::chrono::milliseconds(500));
 
+                {
+                    const auto records = system->getRecords();
+                    DJV_ASSERT(records.size() >= 3);
+                    const auto& record = records.back();
+                    DJV_ASSERT("LogSystemTest" == record.prefix);
+                    DJV_ASSERT("Error" == record.text);
+                    DJV_ASSERT(LogLevel::Error == record.level);
+                    const auto newRecords = system->getRecords(record.id);
+                    DJV_ASSERT(1 == newRecords.size());
+                    DJV_ASSERT(record.id == newRecords[0].id);
+                    DJV_ASSERT(system->getRecords(record.id + 1).empty());
+                }
+
                 system->setConsoleOutput(false);
             }
         }
@@ -32,6 +32,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/PicoJSON.h>
 
+#include <sstream>
+
 using namespace djv::Core;
 
 namespace djv
@@ -45,6 +47,7 @@ namespace djv
         void PicoJSONTest::run(const std::vector<std::string>& args)
         {
             _io();
+            _split();
             _conversion();
         }
                 
@@ -91,6 +94,41 @@ namespace djv
             }
         }
         
+        void PicoJSONTest::_split()
+        {
+            {
+                const std::string text = "{ \"a\": \"1\", \"b\" : [ \"2\", { \"c\": \"]}\\\",\" } ],\n\"d\": {} }";
+                std::map<std::string, std::string> values;
+                PicoJSON::split(text.data(), text.data() + text.size(), values);
+                DJV_ASSERT(3 == values.size());
+                DJV_ASSERT("\"1\"" == values["a"]);
+                DJV_ASSERT("[ \"2\", { \"c\": \"]}\\\",\" } ]" == values["b"]);
+                DJV_ASSERT("{}" == values["d"]);
+                picojson::value json;
+                DJV_ASSERT(picojson::parse(json, values["b"]).empty());
+                DJV_ASSERT(json.is<picojson::array>());
+            }
+
+            {
+                const std::string text = "{}";
+                std::map<std::string, std::string> values;
+                PicoJSON::split(text.data(), text.data() + text.size(), values);
+                DJV_ASSERT(values.empty());
+            }
+
+            for (const std::string text : { "", "[]", "{ \"a\" }", "{ \"a\": \"1\"", "{ 1: 2 }" })
+            {
+                try
+                {
+                    std::map<std::string, std::string> values;
+                    PicoJSON::split(text.data(), text.data() + text.size(), values);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
         void PicoJSONTest::_conversion()
         {
             {
@@ -44,6 +44,7 @@ namespace djv
         
         private:
             void _io();
+            void _split();
             void _conversion();
         };
         
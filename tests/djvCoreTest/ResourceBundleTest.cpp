@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvCoreTest/ResourceBundleTest.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/ResourceBundle.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        ResourceBundleTest::ResourceBundleTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::CoreTest::ResourceBundleTest", context),
+            _fileName("ResourceBundleTest.pak")
+        {}
+        
+        void ResourceBundleTest::run(const std::vector<std::string>& args)
+        {
+            _bundle();
+            _text();
+            _error();
+        }
+
+        void ResourceBundleTest::_bundle()
+        {
+            std::vector<std::pair<ResourceBundle::Entry, std::vector<uint8_t> > > entries;
+            {
+                ResourceBundle::Entry entry;
+                entry.name = "Shaders/shader.glsl";
+                entries.push_back(std::make_pair(entry, std::vector<uint8_t>({ 1, 2, 3 })));
+            }
+            {
+                ResourceBundle::Entry entry;
+                entry.type = ResourceBundle::EntryType::Image;
+                entry.name = "Icons/96DPI/icon.png";
+                entry.width = 1;
+                entry.height = 2;
+                entries.push_back(std::make_pair(entry, std::vector<uint8_t>({ 1, 2, 3, 4, 5, 6, 7, 8 })));
+            }
+            ResourceBundle::write(_fileName, entries);
+
+            auto bundle = ResourceBundle::create(_fileName);
+            DJV_ASSERT(_fileName == bundle->getFileName());
+            DJV_ASSERT(2 == bundle->getEntries().size());
+            DJV_ASSERT(!bundle->getEntry("Shaders/missing.glsl"));
+            for (const auto& i : entries)
+            {
+                const auto entry = bundle->getEntry(i.first.name);
+                DJV_ASSERT(entry);
+                DJV_ASSERT(i.first.type == entry->type);
+                DJV_ASSERT(i.first.width == entry->width);
+                DJV_ASSERT(i.first.height == entry->height);
+                DJV_ASSERT(i.second.size() == entry->size);
+                DJV_ASSERT(0 == memcmp(i.second.data(), bundle->getData(*entry), entry->size));
+            }
+            const auto names = bundle->getNames("Icons/");
+            DJV_ASSERT(1 == names.size());
+            DJV_ASSERT("Icons/96DPI/icon.png" == names[0]);
+        }
+
+        void ResourceBundleTest::_text()
+        {
+            const ResourceBundle::TextList text =
+            {
+                { "Hello", "world" },
+                { "Empty", "" }
+            };
+            const auto data = ResourceBundle::packText(text);
+            const auto text2 = ResourceBundle::unpackText(data.data(), data.size());
+            DJV_ASSERT(text.size() == text2.size());
+            for (const auto& i : text)
+            {
+                DJV_ASSERT(std::find(text2.begin(), text2.end(), i) != text2.end());
+            }
+            DJV_ASSERT(ResourceBundle::getTextHash("Hello") != ResourceBundle::getTextHash("world"));
+        }
+
+        void ResourceBundleTest::_error()
+        {
+            try
+            {
+                ResourceBundle::create("ResourceBundleTest.missing");
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            try
+            {
+                FileSystem::FileIO io;
+                io.open(_fileName, FileSystem::FileIO::Mode::Write);
+                io.write("Hello world!");
+                io.close();
+                ResourceBundle::create(_fileName);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            try
+            {
+                const std::vector<uint8_t> data(4, 0xff);
+                ResourceBundle::unpackText(data.data(), data.size());
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
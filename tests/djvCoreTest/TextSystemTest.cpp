@@ -30,7 +30,13 @@
 #include <djvCoreTest/TextSystemTest.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/ResourceSystem.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
+
+#include <algorithm>
 
 using namespace djv::Core;
 
@@ -55,6 +61,18 @@ namespace djv
                     _print(ss.str());
                 }
 
+                {
+                    // Only the current locale and the fallback are loaded.
+                    const std::string currentLocale = system->observeCurrentLocale()->get();
+                    for (const auto& i : system->getLoadedLocales())
+                    {
+                        std::stringstream ss;
+                        ss << "loaded locale: " << i;
+                        _print(ss.str());
+                        DJV_ASSERT(currentLocale == i || "en" == i);
+                    }
+                }
+
                 auto localeObserver = ValueObserver<std::string>::create(
                     system->observeCurrentLocale(),
                     [this](const std::string& value)
@@ -68,6 +86,8 @@ namespace djv
                     system->setCurrentLocale("zh");
                     system->setCurrentLocale("zh");
                     DJV_ASSERT("zh" == system->observeCurrentLocale()->get());
+                    const auto loaded = system->getLoadedLocales();
+                    DJV_ASSERT(std::find(loaded.begin(), loaded.end(), "zh") != loaded.end());
                 }
                 
                 for (const std::string& i : { "File", "Window", "Image" })
@@ -76,6 +96,48 @@ namespace djv
                     ss << i << ": " << system->getText(i);
                     _print(ss.str());
                 }
+
+                {
+                    const std::string id = "djv::CoreTest::TextSystemTest";
+                    DJV_ASSERT(id == system->getText(id));
+                }
+
+                {
+                    DJV_ASSERT(!system->hasHotReload());
+                    system->setHotReload(true);
+                    DJV_ASSERT(system->hasHotReload());
+
+                    // Add a text file to the resource text directory and wait for
+                    // it to be reloaded.
+                    bool textChanged = false;
+                    auto textChangedObserver = ValueObserver<bool>::create(
+                        system->observeTextChanged(),
+                        [&textChanged](bool value)
+                        {
+                            textChanged = value;
+                        });
+                    textChanged = false;
+                    const std::string id = "djv::CoreTest::TextSystemTest";
+                    const FileSystem::Path path(
+                        context->getSystemT<ResourceSystem>()->getPath(FileSystem::ResourcePath::Text),
+                        "djvCoreTest." + system->observeCurrentLocale()->get() + ".text");
+                    {
+                        FileSystem::FileIO io;
+                        io.open(path.get(), FileSystem::FileIO::Mode::Write);
+                        io.write("[ { \"id\": \"" + id + "\", \"text\": \"Reloaded\" } ]");
+                    }
+                    for (size_t i = 0; i < 50 && system->getText(id) == id; ++i)
+                    {
+                        _tickFor(Time::getMilliseconds(Time::TimerValue::Medium));
+                    }
+                    DJV_ASSERT(textChanged);
+                    DJV_ASSERT("Reloaded" == system->getText(id));
+                    FileSystem::remove(path.get());
+
+                    system->setHotReload(false);
+                    DJV_ASSERT(!system->hasHotReload());
+                    _tickFor(Time::getMilliseconds(Time::TimerValue::Medium));
+                }
             }
         }
                 
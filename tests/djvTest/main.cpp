@@ -39,6 +39,7 @@
 #include <djvCoreTest/EventTest.h>
 #include <djvCoreTest/FileIOTest.h>
 #include <djvCoreTest/FileInfoTest.h>
+#include <djvCoreTest/FileSystemTest.h>
 #include <djvCoreTest/FrameTest.h>
 #include <djvCoreTest/IEventSystemTest.h>
 #include <djvCoreTest/ISystemTest.h>
@@ -52,6 +53,7 @@
 #include <djvCoreTest/PathTest.h>
 #include <djvCoreTest/PicoJSONTest.h>
 #include <djvCoreTest/RangeTest.h>
+#include <djvCoreTest/ResourceBundleTest.h>
 #include <djvCoreTest/SpeedTest.h>
 #include <djvCoreTest/StringTest.h>
 #include <djvCoreTest/TextSystemTest.h>
@@ -61,22 +63,29 @@
 
 #include <djvAVTest/AVSystemTest.h>
 #include <djvAVTest/AudioDataTest.h>
+#include <djvAVTest/AudioMixerTest.h>
 #include <djvAVTest/AudioTest.h>
 #include <djvAVTest/ColorTest.h>
 #include <djvAVTest/EnumTest.h>
+#include <djvAVTest/FFmpegTest.h>
 #include <djvAVTest/FontSystemTest.h>
 #include <djvAVTest/IOTest.h>
 #include <djvAVTest/ImageConvertTest.h>
 #include <djvAVTest/ImageDataTest.h>
+#include <djvAVTest/ImageScopesTest.h>
 #include <djvAVTest/ImageTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
 #include <djvAVTest/PixelTest.h>
+#include <djvAVTest/RLETest.h>
 #include <djvAVTest/Render2DTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
+#include <djvAVTest/TextureAtlasTest.h>
+#include <djvAVTest/TIFFTest.h>
 
 #include <djvUITest/EnumTest.h>
+#include <djvUITest/SettingsSystemTest.h>
 #include <djvUITest/WidgetTest.h>
 
 #include <djvUI/UISystem.h>
@@ -114,6 +123,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::EventTest(context));
         tests.emplace_back(new CoreTest::FileIOTest(context));
         tests.emplace_back(new CoreTest::FileInfoTest(context));
+        tests.emplace_back(new CoreTest::FileSystemTest(context));
         tests.emplace_back(new CoreTest::FrameTest(context));
         tests.emplace_back(new CoreTest::IEventSystemTest(context));
         tests.emplace_back(new CoreTest::ISystemTest(context));
@@ -127,6 +137,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::PathTest(context));
         tests.emplace_back(new CoreTest::PicoJSONTest(context));
         tests.emplace_back(new CoreTest::RangeTest(context));
+        tests.emplace_back(new CoreTest::ResourceBundleTest(context));
         tests.emplace_back(new CoreTest::SpeedTest(context));
         tests.emplace_back(new CoreTest::StringTest(context));
         tests.emplace_back(new CoreTest::TextSystemTest(context));
@@ -136,22 +147,29 @@ int main(int argc, char ** argv)
 
         tests.emplace_back(new AVTest::AVSystemTest(context));
         tests.emplace_back(new AVTest::AudioDataTest(context));
+        tests.emplace_back(new AVTest::AudioMixerTest(context));
         tests.emplace_back(new AVTest::AudioTest(context));
         tests.emplace_back(new AVTest::ColorTest(context));
         tests.emplace_back(new AVTest::EnumTest(context));
+        tests.emplace_back(new AVTest::FFmpegTest(context));
         tests.emplace_back(new AVTest::FontSystemTest(context));
         tests.emplace_back(new AVTest::IOTest(context));
         tests.emplace_back(new AVTest::ImageConvertTest(context));
         tests.emplace_back(new AVTest::ImageDataTest(context));
+        tests.emplace_back(new AVTest::ImageScopesTest(context));
         tests.emplace_back(new AVTest::ImageTest(context));
         tests.emplace_back(new AVTest::OCIOSystemTest(context));
         tests.emplace_back(new AVTest::OCIOTest(context));
         tests.emplace_back(new AVTest::PixelTest(context));
+        tests.emplace_back(new AVTest::RLETest(context));
         tests.emplace_back(new AVTest::Render2DTest(context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
         tests.emplace_back(new AVTest::TagsTest(context));
+        tests.emplace_back(new AVTest::TextureAtlasTest(context));
+        tests.emplace_back(new AVTest::TIFFTest(context));
 
         tests.emplace_back(new UITest::EnumTest(context));
+        tests.emplace_back(new UITest::SettingsSystemTest(context));
         tests.emplace_back(new UITest::WidgetTest(context));
         
         std::vector<std::shared_ptr<Test::ITest> > testsToRun;
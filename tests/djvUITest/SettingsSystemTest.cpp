@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <djvUITest/SettingsSystemTest.h>
+
+#include <djvUI/SettingsSystem.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+
+#include <future>
+
+using namespace djv::Core;
+using namespace djv::UI;
+
+namespace djv
+{
+    namespace UITest
+    {
+        namespace
+        {
+            picojson::value createSettings(size_t version, size_t value)
+            {
+                picojson::value out(picojson::object_type, true);
+                auto& object = out.get<picojson::object>();
+                object["SettingsVersion"] = toJSON(version);
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "Settings" << i;
+                    picojson::value group(picojson::object_type, true);
+                    group.get<picojson::object>()["Value"] = toJSON(value);
+                    object[ss.str()] = group;
+                }
+                return out;
+            }
+
+            size_t getTempFileCount(const std::string& fileName)
+            {
+                size_t out = 0;
+                for (const auto& i : FileSystem::FileInfo::directoryList(FileSystem::Path(".")))
+                {
+                    const std::string name = i.getFileName(Frame::invalid, false);
+                    if (name.size() > fileName.size() && 0 == name.compare(0, fileName.size() + 1, fileName + "."))
+                    {
+                        ++out;
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        SettingsSystemTest::SettingsSystemTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::UITest::SettingsSystemTest", context)
+        {}
+        
+        void SettingsSystemTest::run(const std::vector<std::string>& args)
+        {
+            _io();
+            _async();
+        }
+
+        void SettingsSystemTest::_io()
+        {
+            //! \todo The version needs to be at least the current settings version.
+            const size_t version = 1000;
+            const std::string fileName = "SettingsSystemTest_io.json";
+            const FileSystem::Path path(fileName);
+
+            {
+                const auto json = createSettings(version, 1);
+                Settings::writeSettingsFile(path, json);
+                DJV_ASSERT(0 == getTempFileCount(fileName));
+                std::map<std::string, picojson::value> groups;
+                std::map<std::string, std::string> errors;
+                Settings::readSettingsFile(path, groups, errors);
+                DJV_ASSERT(json.get<picojson::object>().size() == groups.size());
+                DJV_ASSERT(errors.empty());
+                for (const auto& i : json.get<picojson::object>())
+                {
+                    DJV_ASSERT(i.second == groups[i.first]);
+                }
+            }
+
+            {
+                // Settings from an older version are ignored.
+                Settings::writeSettingsFile(path, createSettings(0, 1));
+                std::map<std::string, picojson::value> groups;
+                std::map<std::string, std::string> errors;
+                Settings::readSettingsFile(path, groups, errors);
+                DJV_ASSERT(groups.empty());
+            }
+
+            {
+                // Groups that cannot be parsed are reported and the other groups
+                // are still read.
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                std::stringstream ss;
+                ss << "{ \"SettingsVersion\": \"" << version << "\", \"A\": { \"Value\": \"1\" }, \"B\": [ 1 2 ] }";
+                io.write(ss.str());
+                io.close();
+                std::map<std::string, picojson::value> groups;
+                std::map<std::string, std::string> errors;
+                Settings::readSettingsFile(path, groups, errors);
+                DJV_ASSERT(2 == groups.size());
+                DJV_ASSERT(groups.count("A"));
+                DJV_ASSERT(1 == errors.size());
+                DJV_ASSERT(errors.count("B"));
+            }
+
+            FileSystem::remove(fileName);
+        }
+
+        void SettingsSystemTest::_async()
+        {
+            const size_t version = 1000;
+            const std::string fileName = "SettingsSystemTest_async.json";
+            const FileSystem::Path path(fileName);
+
+            // Write the settings from multiple threads at the same time, as if
+            // multiple instances of the application were running. Each write
+            // uses its own temporary file, so the result is one of the complete
+            // settings.
+            const size_t count = 8;
+            std::vector<std::future<void> > futures;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto json = createSettings(version, i);
+                futures.push_back(std::async(
+                    std::launch::async,
+                    [path, json]
+                    {
+                        Settings::writeSettingsFile(path, json);
+                    }));
+            }
+            for (auto& i : futures)
+            {
+                try
+                {
+                    i.get();
+                }
+                catch (const std::exception& e)
+                {
+                    // Replacing a file that is being replaced may fail on
+                    // some platforms, but the settings file must stay intact.
+                    _print(e.what());
+                }
+            }
+            DJV_ASSERT(0 == getTempFileCount(fileName));
+
+            std::map<std::string, picojson::value> groups;
+            std::map<std::string, std::string> errors;
+            Settings::readSettingsFile(path, groups, errors);
+            DJV_ASSERT(errors.empty());
+            DJV_ASSERT(11 == groups.size());
+            bool match = false;
+            for (size_t i = 0; i < count && !match; ++i)
+            {
+                const auto json = createSettings(version, i);
+                match = true;
+                for (const auto& j : json.get<picojson::object>())
+                {
+                    match &= j.second == groups[j.first];
+                }
+            }
+            DJV_ASSERT(match);
+
+            FileSystem::remove(fileName);
+        }
+        
+    } // namespace UITest
+} // namespace djv
+